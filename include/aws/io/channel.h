@@ -17,9 +17,11 @@ enum aws_channel_direction {
 
 struct aws_channel;
 struct aws_channel_slot;
+struct aws_channel_recycler;
 struct aws_channel_handler;
 struct aws_event_loop;
 struct aws_event_loop_local_object;
+struct aws_message_pool_statistics;
 
 typedef void(aws_channel_on_setup_completed_fn)(struct aws_channel *channel, int error_code, void *user_data);
 
@@ -119,6 +121,61 @@ struct aws_channel_handler_vtable {
      * associated with the channel's handler chain.
      */
     void (*gather_statistics)(struct aws_channel_handler *handler, struct aws_array_list *stats_list);
+
+    /**
+     * Optional. Called by the channel when a batch of messages is available for processing in the read direction.
+     * messages is a list of aws_io_message linked through their queueing_handle, in the order they were read. Take
+     * ownership of each message by removing it from the list. On success the list must be left empty; on failure any
+     * messages still in the list go back to the sender.
+     *
+     * If not set, the channel calls process_read_message once per message instead.
+     */
+    int (*process_read_messages)(
+        struct aws_channel_handler *handler,
+        struct aws_channel_slot *slot,
+        struct aws_linked_list *messages);
+
+    /**
+     * Optional. Same as process_read_messages, but for the write direction. If not set, the channel calls
+     * process_write_message once per message instead.
+     */
+    int (*process_write_messages)(
+        struct aws_channel_handler *handler,
+        struct aws_channel_slot *slot,
+        struct aws_linked_list *messages);
+
+    /**
+     * Optional. Called by the channel when a downstream handler corks or uncorks the write direction, see
+     * aws_channel_slot_cork_writes(). While corked, a handler that sends data on to the network may hold on to write
+     * messages instead of writing them, and must send everything it held back when uncorked. A handler implementing
+     * this is responsible for passing the call on to the handler to its left, if that matters to it.
+     *
+     * If not set, the channel passes the call straight through to the next handler to the left.
+     */
+    int (*set_write_cork)(struct aws_channel_handler *handler, struct aws_channel_slot *slot, bool corked);
+
+    /**
+     * Optional. Called by the channel, on every handler from left to right, when the channel's write window fills up
+     * past its high water mark (writable is false) and when it drains back down to its low water mark (writable is
+     * true). Producers should hold off on writing while the channel isn't writable, rather than buffering data.
+     * See aws_channel_options.
+     */
+    void (*on_writability_changed)(struct aws_channel_handler *handler, struct aws_channel_slot *slot, bool writable);
+
+    /**
+     * Optional. Lets the handler supply the buffer the handler to its left reads into next, so data lands straight in
+     * the handler's own storage, e.g. a free region of its ring buffer, instead of being copied out of a pool message.
+     * Called through aws_channel_slot_borrow_read_buffer(), by the socket handler before each read. size_hint is the
+     * most the caller will read.
+     *
+     * Return an application data message whose message_data is the lent storage, or NULL to have the caller use a
+     * pool message. The message comes back through process_read_message(s) like any other, and what releasing it
+     * does is up to its allocator. See struct aws_channel_read_buffer_loan.
+     */
+    struct aws_io_message *(*lend_read_buffer)(
+        struct aws_channel_handler *handler,
+        struct aws_channel_slot *slot,
+        size_t size_hint);
 };
 
 struct aws_channel_handler {
@@ -128,6 +185,30 @@ struct aws_channel_handler {
     void *impl;
 };
 
+struct aws_channel_read_buffer_loan;
+
+/**
+ * Invoked when a lent read buffer's message is released. data is the region that was lent, with len set to how much
+ * of it now holds data. That may be 0 if nothing was read into it.
+ */
+typedef void(aws_channel_on_read_buffer_returned_fn)(
+    struct aws_channel_read_buffer_loan *loan,
+    struct aws_byte_buf *data,
+    void *user_data);
+
+/**
+ * For handlers implementing lend_read_buffer: wraps a region of the handler's own storage in a message that, when
+ * released via aws_mem_release(message->allocator, message), hands the region back through on_returned instead of
+ * freeing anything. A loan lends one region at a time, and is usually embedded in the handler.
+ */
+struct aws_channel_read_buffer_loan {
+    struct aws_io_message message;
+    struct aws_allocator message_allocator;
+    aws_channel_on_read_buffer_returned_fn *on_returned;
+    void *user_data;
+    bool outstanding;
+};
+
 /**
  * Args for creating a new channel.
  *  event_loop to use for IO and tasks. on_setup_completed will be invoked when
@@ -138,6 +219,30 @@ struct aws_channel_handler {
  *  Leave this option off unless you're using something like reactive-streams, since it is a slight throughput
  *  penalty.
  *
+ *  max_fragment_size is the largest message the channel's handlers will produce, e.g. for socket reads, and sizes the
+ *  read window batching. 0 means g_aws_channel_max_fragment_size.
+ *
+ *  write_high_water_mark turns on write back pressure: once this many bytes have been handed to the channel's
+ *  socket but not yet written, the channel stops being writable and handlers are told via on_writability_changed.
+ *  It becomes writable again once the pending bytes drain down to write_low_water_mark, which must be less than the
+ *  high water mark. 0 for the high water mark (the default) turns write back pressure off.
+ *
+ *  enable_read_window_auto_tuning lets the channel size the read window of its last handler, the consumer, instead of
+ *  leaving it at the handler's initial_window_size. It requires enable_read_back_pressure. Each time the consumer has
+ *  let the window run dry and then hands it back, the window doubles, up to max_read_window_size (0 means 64 times
+ *  max_fragment_size). Whenever one of this channel's messages has had to be allocated outside the message pool's
+ *  slabs since the last update, because the pool was full, the window halves instead, down to the consumer's initial
+ *  window size. The current window is reported in the channel's statistics.
+ *
+ *  arena_size, if set, makes the channel allocate this many extra bytes along with itself, and hand them out from
+ *  aws_channel_get_allocator(). Its slots come from there, and so can its handlers' state if they're created with
+ *  that allocator, so a channel costs a single allocation which is freed at once when the channel is deleted.
+ *  aws_channel_arena_size_hint() helps with sizing it. Once the arena is used up, allocations fall back to the
+ *  channel's regular allocator.
+ *
+ *  recycler, if set, is where the channel's memory, arena included, goes when the channel is deleted, and where it
+ *  comes from when a channel of the same size is created with it, see aws_channel_recycler_new().
+ *
  *  Unless otherwise
  *  specified all functions for channels and channel slots must be executed within that channel's event-loop's thread.
  **/
@@ -148,6 +253,13 @@ struct aws_channel_options {
     void *setup_user_data;
     void *shutdown_user_data;
     bool enable_read_back_pressure;
+    size_t max_fragment_size;
+    size_t write_high_water_mark;
+    size_t write_low_water_mark;
+    bool enable_read_window_auto_tuning;
+    size_t max_read_window_size;
+    size_t arena_size;
+    struct aws_channel_recycler *recycler;
 };
 
 AWS_EXTERN_C_BEGIN
@@ -224,6 +336,104 @@ struct aws_channel_slot *aws_channel_slot_new(struct aws_channel *channel);
 AWS_IO_API
 struct aws_event_loop *aws_channel_get_event_loop(struct aws_channel *channel);
 
+/**
+ * Fetches the channel's max fragment size, see aws_channel_options. This never changes, so it can be called from any
+ * thread.
+ */
+AWS_IO_API
+size_t aws_channel_max_fragment_size(const struct aws_channel *channel);
+
+/**
+ * Returns false while the channel's write window is above its high water mark, see aws_channel_options. Channels
+ * without write back pressure are always writable.
+ */
+AWS_IO_API
+bool aws_channel_is_writable(const struct aws_channel *channel);
+
+/**
+ * Fetches the number of bytes handed to the channel's socket but not yet written.
+ */
+AWS_IO_API
+size_t aws_channel_pending_write_bytes(const struct aws_channel *channel);
+
+/**
+ * Returns an arena_size for a channel with slot_count slots whose handlers allocate handler_bytes of state between
+ * them, see aws_channel_options.
+ */
+AWS_IO_API
+size_t aws_channel_arena_size_hint(size_t slot_count, size_t handler_bytes);
+
+/**
+ * Fetches the allocator for objects that live as long as the channel, such as its handlers. For a channel created with
+ * an arena_size this hands out memory from the channel's own allocation, and must only be used from the channel's
+ * thread; otherwise it's the allocator the channel was created with.
+ */
+AWS_IO_API
+struct aws_allocator *aws_channel_get_allocator(struct aws_channel *channel);
+
+/**
+ * Creates a cache for the memory of deleted channels, which channels created with it afterwards reuse instead of
+ * allocating their own, as long as they're the same size (i.e. have the same arena_size). It keeps up to max_channels
+ * of them; beyond that, channels are freed as usual. The recycler can be shared between threads, but it works best
+ * with one per event loop, so channels reuse memory last touched on their own loop's thread. It starts with a
+ * reference count of 1, and each channel created with it holds another until it's deleted.
+ */
+AWS_IO_API
+struct aws_channel_recycler *aws_channel_recycler_new(struct aws_allocator *allocator, size_t max_channels);
+
+AWS_IO_API
+struct aws_channel_recycler *aws_channel_recycler_acquire(struct aws_channel_recycler *recycler);
+
+/**
+ * Releases a reference to the recycler. Once the last one is gone, the recycler frees the memory it was keeping.
+ */
+AWS_IO_API
+void aws_channel_recycler_release(struct aws_channel_recycler *recycler);
+
+/**
+ * Fetches how many deleted channels' memory the recycler is currently keeping for reuse.
+ */
+AWS_IO_API
+size_t aws_channel_recycler_get_cached_count(struct aws_channel_recycler *recycler);
+
+/**
+ * Fetches the recycler the channel was created with, if any. Handlers can use it as a hint that the channel's
+ * owner wants their per-connection state recycled too.
+ */
+AWS_IO_API
+struct aws_channel_recycler *aws_channel_get_recycler(const struct aws_channel *channel);
+
+/**
+ * Fetches the read window the channel currently grants its last handler. With read window auto-tuning off this is just
+ * that handler's initial window size, and with read back pressure off it's SIZE_MAX.
+ */
+AWS_IO_API
+size_t aws_channel_read_window_size(const struct aws_channel *channel);
+
+/**
+ * Called by the handler that writes to the network, usually the socket handler, when it takes size bytes that it
+ * can't write right away. May make the channel unwritable. Must be called from the channel's thread.
+ */
+AWS_IO_API
+void aws_channel_increment_pending_write_bytes(struct aws_channel *channel, size_t size);
+
+/**
+ * Called by the handler that writes to the network once size bytes previously counted with
+ * aws_channel_increment_pending_write_bytes() have been written or dropped. May make the channel writable again.
+ * Must be called from the channel's thread.
+ */
+AWS_IO_API
+void aws_channel_decrement_pending_write_bytes(struct aws_channel *channel, size_t size);
+
+/**
+ * Fetches hit, miss and outstanding counts for the message pool the channel draws from. The pool is shared by every
+ * channel on the same event-loop, so these are per-loop numbers. Fails if channel setup hasn't completed.
+ */
+AWS_IO_API
+int aws_channel_get_message_pool_statistics(
+    struct aws_channel *channel,
+    struct aws_message_pool_statistics *stats);
+
 /**
  * Fetches the current timestamp from the event-loop's clock, in nanoseconds.
  */
@@ -268,6 +478,24 @@ struct aws_io_message *aws_channel_acquire_message_from_pool(
     enum aws_io_message_type message_type,
     size_t size_hint);
 
+/**
+ * Sets up a loan for lending read buffers. on_returned is invoked each time a lent region comes back.
+ */
+AWS_IO_API
+void aws_channel_read_buffer_loan_init(
+    struct aws_channel_read_buffer_loan *loan,
+    aws_channel_on_read_buffer_returned_fn *on_returned,
+    void *user_data);
+
+/**
+ * Returns the loan's message, wrapping the region.capacity bytes at region.buffer and starting out empty. Fails with
+ * AWS_ERROR_INVALID_STATE if the previous region hasn't come back yet.
+ */
+AWS_IO_API
+struct aws_io_message *aws_channel_read_buffer_loan_lend(
+    struct aws_channel_read_buffer_loan *loan,
+    struct aws_byte_buf region);
+
 /**
  * Schedules a task to run on the event loop as soon as possible.
  * This is the ideal way to move a task into the correct thread. It's also handy for context switches.
@@ -367,6 +595,42 @@ int aws_channel_slot_send_message(
     struct aws_io_message *message,
     enum aws_channel_direction dir);
 
+/**
+ * Sends a batch of messages, linked through their queueing_handle, to the adjacent slot in the channel based on dir.
+ * Read window checking is done against the batch's total size. Handlers that implement process_read_messages or
+ * process_write_messages receive the whole batch in one call, other handlers receive one message at a time.
+ *
+ * On AWS_OP_SUCCESS messages is left empty and the recipient owns every message. On failure, whatever messages are
+ * still in the list belong to the caller and must be released back to the pool.
+ */
+AWS_IO_API
+int aws_channel_slot_send_messages(
+    struct aws_channel_slot *slot,
+    struct aws_linked_list *messages,
+    enum aws_channel_direction dir);
+
+/**
+ * Asks the handler to the right of slot for a buffer to read up to size_hint bytes into, see lend_read_buffer in
+ * aws_channel_handler_vtable. Send the message on with aws_channel_slot_send_message(s), or release it if nothing was
+ * read into it. Returns NULL, without raising an error, if the handler doesn't lend buffers. Use a pool message then.
+ */
+AWS_IO_API
+struct aws_io_message *aws_channel_slot_borrow_read_buffer(struct aws_channel_slot *slot, size_t size_hint);
+
+/**
+ * Tells the handlers to the left of slot that more writes are coming. The socket handler holds on to write messages
+ * until the channel is uncorked, then sends them all in a single vectored write. Handlers in between, e.g. TLS,
+ * pass the cork along.
+ */
+AWS_IO_API
+int aws_channel_slot_cork_writes(struct aws_channel_slot *slot);
+
+/**
+ * Undoes aws_channel_slot_cork_writes(), flushing any writes held back in the meantime.
+ */
+AWS_IO_API
+int aws_channel_slot_uncork_writes(struct aws_channel_slot *slot);
+
 /**
  * Convenience function that invokes aws_channel_acquire_message_from_pool(),
  * asking for the largest reasonable DATA message that can be sent in the write direction,
@@ -438,6 +702,36 @@ int aws_channel_handler_process_write_message(
     struct aws_channel_slot *slot,
     struct aws_io_message *message);
 
+/**
+ * Calls process_read_messages on handler's vtable, or process_read_message for each message in turn if the handler
+ * doesn't handle batches. Ownership follows aws_channel_slot_send_messages().
+ */
+AWS_IO_API
+int aws_channel_handler_process_read_messages(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    struct aws_linked_list *messages);
+
+/**
+ * Calls process_write_messages on handler's vtable, or process_write_message for each message in turn if the handler
+ * doesn't handle batches. Ownership follows aws_channel_slot_send_messages().
+ */
+AWS_IO_API
+int aws_channel_handler_process_write_messages(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    struct aws_linked_list *messages);
+
+/**
+ * Calls set_write_cork on handler's vtable, or passes the call on to the handler to the left of slot if handler
+ * doesn't implement it.
+ */
+AWS_IO_API
+int aws_channel_handler_set_write_cork(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    bool corked);
+
 /**
  * Calls on_window_update on handler's vtable.
  */
@@ -66,6 +66,9 @@ struct aws_client_bootstrap {
     struct aws_ref_count ref_count;
     aws_client_bootstrap_shutdown_complete_fn *on_shutdown_complete;
     void *user_data;
+    /* one per event loop, see aws_client_bootstrap_enable_channel_recycling() */
+    struct aws_channel_recycler **channel_recyclers;
+    size_t channel_recycler_count;
 };
 
 /**
@@ -146,6 +149,9 @@ struct aws_server_bootstrap {
     struct aws_event_loop_group *event_loop_group;
     aws_channel_on_protocol_negotiated_fn *on_protocol_negotiated;
     struct aws_ref_count ref_count;
+    /* one per event loop, see aws_server_bootstrap_enable_channel_recycling() */
+    struct aws_channel_recycler **channel_recyclers;
+    size_t channel_recycler_count;
 };
 
 /**
@@ -163,6 +169,14 @@ struct aws_server_bootstrap {
  * setup_callback - callback invoked once the channel is ready for use and TLS has been negotiated or if an error
  *   is encountered
  * shutdown_callback - callback invoked once the channel has shutdown.
+ * max_fragment_size - (optional) max fragment size of the new channel, see aws_channel_options. 0 means
+ *   g_aws_channel_max_fragment_size.
+ * write_high_water_mark, write_low_water_mark - (optional) write back pressure for the new channel, see
+ *   aws_channel_options.
+ * enable_read_window_auto_tuning, max_read_window_size - (optional) read window auto-tuning for the new channel, see
+ *   aws_channel_options.
+ * channel_arena_size - (optional) arena_size of the new channel, see aws_channel_options. The bootstrap creates the
+ *   channel's socket, TLS and ALPN handlers from its arena.
  *
  * Immediately after the `shutdown_callback` returns, the channel is cleaned up automatically. All callbacks are invoked
  * in the thread of the event-loop that the new channel is assigned to.
@@ -178,6 +192,12 @@ struct aws_socket_channel_bootstrap_options {
     aws_client_bootstrap_on_channel_event_fn *setup_callback;
     aws_client_bootstrap_on_channel_event_fn *shutdown_callback;
     bool enable_read_back_pressure;
+    size_t max_fragment_size;
+    size_t write_high_water_mark;
+    size_t write_low_water_mark;
+    bool enable_read_window_auto_tuning;
+    size_t max_read_window_size;
+    size_t channel_arena_size;
     void *user_data;
 };
 
@@ -195,6 +215,11 @@ struct aws_socket_channel_bootstrap_options {
  *
  * The socket type in `options` must be AWS_SOCKET_STREAM if tls_options is set.
  * DTLS is not currently supported for tls.
+ *
+ * `max_fragment_size` optionally sets the max fragment size of each incoming channel, `write_high_water_mark`
+ * and `write_low_water_mark` its write back pressure, `enable_read_window_auto_tuning` and
+ * `max_read_window_size` its read window auto-tuning, and `channel_arena_size` its arena, from which the bootstrap
+ * creates its socket, TLS and ALPN handlers, see aws_channel_options.
  */
 struct aws_server_socket_channel_bootstrap_options {
     struct aws_server_bootstrap *bootstrap;
@@ -206,6 +231,12 @@ struct aws_server_socket_channel_bootstrap_options {
     aws_server_bootstrap_on_accept_channel_shutdown_fn *shutdown_callback;
     aws_server_bootstrap_on_server_listener_destroy_fn *destroy_callback;
     bool enable_read_back_pressure;
+    size_t max_fragment_size;
+    size_t write_high_water_mark;
+    size_t write_low_water_mark;
+    bool enable_read_window_auto_tuning;
+    size_t max_read_window_size;
+    size_t channel_arena_size;
     void *user_data;
 };
 
@@ -238,6 +269,17 @@ AWS_IO_API int aws_client_bootstrap_set_alpn_callback(
     struct aws_client_bootstrap *bootstrap,
     aws_channel_on_protocol_negotiated_fn *on_protocol_negotiated);
 
+/**
+ * Makes the bootstrap's channels recycle their memory: each event loop keeps up to channels_per_loop closed channels
+ * around, which new channels on that loop reuse, see aws_channel_recycler_new(). Combine it with channel_arena_size so
+ * the recycled memory covers the channel's slots and handlers as well. TLS handlers on these channels also reuse their
+ * TLS connections where the implementation supports it. Call this before the bootstrap makes any connections; it can
+ * only be called once.
+ */
+AWS_IO_API int aws_client_bootstrap_enable_channel_recycling(
+    struct aws_client_bootstrap *bootstrap,
+    size_t channels_per_loop);
+
 /**
  * Sets up a client socket channel.
  */
@@ -271,6 +313,14 @@ AWS_IO_API int aws_server_bootstrap_set_alpn_callback(
     struct aws_server_bootstrap *bootstrap,
     aws_channel_on_protocol_negotiated_fn *on_protocol_negotiated);
 
+/**
+ * Makes the bootstrap's incoming channels recycle their memory, see aws_client_bootstrap_enable_channel_recycling().
+ * Call this before creating any socket listeners; it can only be called once.
+ */
+AWS_IO_API int aws_server_bootstrap_enable_channel_recycling(
+    struct aws_server_bootstrap *bootstrap,
+    size_t channels_per_loop);
+
 /**
  * Sets up a server socket listener. If you are planning on using TLS, use
  * `aws_server_bootstrap_new_tls_socket_listener` instead. This creates a socket listener bound to `local_endpoint`
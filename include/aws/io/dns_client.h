@@ -0,0 +1,98 @@
+#ifndef AWS_IO_DNS_CLIENT_H
+#define AWS_IO_DNS_CLIENT_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/io/io.h>
+
+#include <aws/io/socket.h>
+
+struct aws_array_list;
+struct aws_dns_client;
+struct aws_event_loop_group;
+struct aws_string;
+
+/**
+ * Invoked once per aws_dns_client_resolve() call, from an event loop thread of the client's group. On success,
+ * addresses holds struct aws_host_address (by-value), A and AAAA records together. They're cleaned up when the
+ * callback returns, so copy whatever you want to keep.
+ */
+typedef void(aws_dns_client_on_resolved_fn)(
+    struct aws_dns_client *client,
+    const struct aws_string *host_name,
+    int error_code,
+    const struct aws_array_list *addresses,
+    void *user_data);
+
+struct aws_dns_client_options {
+    /* queries run on this group's event loops. Required. */
+    struct aws_event_loop_group *el_group;
+
+    /* where to read nameservers and resolver options from. Defaults to /etc/resolv.conf */
+    const char *resolv_conf_path;
+
+    /* where to look up static host entries. Defaults to /etc/hosts */
+    const char *hosts_path;
+
+    /* If set, these are queried (in order, port included) instead of the nameservers in resolv.conf. */
+    const struct aws_socket_endpoint *nameservers;
+    size_t nameserver_count;
+
+    /* How long to wait for each nameserver to answer. 0 means use resolv.conf's "options timeout:", or 5 seconds. */
+    uint32_t timeout_ms;
+
+    /* How many times to go around the nameserver list. 0 means use resolv.conf's "options attempts:", or 2. */
+    uint32_t attempts;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Creates a stub resolver that speaks DNS itself, over UDP (falling back to TCP for truncated answers) on event loop
+ * sockets, instead of blocking a thread in getaddrinfo(). Names are looked up in the hosts file first; otherwise A and
+ * AAAA queries go out in parallel, moving on to the next nameserver on timeout or failure. Each returned address's
+ * expiry is derived from its record's TTL.
+ *
+ * Names are queried as given: resolv.conf's search and domain lists are not applied.
+ *
+ * Configuration files are read once, here. Only available on POSIX platforms.
+ */
+AWS_IO_API
+struct aws_dns_client *aws_dns_client_new(struct aws_allocator *allocator, const struct aws_dns_client_options *options);
+
+AWS_IO_API
+struct aws_dns_client *aws_dns_client_acquire(struct aws_dns_client *client);
+
+/**
+ * Releases a reference. Resolves in flight hold their own reference, so the client goes away once the last of them
+ * completes.
+ */
+AWS_IO_API
+void aws_dns_client_release(struct aws_dns_client *client);
+
+/**
+ * Starts resolving host_name. on_resolved is always invoked asynchronously, unless this call fails.
+ */
+AWS_IO_API
+int aws_dns_client_resolve(
+    struct aws_dns_client *client,
+    const struct aws_string *host_name,
+    aws_dns_client_on_resolved_fn *on_resolved,
+    void *user_data);
+
+/**
+ * An aws_resolve_host_implementation_fn for the default host resolver: pass the client as impl_data. The calling
+ * resolver thread only waits on a condition variable while the query runs on the event loop. Never call it from one of
+ * the client's event loop threads.
+ */
+AWS_IO_API
+int aws_dns_client_resolve_host(
+    struct aws_allocator *allocator,
+    const struct aws_string *host_name,
+    struct aws_array_list *output_addresses,
+    void *user_data);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_IO_DNS_CLIENT_H */
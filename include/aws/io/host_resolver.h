@@ -59,6 +59,10 @@ typedef void(aws_on_host_resolved_result_fn)(
  * Function signature for configuring your own resolver (the default just uses getaddrinfo()). The type in
  * output_addresses is struct aws_host_address (by-value). We assume this function blocks, hence this absurdly
  * complicated design.
+ *
+ * If the implementation knows the records' TTLs, it can set each address's expiry to when its record expires, as a
+ * system clock timestamp in nanoseconds. The default resolver honors it, up to max_ttl. An expiry of 0 means unknown,
+ * and max_ttl is used.
  */
 typedef int(aws_resolve_host_implementation_fn)(
     struct aws_allocator *allocator,
@@ -106,6 +110,12 @@ struct aws_host_resolver_vtable {
 
     /** removes a host listener from the host resolver and frees it. */
     int (*remove_host_listener)(struct aws_host_resolver *resolver, struct aws_host_listener *listener);
+
+    /** writes what you have cached to a file at path. Optional. */
+    int (*save_cache)(struct aws_host_resolver *resolver, const char *path);
+
+    /** warms your cache from a file written by save_cache. Optional. */
+    int (*load_cache)(struct aws_host_resolver *resolver, const char *path);
 };
 
 struct aws_host_resolver {
@@ -121,6 +131,19 @@ struct aws_host_resolver_default_options {
     struct aws_event_loop_group *el_group;
     const struct aws_shutdown_callback_options *shutdown_options;
     aws_io_clock_fn *system_clock_override_fn;
+
+    /*
+     * If non-zero, host entries don't get a thread each. Instead this many worker threads resolve them, as a single
+     * scheduler thread hands out entries that are due for a refresh. Caching and listener behavior are unchanged.
+     */
+    size_t resolver_thread_pool_size;
+
+    /*
+     * If non-zero, addresses may be served for up to this many seconds past their expiry while they are re-resolved
+     * in the background: through DNS outages, and for hosts whose entries were retired for lack of queries, whose next
+     * query is then answered straight away instead of waiting on DNS.
+     */
+    size_t max_stale_secs;
 };
 
 AWS_EXTERN_C_BEGIN
@@ -161,12 +184,19 @@ AWS_IO_API int aws_default_dns_resolve(
  * take a little while in the background thread to fetch more, evaluate TTLs etc... In that case your callback will be
  * invoked from the background thread.
  *
+ * Processes that talk to hundreds of hosts can set resolver_thread_pool_size in the options to bound the number of
+ * threads: entries are then resolved by that many shared workers, and callbacks are invoked from one of those.
+ *
  * --------------------------------------------------------------------------------------------------------------------
  *
  * A few things to note about TTLs and connection failures.
  *
  * We attempt to honor your max ttl but will not honor it if dns queries are failing or all of your connections are
- * marked as failed. Once we are able to query dns again, we will re-evaluate the TTLs.
+ * marked as failed. Once we are able to query dns again, we will re-evaluate the TTLs. Addresses whose records have a
+ * shorter TTL (if the resolve implementation reports it) expire with their records instead.
+ *
+ * With max_stale_secs set, expired addresses keep being served while the background refresh runs, and a host that
+ * comes back after its entry retired is answered right away from its last known addresses.
  *
  * Upon notification connection failures, we move them to a separate list. Eventually we retry them when it's likely
  * that the endpoint is healthy again or we don't really have another choice, but we try to keep them out of your
@@ -219,6 +249,25 @@ AWS_IO_API int aws_host_resolver_record_connection_failure(
  */
 AWS_IO_API int aws_host_resolver_purge_cache(struct aws_host_resolver *resolver);
 
+/**
+ * calls save_cache on the vtable, or fails with AWS_ERROR_UNSUPPORTED_OPERATION if it has none.
+ *
+ * The default resolver writes every host it has addresses for, with their expiries and connection failure counts, to a
+ * compact binary file. Load it into a new resolver with aws_host_resolver_load_cache() to start warm. The file is
+ * written to `<path>.tmp` and renamed over path, so a failed save leaves the previous cache intact.
+ */
+AWS_IO_API int aws_host_resolver_save_cache(struct aws_host_resolver *resolver, const char *path);
+
+/**
+ * calls load_cache on the vtable, or fails with AWS_ERROR_UNSUPPORTED_OPERATION if it has none.
+ *
+ * The default resolver answers the first query for each host in the file straight away with its saved addresses
+ * (if they haven't expired, or are within max_stale_secs of expiring) while it resolves the host in the background.
+ * Hosts that are already cached are left alone. A file that fails to parse, e.g. because it was truncated while being
+ * saved, fails with AWS_IO_FILE_VALIDATION_FAILURE and loads nothing.
+ */
+AWS_IO_API int aws_host_resolver_load_cache(struct aws_host_resolver *resolver, const char *path);
+
 /**
  * get number of addresses for a given host.
  */
@@ -25,6 +25,7 @@ enum aws_io_message_type {
 };
 
 struct aws_io_message;
+struct aws_io_slice_chain;
 struct aws_channel;
 
 typedef void(aws_channel_on_message_write_completed_fn)(
@@ -82,6 +83,14 @@ struct aws_io_message {
      * go ahead and make sure the list info is part of the original allocation.
      */
     struct aws_linked_list_node queueing_handle;
+
+    /**
+     * For scatter-gather messages, the chain of buffer slices holding the payload, and message_data is empty.
+     * NULL for ordinary messages. See aws_io_message_new_sliced() in aws/io/io_slice.h.
+     * Only the socket handler writes sliced messages; the TLS handlers fail them with
+     * AWS_IO_CHANNEL_UNKNOWN_MESSAGE_TYPE rather than send an empty payload.
+     */
+    struct aws_io_slice_chain *slices;
 };
 
 typedef int(aws_io_clock_fn)(uint64_t *timestamp);
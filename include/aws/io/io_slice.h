@@ -0,0 +1,109 @@
+#ifndef AWS_IO_IO_SLICE_H
+#define AWS_IO_IO_SLICE_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/common/atomics.h>
+#include <aws/common/byte_buf.h>
+#include <aws/common/linked_list.h>
+#include <aws/io/io.h>
+
+/**
+ * A refcounted block of memory. Slices reference ranges of it, so payloads can be framed, split and forwarded down a
+ * channel without being copied. The memory is freed when the last reference goes away.
+ */
+struct aws_io_buffer {
+    struct aws_allocator *allocator;
+    struct aws_atomic_var ref_count;
+    /* the buffer's memory, filled in by whoever created it. Don't modify once slices reference it. */
+    struct aws_byte_buf data;
+};
+
+/**
+ * A range of an aws_io_buffer, holding a reference to it.
+ */
+struct aws_io_slice {
+    struct aws_io_buffer *buffer;
+    struct aws_byte_cursor cursor;
+    struct aws_linked_list_node node;
+};
+
+/**
+ * An ordered chain of slices. Scatter-gather messages carry their payload in one of these, see
+ * aws_io_message_new_sliced().
+ */
+struct aws_io_slice_chain {
+    struct aws_allocator *allocator;
+    struct aws_linked_list slices;
+    size_t slice_count;
+    /* total bytes across all slices */
+    size_t len;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Creates a buffer with room for capacity bytes and a reference count of 1.
+ */
+AWS_IO_API
+struct aws_io_buffer *aws_io_buffer_new(struct aws_allocator *allocator, size_t capacity);
+
+AWS_IO_API
+struct aws_io_buffer *aws_io_buffer_acquire(struct aws_io_buffer *buffer);
+
+AWS_IO_API
+void aws_io_buffer_release(struct aws_io_buffer *buffer);
+
+AWS_IO_API
+void aws_io_slice_chain_init(struct aws_io_slice_chain *chain, struct aws_allocator *allocator);
+
+/**
+ * Releases every slice in the chain, and with them the chain's references to their buffers.
+ */
+AWS_IO_API
+void aws_io_slice_chain_clean_up(struct aws_io_slice_chain *chain);
+
+/**
+ * Adds a slice referencing range to the end of the chain. range must lie within buffer->data.
+ */
+AWS_IO_API
+int aws_io_slice_chain_append(
+    struct aws_io_slice_chain *chain,
+    struct aws_io_buffer *buffer,
+    struct aws_byte_cursor range);
+
+/**
+ * Adds a slice referencing range to the front of the chain, e.g. a frame header. range must lie within buffer->data.
+ */
+AWS_IO_API
+int aws_io_slice_chain_prepend(
+    struct aws_io_slice_chain *chain,
+    struct aws_io_buffer *buffer,
+    struct aws_byte_cursor range);
+
+/**
+ * Moves every slice of src to the end of dest, leaving src empty. Both chains must share an allocator.
+ */
+AWS_IO_API
+void aws_io_slice_chain_move(struct aws_io_slice_chain *dest, struct aws_io_slice_chain *src);
+
+/**
+ * Moves everything past the first `offset` bytes of chain to the end of tail. A slice straddling the offset is split
+ * in two, both halves referencing the same buffer. Fails with AWS_ERROR_INVALID_ARGUMENT if offset is past the end of
+ * the chain.
+ */
+AWS_IO_API
+int aws_io_slice_chain_split(struct aws_io_slice_chain *chain, size_t offset, struct aws_io_slice_chain *tail);
+
+/**
+ * Creates an application data message whose payload is a slice chain, pointed to by message->slices. message_data is
+ * left empty. The chain is cleaned up along with the message, when it's released via aws_mem_release() on
+ * message->allocator like any other message.
+ */
+AWS_IO_API
+struct aws_io_message *aws_io_message_new_sliced(struct aws_allocator *allocator);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_IO_IO_SLICE_H */
@@ -5,31 +5,101 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 #include <aws/common/array_list.h>
+#include <aws/common/linked_list.h>
 #include <aws/io/io.h>
 
+/**
+ * Fixed-size segments carved out of larger slabs. The pool grows a slab at a time as demand rises, up to
+ * max_segment_count, and hands slabs that sit entirely unused back to the allocator once demand drops.
+ * Segments beyond max_segment_count are allocated and freed individually.
+ */
 struct aws_memory_pool {
     struct aws_allocator *alloc;
+    /* free segments, most recently released at the back */
     struct aws_array_list stack;
+    /* segments that are always kept, even when idle */
     uint16_t ideal_segment_count;
     size_t segment_size;
+    /* unused, segments live in slabs now */
     void *data_ptr;
+    /* slab memory comes from here, e.g. an allocator backed by huge pages */
+    struct aws_allocator *slab_alloc;
+    struct aws_linked_list slabs;
+    /* high-water mark on segments held in slabs, 0 for no limit */
+    size_t max_segment_count;
+    size_t segments_per_slab;
+    size_t slab_segment_count;
+    size_t outstanding;
+    size_t peak_outstanding;
+    size_t ops_since_trim;
+    uint64_t hits;
+    uint64_t misses;
+    /* misses served by an individual allocation, because the pool was at max_segment_count or couldn't add a slab */
+    uint64_t fallbacks;
 };
 
+struct aws_memory_pool_options {
+    /* allocator for bookkeeping, and for slabs if slab_alloc is NULL */
+    struct aws_allocator *alloc;
+    struct aws_allocator *slab_alloc;
+    size_t segment_size;
+    /* segments allocated up front and never trimmed */
+    uint16_t min_segment_count;
+    /* high-water mark on pooled segments, 0 for no limit */
+    size_t max_segment_count;
+    /* bytes per slab, 0 for the default of 64KB. Slabs always hold at least one segment. */
+    size_t slab_size;
+};
+
+struct aws_message_pool_statistics {
+    /* acquisitions served by an already pooled message */
+    uint64_t hits;
+    /* acquisitions that had to allocate, either to grow the pool or because it was at its high-water mark */
+    uint64_t misses;
+    /* messages currently acquired and not yet released */
+    size_t outstanding;
+    /* bytes held in slabs, in use or not */
+    size_t bytes_reserved;
+    /* misses served by an individual allocation outside the pool's slabs, a sign of real memory pressure */
+    uint64_t fallbacks;
+};
+
+/* the small block and application data pools, plus up to four additional size classes */
+#define AWS_MESSAGE_POOL_MAX_SIZE_CLASSES 6
+
 struct aws_message_pool {
     struct aws_allocator *alloc;
-    struct aws_memory_pool application_data_pool;
-    struct aws_memory_pool small_block_pool;
+    /* one pool per message data size, ordered from smallest to largest with duplicate sizes removed */
+    struct aws_memory_pool size_classes[AWS_MESSAGE_POOL_MAX_SIZE_CLASSES];
+    size_t size_class_count;
 };
 
 struct aws_message_pool_creation_args {
     size_t application_data_msg_data_size;
+    /* messages of each application data size class kept even when idle */
     uint8_t application_data_msg_count;
     size_t small_block_msg_data_size;
     uint8_t small_block_msg_count;
+    /**
+     * Additional message data sizes to pool messages for, so that channels with different fragment sizes can share
+     * one message pool. Nothing is allocated for these up front: each one fills only as messages of its size are
+     * used, and is trimmed back to empty once they're no longer needed. Zero entries are ignored.
+     */
+    size_t additional_msg_data_sizes[AWS_MESSAGE_POOL_MAX_SIZE_CLASSES - 2];
+    /**
+     * High-water mark on the memory each size class holds in slabs, 0 for no limit. Demand beyond it is served by
+     * individual allocations.
+     */
+    size_t max_bytes_per_size_class;
+    /* (optional) allocator for slab memory, e.g. one backed by huge pages. Defaults to the pool's allocator. */
+    struct aws_allocator *slab_allocator;
 };
 
 AWS_EXTERN_C_BEGIN
 
+/**
+ * Initializes a pool that keeps at least ideal_segment_count segments of segment_size bytes and grows without limit.
+ */
 AWS_IO_API
 int aws_memory_pool_init(
     struct aws_memory_pool *mempool,
@@ -37,6 +107,9 @@ int aws_memory_pool_init(
     uint16_t ideal_segment_count,
     size_t segment_size);
 
+AWS_IO_API
+int aws_memory_pool_init_from_options(struct aws_memory_pool *mempool, const struct aws_memory_pool_options *options);
+
 AWS_IO_API
 void aws_memory_pool_clean_up(struct aws_memory_pool *mempool);
 
@@ -67,6 +140,7 @@ void aws_message_pool_clean_up(struct aws_message_pool *msg_pool);
 /**
  * Acquires a message from the pool if available, otherwise, it attempts to allocate. If a message is acquired,
  * note that size_hint is just a hint. the return value's capacity will be set to the actual buffer size.
+ * The message comes from the smallest size class that fits size_hint, or from the largest one if none do.
  */
 AWS_IO_API
 struct aws_io_message *aws_message_pool_acquire(
@@ -81,6 +155,14 @@ struct aws_io_message *aws_message_pool_acquire(
 AWS_IO_API
 void aws_message_pool_release(struct aws_message_pool *msg_pool, struct aws_io_message *message);
 
+/**
+ * Sums hit, miss and outstanding counts across all of the pool's size classes.
+ */
+AWS_IO_API
+void aws_message_pool_get_statistics(
+    const struct aws_message_pool *msg_pool,
+    struct aws_message_pool_statistics *stats);
+
 AWS_EXTERN_C_END
 
 #endif /* AWS_IO_MESSAGE_POOL_H */
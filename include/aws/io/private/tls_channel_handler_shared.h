@@ -34,6 +34,12 @@ AWS_IO_API void aws_on_tls_negotiation_completed(
     struct aws_tls_channel_handler_shared *tls_handler_shared,
     int error_code);
 
+/**
+ * Returns the number of distinct certificate and key pairs currently held by the process-wide credential cache. Used
+ * by tests to verify that contexts share parsed credentials. Only implemented with s2n.
+ */
+AWS_IO_API size_t aws_tls_credential_cache_entry_count(void);
+
 AWS_EXTERN_C_END
 
 #endif /* AWS_IO_TLS_CHANNEL_HANDLER_SHARED_H */
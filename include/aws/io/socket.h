@@ -265,6 +265,19 @@ AWS_IO_API int aws_socket_subscribe_to_readable_events(
  */
 AWS_IO_API int aws_socket_read(struct aws_socket *socket, struct aws_byte_buf *buffer, size_t *amount_read);
 
+/**
+ * Like aws_socket_read(), but scatters the data across buffer_count buffers, filling each from `len` to `capacity`
+ * before moving on to the next, with a single vectored read where the platform supports it. Each buffer's `len` is
+ * updated to reflect what was read into it, and `amount_read` is the total.
+ *
+ * NOTE! This function must be called from the event-loop used in aws_socket_assign_to_event_loop
+ */
+AWS_IO_API int aws_socket_readv(
+    struct aws_socket *socket,
+    struct aws_byte_buf *buffers,
+    size_t buffer_count,
+    size_t *amount_read);
+
 /**
  * Writes to the socket. This call is non-blocking and will attempt to write as much as it can, but will queue any
  * remaining portion of the data for write when available. written_fn will be invoked once the entire cursor has been
@@ -282,6 +295,18 @@ AWS_IO_API int aws_socket_write(
     aws_socket_on_write_completed_fn *written_fn,
     void *user_data);
 
+/**
+ * Like aws_socket_write(), but writes cursor_count cursors back to back, with a single vectored send where the
+ * platform supports it. The cursors array is copied, but the memory it points to must stay valid until written_fn is
+ * invoked. written_fn is invoked once, after all of the cursors have been written.
+ */
+AWS_IO_API int aws_socket_writev(
+    struct aws_socket *socket,
+    const struct aws_byte_cursor *cursors,
+    size_t cursor_count,
+    aws_socket_on_write_completed_fn *written_fn,
+    void *user_data);
+
 /**
  * Gets the latest error from the socket. If no error has occurred AWS_OP_SUCCESS will be returned. This function does
  * not raise any errors to the installed error handlers.
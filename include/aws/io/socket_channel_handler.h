@@ -15,8 +15,10 @@ struct aws_event_loop;
 AWS_EXTERN_C_BEGIN
 /**
  * Socket handlers should be the first slot/handler in a channel. It interacts directly with the channel's event loop
- * for read and write notifications. max_read_size is the maximum amount of data it will read from the socket
- * before a context switch (a continuation task will be scheduled).
+ * for read and write notifications. The amount of data it will read from the socket before a context switch (a
+ * continuation task will be scheduled) adapts to the load on its event loop: the sockets on a loop that keep
+ * having more to read share a per-tick budget, which shrinks when the loop's ticks get slow and grows while they're
+ * fast. max_read_size scales a socket's share, which stays between a quarter of it and 16 times it.
  */
 AWS_IO_API struct aws_channel_handler *aws_socket_handler_new(
     struct aws_allocator *allocator,
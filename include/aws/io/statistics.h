@@ -14,6 +14,7 @@
 enum aws_crt_io_statistics_category {
     AWSCRT_STAT_CAT_SOCKET = AWS_CRT_STATISTICS_CATEGORY_BEGIN_RANGE(AWS_C_IO_PACKAGE_ID),
     AWSCRT_STAT_CAT_TLS,
+    AWSCRT_STAT_CAT_CHANNEL,
 };
 
 /**
@@ -23,6 +24,12 @@ struct aws_crt_statistics_socket {
     aws_crt_statistics_category_t category;
     uint64_t bytes_read;
     uint64_t bytes_written;
+    /* the most the socket may currently read per event loop tick, adapted to its event loop's load */
+    uint64_t read_budget;
+    /* number of times the socket used up its read budget and had to yield with data still pending */
+    uint32_t read_budget_exhausted_count;
+    /* number of writes handed to the socket. A batch of messages sent in one vectored write counts once. */
+    uint32_t write_requests;
 };
 
 /**
@@ -33,6 +40,44 @@ struct aws_crt_statistics_tls {
     uint64_t handshake_start_ns;
     uint64_t handshake_end_ns;
     enum aws_tls_negotiation_status handshake_status;
+    /* true if the handshake resumed a previous session instead of performing a full handshake */
+    bool session_resumed;
+
+    /* Handshake breakdown, calculated once the handshake completes */
+    /*
+     * number of times the handshake stopped because it needed more data from the peer. This approximates, but is not
+     * the same as, the number of network round trips: a flight split across several reads counts once per read.
+     */
+    uint32_t handshake_read_waits;
+    uint64_t handshake_bytes_sent;
+    uint64_t handshake_bytes_received;
+    /* IANA cipher suite value, e.g. 0xC02F for TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256 */
+    uint16_t cipher_suite;
+    /* AWS_IO_TLS_VER_SYS_DEFAULTS until the handshake completes */
+    enum aws_tls_versions protocol_version;
+    /* time spent in handshake private key operations. Only measured when handshake offload is enabled. */
+    uint64_t private_key_op_ns;
+
+    /* Per-interval counters, cleared by aws_crt_statistics_tls_reset */
+    uint64_t records_encrypted;
+    uint64_t bytes_encrypted;
+    uint64_t records_decrypted;
+    uint64_t bytes_decrypted;
+    uint32_t blocked_on_read_count;
+    uint32_t blocked_on_write_count;
+};
+
+/**
+ * Channel statistics record, reported by the channel itself ahead of its handlers' records
+ */
+struct aws_crt_statistics_channel {
+    aws_crt_statistics_category_t category;
+    /* read window granted to the channel's last handler, SIZE_MAX if read back pressure is off */
+    uint64_t read_window_size;
+
+    /* Per-interval counters, cleared by aws_crt_statistics_channel_reset */
+    uint32_t read_window_grow_count;
+    uint32_t read_window_shrink_count;
 };
 
 AWS_EXTERN_C_BEGIN
@@ -73,6 +118,24 @@ void aws_crt_statistics_tls_cleanup(struct aws_crt_statistics_tls *stats);
 AWS_IO_API
 void aws_crt_statistics_tls_reset(struct aws_crt_statistics_tls *stats);
 
+/**
+ * Initializes channel statistics
+ */
+AWS_IO_API
+int aws_crt_statistics_channel_init(struct aws_crt_statistics_channel *stats);
+
+/**
+ * Cleans up channel statistics
+ */
+AWS_IO_API
+void aws_crt_statistics_channel_cleanup(struct aws_crt_statistics_channel *stats);
+
+/**
+ * Resets channel statistics for the next gather interval.  The current read window is left alone.
+ */
+AWS_IO_API
+void aws_crt_statistics_channel_reset(struct aws_crt_statistics_channel *stats);
+
 AWS_EXTERN_C_END
 
 #endif /* AWS_IO_STATISTICS_H */
@@ -21,6 +21,18 @@ enum aws_tls_versions {
     AWS_IO_TLS_VER_SYS_DEFAULTS = 128,
 };
 
+/**
+ * Outcome of TLS 1.3 early data (0-RTT) for a connection, known once negotiation completes.
+ */
+enum aws_tls_early_data_status {
+    /* early data was not attempted, e.g. there was no resumable session or it isn't enabled */
+    AWS_IO_TLS_EARLY_DATA_NOT_REQUESTED,
+    /* the server processed the early data */
+    AWS_IO_TLS_EARLY_DATA_ACCEPTED,
+    /* the server discarded the early data. Clients resend it automatically once the handshake completes. */
+    AWS_IO_TLS_EARLY_DATA_REJECTED,
+};
+
 enum aws_tls_cipher_pref {
     AWS_IO_TLS_CIPHER_PREF_SYSTEM_DEFAULT = 0,
     AWS_IO_TLS_CIPHER_PREF_KMS_PQ_TLSv1_0_2019_06 = 1,
@@ -32,6 +44,24 @@ enum aws_tls_cipher_pref {
     AWS_IO_TLS_CIPHER_PREF_END_RANGE = 0xFFFF
 };
 
+/**
+ * Controls how large the TLS records produced for application data are.
+ */
+enum aws_tls_record_size_policy {
+    /** Use whatever the underlying TLS implementation does by default. */
+    AWS_IO_TLS_RECORD_SIZE_DEFAULT,
+    /** Always send records small enough to fit in a single network packet. Best for interactive traffic. */
+    AWS_IO_TLS_RECORD_SIZE_LOW_LATENCY,
+    /** Always send maximum-size records. Best for bulk transfer. */
+    AWS_IO_TLS_RECORD_SIZE_THROUGHPUT,
+    /**
+     * Start with small records so the first bytes can be decrypted as soon as they arrive, then switch to
+     * maximum-size records once dynamic_record_resize_threshold bytes have been sent. The connection drops back to
+     * small records after being idle for dynamic_record_idle_timeout_secs.
+     */
+    AWS_IO_TLS_RECORD_SIZE_DYNAMIC,
+};
+
 struct aws_tls_ctx {
     struct aws_allocator *alloc;
     void *impl;
@@ -90,6 +120,17 @@ struct aws_tls_connection_options {
     struct aws_tls_ctx *ctx;
     bool advertise_alpn_message;
     uint32_t timeout_ms;
+    /**
+     * Port of the remote endpoint. Together with server_name this keys the client session resumption cache. The
+     * client bootstrap fills this in from the connection's port if it is left as 0.
+     */
+    uint16_t port;
+    /**
+     * Opts this connection in to TLS 1.3 early data, see max_early_data_size on aws_tls_ctx_options. Early data can be
+     * replayed by an attacker. Clients should only set this when everything written before the handshake completes is
+     * idempotent, and servers only when the application tolerates replayed requests.
+     */
+    bool early_data_replay_safe;
 };
 
 struct aws_tls_ctx_options {
@@ -164,6 +205,90 @@ struct aws_tls_ctx_options {
     /** max tls fragment size. Default is the value of g_aws_channel_max_fragment_size. */
     size_t max_fragment_size;
 
+    /**
+     * If non-zero, small application writes are buffered and encrypted together so that they go out as full TLS
+     * records instead of one record per write. Buffered data is flushed once this many bytes are pending, once
+     * write_coalescing_max_delay_ms has elapsed, or when aws_tls_handler_flush() is called. Writes at least this
+     * large bypass the buffer. Default is 0 (disabled). Currently only honored by s2n.
+     */
+    size_t write_coalescing_threshold;
+
+    /**
+     * Upper bound on how long a coalesced write may sit in the buffer. 0 means buffered writes are flushed at the end
+     * of the current event-loop tick. Only used when write_coalescing_threshold is non-zero.
+     */
+    uint32_t write_coalescing_max_delay_ms;
+
+    /**
+     * Record sizing policy for application data. Default is AWS_IO_TLS_RECORD_SIZE_DEFAULT. Currently only honored by
+     * s2n.
+     */
+    enum aws_tls_record_size_policy record_size_policy;
+
+    /**
+     * Only used with AWS_IO_TLS_RECORD_SIZE_DYNAMIC. Number of bytes to send in small records before ramping up to
+     * maximum-size records. 0 selects a default of 1MB.
+     */
+    uint32_t dynamic_record_resize_threshold;
+
+    /**
+     * Only used with AWS_IO_TLS_RECORD_SIZE_DYNAMIC. Seconds of idle time after which the connection goes back to small
+     * records. 0 selects a default of 1 second.
+     */
+    uint16_t dynamic_record_idle_timeout_secs;
+
+    /**
+     * In client mode, remembers the session state negotiated with each server name and port on the aws_tls_ctx and
+     * offers it on the next connection to the same endpoint, skipping the full handshake when the server accepts it.
+     * The cache is shared by every connection made with the ctx, across event loops.
+     *
+     * In server mode, issues session tickets so clients can resume. Ticket encryption keys for the next 24 key
+     * lifetimes are all generated when the ctx is created, and each takes over from the last after
+     * session_ticket_key_lifetime_secs. No keys are added later, so a ctx stops issuing tickets once the last one
+     * retires (after 48 hours with the default lifetime). Long-running servers should replace their ctx before then.
+     *
+     * Default is false. Currently only honored by s2n.
+     */
+    bool enable_session_resumption;
+
+    /**
+     * Client only. Maximum number of endpoints the session cache remembers; the least recently used is evicted first.
+     * 0 selects a default of 256.
+     */
+    size_t session_cache_max_entries;
+
+    /**
+     * Server only. How long each ticket key is used to issue new tickets before the next key takes over. Tickets stay
+     * decryptable for one more lifetime after their key is retired. 0 selects a default of 2 hours. The ctx only has
+     * keys for 24 lifetimes; see enable_session_resumption.
+     */
+    uint32_t session_ticket_key_lifetime_secs;
+
+    /**
+     * Number of worker threads the ctx starts for handshake private key operations (RSA/ECDSA signing and
+     * decryption). When non-zero, those operations run on the workers and their results are posted back to the
+     * channel's event loop, so a burst of full handshakes doesn't stall I/O on established connections.
+     *
+     * Default is 0, which runs them inline on the event loop. Currently only honored by s2n.
+     */
+    size_t handshake_offload_threads;
+
+    /**
+     * Maximum number of operations waiting for a handshake worker. Once the queue is full, further operations run
+     * inline on the event loop rather than adding unbounded latency. 0 selects a default of 64 per worker thread.
+     */
+    size_t handshake_offload_max_queued;
+
+    /**
+     * Maximum TLS 1.3 early data (0-RTT) size. In server mode, the most early data accepted on a resumed session, which
+     * is also advertised in session tickets. In client mode, the most that will be written before the handshake
+     * completes. Connections also have to opt in with early_data_replay_safe.
+     *
+     * Requires enable_session_resumption and a minimum_tls_version of AWS_IO_TLSv1_3. Default is 0 (disabled).
+     * Currently only honored by s2n.
+     */
+    uint32_t max_early_data_size;
+
     /**
      * default is true for clients and false for servers.
      * You should not change this default for clients unless
@@ -348,6 +473,51 @@ AWS_IO_API void aws_tls_ctx_options_set_minimum_tls_version(
     struct aws_tls_ctx_options *options,
     enum aws_tls_versions minimum_tls_version);
 
+/**
+ * Enables coalescing of small writes into full TLS records. See write_coalescing_threshold and
+ * write_coalescing_max_delay_ms on aws_tls_ctx_options. A threshold of 0 disables coalescing.
+ */
+AWS_IO_API void aws_tls_ctx_options_set_write_coalescing(
+    struct aws_tls_ctx_options *options,
+    size_t threshold,
+    uint32_t max_delay_ms);
+
+/**
+ * Sets the record sizing policy for application data. See aws_tls_record_size_policy.
+ */
+AWS_IO_API void aws_tls_ctx_options_set_record_size_policy(
+    struct aws_tls_ctx_options *options,
+    enum aws_tls_record_size_policy policy);
+
+/**
+ * Selects AWS_IO_TLS_RECORD_SIZE_DYNAMIC and sets its tuning knobs. Passing 0 for either value selects its default.
+ */
+AWS_IO_API void aws_tls_ctx_options_set_dynamic_record_sizing(
+    struct aws_tls_ctx_options *options,
+    uint32_t resize_threshold,
+    uint16_t idle_timeout_secs);
+
+/**
+ * Enables or disables TLS session resumption. See enable_session_resumption on aws_tls_ctx_options.
+ */
+AWS_IO_API void aws_tls_ctx_options_set_session_resumption(struct aws_tls_ctx_options *options, bool enabled);
+
+/**
+ * Runs handshake private key operations on a pool of worker_threads threads, queueing at most max_queued of them.
+ * See handshake_offload_threads on aws_tls_ctx_options. Passing 0 worker_threads disables offloading.
+ */
+AWS_IO_API void aws_tls_ctx_options_set_handshake_offload(
+    struct aws_tls_ctx_options *options,
+    size_t worker_threads,
+    size_t max_queued);
+
+/**
+ * Enables TLS 1.3 early data up to max_early_data_size bytes. See max_early_data_size on aws_tls_ctx_options.
+ */
+AWS_IO_API void aws_tls_ctx_options_set_max_early_data_size(
+    struct aws_tls_ctx_options *options,
+    uint32_t max_early_data_size);
+
 /**
  * Override the default trust store. ca_file is a buffer containing a PEM armored chain of trusted CA certificates.
  * ca_file is copied.
@@ -494,6 +664,14 @@ AWS_IO_API struct aws_tls_ctx *aws_tls_ctx_acquire(struct aws_tls_ctx *ctx);
  */
 AWS_IO_API void aws_tls_ctx_release(struct aws_tls_ctx *ctx);
 
+/**
+ * Certificate and private key pairs are parsed once per process and shared by every tls context created from the
+ * same contents, and the system trust store location is detected once at startup. Call this after rotating
+ * certificates or CA bundles on disk so that contexts created afterwards load everything fresh. Existing contexts keep
+ * the credentials they were created with. Currently only does anything with s2n.
+ */
+AWS_IO_API void aws_tls_reload_credential_cache(void);
+
 /**
  * Not necessary if you are installing more handlers into the channel, but if you just want to have TLS for arbitrary
  * data and use the channel handler directly, this function allows you to write data to the channel and have it
@@ -506,6 +684,12 @@ AWS_IO_API int aws_tls_handler_write(
     aws_channel_on_message_write_completed_fn *on_write_completed,
     void *completion_user_data);
 
+/**
+ * Immediately encrypts and sends any application data the handler has buffered for write coalescing. This is a no-op
+ * if nothing is buffered or the implementation does not coalesce writes. Must be called from the channel's thread.
+ */
+AWS_IO_API int aws_tls_handler_flush(struct aws_channel_handler *handler);
+
 /**
  * Returns a byte buffer by copy of the negotiated protocols. If there is no agreed upon protocol, len will be 0 and
  * buffer will be NULL.
@@ -517,6 +701,12 @@ AWS_IO_API struct aws_byte_buf aws_tls_handler_protocol(struct aws_channel_handl
  */
 AWS_IO_API struct aws_byte_buf aws_tls_handler_server_name(struct aws_channel_handler *handler);
 
+/**
+ * Returns whether TLS 1.3 early data was accepted. Only meaningful once negotiation has completed, e.g. from the
+ * on_negotiation_result callback.
+ */
+AWS_IO_API enum aws_tls_early_data_status aws_tls_handler_early_data_status(struct aws_channel_handler *handler);
+
 /********************************* Misc TLS related *********************************/
 
 /*
@@ -8,12 +8,15 @@
 #include <aws/common/atomics.h>
 #include <aws/common/clock.h>
 #include <aws/common/mutex.h>
+#include <aws/common/ref_count.h>
 
 #include <aws/io/event_loop.h>
 #include <aws/io/logging.h>
 #include <aws/io/message_pool.h>
 #include <aws/io/statistics.h>
 
+#include <inttypes.h>
+
 #if _MSC_VER
 #    pragma warning(disable : 4204) /* non-constant aggregate initializer */
 #endif
@@ -21,7 +24,11 @@
 static size_t s_message_pool_key = 0; /* Address of variable serves as key in hash table */
 
 enum {
+    KB_2 = 2 * 1024,
     KB_16 = 16 * 1024,
+    KB_64 = 64 * 1024,
+    KB_256 = 256 * 1024,
+    MB_4 = 4 * 1024 * 1024,
 };
 
 size_t g_aws_channel_max_fragment_size = KB_16;
@@ -49,8 +56,45 @@ struct shutdown_task {
     bool shutdown_immediately;
 };
 
+/*
+ * Channels created with an arena_size carry a bump allocator over the rest of their own allocation. Releasing memory
+ * into it is a no-op, except that the most recent allocation is rolled back so that short-lived acquire/release pairs
+ * don't use it up. It all goes away with the channel.
+ */
+struct channel_arena {
+    struct aws_allocator allocator;
+    struct aws_allocator *parent;
+    uint8_t *buffer;
+    size_t capacity;
+    size_t used;
+    /* offset of the most recent allocation, SIZE_MAX once it's been released */
+    size_t last;
+};
+
+struct aws_channel_recycler {
+    struct aws_allocator *allocator;
+    struct aws_ref_count ref_count;
+    size_t max_blocks;
+    struct aws_mutex lock;
+    /* recycled_channel_block nodes, protected by lock */
+    struct aws_linked_list blocks;
+    size_t block_count;
+};
+
+/* overlaid on the start of a deleted channel's memory while it waits in a recycler */
+struct recycled_channel_block {
+    struct aws_linked_list_node node;
+    struct aws_allocator *alloc;
+    size_t size;
+};
+
 struct aws_channel {
     struct aws_allocator *alloc;
+    /* the size of the allocation the channel lives at the start of, arena included */
+    size_t block_size;
+    struct aws_channel_recycler *recycler;
+    /* only set up when the channel was created with an arena_size */
+    struct channel_arena arena;
     struct aws_event_loop *loop;
     struct aws_channel_slot *first;
     struct aws_message_pool *msg_pool;
@@ -70,17 +114,50 @@ struct aws_channel {
         struct aws_linked_list list;
     } channel_thread_tasks;
     struct {
-        struct aws_mutex lock;
+        /*
+         * Lock-free MPSC queue: other threads push tasks onto this stack (newest first, linked through their node's
+         * next pointer), the channel's thread takes the whole stack at once. Set to s_cross_thread_tasks_closed once
+         * the channel has shut down, after which tasks scheduled from other threads are canceled on the spot.
+         */
+        struct aws_atomic_var head;
+        /* set by whichever thread schedules scheduling_task, cleared by scheduling_task before it drains the stack */
+        struct aws_atomic_var drain_pending;
+        /* tasks taken off the stack but not yet run, only touched from the channel's thread. */
         struct aws_linked_list list;
         struct aws_task scheduling_task;
+        /* guards shutdown_task, so only the first aws_channel_shutdown() call schedules it */
+        struct aws_mutex lock;
         struct shutdown_task shutdown_task;
-        bool is_channel_shut_down;
     } cross_thread_tasks;
 
+    size_t max_fragment_size;
     size_t window_update_batch_emit_threshold;
     struct aws_channel_task window_update_task;
     bool read_back_pressure_enabled;
     bool window_update_in_progress;
+
+    size_t write_high_water_mark;
+    size_t write_low_water_mark;
+    size_t pending_write_bytes;
+    bool writable;
+
+    /* read window granted to the last slot, see aws_channel_options. Only touched from the channel's thread. */
+    struct {
+        bool auto_tuning_enabled;
+        /* the last slot when its handler was set, NULL once it's removed */
+        struct aws_channel_slot *slot;
+        size_t window;
+        size_t min_window;
+        size_t max_window;
+        /* credit held back from the slot's next increments, after the window shrank */
+        size_t withheld;
+        /*
+         * this channel's message acquisitions the pool served by allocating outside its slabs, since the last update.
+         * The pool is shared with every channel on the loop, so its own counters can't say which channel is pressed.
+         */
+        uint64_t pool_fallbacks;
+    } read_window;
+    struct aws_crt_statistics_channel statistics;
 };
 
 struct channel_setup_args {
@@ -93,17 +170,30 @@ struct channel_setup_args {
 
 static void s_on_msg_pool_removed(struct aws_event_loop_local_object *object) {
     struct aws_message_pool *msg_pool = object->object;
+    struct aws_message_pool_statistics stats;
+    aws_message_pool_get_statistics(msg_pool, &stats);
     AWS_LOGF_TRACE(
         AWS_LS_IO_CHANNEL,
         "static: message pool %p has been purged "
-        "from the event-loop: likely because of shutdown",
-        (void *)msg_pool);
+        "from the event-loop: likely because of shutdown. "
+        "Lifetime hits %" PRIu64 ", misses %" PRIu64 ", outstanding %zu.",
+        (void *)msg_pool,
+        stats.hits,
+        stats.misses,
+        stats.outstanding);
     struct aws_allocator *alloc = msg_pool->alloc;
     aws_message_pool_clean_up(msg_pool);
     aws_mem_release(alloc, msg_pool);
     aws_mem_release(alloc, object);
 }
 
+/* setup_args may live in the channel's arena, so it has to go before the channel's hold on it does */
+static void s_release_setup_args(struct channel_setup_args *setup_args) {
+    struct aws_channel *channel = setup_args->channel;
+    aws_mem_release(aws_channel_get_allocator(channel), setup_args);
+    aws_channel_release_hold(channel);
+}
+
 static void s_on_channel_setup_complete(struct aws_task *task, void *arg, enum aws_task_status task_status) {
 
     (void)task;
@@ -132,17 +222,22 @@ static void s_on_channel_setup_complete(struct aws_task *task, void *arg, enum a
             AWS_LOGF_DEBUG(
                 AWS_LS_IO_CHANNEL,
                 "id=%p: no message pool is currently stored in the event-loop "
-                "local storage, adding %p with max message size %zu, "
-                "message count 4, with 4 small blocks of 128 bytes.",
+                "local storage, adding %p with 4 messages of default size %zu, "
+                "4 small blocks of 128 bytes, and on-demand sizes of 2KB, 16KB, 64KB and 256KB, "
+                "growing up to 4MB per size.",
                 (void *)setup_args->channel,
                 (void *)message_pool,
                 g_aws_channel_max_fragment_size);
 
+            /* the pool is shared by every channel on this loop, so carry size classes for typical fragment sizes
+             * rather than just this channel's. */
             struct aws_message_pool_creation_args creation_args = {
                 .application_data_msg_data_size = g_aws_channel_max_fragment_size,
                 .application_data_msg_count = 4,
                 .small_block_msg_count = 4,
                 .small_block_msg_data_size = 128,
+                .additional_msg_data_sizes = {KB_2, KB_16, KB_64, KB_256},
+                .max_bytes_per_size_class = MB_4,
             };
 
             if (aws_message_pool_init(message_pool, setup_args->alloc, &creation_args)) {
@@ -168,8 +263,7 @@ static void s_on_channel_setup_complete(struct aws_task *task, void *arg, enum a
         setup_args->channel->msg_pool = message_pool;
         setup_args->channel->channel_state = AWS_CHANNEL_ACTIVE;
         setup_args->on_setup_completed(setup_args->channel, AWS_OP_SUCCESS, setup_args->user_data);
-        aws_channel_release_hold(setup_args->channel);
-        aws_mem_release(setup_args->alloc, setup_args);
+        s_release_setup_args(setup_args);
         return;
     }
 
@@ -186,20 +280,229 @@ cleanup_local_obj:
 
 cleanup_setup_args:
     setup_args->on_setup_completed(setup_args->channel, AWS_OP_ERR, setup_args->user_data);
-    aws_channel_release_hold(setup_args->channel);
-    aws_mem_release(setup_args->alloc, setup_args);
+    s_release_setup_args(setup_args);
 }
 
 static void s_schedule_cross_thread_tasks(struct aws_task *task, void *arg, enum aws_task_status status);
 
+/* only its address matters, see aws_channel's cross_thread_tasks.head */
+static struct aws_linked_list_node s_cross_thread_tasks_closed;
+
+/*
+ * Moves the tasks other threads have pushed onto the channel's cross-thread task list, oldest first. If close is
+ * true, the stack is closed as it's emptied, so tasks scheduled from other threads from now on are canceled instead.
+ * Must be called from the channel's thread.
+ */
+static void s_take_cross_thread_tasks(struct aws_channel *channel, bool close) {
+    void *head = NULL;
+    if (close) {
+        head = aws_atomic_exchange_ptr(&channel->cross_thread_tasks.head, &s_cross_thread_tasks_closed);
+    } else {
+        head = aws_atomic_load_ptr(&channel->cross_thread_tasks.head);
+        do {
+            if (head == &s_cross_thread_tasks_closed) {
+                return;
+            }
+        } while (!aws_atomic_compare_exchange_ptr(&channel->cross_thread_tasks.head, &head, NULL));
+    }
+
+    if (head == &s_cross_thread_tasks_closed) {
+        return;
+    }
+
+    /* the stack is newest first, reverse it so tasks run in the order they were scheduled */
+    struct aws_linked_list taken;
+    aws_linked_list_init(&taken);
+    struct aws_linked_list_node *node = head;
+    while (node) {
+        struct aws_linked_list_node *next = node->next;
+        aws_linked_list_push_front(&taken, node);
+        node = next;
+    }
+
+    aws_linked_list_move_all_back(&channel->cross_thread_tasks.list, &taken);
+}
+
+/* keeps every arena allocation suitably aligned for anything a handler might put there */
+#define CHANNEL_ARENA_ALIGNMENT (2 * sizeof(void *))
+
+static size_t s_channel_arena_round_up(size_t size) {
+    return aws_add_size_saturating(size, CHANNEL_ARENA_ALIGNMENT - 1) & ~(CHANNEL_ARENA_ALIGNMENT - 1);
+}
+
+static void *s_channel_arena_mem_acquire(struct aws_allocator *allocator, size_t size) {
+    struct channel_arena *arena = allocator->impl;
+
+    size_t rounded_size = s_channel_arena_round_up(size);
+    if (rounded_size > arena->capacity - arena->used) {
+        /* the arena was sized too small, so this comes from the usual place */
+        return aws_mem_acquire(arena->parent, size);
+    }
+
+    arena->last = arena->used;
+    arena->used += rounded_size;
+    return arena->buffer + arena->last;
+}
+
+static void s_channel_arena_mem_release(struct aws_allocator *allocator, void *ptr) {
+    struct channel_arena *arena = allocator->impl;
+
+    uint8_t *bytes = ptr;
+    if (bytes < arena->buffer || bytes >= arena->buffer + arena->capacity) {
+        aws_mem_release(arena->parent, ptr);
+        return;
+    }
+
+    if (arena->last != SIZE_MAX && bytes == arena->buffer + arena->last) {
+        arena->used = arena->last;
+        arena->last = SIZE_MAX;
+    }
+}
+
+size_t aws_channel_arena_size_hint(size_t slot_count, size_t handler_bytes) {
+    size_t size = s_channel_arena_round_up(sizeof(struct channel_setup_args));
+    size = aws_add_size_saturating(
+        size, s_channel_arena_round_up(INITIAL_STATISTIC_LIST_SIZE * sizeof(struct aws_crt_statistics_base *)));
+    size = aws_add_size_saturating(
+        size, aws_mul_size_saturating(slot_count, s_channel_arena_round_up(sizeof(struct aws_channel_slot))));
+    /* each handler allocation may waste up to an alignment's worth */
+    size = aws_add_size_saturating(size, aws_mul_size_saturating(slot_count, CHANNEL_ARENA_ALIGNMENT));
+    return aws_add_size_saturating(size, handler_bytes);
+}
+
+struct aws_allocator *aws_channel_get_allocator(struct aws_channel *channel) {
+    return channel->arena.buffer ? &channel->arena.allocator : channel->alloc;
+}
+
+static void s_channel_recycler_destroy(void *user_data) {
+    struct aws_channel_recycler *recycler = user_data;
+
+    while (!aws_linked_list_empty(&recycler->blocks)) {
+        struct recycled_channel_block *block =
+            AWS_CONTAINER_OF(aws_linked_list_pop_front(&recycler->blocks), struct recycled_channel_block, node);
+        aws_mem_release(block->alloc, block);
+    }
+
+    aws_mutex_clean_up(&recycler->lock);
+    aws_mem_release(recycler->allocator, recycler);
+}
+
+struct aws_channel_recycler *aws_channel_recycler_new(struct aws_allocator *allocator, size_t max_channels) {
+    struct aws_channel_recycler *recycler = aws_mem_calloc(allocator, 1, sizeof(struct aws_channel_recycler));
+    if (!recycler) {
+        return NULL;
+    }
+
+    if (aws_mutex_init(&recycler->lock)) {
+        aws_mem_release(allocator, recycler);
+        return NULL;
+    }
+
+    recycler->allocator = allocator;
+    recycler->max_blocks = max_channels;
+    aws_linked_list_init(&recycler->blocks);
+    aws_ref_count_init(&recycler->ref_count, recycler, s_channel_recycler_destroy);
+
+    return recycler;
+}
+
+struct aws_channel_recycler *aws_channel_recycler_acquire(struct aws_channel_recycler *recycler) {
+    if (recycler != NULL) {
+        aws_ref_count_acquire(&recycler->ref_count);
+    }
+
+    return recycler;
+}
+
+void aws_channel_recycler_release(struct aws_channel_recycler *recycler) {
+    if (recycler != NULL) {
+        aws_ref_count_release(&recycler->ref_count);
+    }
+}
+
+size_t aws_channel_recycler_get_cached_count(struct aws_channel_recycler *recycler) {
+    aws_mutex_lock(&recycler->lock);
+    size_t block_count = recycler->block_count;
+    aws_mutex_unlock(&recycler->lock);
+
+    return block_count;
+}
+
+/* a zeroed block of block_size bytes for a new channel, reusing a deleted channel's if the recycler has one */
+static void *s_channel_block_acquire(
+    struct aws_allocator *alloc,
+    struct aws_channel_recycler *recycler,
+    size_t block_size) {
+
+    if (recycler) {
+        struct recycled_channel_block *found = NULL;
+
+        aws_mutex_lock(&recycler->lock);
+        for (struct aws_linked_list_node *node = aws_linked_list_begin(&recycler->blocks);
+             node != aws_linked_list_end(&recycler->blocks);
+             node = aws_linked_list_next(node)) {
+            struct recycled_channel_block *block = AWS_CONTAINER_OF(node, struct recycled_channel_block, node);
+            if (block->alloc == alloc && block->size == block_size) {
+                aws_linked_list_remove(node);
+                recycler->block_count -= 1;
+                found = block;
+                break;
+            }
+        }
+        aws_mutex_unlock(&recycler->lock);
+
+        if (found) {
+            memset(found, 0, block_size);
+            return found;
+        }
+    }
+
+    return aws_mem_calloc(alloc, 1, block_size);
+}
+
+static void s_channel_block_release(struct aws_channel *channel) {
+    struct aws_allocator *alloc = channel->alloc;
+    struct aws_channel_recycler *recycler = channel->recycler;
+
+    if (!recycler) {
+        aws_mem_release(alloc, channel);
+        return;
+    }
+
+    struct recycled_channel_block *block = (struct recycled_channel_block *)channel;
+    size_t block_size = channel->block_size;
+    block->alloc = alloc;
+    block->size = block_size;
+
+    bool recycled = false;
+    aws_mutex_lock(&recycler->lock);
+    if (recycler->block_count < recycler->max_blocks) {
+        aws_linked_list_push_back(&recycler->blocks, &block->node);
+        recycler->block_count += 1;
+        recycled = true;
+    }
+    aws_mutex_unlock(&recycler->lock);
+
+    if (!recycled) {
+        aws_mem_release(alloc, block);
+    }
+
+    aws_channel_recycler_release(recycler);
+}
+
+struct aws_channel_recycler *aws_channel_get_recycler(const struct aws_channel *channel) {
+    return channel->recycler;
+}
+
 static void s_destroy_partially_constructed_channel(struct aws_channel *channel) {
     if (channel == NULL) {
         return;
     }
 
     aws_array_list_clean_up(&channel->statistic_list);
+    aws_crt_statistics_channel_cleanup(&channel->statistics);
 
-    aws_mem_release(channel->alloc, channel);
+    s_channel_block_release(channel);
 }
 
 struct aws_channel *aws_channel_new(struct aws_allocator *alloc, const struct aws_channel_options *creation_args) {
@@ -207,19 +510,60 @@ struct aws_channel *aws_channel_new(struct aws_allocator *alloc, const struct aw
     AWS_PRECONDITION(creation_args->event_loop);
     AWS_PRECONDITION(creation_args->on_setup_completed);
 
-    struct aws_channel *channel = aws_mem_calloc(alloc, 1, sizeof(struct aws_channel));
+    if (creation_args->write_high_water_mark &&
+        creation_args->write_low_water_mark >= creation_args->write_high_water_mark) {
+        AWS_LOGF_ERROR(
+            AWS_LS_IO_CHANNEL,
+            "static: write low water mark %zu must be less than the high water mark %zu.",
+            creation_args->write_low_water_mark,
+            creation_args->write_high_water_mark);
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    if (creation_args->enable_read_window_auto_tuning && !creation_args->enable_read_back_pressure) {
+        AWS_LOGF_ERROR(AWS_LS_IO_CHANNEL, "static: read window auto-tuning requires read back pressure.");
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    /* with an arena, everything below that's allocated from aws_channel_get_allocator() shares this allocation */
+    size_t channel_size = s_channel_arena_round_up(sizeof(struct aws_channel));
+    size_t arena_size = s_channel_arena_round_up(creation_args->arena_size);
+    size_t block_size = aws_add_size_saturating(channel_size, arena_size);
+    struct aws_channel *channel = s_channel_block_acquire(alloc, creation_args->recycler, block_size);
     if (!channel) {
         return NULL;
     }
 
     AWS_LOGF_DEBUG(AWS_LS_IO_CHANNEL, "id=%p: Beginning creation and setup of new channel.", (void *)channel);
     channel->alloc = alloc;
+    channel->block_size = block_size;
+    channel->recycler = aws_channel_recycler_acquire(creation_args->recycler);
+    if (arena_size) {
+        channel->arena.allocator.impl = &channel->arena;
+        channel->arena.allocator.mem_acquire = s_channel_arena_mem_acquire;
+        channel->arena.allocator.mem_release = s_channel_arena_mem_release;
+        channel->arena.parent = alloc;
+        channel->arena.buffer = (uint8_t *)channel + channel_size;
+        channel->arena.capacity = arena_size;
+        channel->arena.last = SIZE_MAX;
+    }
     channel->loop = creation_args->event_loop;
     channel->on_shutdown_completed = creation_args->on_shutdown_completed;
     channel->shutdown_user_data = creation_args->shutdown_user_data;
+    channel->max_fragment_size =
+        creation_args->max_fragment_size ? creation_args->max_fragment_size : g_aws_channel_max_fragment_size;
+    channel->write_high_water_mark = creation_args->write_high_water_mark;
+    channel->write_low_water_mark = creation_args->write_low_water_mark;
+    channel->writable = true;
+    aws_crt_statistics_channel_init(&channel->statistics);
 
     if (aws_array_list_init_dynamic(
-            &channel->statistic_list, alloc, INITIAL_STATISTIC_LIST_SIZE, sizeof(struct aws_crt_statistics_base *))) {
+            &channel->statistic_list,
+            aws_channel_get_allocator(channel),
+            INITIAL_STATISTIC_LIST_SIZE,
+            sizeof(struct aws_crt_statistics_base *))) {
         goto on_error;
     }
 
@@ -228,7 +572,8 @@ struct aws_channel *aws_channel_new(struct aws_allocator *alloc, const struct aw
      * 1 for the setup task, released when task executes */
     aws_atomic_init_int(&channel->refcount, 2);
 
-    struct channel_setup_args *setup_args = aws_mem_calloc(alloc, 1, sizeof(struct channel_setup_args));
+    struct channel_setup_args *setup_args =
+        aws_mem_calloc(aws_channel_get_allocator(channel), 1, sizeof(struct channel_setup_args));
     if (!setup_args) {
         goto on_error;
     }
@@ -236,13 +581,22 @@ struct aws_channel *aws_channel_new(struct aws_allocator *alloc, const struct aw
     channel->channel_state = AWS_CHANNEL_SETTING_UP;
     aws_linked_list_init(&channel->channel_thread_tasks.list);
     aws_linked_list_init(&channel->cross_thread_tasks.list);
+    aws_atomic_init_ptr(&channel->cross_thread_tasks.head, NULL);
+    aws_atomic_init_int(&channel->cross_thread_tasks.drain_pending, 0);
     channel->cross_thread_tasks.lock = (struct aws_mutex)AWS_MUTEX_INIT;
 
     if (creation_args->enable_read_back_pressure) {
         channel->read_back_pressure_enabled = true;
         /* we probably only need room for one fragment, but let's avoid potential deadlocks
          * on things like tls that need extra head-room. */
-        channel->window_update_batch_emit_threshold = g_aws_channel_max_fragment_size * 2;
+        channel->window_update_batch_emit_threshold = channel->max_fragment_size * 2;
+
+        if (creation_args->enable_read_window_auto_tuning) {
+            channel->read_window.auto_tuning_enabled = true;
+            channel->read_window.max_window = creation_args->max_read_window_size
+                                                  ? creation_args->max_read_window_size
+                                                  : aws_mul_size_saturating(channel->max_fragment_size, 64);
+        }
     }
 
     aws_task_init(
@@ -270,6 +624,9 @@ on_error:
 
 static void s_cleanup_slot(struct aws_channel_slot *slot) {
     if (slot) {
+        if (slot->channel->read_window.slot == slot) {
+            slot->channel->read_window.slot = NULL;
+        }
         if (slot->handler) {
             aws_channel_handler_destroy(slot->handler);
         }
@@ -304,10 +661,12 @@ static void s_final_channel_deletion_task(struct aws_task *task, void *arg, enum
     }
 
     aws_array_list_clean_up(&channel->statistic_list);
+    aws_crt_statistics_channel_cleanup(&channel->statistics);
 
     aws_channel_set_statistics_handler(channel, NULL);
 
-    aws_mem_release(channel->alloc, channel);
+    /* and with it the arena, if there is one */
+    s_channel_block_release(channel);
 }
 
 void aws_channel_acquire_hold(struct aws_channel *channel) {
@@ -370,9 +729,7 @@ static void s_shutdown_task(struct aws_channel_task *task, void *arg, enum aws_t
         channel->channel_state = AWS_CHANNEL_SHUT_DOWN;
         AWS_LOGF_TRACE(AWS_LS_IO_CHANNEL, "id=%p: shutdown completed", (void *)channel);
 
-        aws_mutex_lock(&channel->cross_thread_tasks.lock);
-        channel->cross_thread_tasks.is_channel_shut_down = true;
-        aws_mutex_unlock(&channel->cross_thread_tasks.lock);
+        s_take_cross_thread_tasks(channel, true);
 
         if (channel->on_shutdown_completed) {
             channel->shutdown_notify_task.task.fn = s_on_shutdown_completion_task;
@@ -416,13 +773,29 @@ int aws_channel_shutdown(struct aws_channel *channel, int error_code) {
     return s_channel_shutdown(channel, error_code, false);
 }
 
+static uint64_t s_message_pool_fallbacks(const struct aws_message_pool *msg_pool) {
+    uint64_t fallbacks = 0;
+    for (size_t i = 0; i < msg_pool->size_class_count; ++i) {
+        fallbacks += msg_pool->size_classes[i].fallbacks;
+    }
+    return fallbacks;
+}
+
 struct aws_io_message *aws_channel_acquire_message_from_pool(
     struct aws_channel *channel,
     enum aws_io_message_type message_type,
     size_t size_hint) {
 
+    /* the pool is only touched from this thread, so any fallback across the acquire is this channel's */
+    const bool track_fallbacks = channel->read_window.auto_tuning_enabled;
+    uint64_t fallbacks_before = track_fallbacks ? s_message_pool_fallbacks(channel->msg_pool) : 0;
+
     struct aws_io_message *message = aws_message_pool_acquire(channel->msg_pool, message_type, size_hint);
 
+    if (track_fallbacks) {
+        channel->read_window.pool_fallbacks += s_message_pool_fallbacks(channel->msg_pool) - fallbacks_before;
+    }
+
     if (AWS_LIKELY(message)) {
         message->owning_channel = channel;
         AWS_LOGF_TRACE(
@@ -438,14 +811,94 @@ struct aws_io_message *aws_channel_acquire_message_from_pool(
     return message;
 }
 
+static void *s_loan_mem_acquire(struct aws_allocator *allocator, size_t size) {
+    (void)allocator;
+    (void)size;
+
+    /* lent messages are never allocated through their allocator */
+    AWS_ASSERT(0);
+    return NULL;
+}
+
+static void s_loan_mem_release(struct aws_allocator *allocator, void *ptr) {
+    struct aws_channel_read_buffer_loan *loan = allocator->impl;
+    AWS_ASSERT(ptr == &loan->message);
+    AWS_ASSERT(loan->outstanding);
+    (void)ptr;
+
+    loan->outstanding = false;
+    struct aws_byte_buf data = loan->message.message_data;
+    AWS_ZERO_STRUCT(loan->message.message_data);
+    loan->on_returned(loan, &data, loan->user_data);
+}
+
+void aws_channel_read_buffer_loan_init(
+    struct aws_channel_read_buffer_loan *loan,
+    aws_channel_on_read_buffer_returned_fn *on_returned,
+    void *user_data) {
+    AWS_PRECONDITION(on_returned);
+
+    AWS_ZERO_STRUCT(*loan);
+    loan->message_allocator.impl = loan;
+    loan->message_allocator.mem_acquire = s_loan_mem_acquire;
+    loan->message_allocator.mem_release = s_loan_mem_release;
+    loan->on_returned = on_returned;
+    loan->user_data = user_data;
+}
+
+struct aws_io_message *aws_channel_read_buffer_loan_lend(
+    struct aws_channel_read_buffer_loan *loan,
+    struct aws_byte_buf region) {
+
+    if (loan->outstanding) {
+        aws_raise_error(AWS_ERROR_INVALID_STATE);
+        return NULL;
+    }
+
+    struct aws_io_message *message = &loan->message;
+    AWS_ZERO_STRUCT(*message);
+    message->allocator = &loan->message_allocator;
+    message->message_type = AWS_IO_MESSAGE_APPLICATION_DATA;
+    message->message_data = region;
+    message->message_data.len = 0;
+    loan->outstanding = true;
+
+    return message;
+}
+
+struct aws_io_message *aws_channel_slot_borrow_read_buffer(struct aws_channel_slot *slot, size_t size_hint) {
+    AWS_PRECONDITION(aws_channel_thread_is_callers_thread(slot->channel));
+
+    struct aws_channel_slot *lender = slot->adj_right;
+    if (!lender || !lender->handler || !lender->handler->vtable->lend_read_buffer) {
+        return NULL;
+    }
+
+    struct aws_io_message *message = lender->handler->vtable->lend_read_buffer(lender->handler, lender, size_hint);
+    if (message) {
+        AWS_ASSERT(message->message_type == AWS_IO_MESSAGE_APPLICATION_DATA);
+        message->owning_channel = slot->channel;
+        AWS_LOGF_TRACE(
+            AWS_LS_IO_CHANNEL,
+            "id=%p: borrowed read buffer %p of capacity %zu from handler %p",
+            (void *)slot->channel,
+            (void *)message,
+            message->message_data.capacity,
+            (void *)lender->handler);
+    }
+
+    return message;
+}
+
 struct aws_channel_slot *aws_channel_slot_new(struct aws_channel *channel) {
-    struct aws_channel_slot *new_slot = aws_mem_calloc(channel->alloc, 1, sizeof(struct aws_channel_slot));
+    struct aws_allocator *alloc = aws_channel_get_allocator(channel);
+    struct aws_channel_slot *new_slot = aws_mem_calloc(alloc, 1, sizeof(struct aws_channel_slot));
     if (!new_slot) {
         return NULL;
     }
 
     AWS_LOGF_TRACE(AWS_LS_IO_CHANNEL, "id=%p: creating new slot %p.", (void *)channel, (void *)new_slot);
-    new_slot->alloc = channel->alloc;
+    new_slot->alloc = alloc;
     new_slot->channel = channel;
 
     if (!channel->first) {
@@ -500,13 +953,13 @@ static void s_schedule_cross_thread_tasks(struct aws_task *task, void *arg, enum
     (void)task;
     struct aws_channel *channel = arg;
 
+    /* Clear the flag before taking the tasks, anything pushed after this point schedules another drain */
+    aws_atomic_store_int(&channel->cross_thread_tasks.drain_pending, 0);
+    s_take_cross_thread_tasks(channel, false);
+
     struct aws_linked_list cross_thread_task_list;
     aws_linked_list_init(&cross_thread_task_list);
-
-    /* Grab contents of cross-thread task list while we have the lock */
-    aws_mutex_lock(&channel->cross_thread_tasks.lock);
     aws_linked_list_swap_contents(&channel->cross_thread_tasks.list, &cross_thread_task_list);
-    aws_mutex_unlock(&channel->cross_thread_tasks.lock);
 
     /* If the channel has shut down since the cross-thread tasks were scheduled, run tasks immediately as canceled */
     if (channel->channel_state == AWS_CHANNEL_SHUT_DOWN) {
@@ -527,6 +980,9 @@ static void s_schedule_cross_thread_tasks(struct aws_task *task, void *arg, enum
                 channel->loop, &channel_task->wrapper_task, channel_task->wrapper_task.timestamp);
         }
     }
+
+    /* release the hold taken when this task was scheduled */
+    aws_channel_release_hold(channel);
 }
 
 void aws_channel_task_init(
@@ -586,26 +1042,21 @@ static void s_register_pending_task(
         "outside the event-loop thread.",
         (void *)channel,
         (void *)&channel_task->wrapper_task);
-    /* Outside event-loop thread... */
-    bool should_cancel_task = false;
-
-    /* Begin Critical Section */
-    aws_mutex_lock(&channel->cross_thread_tasks.lock);
-    if (channel->cross_thread_tasks.is_channel_shut_down) {
-        should_cancel_task = true; /* run task outside critical section to avoid deadlock */
-    } else {
-        bool list_was_empty = aws_linked_list_empty(&channel->cross_thread_tasks.list);
-        aws_linked_list_push_back(&channel->cross_thread_tasks.list, &channel_task->node);
-
-        if (list_was_empty) {
-            aws_event_loop_schedule_task_now(channel->loop, &channel->cross_thread_tasks.scheduling_task);
+    /* Outside event-loop thread, push the task onto the cross-thread stack, unless the channel has shut down */
+    void *head = aws_atomic_load_ptr(&channel->cross_thread_tasks.head);
+    do {
+        if (head == &s_cross_thread_tasks_closed) {
+            channel_task->task_fn(channel_task, channel_task->arg, AWS_TASK_STATUS_CANCELED);
+            return;
         }
-    }
-    aws_mutex_unlock(&channel->cross_thread_tasks.lock);
-    /* End Critical Section */
-
-    if (should_cancel_task) {
-        channel_task->task_fn(channel_task, channel_task->arg, AWS_TASK_STATUS_CANCELED);
+        channel_task->node.next = head;
+    } while (!aws_atomic_compare_exchange_ptr(&channel->cross_thread_tasks.head, &head, &channel_task->node));
+
+    /* Only one thread at a time needs to wake the channel's thread up. The scheduled task holds the channel, so it can
+     * safely run even if the channel shuts down and is destroyed in the meantime. */
+    if (!aws_atomic_exchange_int(&channel->cross_thread_tasks.drain_pending, 1)) {
+        aws_channel_acquire_hold(channel);
+        aws_event_loop_schedule_task_now(channel->loop, &channel->cross_thread_tasks.scheduling_task);
     }
 }
 
@@ -638,12 +1089,41 @@ static void s_update_channel_slot_message_overheads(struct aws_channel *channel)
     }
 }
 
+static void s_set_read_window(struct aws_channel *channel, size_t window) {
+    channel->read_window.window = window;
+    channel->statistics.read_window_size = window;
+
+    if (channel->read_window.auto_tuning_enabled) {
+        /* ask for more once half of a large window is used up, rather than waiting until it's nearly empty */
+        channel->window_update_batch_emit_threshold = aws_max_size(channel->max_fragment_size * 2, window / 2);
+    }
+}
+
 int aws_channel_slot_set_handler(struct aws_channel_slot *slot, struct aws_channel_handler *handler) {
     slot->handler = handler;
     slot->handler->slot = slot;
     s_update_channel_slot_message_overheads(slot->channel);
 
-    return aws_channel_slot_increment_read_window(slot, slot->handler->vtable->initial_window_size(handler));
+    struct aws_channel *channel = slot->channel;
+    if (channel->read_window.slot == slot) {
+        channel->read_window.slot = NULL;
+    }
+
+    size_t initial_window = slot->handler->vtable->initial_window_size(handler);
+    if (aws_channel_slot_increment_read_window(slot, initial_window)) {
+        return AWS_OP_ERR;
+    }
+
+    /* the last slot is the channel's consumer, the one whose window gets tuned */
+    if (channel->read_back_pressure_enabled && !slot->adj_right) {
+        channel->read_window.slot = slot;
+        channel->read_window.min_window = initial_window;
+        channel->read_window.withheld = 0;
+        channel->read_window.pool_fallbacks = 0;
+        s_set_read_window(channel, initial_window);
+    }
+
+    return AWS_OP_SUCCESS;
 }
 
 int aws_channel_slot_remove(struct aws_channel_slot *slot) {
@@ -786,20 +1266,110 @@ int aws_channel_slot_send_message(
     return aws_channel_handler_process_write_message(slot->adj_left->handler, slot->adj_left, message);
 }
 
+int aws_channel_slot_send_messages(
+    struct aws_channel_slot *slot,
+    struct aws_linked_list *messages,
+    enum aws_channel_direction dir) {
+
+    size_t message_count = 0;
+    size_t total_len = 0;
+    for (struct aws_linked_list_node *node = aws_linked_list_begin(messages); node != aws_linked_list_end(messages);
+         node = aws_linked_list_next(node)) {
+        struct aws_io_message *message = AWS_CONTAINER_OF(node, struct aws_io_message, queueing_handle);
+        message_count += 1;
+        total_len += message->message_data.len;
+    }
+
+    if (message_count == 0) {
+        return AWS_OP_SUCCESS;
+    }
+
+    if (dir == AWS_CHANNEL_DIR_READ) {
+        AWS_ASSERT(slot->adj_right);
+        AWS_ASSERT(slot->adj_right->handler);
+
+        if (!slot->channel->read_back_pressure_enabled || slot->adj_right->window_size >= total_len) {
+            AWS_LOGF_TRACE(
+                AWS_LS_IO_CHANNEL,
+                "id=%p: sending %zu read messages totalling %zu bytes, "
+                "from slot %p to slot %p with handler %p.",
+                (void *)slot->channel,
+                message_count,
+                total_len,
+                (void *)slot,
+                (void *)slot->adj_right,
+                (void *)slot->adj_right->handler);
+            slot->adj_right->window_size -= total_len;
+            return aws_channel_handler_process_read_messages(slot->adj_right->handler, slot->adj_right, messages);
+        }
+        AWS_LOGF_ERROR(
+            AWS_LS_IO_CHANNEL,
+            "id=%p: sending %zu messages totalling %zu bytes, "
+            "from slot %p to slot %p with handler %p, but this would exceed the channel's "
+            "read window, this is always a programming error.",
+            (void *)slot->channel,
+            message_count,
+            total_len,
+            (void *)slot,
+            (void *)slot->adj_right,
+            (void *)slot->adj_right->handler);
+        return aws_raise_error(AWS_IO_CHANNEL_READ_WOULD_EXCEED_WINDOW);
+    }
+
+    AWS_ASSERT(slot->adj_left);
+    AWS_ASSERT(slot->adj_left->handler);
+    AWS_LOGF_TRACE(
+        AWS_LS_IO_CHANNEL,
+        "id=%p: sending %zu write messages totalling %zu bytes, "
+        "from slot %p to slot %p with handler %p.",
+        (void *)slot->channel,
+        message_count,
+        total_len,
+        (void *)slot,
+        (void *)slot->adj_left,
+        (void *)slot->adj_left->handler);
+    return aws_channel_handler_process_write_messages(slot->adj_left->handler, slot->adj_left, messages);
+}
+
+static int s_slot_set_write_cork(struct aws_channel_slot *slot, bool corked) {
+    AWS_PRECONDITION(aws_channel_thread_is_callers_thread(slot->channel));
+
+    if (!slot->adj_left || !slot->adj_left->handler) {
+        return AWS_OP_SUCCESS;
+    }
+
+    AWS_LOGF_TRACE(
+        AWS_LS_IO_CHANNEL,
+        "id=%p: %s writes from slot %p",
+        (void *)slot->channel,
+        corked ? "corking" : "uncorking",
+        (void *)slot);
+    return aws_channel_handler_set_write_cork(slot->adj_left->handler, slot->adj_left, corked);
+}
+
+int aws_channel_slot_cork_writes(struct aws_channel_slot *slot) {
+    return s_slot_set_write_cork(slot, true);
+}
+
+int aws_channel_slot_uncork_writes(struct aws_channel_slot *slot) {
+    return s_slot_set_write_cork(slot, false);
+}
+
 struct aws_io_message *aws_channel_slot_acquire_max_message_for_write(struct aws_channel_slot *slot) {
     AWS_PRECONDITION(slot);
     AWS_PRECONDITION(slot->channel);
     AWS_PRECONDITION(aws_channel_thread_is_callers_thread(slot->channel));
 
     const size_t overhead = aws_channel_slot_upstream_message_overhead(slot);
-    if (overhead >= g_aws_channel_max_fragment_size) {
+    const size_t max_fragment_size = slot->channel->max_fragment_size;
+    if (overhead >= max_fragment_size) {
         AWS_LOGF_ERROR(
             AWS_LS_IO_CHANNEL, "id=%p: Upstream overhead exceeds channel's max message size.", (void *)slot->channel);
         aws_raise_error(AWS_ERROR_INVALID_STATE);
         return NULL;
     }
 
-    const size_t size_hint = g_aws_channel_max_fragment_size - overhead;
+    const size_t size_hint = max_fragment_size - overhead;
     return aws_channel_acquire_message_from_pool(slot->channel, AWS_IO_MESSAGE_APPLICATION_DATA, size_hint);
 }
 
@@ -837,9 +1407,56 @@ static void s_window_update_task(struct aws_channel_task *channel_task, void *ar
     channel->window_update_in_progress = false;
 }
 
+/*
+ * Called when the last slot hands window back. Grows or shrinks its window, and returns how much to actually pass on:
+ * more than it handed back when the window grew, less while the difference from a shrink is still being held back.
+ */
+static size_t s_tune_read_window(struct aws_channel_slot *slot, size_t window) {
+    struct aws_channel *channel = slot->channel;
+    const size_t old_window = channel->read_window.window;
+    size_t new_window = old_window;
+
+    bool memory_pressure = channel->read_window.pool_fallbacks > 0;
+    channel->read_window.pool_fallbacks = 0;
+
+    /* with less than a fragment of room left, the consumer was what held the channel back, and it's caught up now */
+    size_t remaining = aws_add_size_saturating(slot->window_size, slot->current_window_update_batch_size);
+    bool drained = remaining < channel->max_fragment_size;
+
+    if (memory_pressure && old_window > channel->read_window.min_window) {
+        new_window = aws_max_size(channel->read_window.min_window, old_window / 2);
+        channel->read_window.withheld += old_window - new_window;
+        channel->statistics.read_window_shrink_count += 1;
+    } else if (!memory_pressure && drained && old_window < channel->read_window.max_window) {
+        new_window = aws_min_size(channel->read_window.max_window, aws_mul_size_saturating(old_window, 2));
+        window = aws_add_size_saturating(window, new_window - old_window);
+        channel->statistics.read_window_grow_count += 1;
+    }
+
+    if (new_window != old_window) {
+        AWS_LOGF_DEBUG(
+            AWS_LS_IO_CHANNEL,
+            "id=%p: read window of slot %p resized from %zu to %zu.",
+            (void *)channel,
+            (void *)slot,
+            old_window,
+            new_window);
+        s_set_read_window(channel, new_window);
+    }
+
+    size_t repaid = aws_min_size(channel->read_window.withheld, window);
+    channel->read_window.withheld -= repaid;
+    return window - repaid;
+}
+
 int aws_channel_slot_increment_read_window(struct aws_channel_slot *slot, size_t window) {
 
     if (slot->channel->read_back_pressure_enabled && slot->channel->channel_state < AWS_CHANNEL_SHUTTING_DOWN) {
+        if (slot->channel->read_window.auto_tuning_enabled && slot == slot->channel->read_window.slot &&
+            !slot->adj_right) {
+            window = s_tune_read_window(slot, window);
+        }
+
         slot->current_window_update_batch_size =
             aws_add_size_saturating(slot->current_window_update_batch_size, window);
 
@@ -893,13 +1510,12 @@ static void s_on_shutdown_completion_task(struct aws_task *task, void *arg, enum
         aws_event_loop_cancel_task(channel->loop, &channel_task->wrapper_task);
     }
 
-    /* Cancel off-thread tasks, which haven't made it to the event-loop thread yet */
-    aws_mutex_lock(&channel->cross_thread_tasks.lock);
-    bool cancel_cross_thread_tasks = !aws_linked_list_empty(&channel->cross_thread_tasks.list);
-    aws_mutex_unlock(&channel->cross_thread_tasks.lock);
-
-    if (cancel_cross_thread_tasks) {
-        aws_event_loop_cancel_task(channel->loop, &channel->cross_thread_tasks.scheduling_task);
+    /* Cancel off-thread tasks, which haven't made it to the event-loop thread yet. They were taken off the
+     * cross-thread stack when it was closed at shutdown. Any pending scheduling task will find nothing left to do. */
+    while (!aws_linked_list_empty(&channel->cross_thread_tasks.list)) {
+        struct aws_linked_list_node *node = aws_linked_list_pop_front(&channel->cross_thread_tasks.list);
+        struct aws_channel_task *channel_task = AWS_CONTAINER_OF(node, struct aws_channel_task, node);
+        channel_task->task_fn(channel_task, channel_task->arg, AWS_TASK_STATUS_CANCELED);
     }
 
     AWS_ASSERT(aws_linked_list_empty(&channel->channel_thread_tasks.list));
@@ -962,9 +1578,7 @@ int aws_channel_slot_on_handler_shutdown_complete(
 
     if (slot->channel->first == slot) {
         slot->channel->channel_state = AWS_CHANNEL_SHUT_DOWN;
-        aws_mutex_lock(&slot->channel->cross_thread_tasks.lock);
-        slot->channel->cross_thread_tasks.is_channel_shut_down = true;
-        aws_mutex_unlock(&slot->channel->cross_thread_tasks.lock);
+        s_take_cross_thread_tasks(slot->channel, true);
 
         if (slot->channel->on_shutdown_completed) {
             slot->channel->shutdown_notify_task.task.fn = s_on_shutdown_completion_task;
@@ -1009,6 +1623,70 @@ int aws_channel_handler_process_write_message(
     return handler->vtable->process_write_message(handler, slot, message);
 }
 
+/*
+ * Hands the messages to process_fn one at a time. A message the handler fails to take goes back on the front of the
+ * list, so that the caller owns everything still in the list, just like when a batched handler fails.
+ */
+static int s_process_messages_one_at_a_time(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    struct aws_linked_list *messages,
+    int (*process_fn)(struct aws_channel_handler *, struct aws_channel_slot *, struct aws_io_message *)) {
+
+    while (!aws_linked_list_empty(messages)) {
+        struct aws_linked_list_node *node = aws_linked_list_pop_front(messages);
+        struct aws_io_message *message = AWS_CONTAINER_OF(node, struct aws_io_message, queueing_handle);
+
+        if (process_fn(handler, slot, message)) {
+            aws_linked_list_push_front(messages, node);
+            return AWS_OP_ERR;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_channel_handler_process_read_messages(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    struct aws_linked_list *messages) {
+
+    AWS_ASSERT(handler->vtable);
+    if (handler->vtable->process_read_messages) {
+        return handler->vtable->process_read_messages(handler, slot, messages);
+    }
+
+    AWS_ASSERT(handler->vtable->process_read_message);
+    return s_process_messages_one_at_a_time(handler, slot, messages, handler->vtable->process_read_message);
+}
+
+int aws_channel_handler_process_write_messages(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    struct aws_linked_list *messages) {
+
+    AWS_ASSERT(handler->vtable);
+    if (handler->vtable->process_write_messages) {
+        return handler->vtable->process_write_messages(handler, slot, messages);
+    }
+
+    AWS_ASSERT(handler->vtable->process_write_message);
+    return s_process_messages_one_at_a_time(handler, slot, messages, handler->vtable->process_write_message);
+}
+
+int aws_channel_handler_set_write_cork(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    bool corked) {
+
+    AWS_ASSERT(handler->vtable);
+    if (handler->vtable->set_write_cork) {
+        return handler->vtable->set_write_cork(handler, slot, corked);
+    }
+
+    return s_slot_set_write_cork(slot, corked);
+}
+
 int aws_channel_handler_increment_read_window(
     struct aws_channel_handler *handler,
     struct aws_channel_slot *slot,
@@ -1042,6 +1720,8 @@ struct aws_channel_slot *aws_channel_get_first_slot(struct aws_channel *channel)
 static void s_reset_statistics(struct aws_channel *channel) {
     AWS_FATAL_ASSERT(aws_channel_thread_is_callers_thread(channel));
 
+    aws_crt_statistics_channel_reset(&channel->statistics);
+
     struct aws_channel_slot *current_slot = channel->first;
     while (current_slot) {
         struct aws_channel_handler *handler = current_slot->handler;
@@ -1076,6 +1756,9 @@ static void s_channel_gather_statistics_task(struct aws_task *task, void *arg, e
     struct aws_array_list *statistics_list = &channel->statistic_list;
     aws_array_list_clear(statistics_list);
 
+    void *channel_stats = &channel->statistics;
+    aws_array_list_push_back(statistics_list, &channel_stats);
+
     struct aws_channel_slot *current_slot = channel->first;
     while (current_slot) {
         struct aws_channel_handler *handler = current_slot->handler;
@@ -1142,3 +1825,79 @@ int aws_channel_set_statistics_handler(struct aws_channel *channel, struct aws_c
 struct aws_event_loop *aws_channel_get_event_loop(struct aws_channel *channel) {
     return channel->loop;
 }
+
+size_t aws_channel_max_fragment_size(const struct aws_channel *channel) {
+    return channel->max_fragment_size;
+}
+
+bool aws_channel_is_writable(const struct aws_channel *channel) {
+    return channel->writable;
+}
+
+size_t aws_channel_pending_write_bytes(const struct aws_channel *channel) {
+    return channel->pending_write_bytes;
+}
+
+size_t aws_channel_read_window_size(const struct aws_channel *channel) {
+    return channel->read_back_pressure_enabled ? channel->read_window.window : SIZE_MAX;
+}
+
+static void s_notify_writability_changed(struct aws_channel *channel) {
+    AWS_LOGF_DEBUG(
+        AWS_LS_IO_CHANNEL,
+        "id=%p: channel is now %s with %zu bytes pending write.",
+        (void *)channel,
+        channel->writable ? "writable" : "not writable",
+        channel->pending_write_bytes);
+
+    /* once shut down, handlers may already be getting destroyed, and no one is producing anyway */
+    if (channel->channel_state == AWS_CHANNEL_SHUT_DOWN) {
+        return;
+    }
+
+    struct aws_channel_slot *slot = channel->first;
+    while (slot) {
+        struct aws_channel_slot *next = slot->adj_right;
+        if (slot->handler && slot->handler->vtable->on_writability_changed) {
+            slot->handler->vtable->on_writability_changed(slot->handler, slot, channel->writable);
+        }
+        slot = next;
+    }
+}
+
+void aws_channel_increment_pending_write_bytes(struct aws_channel *channel, size_t size) {
+    AWS_PRECONDITION(aws_channel_thread_is_callers_thread(channel));
+
+    channel->pending_write_bytes = aws_add_size_saturating(channel->pending_write_bytes, size);
+
+    if (channel->write_high_water_mark && channel->writable &&
+        channel->pending_write_bytes >= channel->write_high_water_mark) {
+        channel->writable = false;
+        s_notify_writability_changed(channel);
+    }
+}
+
+void aws_channel_decrement_pending_write_bytes(struct aws_channel *channel, size_t size) {
+    AWS_PRECONDITION(aws_channel_thread_is_callers_thread(channel));
+    AWS_ASSERT(size <= channel->pending_write_bytes);
+
+    channel->pending_write_bytes = size < channel->pending_write_bytes ? channel->pending_write_bytes - size : 0;
+
+    if (!channel->writable && channel->pending_write_bytes <= channel->write_low_water_mark) {
+        channel->writable = true;
+        s_notify_writability_changed(channel);
+    }
+}
+
+int aws_channel_get_message_pool_statistics(
+    struct aws_channel *channel,
+    struct aws_message_pool_statistics *stats) {
+    AWS_PRECONDITION(aws_channel_thread_is_callers_thread(channel));
+
+    if (!channel->msg_pool) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    aws_message_pool_get_statistics(channel->msg_pool, stats);
+    return AWS_OP_SUCCESS;
+}
@@ -23,12 +23,76 @@
 
 #define DEFAULT_DNS_TTL 30
 
+/* one recycler per event loop in the group, so channels only reuse memory last touched on their own loop */
+static int s_channel_recyclers_init(
+    struct aws_allocator *allocator,
+    struct aws_event_loop_group *event_loop_group,
+    size_t channels_per_loop,
+    struct aws_channel_recycler ***recyclers,
+    size_t *recycler_count) {
+
+    if (*recyclers) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    size_t loop_count = aws_event_loop_group_get_loop_count(event_loop_group);
+    struct aws_channel_recycler **new_recyclers =
+        aws_mem_calloc(allocator, loop_count, sizeof(struct aws_channel_recycler *));
+    if (!new_recyclers) {
+        return AWS_OP_ERR;
+    }
+
+    for (size_t i = 0; i < loop_count; ++i) {
+        new_recyclers[i] = aws_channel_recycler_new(allocator, channels_per_loop);
+        if (!new_recyclers[i]) {
+            for (size_t j = 0; j < i; ++j) {
+                aws_channel_recycler_release(new_recyclers[j]);
+            }
+            aws_mem_release(allocator, new_recyclers);
+            return AWS_OP_ERR;
+        }
+    }
+
+    *recyclers = new_recyclers;
+    *recycler_count = loop_count;
+    return AWS_OP_SUCCESS;
+}
+
+static void s_channel_recyclers_clean_up(
+    struct aws_allocator *allocator,
+    struct aws_channel_recycler **recyclers,
+    size_t recycler_count) {
+
+    if (recyclers) {
+        for (size_t i = 0; i < recycler_count; ++i) {
+            aws_channel_recycler_release(recyclers[i]);
+        }
+        aws_mem_release(allocator, recyclers);
+    }
+}
+
+static struct aws_channel_recycler *s_channel_recycler_for_loop(
+    struct aws_event_loop_group *event_loop_group,
+    struct aws_channel_recycler **recyclers,
+    size_t recycler_count,
+    struct aws_event_loop *event_loop) {
+
+    for (size_t i = 0; recyclers && i < recycler_count; ++i) {
+        if (aws_event_loop_group_get_loop_at(event_loop_group, i) == event_loop) {
+            return recyclers[i];
+        }
+    }
+
+    return NULL;
+}
+
 static void s_client_bootstrap_destroy_impl(struct aws_client_bootstrap *bootstrap) {
     AWS_ASSERT(bootstrap);
     AWS_LOGF_DEBUG(AWS_LS_IO_CHANNEL_BOOTSTRAP, "id=%p: destroying", (void *)bootstrap);
     aws_client_bootstrap_shutdown_complete_fn *on_shutdown_complete = bootstrap->on_shutdown_complete;
     void *user_data = bootstrap->user_data;
 
+    s_channel_recyclers_clean_up(bootstrap->allocator, bootstrap->channel_recyclers, bootstrap->channel_recycler_count);
     aws_event_loop_group_release(bootstrap->event_loop_group);
     aws_host_resolver_release(bootstrap->host_resolver);
 
@@ -104,6 +168,20 @@ int aws_client_bootstrap_set_alpn_callback(
     return AWS_OP_SUCCESS;
 }
 
+int aws_client_bootstrap_enable_channel_recycling(struct aws_client_bootstrap *bootstrap, size_t channels_per_loop) {
+    AWS_LOGF_DEBUG(
+        AWS_LS_IO_CHANNEL_BOOTSTRAP,
+        "id=%p: Recycling up to %zu channels per event loop",
+        (void *)bootstrap,
+        channels_per_loop);
+    return s_channel_recyclers_init(
+        bootstrap->allocator,
+        bootstrap->event_loop_group,
+        channels_per_loop,
+        &bootstrap->channel_recyclers,
+        &bootstrap->channel_recycler_count);
+}
+
 struct client_channel_data {
     struct aws_channel *channel;
     struct aws_socket *socket;
@@ -131,6 +209,12 @@ struct client_connection_args {
     bool connection_chosen;
     bool setup_called;
     bool enable_read_back_pressure;
+    size_t max_fragment_size;
+    size_t write_high_water_mark;
+    size_t write_low_water_mark;
+    bool enable_read_window_auto_tuning;
+    size_t max_read_window_size;
+    size_t channel_arena_size;
 
     /*
      * It is likely that all reference adjustments to the connection args take place in a single event loop
@@ -287,10 +371,10 @@ static inline int s_setup_client_tls(struct client_connection_args *connection_a
     }
 
     struct aws_channel_handler *tls_handler = aws_tls_client_handler_new(
-        connection_args->bootstrap->allocator, &connection_args->channel_data.tls_options, tls_slot);
+        aws_channel_get_allocator(channel), &connection_args->channel_data.tls_options, tls_slot);
 
     if (!tls_handler) {
-        aws_mem_release(connection_args->bootstrap->allocator, (void *)tls_slot);
+        aws_mem_release(tls_slot->alloc, (void *)tls_slot);
         return AWS_OP_ERR;
     }
 
@@ -315,12 +399,12 @@ static inline int s_setup_client_tls(struct client_connection_args *connection_a
         }
 
         struct aws_channel_handler *alpn_handler = aws_tls_alpn_handler_new(
-            connection_args->bootstrap->allocator,
+            aws_channel_get_allocator(channel),
             connection_args->channel_data.on_protocol_negotiated,
             connection_args->user_data);
 
         if (!alpn_handler) {
-            aws_mem_release(connection_args->bootstrap->allocator, (void *)alpn_slot);
+            aws_mem_release(alpn_slot->alloc, (void *)alpn_slot);
             return AWS_OP_ERR;
         }
 
@@ -365,10 +449,10 @@ static void s_on_client_channel_on_setup_completed(struct aws_channel *channel,
         }
 
         struct aws_channel_handler *socket_channel_handler = aws_socket_handler_new(
-            connection_args->bootstrap->allocator,
+            aws_channel_get_allocator(channel),
             connection_args->channel_data.socket,
             socket_slot,
-            g_aws_channel_max_fragment_size);
+            aws_channel_max_fragment_size(channel));
 
         if (!socket_channel_handler) {
             err_code = aws_last_error();
@@ -513,7 +597,18 @@ static void s_on_client_connection_established(struct aws_socket *socket, int er
     };
 
     args.enable_read_back_pressure = connection_args->enable_read_back_pressure;
+    args.max_fragment_size = connection_args->max_fragment_size;
+    args.write_high_water_mark = connection_args->write_high_water_mark;
+    args.write_low_water_mark = connection_args->write_low_water_mark;
+    args.enable_read_window_auto_tuning = connection_args->enable_read_window_auto_tuning;
+    args.max_read_window_size = connection_args->max_read_window_size;
+    args.arena_size = connection_args->channel_arena_size;
     args.event_loop = aws_socket_get_event_loop(socket);
+    args.recycler = s_channel_recycler_for_loop(
+        connection_args->bootstrap->event_loop_group,
+        connection_args->bootstrap->channel_recyclers,
+        connection_args->bootstrap->channel_recycler_count,
+        args.event_loop);
 
     AWS_LOGF_TRACE(
         AWS_LS_IO_CHANNEL_BOOTSTRAP,
@@ -736,6 +831,12 @@ int aws_client_bootstrap_new_socket_channel(struct aws_socket_channel_bootstrap_
     client_connection_args->outgoing_options = *socket_options;
     client_connection_args->outgoing_port = port;
     client_connection_args->enable_read_back_pressure = options->enable_read_back_pressure;
+    client_connection_args->max_fragment_size = options->max_fragment_size;
+    client_connection_args->write_high_water_mark = options->write_high_water_mark;
+    client_connection_args->write_low_water_mark = options->write_low_water_mark;
+    client_connection_args->enable_read_window_auto_tuning = options->enable_read_window_auto_tuning;
+    client_connection_args->max_read_window_size = options->max_read_window_size;
+    client_connection_args->channel_arena_size = options->channel_arena_size;
 
     if (tls_options) {
         if (aws_tls_connection_options_copy(&client_connection_args->channel_data.tls_options, tls_options)) {
@@ -743,6 +844,10 @@ int aws_client_bootstrap_new_socket_channel(struct aws_socket_channel_bootstrap_
         }
         client_connection_args->channel_data.use_tls = true;
 
+        if (!tls_options->port) {
+            client_connection_args->channel_data.tls_options.port = port;
+        }
+
         client_connection_args->channel_data.on_protocol_negotiated = bootstrap->on_protocol_negotiated;
         client_connection_args->channel_data.tls_user_data = tls_options->user_data;
 
@@ -839,6 +944,7 @@ error:
 
 void s_server_bootstrap_destroy_impl(struct aws_server_bootstrap *bootstrap) {
     AWS_ASSERT(bootstrap);
+    s_channel_recyclers_clean_up(bootstrap->allocator, bootstrap->channel_recyclers, bootstrap->channel_recycler_count);
     aws_event_loop_group_release(bootstrap->event_loop_group);
     aws_mem_release(bootstrap->allocator, bootstrap);
 }
@@ -903,6 +1009,12 @@ struct server_connection_args {
     void *user_data;
     bool use_tls;
     bool enable_read_back_pressure;
+    size_t max_fragment_size;
+    size_t write_high_water_mark;
+    size_t write_low_water_mark;
+    bool enable_read_window_auto_tuning;
+    size_t max_read_window_size;
+    size_t channel_arena_size;
     struct aws_ref_count ref_count;
 };
 
@@ -1031,10 +1143,10 @@ static inline int s_setup_server_tls(struct server_channel_data *channel_data, s
     /* Shallow-copy tls_options so we can override the user_data, making it specific to this channel */
     struct aws_tls_connection_options tls_options = connection_args->tls_options;
     tls_options.user_data = channel_data;
-    tls_handler = aws_tls_server_handler_new(connection_args->bootstrap->allocator, &tls_options, tls_slot);
+    tls_handler = aws_tls_server_handler_new(aws_channel_get_allocator(channel), &tls_options, tls_slot);
 
     if (!tls_handler) {
-        aws_mem_release(connection_args->bootstrap->allocator, tls_slot);
+        aws_mem_release(tls_slot->alloc, tls_slot);
         return AWS_OP_ERR;
     }
 
@@ -1062,7 +1174,7 @@ static inline int s_setup_server_tls(struct server_channel_data *channel_data, s
         }
 
         alpn_handler = aws_tls_alpn_handler_new(
-            connection_args->bootstrap->allocator, connection_args->on_protocol_negotiated, connection_args->user_data);
+            aws_channel_get_allocator(channel), connection_args->on_protocol_negotiated, connection_args->user_data);
 
         if (!alpn_handler) {
             aws_channel_slot_remove(alpn_slot);
@@ -1126,10 +1238,7 @@ static void s_on_server_channel_on_setup_completed(struct aws_channel *channel,
     }
 
     struct aws_channel_handler *socket_channel_handler = aws_socket_handler_new(
-        channel_data->server_connection_args->bootstrap->allocator,
-        channel_data->socket,
-        socket_slot,
-        g_aws_channel_max_fragment_size);
+        aws_channel_get_allocator(channel), channel_data->socket, socket_slot, aws_channel_max_fragment_size(channel));
 
     if (!socket_channel_handler) {
         err_code = aws_last_error();
@@ -1242,6 +1351,18 @@ void s_on_server_connection_result(
 
         channel_args.event_loop = event_loop;
         channel_args.enable_read_back_pressure = channel_data->server_connection_args->enable_read_back_pressure;
+        channel_args.max_fragment_size = channel_data->server_connection_args->max_fragment_size;
+        channel_args.write_high_water_mark = channel_data->server_connection_args->write_high_water_mark;
+        channel_args.write_low_water_mark = channel_data->server_connection_args->write_low_water_mark;
+        channel_args.enable_read_window_auto_tuning =
+            channel_data->server_connection_args->enable_read_window_auto_tuning;
+        channel_args.max_read_window_size = channel_data->server_connection_args->max_read_window_size;
+        channel_args.arena_size = channel_data->server_connection_args->channel_arena_size;
+        channel_args.recycler = s_channel_recycler_for_loop(
+            connection_args->bootstrap->event_loop_group,
+            connection_args->bootstrap->channel_recyclers,
+            connection_args->bootstrap->channel_recycler_count,
+            event_loop);
 
         if (aws_socket_assign_to_event_loop(new_socket, event_loop)) {
             aws_mem_release(connection_args->bootstrap->allocator, (void *)channel_data);
@@ -1314,6 +1435,12 @@ struct aws_socket *aws_server_bootstrap_new_socket_listener(
     server_connection_args->destroy_callback = bootstrap_options->destroy_callback;
     server_connection_args->on_protocol_negotiated = bootstrap_options->bootstrap->on_protocol_negotiated;
     server_connection_args->enable_read_back_pressure = bootstrap_options->enable_read_back_pressure;
+    server_connection_args->max_fragment_size = bootstrap_options->max_fragment_size;
+    server_connection_args->write_high_water_mark = bootstrap_options->write_high_water_mark;
+    server_connection_args->write_low_water_mark = bootstrap_options->write_low_water_mark;
+    server_connection_args->enable_read_window_auto_tuning = bootstrap_options->enable_read_window_auto_tuning;
+    server_connection_args->max_read_window_size = bootstrap_options->max_read_window_size;
+    server_connection_args->channel_arena_size = bootstrap_options->channel_arena_size;
 
     aws_task_init(
         &server_connection_args->listener_destroy_task,
@@ -1419,3 +1546,17 @@ int aws_server_bootstrap_set_alpn_callback(
     bootstrap->on_protocol_negotiated = on_protocol_negotiated;
     return AWS_OP_SUCCESS;
 }
+
+int aws_server_bootstrap_enable_channel_recycling(struct aws_server_bootstrap *bootstrap, size_t channels_per_loop) {
+    AWS_LOGF_DEBUG(
+        AWS_LS_IO_CHANNEL_BOOTSTRAP,
+        "id=%p: Recycling up to %zu channels per event loop",
+        (void *)bootstrap,
+        channels_per_loop);
+    return s_channel_recyclers_init(
+        bootstrap->allocator,
+        bootstrap->event_loop_group,
+        channels_per_loop,
+        &bootstrap->channel_recyclers,
+        &bootstrap->channel_recycler_count);
+}
@@ -522,6 +522,11 @@ static int s_process_write_message(
 
     struct secure_transport_handler *secure_transport_handler = handler->impl;
 
+    if (AWS_UNLIKELY(message->slices != NULL)) {
+        /* the payload isn't in message_data, which is all this handler knows how to encrypt */
+        return aws_raise_error(AWS_IO_CHANNEL_UNKNOWN_MESSAGE_TYPE);
+    }
+
     if (AWS_UNLIKELY(!secure_transport_handler->negotiation_finished)) {
         return aws_raise_error(AWS_IO_TLS_ERROR_NOT_NEGOTIATED);
     }
@@ -757,6 +762,22 @@ struct aws_byte_buf aws_tls_handler_server_name(struct aws_channel_handler *hand
     return secure_transport_handler->server_name;
 }
 
+int aws_tls_handler_flush(struct aws_channel_handler *handler) {
+    /* writes are not coalesced by this implementation, so there is never anything buffered to flush. */
+    (void)handler;
+    return AWS_OP_SUCCESS;
+}
+
+void aws_tls_reload_credential_cache(void) {
+    /* credentials are not cached by this implementation, every ctx already loads them fresh. */
+}
+
+enum aws_tls_early_data_status aws_tls_handler_early_data_status(struct aws_channel_handler *handler) {
+    /* this implementation doesn't support TLS 1.3 early data. */
+    (void)handler;
+    return AWS_IO_TLS_EARLY_DATA_NOT_REQUESTED;
+}
+
 static struct aws_channel_handler_vtable s_handler_vtable = {
     .destroy = s_destroy,
     .process_read_message = s_process_read_message,
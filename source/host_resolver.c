@@ -10,12 +10,21 @@
 #include <aws/common/hash_table.h>
 #include <aws/common/lru_cache.h>
 #include <aws/common/mutex.h>
+#include <aws/common/priority_queue.h>
+#include <aws/common/rw_lock.h>
 #include <aws/common/string.h>
 #include <aws/common/thread.h>
 
+#include <aws/io/file_utils.h>
 #include <aws/io/logging.h>
 
+#include <errno.h>
 #include <inttypes.h>
+#include <stdio.h>
+
+#ifdef _MSC_VER
+#    pragma warning(disable : 4996) /* Disable warnings about fopen() being insecure */
+#endif                              /* _MSC_VER */
 
 const uint64_t NS_PER_SEC = 1000000000;
 
@@ -80,6 +89,24 @@ int aws_host_resolver_purge_cache(struct aws_host_resolver *resolver) {
     return resolver->vtable->purge_cache(resolver);
 }
 
+int aws_host_resolver_save_cache(struct aws_host_resolver *resolver, const char *path) {
+    AWS_ASSERT(resolver->vtable);
+    if (resolver->vtable->save_cache == NULL) {
+        return aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+    }
+
+    return resolver->vtable->save_cache(resolver, path);
+}
+
+int aws_host_resolver_load_cache(struct aws_host_resolver *resolver, const char *path) {
+    AWS_ASSERT(resolver->vtable);
+    if (resolver->vtable->load_cache == NULL) {
+        return aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+    }
+
+    return resolver->vtable->load_cache(resolver, path);
+}
+
 int aws_host_resolver_record_connection_failure(struct aws_host_resolver *resolver, struct aws_host_address *address) {
     AWS_ASSERT(resolver->vtable && resolver->vtable->record_connection_failure);
     return resolver->vtable->record_connection_failure(resolver, address);
@@ -119,6 +146,49 @@ enum default_resolver_state {
     DRS_SHUTTING_DOWN,
 };
 
+/* Number of independently locked tables that published address snapshots are spread over. */
+#define HOST_SNAPSHOT_SHARD_COUNT 16
+
+struct host_entry;
+
+/*
+ * An immutable copy of a host entry's good addresses. Cache hits are answered from these without taking the resolver
+ * or entry locks; whoever changes the entry's caches publishes a new one in its place.
+ */
+struct host_address_snapshot {
+    struct aws_allocator *allocator;
+    struct aws_atomic_var ref_count;
+
+    /* only valid while the snapshot is published, i.e. with its shard's lock held */
+    struct host_entry *entry;
+
+    /* struct aws_host_address, least recently used first as of publication */
+    struct aws_array_list aaaa_addresses;
+    struct aws_array_list a_addresses;
+
+    /* how many addresses of each type have been vended from this snapshot. Hits rotate through the lists with these. */
+    struct aws_atomic_var aaaa_vended;
+    struct aws_atomic_var a_vended;
+};
+
+/* The addresses an entry had when it retired, or that a cache file had for the host. */
+struct stale_host {
+    struct aws_allocator *allocator;
+    struct aws_string *host_name;
+
+    /* struct aws_host_address */
+    struct aws_array_list addresses;
+    struct aws_array_list failed_addresses;
+};
+
+struct host_snapshot_shard {
+    /* Never held while taking any other lock. Publishers take it with (after) the entry lock. */
+    struct aws_rw_lock lock;
+
+    /* host_name (aws_string*, owned by the host entry) -> host_address_snapshot* */
+    struct aws_hash_table snapshots;
+};
+
 struct default_host_resolver {
     struct aws_allocator *allocator;
 
@@ -149,6 +219,28 @@ struct default_host_resolver {
      */
     uint32_t pending_host_entry_shutdown_completion_callbacks;
 
+    /*
+     * Set when host entries are resolved by a shared pool of threads rather than one thread each. The resolver can
+     * only be cleaned up once every pool thread that was launched has exited too.
+     */
+    struct resolver_thread_pool *thread_pool;
+    uint32_t pool_thread_count;
+
+    /*
+     * Published snapshots of every active entry that has good addresses, sharded by host name so that cache hits
+     * neither take resolver_lock nor contend with hits on other hosts.
+     */
+    struct host_snapshot_shard snapshot_shards[HOST_SNAPSHOT_SHARD_COUNT];
+
+    /*
+     * How long addresses may be served past their expiry, and the last known addresses of hosts without an entry, to
+     * answer their next query with straight away. Those come from entries that retired for lack of queries (only if
+     * max_stale_ns isn't 0) and from loaded cache files.
+     * host_name (aws_string*, owned by the stale_host) -> stale_host*
+     */
+    uint64_t max_stale_ns;
+    struct aws_cache *stale_hosts;
+
     /*
      * Function to use to query current time.  Overridable in construction options.
      */
@@ -223,11 +315,63 @@ struct host_entry {
     struct aws_cache *failed_connection_aaaa_records;
     struct aws_cache *failed_connection_a_records;
     struct aws_linked_list pending_resolution_callbacks;
-    uint32_t resolves_since_last_request;
-    uint64_t last_resolve_request_timestamp_ns;
     enum default_resolver_state state;
     struct aws_array_list new_addresses;
     struct aws_array_list expired_addresses;
+
+    /* the snapshot of this entry's good addresses that cache hits currently read, if any */
+    struct host_address_snapshot *published_snapshot;
+
+    /*
+     * Also updated by cache hits, which hold neither lock. The timestamp is kept in (rounded up) seconds so that it
+     * fits an atomic on 32-bit platforms.
+     */
+    struct aws_atomic_var resolves_since_last_request;
+    struct aws_atomic_var last_resolve_request_timestamp_secs;
+
+    /* Only used by the thread resolving the entry: its own thread, or the pool worker it's been handed to. */
+    struct host_entry_threaded_data {
+        struct aws_linked_list listener_list;
+        struct aws_linked_list listener_destroy_list;
+        struct aws_array_list address_list;
+        struct aws_array_list new_address_list;
+        struct aws_array_list expired_address_list;
+        bool resolved_once;
+    } threaded_data;
+
+    /* pooled mode only, protected by the pool's lock */
+    struct aws_linked_list_node pool_node;
+    uint64_t next_resolve_ns;
+};
+
+/*
+ * Shared resolver threads. Every live host entry is either scheduled, waiting for its next refresh time, or ready,
+ * waiting for a worker. The scheduler thread moves entries from the former to the latter as they come due, and a
+ * worker puts an entry back on the schedule once it's done with it, so only one thread ever works on an entry at a
+ * time.
+ */
+struct resolver_thread_pool {
+    struct aws_allocator *allocator;
+    struct aws_host_resolver *resolver;
+
+    /* Protects everything below. Always taken last, after the resolver and entry locks. */
+    struct aws_mutex lock;
+    struct aws_condition_variable worker_signal;
+    struct aws_condition_variable scheduler_signal;
+
+    /* host_entry* ordered by next_resolve_ns */
+    struct aws_priority_queue scheduled_entries;
+
+    /* linked list of host_entry, through pool_node */
+    struct aws_linked_list ready_entries;
+
+    /* entries handed to the pool that haven't finished yet. The threads exit once this drops to 0 on shutdown. */
+    size_t entry_count;
+    bool shutting_down;
+
+    struct aws_thread scheduler;
+    struct aws_thread *workers;
+    size_t worker_count;
 };
 
 /*
@@ -253,9 +397,14 @@ int aws_host_address_cache_entry_copy(
     return AWS_OP_SUCCESS;
 }
 
+static void s_withdraw_host_entry_snapshot(struct host_entry *host_entry);
+
+static void s_publish_host_entry_snapshot(struct host_entry *host_entry);
+
 static void s_shutdown_host_entry(struct host_entry *entry) {
     aws_mutex_lock(&entry->entry_lock);
     entry->state = DRS_SHUTTING_DOWN;
+    s_withdraw_host_entry_snapshot(entry);
     aws_mutex_unlock(&entry->entry_lock);
 }
 
@@ -286,6 +435,18 @@ static void s_remove_host_listener_from_entry(
 
 static void s_host_listener_destroy(struct host_listener *listener);
 
+static void s_resolver_thread_pool_shut_down(struct resolver_thread_pool *pool);
+
+static void s_resolver_thread_pool_destroy(struct resolver_thread_pool *pool);
+
+/*
+ * resolver lock must be held before calling this function
+ */
+static bool s_default_resolver_is_drained(struct default_host_resolver *resolver) {
+    return resolver->state == DRS_SHUTTING_DOWN && resolver->pending_host_entry_shutdown_completion_callbacks == 0 &&
+           resolver->pool_thread_count == 0;
+}
+
 /*
  * resolver lock must be held before calling this function
  */
@@ -304,6 +465,9 @@ static int resolver_purge_cache(struct aws_host_resolver *resolver) {
     struct default_host_resolver *default_host_resolver = resolver->impl;
     aws_mutex_lock(&default_host_resolver->resolver_lock);
     s_clear_default_resolver_entry_table(default_host_resolver);
+    if (default_host_resolver->stale_hosts != NULL) {
+        aws_cache_clear(default_host_resolver->stale_hosts);
+    }
     aws_mutex_unlock(&default_host_resolver->resolver_lock);
 
     return AWS_OP_SUCCESS;
@@ -315,6 +479,19 @@ static void s_cleanup_default_resolver(struct aws_host_resolver *resolver) {
     aws_hash_table_clean_up(&default_host_resolver->host_entry_table);
     aws_hash_table_clean_up(&default_host_resolver->listener_entry_table);
 
+    if (default_host_resolver->stale_hosts != NULL) {
+        aws_cache_destroy(default_host_resolver->stale_hosts);
+    }
+
+    /* every entry withdraws its snapshot before it goes away, so these are empty */
+    for (size_t i = 0; i < HOST_SNAPSHOT_SHARD_COUNT; ++i) {
+        struct host_snapshot_shard *shard = &default_host_resolver->snapshot_shards[i];
+        aws_hash_table_clean_up(&shard->snapshots);
+        aws_rw_lock_clean_up(&shard->lock);
+    }
+
+    s_resolver_thread_pool_destroy(default_host_resolver->thread_pool);
+
     aws_mutex_clean_up(&default_host_resolver->resolver_lock);
 
     aws_simple_completion_callback *shutdown_callback = resolver->shutdown_options.shutdown_callback_fn;
@@ -341,11 +518,16 @@ static void resolver_destroy(struct aws_host_resolver *resolver) {
 
     s_clear_default_resolver_entry_table(default_host_resolver);
     default_host_resolver->state = DRS_SHUTTING_DOWN;
-    if (default_host_resolver->pending_host_entry_shutdown_completion_callbacks == 0) {
-        cleanup_resolver = true;
-    }
+    cleanup_resolver = s_default_resolver_is_drained(default_host_resolver);
+
+    /* once unlocked, the resolver may be cleaned up by its last entry thread, but never before the pool shuts down */
+    struct resolver_thread_pool *thread_pool = default_host_resolver->thread_pool;
     aws_mutex_unlock(&default_host_resolver->resolver_lock);
 
+    if (thread_pool != NULL) {
+        s_resolver_thread_pool_shut_down(thread_pool);
+    }
+
     if (cleanup_resolver) {
         s_cleanup_default_resolver(resolver);
     }
@@ -406,6 +588,18 @@ static void s_clean_up_host_entry(struct host_entry *entry) {
     s_clear_address_list(&entry->expired_addresses);
     aws_array_list_clean_up(&entry->expired_addresses);
 
+    AWS_FATAL_ASSERT(entry->published_snapshot == NULL);
+
+    /* listeners are handed back to the resolver before an entry finishes */
+    AWS_FATAL_ASSERT(aws_linked_list_empty(&entry->threaded_data.listener_list));
+    AWS_FATAL_ASSERT(aws_linked_list_empty(&entry->threaded_data.listener_destroy_list));
+    AWS_FATAL_ASSERT(aws_array_list_length(&entry->threaded_data.address_list) == 0);
+    AWS_FATAL_ASSERT(aws_array_list_length(&entry->threaded_data.new_address_list) == 0);
+    AWS_FATAL_ASSERT(aws_array_list_length(&entry->threaded_data.expired_address_list) == 0);
+    aws_array_list_clean_up(&entry->threaded_data.address_list);
+    aws_array_list_clean_up(&entry->threaded_data.new_address_list);
+    aws_array_list_clean_up(&entry->threaded_data.expired_address_list);
+
     aws_mem_release(entry->allocator, entry);
 }
 
@@ -420,10 +614,7 @@ static void s_on_host_entry_shutdown_completion(void *user_data) {
 
     aws_mutex_lock(&default_host_resolver->resolver_lock);
     --default_host_resolver->pending_host_entry_shutdown_completion_callbacks;
-    if (default_host_resolver->state == DRS_SHUTTING_DOWN &&
-        default_host_resolver->pending_host_entry_shutdown_completion_callbacks == 0) {
-        cleanup_resolver = true;
-    }
+    cleanup_resolver = s_default_resolver_is_drained(default_host_resolver);
     aws_mutex_unlock(&default_host_resolver->resolver_lock);
 
     if (cleanup_resolver) {
@@ -477,11 +668,19 @@ static uint64_t s_get_system_time_for_default_resolver(struct aws_host_resolver
 static inline void process_records(
     struct host_entry *host_entry,
     struct aws_cache *records,
-    struct aws_cache *failed_records) {
+    struct aws_cache *failed_records,
+    bool resolve_succeeded) {
 
     struct aws_host_resolver *resolver = host_entry->resolver;
     uint64_t timestamp = s_get_system_time_for_default_resolver(resolver);
 
+    /* while dns is failing, expired records may keep being served for up to max_stale_ns */
+    uint64_t purge_before = timestamp;
+    if (!resolve_succeeded) {
+        uint64_t max_stale_ns = ((struct default_host_resolver *)resolver->impl)->max_stale_ns;
+        purge_before = timestamp > max_stale_ns ? timestamp - max_stale_ns : 0;
+    }
+
     size_t record_count = aws_cache_get_element_count(records);
     size_t expired_records = 0;
 
@@ -490,7 +689,7 @@ static inline void process_records(
     for (size_t index = 0; index < record_count && expired_records < record_count - 1; ++index) {
         struct aws_host_address_cache_entry *lru_element_entry = aws_lru_cache_use_lru_element(records);
 
-        if (lru_element_entry->address.expiry < timestamp) {
+        if (lru_element_entry->address.expiry < purge_before) {
             AWS_LOGF_DEBUG(
                 AWS_LS_IO_DNS,
                 "static: purging expired record %s for %s",
@@ -608,6 +807,9 @@ static int resolver_record_connection_failure(struct aws_host_resolver *resolver
             if (aws_cache_put(failed_table, address_entry_copy->address.address, address_entry_copy)) {
                 goto error_host_entry_cleanup;
             }
+
+            /* stop vending the failed address from cache hits */
+            s_publish_host_entry_snapshot(host_entry);
         } else {
             if (aws_cache_find(failed_table, address->address, (void **)&cached_address_entry)) {
                 goto error_host_entry_cleanup;
@@ -702,171 +904,655 @@ static struct aws_host_address_cache_entry *s_get_lru_address(
     }
 }
 
-static void s_update_address_cache(
-    struct host_entry *host_entry,
-    struct aws_array_list *address_list,
-    uint64_t new_expiration) {
-
-    AWS_PRECONDITION(host_entry);
-    AWS_PRECONDITION(address_list);
-
-    for (size_t i = 0; i < aws_array_list_length(address_list); ++i) {
-        struct aws_host_address *fresh_resolved_address = NULL;
-        aws_array_list_get_at_ptr(address_list, (void **)&fresh_resolved_address, i);
-
-        struct aws_host_address_cache_entry *address_to_cache_entry = s_find_cached_address_entry(
-            host_entry, fresh_resolved_address->address, fresh_resolved_address->record_type);
+/*
+ * Cache hits don't touch the entry's caches, just the published snapshot, so snapshot reads and writes live here.
+ */
 
-        if (address_to_cache_entry) {
-            address_to_cache_entry->address.expiry = new_expiration;
-            AWS_LOGF_TRACE(
-                AWS_LS_IO_DNS,
-                "static: updating expiry for %s for host %s to %llu",
-                address_to_cache_entry->address.address->bytes,
-                host_entry->host_name->bytes,
-                (unsigned long long)new_expiration);
-        } else {
-            address_to_cache_entry =
-                aws_mem_calloc(host_entry->allocator, 1, sizeof(struct aws_host_address_cache_entry));
+static struct host_snapshot_shard *s_get_snapshot_shard(
+    struct default_host_resolver *resolver,
+    const struct aws_string *host_name) {
 
-            aws_host_address_move(fresh_resolved_address, &address_to_cache_entry->address);
-            address_to_cache_entry->address.expiry = new_expiration;
-            address_to_cache_entry->entry = host_entry;
+    return &resolver->snapshot_shards[aws_hash_string(host_name) % HOST_SNAPSHOT_SHARD_COUNT];
+}
 
-            struct aws_cache *address_table =
-                address_to_cache_entry->address.record_type == AWS_ADDRESS_RECORD_TYPE_AAAA ? host_entry->aaaa_records
-                                                                                            : host_entry->a_records;
+static void s_host_address_snapshot_release(struct host_address_snapshot *snapshot) {
+    if (snapshot == NULL || aws_atomic_fetch_sub(&snapshot->ref_count, 1) != 1) {
+        return;
+    }
 
-            if (aws_cache_put(address_table, address_to_cache_entry->address.address, address_to_cache_entry)) {
-                AWS_LOGF_ERROR(
-                    AWS_LS_IO_DNS,
-                    "static: could not add new address to host entry cache for host '%s' in "
-                    "s_update_address_cache.",
-                    host_entry->host_name->bytes);
+    s_clear_address_list(&snapshot->aaaa_addresses);
+    aws_array_list_clean_up(&snapshot->aaaa_addresses);
+    s_clear_address_list(&snapshot->a_addresses);
+    aws_array_list_clean_up(&snapshot->a_addresses);
+    aws_mem_release(snapshot->allocator, snapshot);
+}
 
-                continue;
-            }
+/*
+ * Copies a good address cache into list, least recently used first. Hits rotate through the published snapshot rather
+ * than the cache, so the cache is first caught up with the `vended` addresses they've handed out since.
+ */
+static int s_copy_cache_into_snapshot_list(struct aws_cache *records, size_t vended, struct aws_array_list *list) {
+    size_t record_count = aws_cache_get_element_count(records);
+    if (record_count == 0) {
+        return AWS_OP_SUCCESS;
+    }
 
-            AWS_LOGF_DEBUG(
-                AWS_LS_IO_DNS,
-                "static: new address resolved %s for host %s caching",
-                address_to_cache_entry->address.address->bytes,
-                host_entry->host_name->bytes);
+    for (size_t i = 0; i < vended % record_count; ++i) {
+        aws_lru_cache_use_lru_element(records);
+    }
 
-            struct aws_host_address new_address_copy;
+    /* going all the way around leaves the cache as it was */
+    for (size_t i = 0; i < record_count; ++i) {
+        struct aws_host_address_cache_entry *record = aws_lru_cache_use_lru_element(records);
+        if (s_copy_address_into_array_list(&record->address, list)) {
+            return AWS_OP_ERR;
+        }
+    }
 
-            if (aws_host_address_copy(&address_to_cache_entry->address, &new_address_copy)) {
-                AWS_LOGF_ERROR(
-                    AWS_LS_IO_DNS,
-                    "static: could not copy address for new-address list for host '%s' in s_update_address_cache.",
-                    host_entry->host_name->bytes);
+    return AWS_OP_SUCCESS;
+}
 
-                continue;
-            }
+static struct host_address_snapshot *s_host_address_snapshot_new(
+    struct host_entry *host_entry,
+    size_t aaaa_vended,
+    size_t a_vended) {
 
-            if (aws_array_list_push_back(&host_entry->new_addresses, &new_address_copy)) {
-                aws_host_address_clean_up(&new_address_copy);
+    struct host_address_snapshot *snapshot =
+        aws_mem_calloc(host_entry->allocator, 1, sizeof(struct host_address_snapshot));
+    if (snapshot == NULL) {
+        return NULL;
+    }
 
-                AWS_LOGF_ERROR(
-                    AWS_LS_IO_DNS,
-                    "static: could not push address to new-address list for host '%s' in s_update_address_cache.",
-                    host_entry->host_name->bytes);
+    snapshot->allocator = host_entry->allocator;
+    snapshot->entry = host_entry;
+    aws_atomic_init_int(&snapshot->ref_count, 1);
+    aws_atomic_init_int(&snapshot->aaaa_vended, 0);
+    aws_atomic_init_int(&snapshot->a_vended, 0);
 
-                continue;
-            }
-        }
+    if (aws_array_list_init_dynamic(
+            &snapshot->aaaa_addresses,
+            host_entry->allocator,
+            aws_cache_get_element_count(host_entry->aaaa_records),
+            sizeof(struct aws_host_address)) ||
+        aws_array_list_init_dynamic(
+            &snapshot->a_addresses,
+            host_entry->allocator,
+            aws_cache_get_element_count(host_entry->a_records),
+            sizeof(struct aws_host_address)) ||
+        s_copy_cache_into_snapshot_list(host_entry->aaaa_records, aaaa_vended, &snapshot->aaaa_addresses) ||
+        s_copy_cache_into_snapshot_list(host_entry->a_records, a_vended, &snapshot->a_addresses)) {
+
+        s_host_address_snapshot_release(snapshot);
+        return NULL;
     }
+
+    return snapshot;
 }
 
-static void s_copy_address_into_callback_set(
-    struct aws_host_address_cache_entry *entry,
-    struct aws_array_list *callback_addresses,
-    const struct aws_string *host_name) {
+/*
+ * Withdraws the entry's snapshot, sending cache hits for its host back to the locked path. The entry lock must be held.
+ */
+static void s_withdraw_host_entry_snapshot(struct host_entry *host_entry) {
+    struct host_address_snapshot *snapshot = host_entry->published_snapshot;
+    if (snapshot == NULL) {
+        return;
+    }
 
-    if (entry != NULL) {
-        if (s_copy_address_into_array_list(&entry->address, callback_addresses)) {
-            AWS_LOGF_ERROR(
-                AWS_LS_IO_DNS,
-                "static: failed to vend address %s for host %s to caller",
-                entry->address.address->bytes,
-                host_name->bytes);
-            return;
-        }
+    struct host_snapshot_shard *shard = s_get_snapshot_shard(host_entry->resolver->impl, host_entry->host_name);
+    aws_rw_lock_wlock(&shard->lock);
+    aws_hash_table_remove(&shard->snapshots, host_entry->host_name, NULL, NULL);
+    aws_rw_lock_wunlock(&shard->lock);
 
-        entry->address.use_count += 1;
+    host_entry->published_snapshot = NULL;
+    s_host_address_snapshot_release(snapshot);
+}
 
-        AWS_LOGF_TRACE(
-            AWS_LS_IO_DNS,
-            "static: vending address %s for host %s to caller",
-            entry->address.address->bytes,
-            host_name->bytes);
+/*
+ * Publishes a fresh snapshot of the entry's good addresses for cache hits to read, or withdraws the current one if
+ * there are none. The entry lock must be held.
+ */
+static void s_publish_host_entry_snapshot(struct host_entry *host_entry) {
+    /* a retired entry may still be finishing a resolve, it must not shadow its replacement */
+    if (host_entry->state != DRS_ACTIVE ||
+        aws_cache_get_element_count(host_entry->aaaa_records) + aws_cache_get_element_count(host_entry->a_records) ==
+            0) {
+        s_withdraw_host_entry_snapshot(host_entry);
+        return;
     }
-}
 
-static bool s_host_entry_finished_pred(void *user_data) {
-    struct host_entry *entry = user_data;
+    size_t aaaa_vended = 0;
+    size_t a_vended = 0;
+    struct host_address_snapshot *previous = host_entry->published_snapshot;
+    if (previous != NULL) {
+        aaaa_vended = aws_atomic_load_int(&previous->aaaa_vended);
+        a_vended = aws_atomic_load_int(&previous->a_vended);
+    }
 
-    return entry->state == DRS_SHUTTING_DOWN;
-}
+    struct host_address_snapshot *snapshot = s_host_address_snapshot_new(host_entry, aaaa_vended, a_vended);
+    if (snapshot == NULL) {
+        AWS_LOGF_ERROR(
+            AWS_LS_IO_DNS,
+            "static: could not snapshot addresses for host %s, cache hits will take the locked path",
+            host_entry->host_name->bytes);
+        s_withdraw_host_entry_snapshot(host_entry);
+        return;
+    }
 
-/* Move all of the listeners in the host-resolver-owned listener entry to the resolver thread owned list. */
-/* Assumes resolver_lock is held so that we can pop from the listener entry and access the listener's synced_data. */
-static void s_resolver_thread_move_listeners_from_listener_entry(
-    struct default_host_resolver *resolver,
-    const struct aws_string *host_name,
-    struct aws_linked_list *listener_list) {
+    struct host_snapshot_shard *shard = s_get_snapshot_shard(host_entry->resolver->impl, host_entry->host_name);
+    aws_rw_lock_wlock(&shard->lock);
+    int put_result = aws_hash_table_put(&shard->snapshots, host_entry->host_name, snapshot, NULL);
+    if (put_result) {
+        aws_hash_table_remove(&shard->snapshots, host_entry->host_name, NULL, NULL);
+    }
+    aws_rw_lock_wunlock(&shard->lock);
 
-    AWS_PRECONDITION(resolver);
-    AWS_PRECONDITION(host_name);
-    AWS_PRECONDITION(listener_list);
+    if (put_result) {
+        s_host_address_snapshot_release(snapshot);
+        snapshot = NULL;
+    }
 
-    struct host_listener_entry *listener_entry = NULL;
-    struct host_listener *listener = s_pop_host_listener_from_entry(resolver, host_name, &listener_entry);
+    host_entry->published_snapshot = snapshot;
+    s_host_address_snapshot_release(previous);
+}
 
-    while (listener != NULL) {
-        /* Flag this listener as in-use by the resolver thread so that it can't be destroyed from outside of that
-         * thread. */
-        listener->synced_data.owned_by_resolver_thread = true;
+/* Called for every query of the entry's host, cache hits included, so it mustn't rely on any lock being held. */
+static void s_host_entry_record_request(struct host_entry *host_entry, uint64_t timestamp) {
+    aws_atomic_store_int(
+        &host_entry->last_resolve_request_timestamp_secs, (size_t)((timestamp + NS_PER_SEC - 1) / NS_PER_SEC));
+    aws_atomic_store_int(&host_entry->resolves_since_last_request, 0);
+}
 
-        aws_linked_list_push_back(listener_list, &listener->threaded_data.node);
+static void s_copy_snapshot_address_into_callback_set(
+    const struct aws_array_list *snapshot_addresses,
+    size_t vended,
+    struct aws_array_list *callback_addresses) {
 
-        listener = s_pop_host_listener_from_entry(resolver, host_name, &listener_entry);
+    size_t address_count = aws_array_list_length(snapshot_addresses);
+    if (address_count == 0) {
+        return;
     }
+
+    struct aws_host_address *address = NULL;
+    aws_array_list_get_at_ptr(snapshot_addresses, (void **)&address, vended % address_count);
+    s_copy_address_into_array_list(address, callback_addresses);
 }
 
-/* When the thread is ready to exit, we move all of the listeners back to the host-resolver-owned listener entry.*/
-/* Assumes that we have already removed all pending_destroy listeners via
- * s_resolver_thread_cull_pending_destroy_listeners. */
-/* Assumes resolver_lock is held so that we can write to the listener entry and read/write from the listener's
- * synced_data. */
-static int s_resolver_thread_move_listeners_to_listener_entry(
-    struct default_host_resolver *resolver,
+/*
+ * Answers a query from its host's published snapshot, taking only the snapshot shard's read lock. Returns false if
+ * there's no snapshot, in which case the query has to go through the resolver's locks.
+ */
+static bool s_resolve_host_from_snapshot(
+    struct aws_host_resolver *resolver,
     const struct aws_string *host_name,
-    struct aws_linked_list *listener_list) {
-
-    AWS_PRECONDITION(resolver);
-    AWS_PRECONDITION(host_name);
-    AWS_PRECONDITION(listener_list);
+    aws_on_host_resolved_result_fn *res,
+    void *user_data,
+    uint64_t timestamp,
+    int *result) {
 
-    int result = 0;
-    size_t num_listeners_not_moved = 0;
+    struct host_snapshot_shard *shard = s_get_snapshot_shard(resolver->impl, host_name);
 
-    while (!aws_linked_list_empty(listener_list)) {
-        struct aws_linked_list_node *listener_node = aws_linked_list_pop_back(listener_list);
-        struct host_listener *listener = HOST_LISTENER_FROM_THREADED_NODE(listener_node);
+    size_t aaaa_vended = 0;
+    size_t a_vended = 0;
+    struct host_address_snapshot *snapshot = NULL;
 
-        /* Flag this listener as no longer in-use by the resolver thread. */
-        listener->synced_data.owned_by_resolver_thread = false;
+    aws_rw_lock_rlock(&shard->lock);
+    struct aws_hash_element *element = NULL;
+    aws_hash_table_find(&shard->snapshots, host_name, &element);
+    if (element != NULL) {
+        snapshot = element->value;
+        aws_atomic_fetch_add(&snapshot->ref_count, 1);
 
-        AWS_ASSERT(!listener->synced_data.pending_destroy);
+        /* a published snapshot's entry can't be cleaned up before the snapshot is withdrawn under this lock */
+        s_host_entry_record_request(snapshot->entry, timestamp);
+        aaaa_vended = aws_atomic_fetch_add(&snapshot->aaaa_vended, 1);
+        a_vended = aws_atomic_fetch_add(&snapshot->a_vended, 1);
+    }
+    aws_rw_lock_runlock(&shard->lock);
 
-        if (s_add_host_listener_to_listener_entry(resolver, host_name, listener)) {
-            result = AWS_OP_ERR;
-            ++num_listeners_not_moved;
-        }
+    if (snapshot == NULL) {
+        return false;
     }
 
-    if (result == AWS_OP_ERR) {
+    AWS_LOGF_DEBUG(
+        AWS_LS_IO_DNS, "id=%p: cached entries found for %s returning to caller.", (void *)resolver, host_name->bytes);
+
+    struct aws_host_address address_array[2];
+    AWS_ZERO_ARRAY(address_array);
+    struct aws_array_list callback_address_list;
+    aws_array_list_init_static(&callback_address_list, address_array, 2, sizeof(struct aws_host_address));
+
+    s_copy_snapshot_address_into_callback_set(&snapshot->aaaa_addresses, aaaa_vended, &callback_address_list);
+    s_copy_snapshot_address_into_callback_set(&snapshot->a_addresses, a_vended, &callback_address_list);
+    s_host_address_snapshot_release(snapshot);
+
+    *result = AWS_OP_SUCCESS;
+    if (aws_array_list_length(&callback_address_list)) {
+        res(resolver, host_name, AWS_OP_SUCCESS, &callback_address_list, user_data);
+    } else {
+        res(resolver, host_name, aws_last_error(), NULL, user_data);
+        *result = AWS_OP_ERR;
+    }
+
+    s_clear_address_list(&callback_address_list);
+    aws_array_list_clean_up(&callback_address_list);
+
+    return true;
+}
+
+/*
+ * Serving stale: entries that retire for lack of queries leave their addresses behind, as do cache files loaded at
+ * startup, so that the host's next query is answered straight away while a new entry re-resolves it.
+ */
+
+static int s_stale_host_init(struct stale_host *stale_host, struct aws_allocator *allocator) {
+    AWS_ZERO_STRUCT(*stale_host);
+    stale_host->allocator = allocator;
+
+    if (aws_array_list_init_dynamic(&stale_host->addresses, allocator, 4, sizeof(struct aws_host_address))) {
+        return AWS_OP_ERR;
+    }
+
+    if (aws_array_list_init_dynamic(&stale_host->failed_addresses, allocator, 0, sizeof(struct aws_host_address))) {
+        aws_array_list_clean_up(&stale_host->addresses);
+        return AWS_OP_ERR;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_stale_host_clean_up(struct stale_host *stale_host) {
+    s_clear_address_list(&stale_host->addresses);
+    aws_array_list_clean_up(&stale_host->addresses);
+    s_clear_address_list(&stale_host->failed_addresses);
+    aws_array_list_clean_up(&stale_host->failed_addresses);
+    aws_string_destroy(stale_host->host_name);
+    stale_host->host_name = NULL;
+}
+
+static void s_stale_host_destroy(void *value) {
+    struct stale_host *stale_host = value;
+    if (stale_host == NULL) {
+        return;
+    }
+
+    s_stale_host_clean_up(stale_host);
+    aws_mem_release(stale_host->allocator, stale_host);
+}
+
+/*
+ * Copies every address an entry has, good and failed. The entry lock must be held.
+ */
+static struct stale_host *s_stale_host_new_from_entry(struct aws_allocator *allocator, struct host_entry *host_entry) {
+    struct stale_host *stale_host = aws_mem_calloc(allocator, 1, sizeof(struct stale_host));
+    if (stale_host == NULL) {
+        return NULL;
+    }
+
+    if (s_stale_host_init(stale_host, allocator)) {
+        aws_mem_release(allocator, stale_host);
+        return NULL;
+    }
+
+    stale_host->host_name = aws_string_new_from_string(allocator, host_entry->host_name);
+    if (stale_host->host_name == NULL ||
+        s_copy_cache_into_snapshot_list(host_entry->aaaa_records, 0, &stale_host->addresses) ||
+        s_copy_cache_into_snapshot_list(host_entry->a_records, 0, &stale_host->addresses) ||
+        s_copy_cache_into_snapshot_list(
+            host_entry->failed_connection_aaaa_records, 0, &stale_host->failed_addresses) ||
+        s_copy_cache_into_snapshot_list(host_entry->failed_connection_a_records, 0, &stale_host->failed_addresses)) {
+
+        s_stale_host_destroy(stale_host);
+        return NULL;
+    }
+
+    return stale_host;
+}
+
+/* Adds or replaces the host's stale addresses. Takes ownership of stale_host. The resolver lock must be held. */
+static int s_put_stale_host(struct default_host_resolver *resolver, struct stale_host *stale_host) {
+    aws_cache_remove(resolver->stale_hosts, stale_host->host_name);
+    if (aws_cache_put(resolver->stale_hosts, stale_host->host_name, stale_host)) {
+        s_stale_host_destroy(stale_host);
+        return AWS_OP_ERR;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * Keeps the addresses of an entry that's retiring. The resolver and entry locks must be held.
+ */
+static void s_stash_stale_host(struct default_host_resolver *resolver, struct host_entry *host_entry) {
+    if (resolver->max_stale_ns == 0 || resolver->state != DRS_ACTIVE) {
+        return;
+    }
+
+    struct stale_host *stale_host = s_stale_host_new_from_entry(resolver->allocator, host_entry);
+    if (stale_host == NULL) {
+        return;
+    }
+
+    if (aws_array_list_length(&stale_host->addresses) == 0) {
+        s_stale_host_destroy(stale_host);
+        return;
+    }
+
+    AWS_LOGF_DEBUG(
+        AWS_LS_IO_DNS,
+        "static: keeping %d addresses of retired host %s to serve stale",
+        (int)aws_array_list_length(&stale_host->addresses),
+        host_entry->host_name->bytes);
+
+    s_put_stale_host(resolver, stale_host);
+}
+
+static void s_copy_servable_addresses(
+    const struct aws_array_list *from,
+    uint64_t not_expired_before,
+    struct aws_array_list *to) {
+
+    for (size_t i = 0; i < aws_array_list_length(from); ++i) {
+        struct aws_host_address *address = NULL;
+        aws_array_list_get_at_ptr(from, (void **)&address, i);
+        if (address->expiry >= not_expired_before) {
+            s_copy_address_into_array_list(address, to);
+        }
+    }
+}
+
+/*
+ * Takes the host's stale addresses that are still fit to serve into stale_host, which is initialized only when this
+ * returns true. The resolver lock must be held.
+ */
+static bool s_take_stale_host(
+    struct default_host_resolver *resolver,
+    const struct aws_string *host_name,
+    uint64_t timestamp,
+    struct stale_host *stale_host) {
+
+    struct stale_host *cached = NULL;
+    aws_cache_find(resolver->stale_hosts, host_name, (void **)&cached);
+    if (cached == NULL) {
+        return false;
+    }
+
+    if (s_stale_host_init(stale_host, resolver->allocator)) {
+        aws_cache_remove(resolver->stale_hosts, host_name);
+        return false;
+    }
+
+    uint64_t not_expired_before = timestamp > resolver->max_stale_ns ? timestamp - resolver->max_stale_ns : 0;
+    s_copy_servable_addresses(&cached->addresses, not_expired_before, &stale_host->addresses);
+    s_copy_servable_addresses(&cached->failed_addresses, not_expired_before, &stale_host->failed_addresses);
+
+    aws_cache_remove(resolver->stale_hosts, host_name);
+
+    if (aws_array_list_length(&stale_host->addresses) == 0) {
+        s_stale_host_clean_up(stale_host);
+        return false;
+    }
+
+    return true;
+}
+
+static int s_seed_host_entry_cache(
+    struct host_entry *host_entry,
+    const struct aws_array_list *addresses,
+    struct aws_cache *aaaa_records,
+    struct aws_cache *a_records) {
+
+    for (size_t i = 0; i < aws_array_list_length(addresses); ++i) {
+        struct aws_host_address *address = NULL;
+        aws_array_list_get_at_ptr(addresses, (void **)&address, i);
+
+        struct aws_host_address_cache_entry *cache_entry =
+            aws_mem_calloc(host_entry->allocator, 1, sizeof(struct aws_host_address_cache_entry));
+        if (cache_entry == NULL) {
+            return AWS_OP_ERR;
+        }
+
+        if (aws_host_address_copy(address, &cache_entry->address)) {
+            aws_mem_release(host_entry->allocator, cache_entry);
+            return AWS_OP_ERR;
+        }
+
+        cache_entry->entry = host_entry;
+        struct aws_cache *records = address->record_type == AWS_ADDRESS_RECORD_TYPE_AAAA ? aaaa_records : a_records;
+        if (aws_cache_put(records, cache_entry->address.address, cache_entry)) {
+            aws_host_address_clean_up(&cache_entry->address);
+            aws_mem_release(host_entry->allocator, cache_entry);
+            return AWS_OP_ERR;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/* Puts a host's stale addresses back into its new entry's caches. */
+static int s_seed_host_entry_caches(struct host_entry *host_entry, const struct stale_host *stale_host) {
+    if (s_seed_host_entry_cache(host_entry, &stale_host->addresses, host_entry->aaaa_records, host_entry->a_records)) {
+        return AWS_OP_ERR;
+    }
+
+    return s_seed_host_entry_cache(
+        host_entry,
+        &stale_host->failed_addresses,
+        host_entry->failed_connection_aaaa_records,
+        host_entry->failed_connection_a_records);
+}
+
+/* Answers a query for a host whose entry just came back, with one address of each type it last had. */
+static void s_resolve_host_from_stale_addresses(
+    struct aws_host_resolver *resolver,
+    const struct aws_string *host_name,
+    const struct stale_host *stale_host,
+    aws_on_host_resolved_result_fn *res,
+    void *user_data) {
+
+    struct aws_host_address address_array[2];
+    AWS_ZERO_ARRAY(address_array);
+    struct aws_array_list callback_address_list;
+    aws_array_list_init_static(&callback_address_list, address_array, 2, sizeof(struct aws_host_address));
+
+    bool has_aaaa = false;
+    bool has_a = false;
+    for (size_t i = 0; i < aws_array_list_length(&stale_host->addresses); ++i) {
+        struct aws_host_address *address = NULL;
+        aws_array_list_get_at_ptr(&stale_host->addresses, (void **)&address, i);
+
+        bool *has_type = address->record_type == AWS_ADDRESS_RECORD_TYPE_AAAA ? &has_aaaa : &has_a;
+        if (!*has_type && !s_copy_address_into_array_list(address, &callback_address_list)) {
+            *has_type = true;
+        }
+    }
+
+    AWS_LOGF_DEBUG(
+        AWS_LS_IO_DNS,
+        "id=%p: serving stale addresses for %s while it is re-resolved.",
+        (void *)resolver,
+        host_name->bytes);
+
+    if (aws_array_list_length(&callback_address_list)) {
+        res(resolver, host_name, AWS_OP_SUCCESS, &callback_address_list, user_data);
+    } else {
+        res(resolver, host_name, aws_last_error(), NULL, user_data);
+    }
+
+    s_clear_address_list(&callback_address_list);
+    aws_array_list_clean_up(&callback_address_list);
+}
+
+static void s_update_address_cache(
+    struct host_entry *host_entry,
+    struct aws_array_list *address_list,
+    uint64_t max_expiration) {
+
+    AWS_PRECONDITION(host_entry);
+    AWS_PRECONDITION(address_list);
+
+    for (size_t i = 0; i < aws_array_list_length(address_list); ++i) {
+        struct aws_host_address *fresh_resolved_address = NULL;
+        aws_array_list_get_at_ptr(address_list, (void **)&fresh_resolved_address, i);
+
+        /* the record's own ttl, if the resolve implementation knows it, but never more than max_ttl */
+        uint64_t new_expiration = max_expiration;
+        if (fresh_resolved_address->expiry != 0 && fresh_resolved_address->expiry < max_expiration) {
+            new_expiration = fresh_resolved_address->expiry;
+        }
+
+        struct aws_host_address_cache_entry *address_to_cache_entry = s_find_cached_address_entry(
+            host_entry, fresh_resolved_address->address, fresh_resolved_address->record_type);
+
+        if (address_to_cache_entry) {
+            address_to_cache_entry->address.expiry = new_expiration;
+            AWS_LOGF_TRACE(
+                AWS_LS_IO_DNS,
+                "static: updating expiry for %s for host %s to %llu",
+                address_to_cache_entry->address.address->bytes,
+                host_entry->host_name->bytes,
+                (unsigned long long)new_expiration);
+        } else {
+            address_to_cache_entry =
+                aws_mem_calloc(host_entry->allocator, 1, sizeof(struct aws_host_address_cache_entry));
+
+            aws_host_address_move(fresh_resolved_address, &address_to_cache_entry->address);
+            address_to_cache_entry->address.expiry = new_expiration;
+            address_to_cache_entry->entry = host_entry;
+
+            struct aws_cache *address_table =
+                address_to_cache_entry->address.record_type == AWS_ADDRESS_RECORD_TYPE_AAAA ? host_entry->aaaa_records
+                                                                                            : host_entry->a_records;
+
+            if (aws_cache_put(address_table, address_to_cache_entry->address.address, address_to_cache_entry)) {
+                AWS_LOGF_ERROR(
+                    AWS_LS_IO_DNS,
+                    "static: could not add new address to host entry cache for host '%s' in "
+                    "s_update_address_cache.",
+                    host_entry->host_name->bytes);
+
+                continue;
+            }
+
+            AWS_LOGF_DEBUG(
+                AWS_LS_IO_DNS,
+                "static: new address resolved %s for host %s caching",
+                address_to_cache_entry->address.address->bytes,
+                host_entry->host_name->bytes);
+
+            struct aws_host_address new_address_copy;
+
+            if (aws_host_address_copy(&address_to_cache_entry->address, &new_address_copy)) {
+                AWS_LOGF_ERROR(
+                    AWS_LS_IO_DNS,
+                    "static: could not copy address for new-address list for host '%s' in s_update_address_cache.",
+                    host_entry->host_name->bytes);
+
+                continue;
+            }
+
+            if (aws_array_list_push_back(&host_entry->new_addresses, &new_address_copy)) {
+                aws_host_address_clean_up(&new_address_copy);
+
+                AWS_LOGF_ERROR(
+                    AWS_LS_IO_DNS,
+                    "static: could not push address to new-address list for host '%s' in s_update_address_cache.",
+                    host_entry->host_name->bytes);
+
+                continue;
+            }
+        }
+    }
+}
+
+static void s_copy_address_into_callback_set(
+    struct aws_host_address_cache_entry *entry,
+    struct aws_array_list *callback_addresses,
+    const struct aws_string *host_name) {
+
+    if (entry != NULL) {
+        if (s_copy_address_into_array_list(&entry->address, callback_addresses)) {
+            AWS_LOGF_ERROR(
+                AWS_LS_IO_DNS,
+                "static: failed to vend address %s for host %s to caller",
+                entry->address.address->bytes,
+                host_name->bytes);
+            return;
+        }
+
+        entry->address.use_count += 1;
+
+        AWS_LOGF_TRACE(
+            AWS_LS_IO_DNS,
+            "static: vending address %s for host %s to caller",
+            entry->address.address->bytes,
+            host_name->bytes);
+    }
+}
+
+static bool s_host_entry_finished_pred(void *user_data) {
+    struct host_entry *entry = user_data;
+
+    return entry->state == DRS_SHUTTING_DOWN;
+}
+
+/* Move all of the listeners in the host-resolver-owned listener entry to the resolver thread owned list. */
+/* Assumes resolver_lock is held so that we can pop from the listener entry and access the listener's synced_data. */
+static void s_resolver_thread_move_listeners_from_listener_entry(
+    struct default_host_resolver *resolver,
+    const struct aws_string *host_name,
+    struct aws_linked_list *listener_list) {
+
+    AWS_PRECONDITION(resolver);
+    AWS_PRECONDITION(host_name);
+    AWS_PRECONDITION(listener_list);
+
+    struct host_listener_entry *listener_entry = NULL;
+    struct host_listener *listener = s_pop_host_listener_from_entry(resolver, host_name, &listener_entry);
+
+    while (listener != NULL) {
+        /* Flag this listener as in-use by the resolver thread so that it can't be destroyed from outside of that
+         * thread. */
+        listener->synced_data.owned_by_resolver_thread = true;
+
+        aws_linked_list_push_back(listener_list, &listener->threaded_data.node);
+
+        listener = s_pop_host_listener_from_entry(resolver, host_name, &listener_entry);
+    }
+}
+
+/* When the thread is ready to exit, we move all of the listeners back to the host-resolver-owned listener entry.*/
+/* Assumes that we have already removed all pending_destroy listeners via
+ * s_resolver_thread_cull_pending_destroy_listeners. */
+/* Assumes resolver_lock is held so that we can write to the listener entry and read/write from the listener's
+ * synced_data. */
+static int s_resolver_thread_move_listeners_to_listener_entry(
+    struct default_host_resolver *resolver,
+    const struct aws_string *host_name,
+    struct aws_linked_list *listener_list) {
+
+    AWS_PRECONDITION(resolver);
+    AWS_PRECONDITION(host_name);
+    AWS_PRECONDITION(listener_list);
+
+    int result = 0;
+    size_t num_listeners_not_moved = 0;
+
+    while (!aws_linked_list_empty(listener_list)) {
+        struct aws_linked_list_node *listener_node = aws_linked_list_pop_back(listener_list);
+        struct host_listener *listener = HOST_LISTENER_FROM_THREADED_NODE(listener_node);
+
+        /* Flag this listener as no longer in-use by the resolver thread. */
+        listener->synced_data.owned_by_resolver_thread = false;
+
+        AWS_ASSERT(!listener->synced_data.pending_destroy);
+
+        if (s_add_host_listener_to_listener_entry(resolver, host_name, listener)) {
+            result = AWS_OP_ERR;
+            ++num_listeners_not_moved;
+        }
+    }
+
+    if (result == AWS_OP_ERR) {
         AWS_LOGF_ERROR(
             AWS_LS_IO_DNS,
             "static: could not move %" PRIu64 " listeners back to listener entry",
@@ -963,164 +1649,239 @@ static bool s_is_host_entry_pinned_by_listener(struct aws_linked_list *listener_
     return false;
 }
 
-static void resolver_thread_fn(void *arg) {
-    struct host_entry *host_entry = arg;
+/*
+ * Resolves the entry once: folds the results into its caches and answers every query that was waiting on them.
+ */
+static void s_resolve_host_entry(struct host_entry *host_entry) {
+    struct aws_array_list *address_list = &host_entry->threaded_data.address_list;
 
-    size_t unsolicited_resolve_max = host_entry->resolution_config.max_ttl;
-    if (unsolicited_resolve_max == 0) {
-        unsolicited_resolve_max = 1;
-    }
+    /* resolve and then process each record */
+    int err_code = AWS_ERROR_SUCCESS;
+    if (host_entry->resolution_config.impl(
+            host_entry->allocator, host_entry->host_name, address_list, host_entry->resolution_config.impl_data)) {
 
-    uint64_t max_no_solicitation_interval =
-        aws_timestamp_convert(unsolicited_resolve_max, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL);
+        err_code = aws_last_error();
+    }
 
-    struct aws_linked_list listener_list;
-    aws_linked_list_init(&listener_list);
+    if (err_code == AWS_ERROR_SUCCESS) {
+        AWS_LOGF_DEBUG(
+            AWS_LS_IO_DNS,
+            "static, resolving host %s successful, returned %d addresses",
+            aws_string_c_str(host_entry->host_name),
+            (int)aws_array_list_length(address_list));
+    } else {
+        AWS_LOGF_WARN(
+            AWS_LS_IO_DNS,
+            "static, resolving host %s failed, ec %d (%s)",
+            aws_string_c_str(host_entry->host_name),
+            err_code,
+            aws_error_debug_str(err_code));
+    }
 
-    struct aws_linked_list listener_destroy_list;
-    aws_linked_list_init(&listener_destroy_list);
+    uint64_t timestamp = s_get_system_time_for_default_resolver(host_entry->resolver);
+    uint64_t new_expiry = timestamp + (host_entry->resolution_config.max_ttl * NS_PER_SEC);
 
-    bool keep_going = true;
+    struct aws_linked_list pending_resolve_copy;
+    aws_linked_list_init(&pending_resolve_copy);
 
-    struct aws_array_list address_list;
-    AWS_ZERO_STRUCT(address_list);
-    struct aws_array_list new_address_list;
-    AWS_ZERO_STRUCT(new_address_list);
-    struct aws_array_list expired_address_list;
-    AWS_ZERO_STRUCT(expired_address_list);
+    /*
+     * Within the lock we
+     *  (1) Update the cache with the newly resolved addresses
+     *  (2) Process all held addresses looking for expired or promotable ones
+     *  (3) Prep for callback invocations
+     */
+    aws_mutex_lock(&host_entry->entry_lock);
 
-    if (aws_array_list_init_dynamic(&address_list, host_entry->allocator, 4, sizeof(struct aws_host_address))) {
-        goto done;
+    if (!err_code) {
+        s_update_address_cache(host_entry, address_list, new_expiry);
     }
 
-    if (aws_array_list_init_dynamic(&new_address_list, host_entry->allocator, 4, sizeof(struct aws_host_address))) {
-        goto done;
-    }
+    /*
+     * process and clean_up records in the entry. occasionally, failed connect records will be upgraded
+     * for retry.
+     */
+    process_records(host_entry, host_entry->aaaa_records, host_entry->failed_connection_aaaa_records, !err_code);
+    process_records(host_entry, host_entry->a_records, host_entry->failed_connection_a_records, !err_code);
 
-    if (aws_array_list_init_dynamic(&expired_address_list, host_entry->allocator, 4, sizeof(struct aws_host_address))) {
-        goto done;
-    }
+    aws_linked_list_swap_contents(&pending_resolve_copy, &host_entry->pending_resolution_callbacks);
 
-    while (keep_going) {
+    aws_mutex_unlock(&host_entry->entry_lock);
 
-        /* resolve and then process each record */
-        int err_code = AWS_ERROR_SUCCESS;
-        if (host_entry->resolution_config.impl(
-                host_entry->allocator, host_entry->host_name, &address_list, host_entry->resolution_config.impl_data)) {
+    /*
+     * Clean up resolved addressed outside of the lock
+     */
+    s_clear_address_list(address_list);
 
-            err_code = aws_last_error();
-        }
+    struct aws_host_address address_array[2];
+    AWS_ZERO_ARRAY(address_array);
+
+    /*
+     * Perform the actual subscriber notifications
+     */
+    while (!aws_linked_list_empty(&pending_resolve_copy)) {
+        struct aws_linked_list_node *resolution_callback_node = aws_linked_list_pop_front(&pending_resolve_copy);
+        struct pending_callback *pending_callback =
+            AWS_CONTAINER_OF(resolution_callback_node, struct pending_callback, node);
 
-        if (err_code == AWS_ERROR_SUCCESS) {
+        struct aws_array_list callback_address_list;
+        aws_array_list_init_static(&callback_address_list, address_array, 2, sizeof(struct aws_host_address));
+
+        aws_mutex_lock(&host_entry->entry_lock);
+        s_copy_address_into_callback_set(
+            s_get_lru_address(host_entry, AWS_ADDRESS_RECORD_TYPE_AAAA),
+            &callback_address_list,
+            host_entry->host_name);
+        s_copy_address_into_callback_set(
+            s_get_lru_address(host_entry, AWS_ADDRESS_RECORD_TYPE_A), &callback_address_list, host_entry->host_name);
+        aws_mutex_unlock(&host_entry->entry_lock);
+
+        size_t callback_address_list_size = aws_array_list_length(&callback_address_list);
+        if (callback_address_list_size > 0) {
             AWS_LOGF_DEBUG(
                 AWS_LS_IO_DNS,
-                "static, resolving host %s successful, returned %d addresses",
+                "static, invoking resolution callback for host %s with %d addresses",
                 aws_string_c_str(host_entry->host_name),
-                (int)aws_array_list_length(&address_list));
+                (int)callback_address_list_size);
         } else {
-            AWS_LOGF_WARN(
+            AWS_LOGF_DEBUG(
                 AWS_LS_IO_DNS,
-                "static, resolving host %s failed, ec %d (%s)",
-                aws_string_c_str(host_entry->host_name),
-                err_code,
-                aws_error_debug_str(err_code));
+                "static, invoking resolution callback for host %s with failure",
+                aws_string_c_str(host_entry->host_name));
         }
 
-        uint64_t timestamp = s_get_system_time_for_default_resolver(host_entry->resolver);
-        uint64_t new_expiry = timestamp + (host_entry->resolution_config.max_ttl * NS_PER_SEC);
+        if (callback_address_list_size > 0) {
+            pending_callback->callback(
+                host_entry->resolver,
+                host_entry->host_name,
+                AWS_OP_SUCCESS,
+                &callback_address_list,
+                pending_callback->user_data);
 
-        struct aws_linked_list pending_resolve_copy;
-        aws_linked_list_init(&pending_resolve_copy);
+        } else {
+            int error_code = (err_code != AWS_ERROR_SUCCESS) ? err_code : AWS_IO_DNS_QUERY_FAILED;
+            pending_callback->callback(
+                host_entry->resolver, host_entry->host_name, error_code, NULL, pending_callback->user_data);
+        }
 
-        /*
-         * Within the lock we
-         *  (1) Update the cache with the newly resolved addresses
-         *  (2) Process all held addresses looking for expired or promotable ones
-         *  (3) Prep for callback invocations
-         */
-        aws_mutex_lock(&host_entry->entry_lock);
+        s_clear_address_list(&callback_address_list);
 
-        if (!err_code) {
-            s_update_address_cache(host_entry, &address_list, new_expiry);
-        }
+        aws_mem_release(host_entry->allocator, pending_callback);
+    }
 
-        /*
-         * process and clean_up records in the entry. occasionally, failed connect records will be upgraded
-         * for retry.
-         */
-        process_records(host_entry, host_entry->aaaa_records, host_entry->failed_connection_aaaa_records);
-        process_records(host_entry, host_entry->a_records, host_entry->failed_connection_a_records);
+    /* published only now, so that cache hits pick up where the callbacks above left the caches' LRU order */
+    aws_mutex_lock(&host_entry->entry_lock);
+    s_publish_host_entry_snapshot(host_entry);
+    aws_mutex_unlock(&host_entry->entry_lock);
 
-        aws_linked_list_swap_contents(&pending_resolve_copy, &host_entry->pending_resolution_callbacks);
+    aws_atomic_fetch_add(&host_entry->resolves_since_last_request, 1);
 
-        aws_mutex_unlock(&host_entry->entry_lock);
+    host_entry->threaded_data.resolved_once = true;
+}
 
-        /*
-         * Clean up resolved addressed outside of the lock
-         */
-        s_clear_address_list(&address_list);
+/*
+ * Runs between two resolves of an entry: picks up and culls its listeners, decides whether the entry is still wanted
+ * and tells the listeners about any address changes. Returns false once the entry has been removed from the resolver's
+ * table, after which it must not be resolved again.
+ */
+static bool s_sync_host_entry_with_resolver(struct host_entry *host_entry) {
+    struct host_entry_threaded_data *threaded_data = &host_entry->threaded_data;
 
-        struct aws_host_address address_array[2];
-        AWS_ZERO_ARRAY(address_array);
+    size_t unsolicited_resolve_max = host_entry->resolution_config.max_ttl;
+    if (unsolicited_resolve_max == 0) {
+        unsolicited_resolve_max = 1;
+    }
 
-        /*
-         * Perform the actual subscriber notifications
-         */
-        while (!aws_linked_list_empty(&pending_resolve_copy)) {
-            struct aws_linked_list_node *resolution_callback_node = aws_linked_list_pop_front(&pending_resolve_copy);
-            struct pending_callback *pending_callback =
-                AWS_CONTAINER_OF(resolution_callback_node, struct pending_callback, node);
+    uint64_t max_no_solicitation_interval =
+        aws_timestamp_convert(unsolicited_resolve_max, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL);
 
-            struct aws_array_list callback_address_list;
-            aws_array_list_init_static(&callback_address_list, address_array, 2, sizeof(struct aws_host_address));
+    /*
+     * This is a bit awkward that we unlock the entry and then relock both the resolver and the entry, but it
+     * is mandatory that -- in order to maintain the consistent view of the resolver table (entry exist => entry
+     * is alive and can be queried) -- we have the resolver lock as well before making the decision to remove
+     * the entry from the table and terminate the thread.
+     */
+    struct default_host_resolver *resolver = host_entry->resolver->impl;
+    aws_mutex_lock(&resolver->resolver_lock);
 
-            aws_mutex_lock(&host_entry->entry_lock);
-            s_copy_address_into_callback_set(
-                s_get_lru_address(host_entry, AWS_ADDRESS_RECORD_TYPE_AAAA),
-                &callback_address_list,
-                host_entry->host_name);
-            s_copy_address_into_callback_set(
-                s_get_lru_address(host_entry, AWS_ADDRESS_RECORD_TYPE_A),
-                &callback_address_list,
-                host_entry->host_name);
-            aws_mutex_unlock(&host_entry->entry_lock);
+    /* Remove any listeners from our listener list that have been marked pending destroy, moving them into the
+     * destroy list. */
+    s_resolver_thread_cull_pending_destroy_listeners(
+        &threaded_data->listener_list, &threaded_data->listener_destroy_list);
 
-            size_t callback_address_list_size = aws_array_list_length(&callback_address_list);
-            if (callback_address_list_size > 0) {
-                AWS_LOGF_DEBUG(
-                    AWS_LS_IO_DNS,
-                    "static, invoking resolution callback for host %s with %d addresses",
-                    aws_string_c_str(host_entry->host_name),
-                    (int)callback_address_list_size);
-            } else {
-                AWS_LOGF_DEBUG(
-                    AWS_LS_IO_DNS,
-                    "static, invoking resolution callback for host %s with failure",
-                    aws_string_c_str(host_entry->host_name));
-            }
+    /* Grab any listeners on the listener entry, moving them into the local list. */
+    s_resolver_thread_move_listeners_from_listener_entry(
+        resolver, host_entry->host_name, &threaded_data->listener_list);
 
-            if (callback_address_list_size > 0) {
-                pending_callback->callback(
-                    host_entry->resolver,
-                    host_entry->host_name,
-                    AWS_OP_SUCCESS,
-                    &callback_address_list,
-                    pending_callback->user_data);
-
-            } else {
-                int error_code = (err_code != AWS_ERROR_SUCCESS) ? err_code : AWS_IO_DNS_QUERY_FAILED;
-                pending_callback->callback(
-                    host_entry->resolver, host_entry->host_name, error_code, NULL, pending_callback->user_data);
-            }
+    aws_mutex_lock(&host_entry->entry_lock);
 
-            s_clear_address_list(&callback_address_list);
+    uint64_t now = s_get_system_time_for_default_resolver(host_entry->resolver);
+    bool pinned = s_is_host_entry_pinned_by_listener(&threaded_data->listener_list);
 
-            aws_mem_release(host_entry->allocator, pending_callback);
+    /*
+     * Ideally this should just be time-based, but given the non-determinism of waits (and spurious wake ups) and
+     * clock time, I feel much more comfortable keeping an additional constraint in terms of iterations.
+     *
+     * Note that we have the entry lock now and if any queries have arrived since our last resolution,
+     * resolves_since_last_request will be 0 or 1 (depending on timing) and so, regardless of wait and wake up
+     * timings, this check will always fail in that case leading to another iteration to satisfy the pending
+     * query(ies).
+     *
+     * The only way we terminate the loop with pending queries is if the resolver itself has no more references
+     * to it and is going away.  In that case, the pending queries will be completed (with failure) by the
+     * final clean up of this entry.
+     *
+     * Cache hits record their requests without the entry lock, so one may land just after this check. That's fine:
+     * it was answered, and the next query for the host starts a new entry.
+     */
+    uint64_t last_request_timestamp_ns = aws_timestamp_convert(
+        aws_atomic_load_int(&host_entry->last_resolve_request_timestamp_secs),
+        AWS_TIMESTAMP_SECS,
+        AWS_TIMESTAMP_NANOS,
+        NULL);
+    if (aws_atomic_load_int(&host_entry->resolves_since_last_request) > unsolicited_resolve_max &&
+        last_request_timestamp_ns + max_no_solicitation_interval < now && !pinned && host_entry->state == DRS_ACTIVE) {
+        host_entry->state = DRS_SHUTTING_DOWN;
+        s_stash_stale_host(resolver, host_entry);
+    }
+
+    bool keep_going = host_entry->state == DRS_ACTIVE;
+    if (!keep_going) {
+        s_withdraw_host_entry_snapshot(host_entry);
+        aws_hash_table_remove(&resolver->host_entry_table, host_entry->host_name, NULL, NULL);
+
+        /* Move any local listeners we have back to the listener entry */
+        if (s_resolver_thread_move_listeners_to_listener_entry(
+                resolver, host_entry->host_name, &threaded_data->listener_list)) {
+            AWS_LOGF_ERROR(AWS_LS_IO_DNS, "static: could not clean up all listeners from resolver thread.");
         }
+    }
 
-        aws_mutex_lock(&host_entry->entry_lock);
+    aws_array_list_swap_contents(&host_entry->new_addresses, &threaded_data->new_address_list);
+    aws_array_list_swap_contents(&host_entry->expired_addresses, &threaded_data->expired_address_list);
+
+    aws_mutex_unlock(&host_entry->entry_lock);
+    aws_mutex_unlock(&resolver->resolver_lock);
+
+    /* Destroy any listeners in our destroy list. */
+    s_resolver_thread_destroy_listeners(&threaded_data->listener_destroy_list);
+
+    /* Notify our local listeners of new addresses. */
+    s_resolver_thread_notify_listeners(
+        &threaded_data->listener_list, &threaded_data->new_address_list, &threaded_data->expired_address_list);
+
+    s_clear_address_list(&threaded_data->new_address_list);
+    s_clear_address_list(&threaded_data->expired_address_list);
+
+    return keep_going;
+}
+
+static void resolver_thread_fn(void *arg) {
+    struct host_entry *host_entry = arg;
 
-        ++host_entry->resolves_since_last_request;
+    do {
+        s_resolve_host_entry(host_entry);
+
+        aws_mutex_lock(&host_entry->entry_lock);
 
         /* wait for a quit notification or the base resolve frequency time interval */
         aws_condition_variable_wait_for_pred(
@@ -1130,91 +1891,255 @@ static void resolver_thread_fn(void *arg) {
             s_host_entry_finished_pred,
             host_entry);
 
-        aws_mutex_unlock(&host_entry->entry_lock);
+        aws_mutex_unlock(&host_entry->entry_lock);
+    } while (s_sync_host_entry_with_resolver(host_entry));
+
+    AWS_LOGF_DEBUG(
+        AWS_LS_IO_DNS,
+        "static: Either no requests have been made for an address for %s for the duration "
+        "of the ttl, or this thread is being forcibly shutdown. Killing thread.",
+        host_entry->host_name->bytes);
+
+    /* please don't fail */
+    aws_thread_current_at_exit(s_on_host_entry_shutdown_completion, host_entry);
+}
+
+static int s_compare_host_entry_resolve_times(const void *a, const void *b) {
+    const struct host_entry *entry_a = *(const struct host_entry **)a;
+    const struct host_entry *entry_b = *(const struct host_entry **)b;
+
+    /* min-heap */
+    return entry_a->next_resolve_ns > entry_b->next_resolve_ns;
+}
+
+/*
+ * pool lock must be held before calling this function
+ */
+static void s_resolver_thread_pool_push_ready(struct resolver_thread_pool *pool, struct host_entry *host_entry) {
+    aws_linked_list_push_back(&pool->ready_entries, &host_entry->pool_node);
+    aws_condition_variable_notify_one(&pool->worker_signal);
+}
+
+/*
+ * pool lock must be held before calling this function
+ */
+static void s_resolver_thread_pool_schedule(struct resolver_thread_pool *pool, struct host_entry *host_entry) {
+    if (!pool->shutting_down) {
+        if (aws_priority_queue_push(&pool->scheduled_entries, &host_entry) == AWS_OP_SUCCESS) {
+            aws_condition_variable_notify_one(&pool->scheduler_signal);
+            return;
+        }
+
+        AWS_LOGF_ERROR(
+            AWS_LS_IO_DNS,
+            "static: could not schedule the next resolve of host %s, resolving it again right away",
+            host_entry->host_name->bytes);
+    }
+
+    /* while shutting down, go straight back to a worker so the entry can be finished */
+    s_resolver_thread_pool_push_ready(pool, host_entry);
+}
+
+static void s_on_resolver_pool_thread_exit(void *user_data) {
+    struct aws_host_resolver *resolver = user_data;
+    struct default_host_resolver *default_host_resolver = resolver->impl;
+
+    aws_mutex_lock(&default_host_resolver->resolver_lock);
+    --default_host_resolver->pool_thread_count;
+    bool cleanup_resolver = s_default_resolver_is_drained(default_host_resolver);
+    aws_mutex_unlock(&default_host_resolver->resolver_lock);
+
+    if (cleanup_resolver) {
+        s_cleanup_default_resolver(resolver);
+    }
+}
+
+/* pool lock must be held before calling this function */
+static bool s_resolver_thread_pool_is_finished(struct resolver_thread_pool *pool) {
+    return pool->shutting_down && pool->entry_count == 0;
+}
+
+static void s_resolver_pool_worker_fn(void *arg) {
+    struct resolver_thread_pool *pool = arg;
+
+    aws_mutex_lock(&pool->lock);
+    while (true) {
+        while (aws_linked_list_empty(&pool->ready_entries) && !s_resolver_thread_pool_is_finished(pool)) {
+            aws_condition_variable_wait(&pool->worker_signal, &pool->lock);
+        }
+
+        if (aws_linked_list_empty(&pool->ready_entries)) {
+            break;
+        }
+
+        struct host_entry *host_entry =
+            AWS_CONTAINER_OF(aws_linked_list_pop_front(&pool->ready_entries), struct host_entry, pool_node);
+        aws_mutex_unlock(&pool->lock);
+
+        /* After the first resolve, pick up where an entry's own thread would after waking up from its wait. */
+        bool keep_going = !host_entry->threaded_data.resolved_once || s_sync_host_entry_with_resolver(host_entry);
+        if (keep_going) {
+            s_resolve_host_entry(host_entry);
+
+            uint64_t now = s_get_system_time_for_default_resolver(host_entry->resolver);
+            host_entry->next_resolve_ns = now + (uint64_t)host_entry->resolve_frequency_ns;
+        } else {
+            AWS_LOGF_DEBUG(
+                AWS_LS_IO_DNS,
+                "static: Either no requests have been made for an address for %s for the duration "
+                "of the ttl, or the resolver is shutting down. Retiring host entry.",
+                host_entry->host_name->bytes);
+
+            s_on_host_entry_shutdown_completion(host_entry);
+        }
+
+        aws_mutex_lock(&pool->lock);
+        if (keep_going) {
+            s_resolver_thread_pool_schedule(pool, host_entry);
+        } else if (--pool->entry_count == 0 && pool->shutting_down) {
+            aws_condition_variable_notify_all(&pool->worker_signal);
+            aws_condition_variable_notify_one(&pool->scheduler_signal);
+        }
+    }
+    aws_mutex_unlock(&pool->lock);
+
+    aws_thread_current_at_exit(s_on_resolver_pool_thread_exit, pool->resolver);
+}
+
+static void s_resolver_pool_scheduler_fn(void *arg) {
+    struct resolver_thread_pool *pool = arg;
+
+    aws_mutex_lock(&pool->lock);
+    while (!s_resolver_thread_pool_is_finished(pool)) {
+        /* the resolver's clock, so that system_clock_override_fn covers when entries are due as well */
+        uint64_t now = s_get_system_time_for_default_resolver(pool->resolver);
+
+        /* hand out everything that's due. On shutdown everything is due, so that entries get finished promptly */
+        struct host_entry **next_entry = NULL;
+        while (aws_priority_queue_size(&pool->scheduled_entries) > 0) {
+            aws_priority_queue_top(&pool->scheduled_entries, (void **)&next_entry);
+            if (!pool->shutting_down && (*next_entry)->next_resolve_ns > now) {
+                break;
+            }
+
+            struct host_entry *host_entry = NULL;
+            aws_priority_queue_pop(&pool->scheduled_entries, &host_entry);
+            s_resolver_thread_pool_push_ready(pool, host_entry);
+        }
+
+        if (aws_priority_queue_size(&pool->scheduled_entries) > 0) {
+            aws_condition_variable_wait_for(
+                &pool->scheduler_signal, &pool->lock, (int64_t)((*next_entry)->next_resolve_ns - now));
+        } else if (!s_resolver_thread_pool_is_finished(pool)) {
+            aws_condition_variable_wait(&pool->scheduler_signal, &pool->lock);
+        }
+    }
+    aws_mutex_unlock(&pool->lock);
 
-        /*
-         * This is a bit awkward that we unlock the entry and then relock both the resolver and the entry, but it
-         * is mandatory that -- in order to maintain the consistent view of the resolver table (entry exist => entry
-         * is alive and can be queried) -- we have the resolver lock as well before making the decision to remove
-         * the entry from the table and terminate the thread.
-         */
-        struct default_host_resolver *resolver = host_entry->resolver->impl;
-        aws_mutex_lock(&resolver->resolver_lock);
+    aws_thread_current_at_exit(s_on_resolver_pool_thread_exit, pool->resolver);
+}
 
-        /* Remove any listeners from our listener list that have been marked pending destroy, moving them into the
-         * destroy list. */
-        s_resolver_thread_cull_pending_destroy_listeners(&listener_list, &listener_destroy_list);
+/*
+ * Hands a newly created entry to the pool for its first resolve.
+ */
+static void s_resolver_thread_pool_add_entry(struct resolver_thread_pool *pool, struct host_entry *host_entry) {
+    aws_mutex_lock(&pool->lock);
+    ++pool->entry_count;
+    s_resolver_thread_pool_push_ready(pool, host_entry);
+    aws_mutex_unlock(&pool->lock);
+}
 
-        /* Grab any listeners on the listener entry, moving them into the local list. */
-        s_resolver_thread_move_listeners_from_listener_entry(resolver, host_entry->host_name, &listener_list);
+static void s_resolver_thread_pool_shut_down(struct resolver_thread_pool *pool) {
+    aws_mutex_lock(&pool->lock);
+    pool->shutting_down = true;
+    aws_condition_variable_notify_all(&pool->worker_signal);
+    aws_condition_variable_notify_one(&pool->scheduler_signal);
+    aws_mutex_unlock(&pool->lock);
+}
 
-        aws_mutex_lock(&host_entry->entry_lock);
+/*
+ * Only called once every thread the pool launched has exited (or is on its way out, from its at-exit callback).
+ */
+static void s_resolver_thread_pool_destroy(struct resolver_thread_pool *pool) {
+    if (pool == NULL) {
+        return;
+    }
 
-        uint64_t now = s_get_system_time_for_default_resolver(host_entry->resolver);
-        bool pinned = s_is_host_entry_pinned_by_listener(&listener_list);
-
-        /*
-         * Ideally this should just be time-based, but given the non-determinism of waits (and spurious wake ups) and
-         * clock time, I feel much more comfortable keeping an additional constraint in terms of iterations.
-         *
-         * Note that we have the entry lock now and if any queries have arrived since our last resolution,
-         * resolves_since_last_request will be 0 or 1 (depending on timing) and so, regardless of wait and wake up
-         * timings, this check will always fail in that case leading to another iteration to satisfy the pending
-         * query(ies).
-         *
-         * The only way we terminate the loop with pending queries is if the resolver itself has no more references
-         * to it and is going away.  In that case, the pending queries will be completed (with failure) by the
-         * final clean up of this entry.
-         */
-        if (host_entry->resolves_since_last_request > unsolicited_resolve_max &&
-            host_entry->last_resolve_request_timestamp_ns + max_no_solicitation_interval < now && !pinned) {
-            host_entry->state = DRS_SHUTTING_DOWN;
-        }
+    AWS_FATAL_ASSERT(aws_linked_list_empty(&pool->ready_entries));
+    AWS_FATAL_ASSERT(aws_priority_queue_size(&pool->scheduled_entries) == 0);
 
-        keep_going = host_entry->state == DRS_ACTIVE;
-        if (!keep_going) {
-            aws_hash_table_remove(&resolver->host_entry_table, host_entry->host_name, NULL, NULL);
+    for (size_t i = 0; i < pool->worker_count; ++i) {
+        aws_thread_clean_up(&pool->workers[i]);
+    }
+    aws_thread_clean_up(&pool->scheduler);
 
-            /* Move any local listeners we have back to the listener entry */
-            if (s_resolver_thread_move_listeners_to_listener_entry(resolver, host_entry->host_name, &listener_list)) {
-                AWS_LOGF_ERROR(AWS_LS_IO_DNS, "static: could not clean up all listeners from resolver thread.");
-            }
-        }
+    aws_priority_queue_clean_up(&pool->scheduled_entries);
+    aws_condition_variable_clean_up(&pool->scheduler_signal);
+    aws_condition_variable_clean_up(&pool->worker_signal);
+    aws_mutex_clean_up(&pool->lock);
+    aws_mem_release(pool->allocator, pool->workers);
+    aws_mem_release(pool->allocator, pool);
+}
 
-        aws_array_list_swap_contents(&host_entry->new_addresses, &new_address_list);
-        aws_array_list_swap_contents(&host_entry->expired_addresses, &expired_address_list);
+/*
+ * Creates the pool and launches its threads. If some of them launched before a failure, they're left running; the
+ * caller shuts the pool down and the last one of them to exit cleans up the resolver.
+ */
+static int s_resolver_thread_pool_start(struct aws_host_resolver *resolver, size_t worker_count) {
+    struct default_host_resolver *default_host_resolver = resolver->impl;
 
-        aws_mutex_unlock(&host_entry->entry_lock);
-        aws_mutex_unlock(&resolver->resolver_lock);
+    struct resolver_thread_pool *pool = aws_mem_calloc(resolver->allocator, 1, sizeof(struct resolver_thread_pool));
+    if (pool == NULL) {
+        return AWS_OP_ERR;
+    }
 
-        /* Destroy any listeners in our destroy list. */
-        s_resolver_thread_destroy_listeners(&listener_destroy_list);
+    pool->allocator = resolver->allocator;
+    pool->resolver = resolver;
+    aws_mutex_init(&pool->lock);
+    aws_condition_variable_init(&pool->worker_signal);
+    aws_condition_variable_init(&pool->scheduler_signal);
+    aws_linked_list_init(&pool->ready_entries);
+    default_host_resolver->thread_pool = pool;
+
+    if (aws_priority_queue_init_dynamic(
+            &pool->scheduled_entries,
+            pool->allocator,
+            worker_count * 4,
+            sizeof(struct host_entry *),
+            s_compare_host_entry_resolve_times)) {
+        return AWS_OP_ERR;
+    }
 
-        /* Notify our local listeners of new addresses. */
-        s_resolver_thread_notify_listeners(&listener_list, &new_address_list, &expired_address_list);
+    pool->workers = aws_mem_calloc(pool->allocator, worker_count, sizeof(struct aws_thread));
+    if (pool->workers == NULL) {
+        return AWS_OP_ERR;
+    }
 
-        s_clear_address_list(&new_address_list);
-        s_clear_address_list(&expired_address_list);
+    if (aws_thread_init(&pool->scheduler, pool->allocator) ||
+        aws_thread_launch(&pool->scheduler, s_resolver_pool_scheduler_fn, pool, NULL)) {
+        return AWS_OP_ERR;
     }
 
-    AWS_LOGF_DEBUG(
-        AWS_LS_IO_DNS,
-        "static: Either no requests have been made for an address for %s for the duration "
-        "of the ttl, or this thread is being forcibly shutdown. Killing thread.",
-        host_entry->host_name->bytes)
+    aws_mutex_lock(&default_host_resolver->resolver_lock);
+    ++default_host_resolver->pool_thread_count;
+    aws_mutex_unlock(&default_host_resolver->resolver_lock);
 
-done:
+    for (size_t i = 0; i < worker_count; ++i) {
+        if (aws_thread_init(&pool->workers[i], pool->allocator)) {
+            return AWS_OP_ERR;
+        }
 
-    AWS_FATAL_ASSERT(aws_array_list_length(&address_list) == 0);
-    AWS_FATAL_ASSERT(aws_array_list_length(&new_address_list) == 0);
-    AWS_FATAL_ASSERT(aws_array_list_length(&expired_address_list) == 0);
+        pool->worker_count += 1;
+        if (aws_thread_launch(&pool->workers[i], s_resolver_pool_worker_fn, pool, NULL)) {
+            return AWS_OP_ERR;
+        }
 
-    aws_array_list_clean_up(&address_list);
-    aws_array_list_clean_up(&new_address_list);
-    aws_array_list_clean_up(&expired_address_list);
+        aws_mutex_lock(&default_host_resolver->resolver_lock);
+        ++default_host_resolver->pool_thread_count;
+        aws_mutex_unlock(&default_host_resolver->resolver_lock);
+    }
 
-    /* please don't fail */
-    aws_thread_current_at_exit(s_on_host_entry_shutdown_completion, host_entry);
+    return AWS_OP_SUCCESS;
 }
 
 static void on_cache_entry_removed_helper(struct aws_host_address_cache_entry *entry) {
@@ -1256,6 +2181,7 @@ static inline int create_and_init_host_entry(
     aws_on_host_resolved_result_fn *res,
     struct aws_host_resolution_config *config,
     uint64_t timestamp,
+    const struct stale_host *stale_host,
     void *user_data) {
     struct host_entry *new_host_entry = aws_mem_calloc(resolver->allocator, 1, sizeof(struct host_entry));
     if (!new_host_entry) {
@@ -1264,10 +2190,13 @@ static inline int create_and_init_host_entry(
 
     new_host_entry->resolver = resolver;
     new_host_entry->allocator = resolver->allocator;
-    new_host_entry->last_resolve_request_timestamp_ns = timestamp;
-    new_host_entry->resolves_since_last_request = 0;
+    aws_atomic_init_int(&new_host_entry->resolves_since_last_request, 0);
+    aws_atomic_init_int(&new_host_entry->last_resolve_request_timestamp_secs, 0);
+    s_host_entry_record_request(new_host_entry, timestamp);
     new_host_entry->resolve_frequency_ns = NS_PER_SEC;
     new_host_entry->state = DRS_ACTIVE;
+    aws_linked_list_init(&new_host_entry->threaded_data.listener_list);
+    aws_linked_list_init(&new_host_entry->threaded_data.listener_destroy_list);
 
     bool thread_init = false;
     struct pending_callback *pending_callback = NULL;
@@ -1331,35 +2260,65 @@ static inline int create_and_init_host_entry(
         goto setup_host_entry_error;
     }
 
-    aws_linked_list_init(&new_host_entry->pending_resolution_callbacks);
+    struct host_entry_threaded_data *threaded_data = &new_host_entry->threaded_data;
+    if (aws_array_list_init_dynamic(
+            &threaded_data->address_list, new_host_entry->allocator, 4, sizeof(struct aws_host_address)) ||
+        aws_array_list_init_dynamic(
+            &threaded_data->new_address_list, new_host_entry->allocator, 4, sizeof(struct aws_host_address)) ||
+        aws_array_list_init_dynamic(
+            &threaded_data->expired_address_list, new_host_entry->allocator, 4, sizeof(struct aws_host_address))) {
+        goto setup_host_entry_error;
+    }
 
-    pending_callback = aws_mem_acquire(resolver->allocator, sizeof(struct pending_callback));
+    aws_linked_list_init(&new_host_entry->pending_resolution_callbacks);
 
-    if (AWS_UNLIKELY(!pending_callback)) {
+    if (stale_host != NULL && s_seed_host_entry_caches(new_host_entry, stale_host)) {
         goto setup_host_entry_error;
     }
 
-    /*add the current callback here */
-    pending_callback->user_data = user_data;
-    pending_callback->callback = res;
-    aws_linked_list_push_back(&new_host_entry->pending_resolution_callbacks, &pending_callback->node);
+    /* a query that's answered from stale addresses doesn't wait for the resolve */
+    if (res != NULL) {
+        pending_callback = aws_mem_acquire(resolver->allocator, sizeof(struct pending_callback));
+
+        if (AWS_UNLIKELY(!pending_callback)) {
+            goto setup_host_entry_error;
+        }
+
+        /*add the current callback here */
+        pending_callback->user_data = user_data;
+        pending_callback->callback = res;
+        aws_linked_list_push_back(&new_host_entry->pending_resolution_callbacks, &pending_callback->node);
+    }
 
     aws_mutex_init(&new_host_entry->entry_lock);
     new_host_entry->resolution_config = *config;
     aws_condition_variable_init(&new_host_entry->entry_signal);
 
-    if (aws_thread_init(&new_host_entry->resolver_thread, resolver->allocator)) {
-        goto setup_host_entry_error;
+    struct default_host_resolver *default_host_resolver = resolver->impl;
+    if (default_host_resolver->thread_pool == NULL) {
+        if (aws_thread_init(&new_host_entry->resolver_thread, resolver->allocator)) {
+            goto setup_host_entry_error;
+        }
+
+        thread_init = true;
     }
 
-    thread_init = true;
-    struct default_host_resolver *default_host_resolver = resolver->impl;
     if (AWS_UNLIKELY(
             aws_hash_table_put(&default_host_resolver->host_entry_table, host_string_copy, new_host_entry, NULL))) {
         goto setup_host_entry_error;
     }
 
-    aws_thread_launch(&new_host_entry->resolver_thread, resolver_thread_fn, new_host_entry, NULL);
+    if (stale_host != NULL) {
+        aws_mutex_lock(&new_host_entry->entry_lock);
+        s_publish_host_entry_snapshot(new_host_entry);
+        aws_mutex_unlock(&new_host_entry->entry_lock);
+    }
+
+    if (default_host_resolver->thread_pool != NULL) {
+        s_resolver_thread_pool_add_entry(default_host_resolver->thread_pool, new_host_entry);
+    } else {
+        aws_thread_launch(&new_host_entry->resolver_thread, resolver_thread_fn, new_host_entry, NULL);
+    }
     ++default_host_resolver->pending_host_entry_shutdown_completion_callbacks;
 
     return AWS_OP_SUCCESS;
@@ -1387,6 +2346,10 @@ static int default_resolve_host(
 
     uint64_t timestamp = s_get_system_time_for_default_resolver(resolver);
 
+    if (s_resolve_host_from_snapshot(resolver, host_name, res, user_data, timestamp, &result)) {
+        return result;
+    }
+
     struct default_host_resolver *default_host_resolver = resolver->impl;
     aws_mutex_lock(&default_host_resolver->resolver_lock);
 
@@ -1407,9 +2370,27 @@ static int default_resolve_host(
             (void *)resolver,
             host_name->bytes);
 
-        result = create_and_init_host_entry(resolver, host_name, res, config, timestamp, user_data);
+        struct stale_host stale_host;
+        bool serve_stale = s_take_stale_host(default_host_resolver, host_name, timestamp, &stale_host);
+
+        result = create_and_init_host_entry(
+            resolver,
+            host_name,
+            serve_stale ? NULL : res,
+            config,
+            timestamp,
+            serve_stale ? &stale_host : NULL,
+            user_data);
         aws_mutex_unlock(&default_host_resolver->resolver_lock);
 
+        if (serve_stale) {
+            if (result == AWS_OP_SUCCESS) {
+                s_resolve_host_from_stale_addresses(resolver, host_name, &stale_host, res, user_data);
+            }
+
+            s_stale_host_clean_up(&stale_host);
+        }
+
         return result;
     }
 
@@ -1421,8 +2402,7 @@ static int default_resolve_host(
      * things query other entries.
      */
     aws_mutex_unlock(&default_host_resolver->resolver_lock);
-    host_entry->last_resolve_request_timestamp_ns = timestamp;
-    host_entry->resolves_since_last_request = 0;
+    s_host_entry_record_request(host_entry, timestamp);
 
     struct aws_host_address_cache_entry *aaaa_entry = aws_lru_cache_use_lru_element(host_entry->aaaa_records);
     struct aws_host_address *aaaa_record = (aaaa_entry != NULL) ? &aaaa_entry->address : NULL;
@@ -1535,6 +2515,376 @@ static size_t default_get_host_address_count(
     return address_count;
 }
 
+/*
+ * Cache files are big-endian:
+ *   magic (4) | version (1) | host count (4)
+ *   per host:    name length (2) | name | address count (2)
+ *   per address: flags (1) | record type (1) | address length (2) | address | expiry (8) | connection failures (4)
+ */
+#define HOST_CACHE_FILE_MAGIC 0x444e5343 /* "DNSC" */
+#define HOST_CACHE_FILE_VERSION 1
+#define HOST_CACHE_FILE_HEADER_SIZE 9
+#define HOST_CACHE_ADDRESS_FAILED 0x01
+
+static int s_write_cache_addresses(struct aws_byte_buf *buffer, const struct aws_array_list *addresses, uint8_t flags) {
+    for (size_t i = 0; i < aws_array_list_length(addresses); ++i) {
+        struct aws_host_address *address = NULL;
+        aws_array_list_get_at_ptr(addresses, (void **)&address, i);
+
+        if (aws_byte_buf_reserve_relative(buffer, 16 + address->address->len)) {
+            return AWS_OP_ERR;
+        }
+
+        aws_byte_buf_write_u8(buffer, flags);
+        aws_byte_buf_write_u8(buffer, (uint8_t)address->record_type);
+        aws_byte_buf_write_be16(buffer, (uint16_t)address->address->len);
+        aws_byte_buf_write_from_whole_string(buffer, address->address);
+        aws_byte_buf_write_be64(buffer, address->expiry);
+        aws_byte_buf_write_be32(buffer, (uint32_t)aws_min_size(address->connection_failure_count, UINT32_MAX));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/* Hosts without a good address are left out, since they'd never be served. */
+static int s_write_cache_host(struct aws_byte_buf *buffer, const struct stale_host *stale_host, uint32_t *host_count) {
+    size_t address_count =
+        aws_array_list_length(&stale_host->addresses) + aws_array_list_length(&stale_host->failed_addresses);
+    if (aws_array_list_length(&stale_host->addresses) == 0 || address_count > UINT16_MAX ||
+        stale_host->host_name->len > UINT16_MAX) {
+        return AWS_OP_SUCCESS;
+    }
+
+    if (aws_byte_buf_reserve_relative(buffer, 4 + stale_host->host_name->len)) {
+        return AWS_OP_ERR;
+    }
+
+    aws_byte_buf_write_be16(buffer, (uint16_t)stale_host->host_name->len);
+    aws_byte_buf_write_from_whole_string(buffer, stale_host->host_name);
+    aws_byte_buf_write_be16(buffer, (uint16_t)address_count);
+
+    if (s_write_cache_addresses(buffer, &stale_host->addresses, 0) ||
+        s_write_cache_addresses(buffer, &stale_host->failed_addresses, HOST_CACHE_ADDRESS_FAILED)) {
+        return AWS_OP_ERR;
+    }
+
+    ++*host_count;
+    return AWS_OP_SUCCESS;
+}
+
+/* Serializes every host the resolver knows addresses for. The resolver lock must be held. */
+static int s_write_cache_hosts(struct default_host_resolver *resolver, struct aws_byte_buf *buffer, uint32_t *count) {
+    for (struct aws_hash_iter iter = aws_hash_iter_begin(&resolver->host_entry_table); !aws_hash_iter_done(&iter);
+         aws_hash_iter_next(&iter)) {
+        struct host_entry *host_entry = iter.element.value;
+
+        aws_mutex_lock(&host_entry->entry_lock);
+        struct stale_host *stale_host = s_stale_host_new_from_entry(resolver->allocator, host_entry);
+        aws_mutex_unlock(&host_entry->entry_lock);
+
+        if (stale_host == NULL) {
+            return AWS_OP_ERR;
+        }
+
+        int result = s_write_cache_host(buffer, stale_host, count);
+        s_stale_host_destroy(stale_host);
+        if (result) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    /* cycling through the whole lru leaves it in the order it started in */
+    int result = AWS_OP_SUCCESS;
+    size_t stale_host_count = aws_cache_get_element_count(resolver->stale_hosts);
+    for (size_t i = 0; i < stale_host_count; ++i) {
+        struct stale_host *stale_host = aws_lru_cache_use_lru_element(resolver->stale_hosts);
+        if (result == AWS_OP_SUCCESS) {
+            result = s_write_cache_host(buffer, stale_host, count);
+        }
+    }
+
+    return result;
+}
+
+static int resolver_save_cache(struct aws_host_resolver *resolver, const char *path) {
+    struct default_host_resolver *default_host_resolver = resolver->impl;
+
+    struct aws_byte_buf contents;
+    if (aws_byte_buf_init(&contents, resolver->allocator, 1024)) {
+        return AWS_OP_ERR;
+    }
+
+    /* the cache is written next to its final path and renamed over it, so a crash or a full disk never leaves a
+     * truncated cache behind */
+    struct aws_byte_buf tmp_path;
+    AWS_ZERO_STRUCT(tmp_path);
+    struct aws_byte_cursor path_cursor = aws_byte_cursor_from_c_str(path);
+    struct aws_byte_cursor tmp_suffix = aws_byte_cursor_from_c_str(".tmp");
+
+    int result = AWS_OP_ERR;
+    FILE *fp = NULL;
+    bool remove_tmp_file = false;
+
+    if (aws_byte_buf_init(&tmp_path, resolver->allocator, path_cursor.len + tmp_suffix.len + 1) ||
+        aws_byte_buf_append(&tmp_path, &path_cursor) || aws_byte_buf_append(&tmp_path, &tmp_suffix)) {
+        goto done;
+    }
+    aws_byte_buf_write_u8(&tmp_path, 0);
+    const char *tmp_path_str = (const char *)tmp_path.buffer;
+
+    aws_byte_buf_write_be32(&contents, HOST_CACHE_FILE_MAGIC);
+    aws_byte_buf_write_u8(&contents, HOST_CACHE_FILE_VERSION);
+    aws_byte_buf_write_be32(&contents, 0);
+
+    uint32_t host_count = 0;
+    aws_mutex_lock(&default_host_resolver->resolver_lock);
+    int write_result = s_write_cache_hosts(default_host_resolver, &contents, &host_count);
+    aws_mutex_unlock(&default_host_resolver->resolver_lock);
+
+    if (write_result) {
+        goto done;
+    }
+
+    struct aws_byte_buf host_count_buf = aws_byte_buf_from_empty_array(contents.buffer + 5, 4);
+    aws_byte_buf_write_be32(&host_count_buf, host_count);
+
+    fp = fopen(tmp_path_str, "wb");
+    if (fp == NULL) {
+        AWS_LOGF_ERROR(
+            AWS_LS_IO_DNS, "id=%p: failed to open cache file %s with errno %d", (void *)resolver, tmp_path_str, errno);
+        aws_translate_and_raise_io_error(errno);
+        goto done;
+    }
+    remove_tmp_file = true;
+
+    if (fwrite(contents.buffer, 1, contents.len, fp) < contents.len || fflush(fp)) {
+        AWS_LOGF_ERROR(
+            AWS_LS_IO_DNS, "id=%p: failed to write cache file %s with errno %d", (void *)resolver, tmp_path_str, errno);
+        aws_translate_and_raise_io_error(errno);
+        goto done;
+    }
+
+    int close_result = fclose(fp);
+    fp = NULL;
+    if (close_result) {
+        AWS_LOGF_ERROR(
+            AWS_LS_IO_DNS, "id=%p: failed to close cache file %s with errno %d", (void *)resolver, tmp_path_str, errno);
+        aws_translate_and_raise_io_error(errno);
+        goto done;
+    }
+
+#ifdef _WIN32
+    /* rename() on windows refuses to replace an existing file */
+    remove(path);
+#endif
+    if (rename(tmp_path_str, path)) {
+        AWS_LOGF_ERROR(
+            AWS_LS_IO_DNS,
+            "id=%p: failed to rename cache file %s to %s with errno %d",
+            (void *)resolver,
+            tmp_path_str,
+            path,
+            errno);
+        aws_translate_and_raise_io_error(errno);
+        goto done;
+    }
+    remove_tmp_file = false;
+
+    AWS_LOGF_DEBUG(AWS_LS_IO_DNS, "id=%p: saved %d hosts to cache file %s", (void *)resolver, (int)host_count, path);
+    result = AWS_OP_SUCCESS;
+
+done:
+
+    if (fp != NULL) {
+        fclose(fp);
+    }
+
+    if (remove_tmp_file) {
+        remove((const char *)tmp_path.buffer);
+    }
+
+    aws_byte_buf_clean_up(&tmp_path);
+    aws_byte_buf_clean_up(&contents);
+
+    return result;
+}
+
+static struct stale_host *s_read_cache_host(struct aws_allocator *allocator, struct aws_byte_cursor *cursor) {
+    uint16_t name_length = 0;
+    uint16_t address_count = 0;
+    if (!aws_byte_cursor_read_be16(cursor, &name_length) || name_length == 0 || name_length > cursor->len) {
+        aws_raise_error(AWS_IO_FILE_VALIDATION_FAILURE);
+        return NULL;
+    }
+
+    struct aws_byte_cursor name = aws_byte_cursor_advance(cursor, name_length);
+    if (!aws_byte_cursor_read_be16(cursor, &address_count)) {
+        aws_raise_error(AWS_IO_FILE_VALIDATION_FAILURE);
+        return NULL;
+    }
+
+    struct stale_host *stale_host = aws_mem_calloc(allocator, 1, sizeof(struct stale_host));
+    if (stale_host == NULL) {
+        return NULL;
+    }
+
+    if (s_stale_host_init(stale_host, allocator)) {
+        aws_mem_release(allocator, stale_host);
+        return NULL;
+    }
+
+    stale_host->host_name = aws_string_new_from_cursor(allocator, &name);
+    if (stale_host->host_name == NULL) {
+        goto on_error;
+    }
+
+    for (uint16_t i = 0; i < address_count; ++i) {
+        uint8_t flags = 0;
+        uint8_t record_type = 0;
+        uint16_t address_length = 0;
+        if (!aws_byte_cursor_read_u8(cursor, &flags) || !aws_byte_cursor_read_u8(cursor, &record_type) ||
+            !aws_byte_cursor_read_be16(cursor, &address_length) || address_length == 0 ||
+            address_length > cursor->len ||
+            (record_type != AWS_ADDRESS_RECORD_TYPE_A && record_type != AWS_ADDRESS_RECORD_TYPE_AAAA)) {
+            aws_raise_error(AWS_IO_FILE_VALIDATION_FAILURE);
+            goto on_error;
+        }
+
+        struct aws_byte_cursor address_cursor = aws_byte_cursor_advance(cursor, address_length);
+        uint64_t expiry = 0;
+        uint32_t connection_failure_count = 0;
+        if (!aws_byte_cursor_read_be64(cursor, &expiry) ||
+            !aws_byte_cursor_read_be32(cursor, &connection_failure_count)) {
+            aws_raise_error(AWS_IO_FILE_VALIDATION_FAILURE);
+            goto on_error;
+        }
+
+        struct aws_host_address address = {
+            .allocator = allocator,
+            .address = aws_string_new_from_cursor(allocator, &address_cursor),
+            .host = aws_string_new_from_string(allocator, stale_host->host_name),
+            .record_type = record_type,
+            .expiry = expiry,
+            .connection_failure_count = connection_failure_count,
+        };
+
+        struct aws_array_list *addresses =
+            (flags & HOST_CACHE_ADDRESS_FAILED) ? &stale_host->failed_addresses : &stale_host->addresses;
+        if (address.address == NULL || address.host == NULL || aws_array_list_push_back(addresses, &address)) {
+            aws_host_address_clean_up(&address);
+            goto on_error;
+        }
+    }
+
+    return stale_host;
+
+on_error:
+
+    s_stale_host_destroy(stale_host);
+
+    return NULL;
+}
+
+/* Parses the whole file before anything is loaded, so that a bad file loads nothing. */
+static int s_read_cache_hosts(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor contents,
+    struct aws_array_list *stale_hosts) {
+
+    uint32_t magic = 0;
+    uint8_t version = 0;
+    uint32_t host_count = 0;
+    if (!aws_byte_cursor_read_be32(&contents, &magic) || magic != HOST_CACHE_FILE_MAGIC ||
+        !aws_byte_cursor_read_u8(&contents, &version) || version != HOST_CACHE_FILE_VERSION ||
+        !aws_byte_cursor_read_be32(&contents, &host_count)) {
+        return aws_raise_error(AWS_IO_FILE_VALIDATION_FAILURE);
+    }
+
+    for (uint32_t i = 0; i < host_count; ++i) {
+        struct stale_host *stale_host = s_read_cache_host(allocator, &contents);
+        if (stale_host == NULL) {
+            return AWS_OP_ERR;
+        }
+
+        if (aws_array_list_push_back(stale_hosts, &stale_host)) {
+            s_stale_host_destroy(stale_host);
+            return AWS_OP_ERR;
+        }
+    }
+
+    if (contents.len != 0) {
+        return aws_raise_error(AWS_IO_FILE_VALIDATION_FAILURE);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int resolver_load_cache(struct aws_host_resolver *resolver, const char *path) {
+    struct default_host_resolver *default_host_resolver = resolver->impl;
+
+    struct aws_byte_buf contents;
+    if (aws_byte_buf_init_from_file(&contents, resolver->allocator, path)) {
+        return AWS_OP_ERR;
+    }
+
+    int result = AWS_OP_ERR;
+
+    /* struct stale_host * */
+    struct aws_array_list stale_hosts;
+    if (aws_array_list_init_dynamic(&stale_hosts, resolver->allocator, 16, sizeof(struct stale_host *))) {
+        aws_byte_buf_clean_up(&contents);
+        return AWS_OP_ERR;
+    }
+
+    if (s_read_cache_hosts(resolver->allocator, aws_byte_cursor_from_buf(&contents), &stale_hosts)) {
+        AWS_LOGF_ERROR(
+            AWS_LS_IO_DNS,
+            "id=%p: failed to load cache file %s with error %d",
+            (void *)resolver,
+            path,
+            aws_last_error());
+        goto done;
+    }
+
+    /* hosts that already have an entry know better than the file */
+    size_t loaded_count = 0;
+    aws_mutex_lock(&default_host_resolver->resolver_lock);
+    for (size_t i = 0; i < aws_array_list_length(&stale_hosts); ++i) {
+        struct stale_host **stale_host = NULL;
+        aws_array_list_get_at_ptr(&stale_hosts, (void **)&stale_host, i);
+
+        struct aws_hash_element *element = NULL;
+        aws_hash_table_find(&default_host_resolver->host_entry_table, (*stale_host)->host_name, &element);
+        if (element == NULL && aws_array_list_length(&(*stale_host)->addresses) > 0) {
+            if (s_put_stale_host(default_host_resolver, *stale_host) == AWS_OP_SUCCESS) {
+                ++loaded_count;
+            }
+        } else {
+            s_stale_host_destroy(*stale_host);
+        }
+
+        *stale_host = NULL;
+    }
+    aws_mutex_unlock(&default_host_resolver->resolver_lock);
+
+    AWS_LOGF_DEBUG(
+        AWS_LS_IO_DNS, "id=%p: loaded %d hosts from cache file %s", (void *)resolver, (int)loaded_count, path);
+    result = AWS_OP_SUCCESS;
+
+done:
+
+    for (size_t i = 0; i < aws_array_list_length(&stale_hosts); ++i) {
+        struct stale_host *stale_host = NULL;
+        aws_array_list_get_at(&stale_hosts, &stale_host, i);
+        s_stale_host_destroy(stale_host);
+    }
+
+    aws_array_list_clean_up(&stale_hosts);
+    aws_byte_buf_clean_up(&contents);
+
+    return result;
+}
+
 static struct aws_host_resolver_vtable s_vtable = {
     .purge_cache = resolver_purge_cache,
     .resolve_host = default_resolve_host,
@@ -1542,6 +2892,8 @@ static struct aws_host_resolver_vtable s_vtable = {
     .get_host_address_count = default_get_host_address_count,
     .add_host_listener = default_add_host_listener,
     .remove_host_listener = default_remove_host_listener,
+    .save_cache = resolver_save_cache,
+    .load_cache = resolver_load_cache,
     .destroy = resolver_destroy,
 };
 
@@ -1577,9 +2929,10 @@ struct aws_host_resolver *aws_host_resolver_new_default(
 
     AWS_LOGF_INFO(
         AWS_LS_IO_DNS,
-        "id=%p: Initializing default host resolver with %llu max host entries.",
+        "id=%p: Initializing default host resolver with %llu max host entries and %llu pooled resolver threads.",
         (void *)resolver,
-        (unsigned long long)options->max_entries);
+        (unsigned long long)options->max_entries,
+        (unsigned long long)options->resolver_thread_pool_size);
 
     resolver->vtable = &s_vtable;
     resolver->allocator = allocator;
@@ -1589,6 +2942,9 @@ struct aws_host_resolver *aws_host_resolver_new_default(
     default_host_resolver->pending_host_entry_shutdown_completion_callbacks = 0;
     default_host_resolver->state = DRS_ACTIVE;
     aws_mutex_init(&default_host_resolver->resolver_lock);
+    for (size_t i = 0; i < HOST_SNAPSHOT_SHARD_COUNT; ++i) {
+        aws_rw_lock_init(&default_host_resolver->snapshot_shards[i].lock);
+    }
 
     aws_global_thread_creator_increment();
 
@@ -1614,18 +2970,71 @@ struct aws_host_resolver *aws_host_resolver_new_default(
         goto on_error;
     }
 
+    for (size_t i = 0; i < HOST_SNAPSHOT_SHARD_COUNT; ++i) {
+        if (aws_hash_table_init(
+                &default_host_resolver->snapshot_shards[i].snapshots,
+                allocator,
+                options->max_entries / HOST_SNAPSHOT_SHARD_COUNT + 1,
+                aws_hash_string,
+                aws_hash_callback_string_eq,
+                NULL,
+                NULL)) {
+            goto on_error;
+        }
+    }
+
     aws_ref_count_init(&resolver->ref_count, resolver, (aws_simple_completion_callback *)s_aws_host_resolver_destroy);
 
     if (options->shutdown_options != NULL) {
         resolver->shutdown_options = *options->shutdown_options;
     }
 
+    default_host_resolver->max_stale_ns =
+        aws_timestamp_convert(options->max_stale_secs, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL);
+    default_host_resolver->stale_hosts = aws_cache_new_lru(
+        allocator,
+        aws_hash_string,
+        aws_hash_callback_string_eq,
+        NULL,
+        s_stale_host_destroy,
+        options->max_entries > 0 ? options->max_entries : 1);
+    if (default_host_resolver->stale_hosts == NULL) {
+        goto on_error;
+    }
+
     if (options->system_clock_override_fn != NULL) {
         default_host_resolver->system_clock_fn = options->system_clock_override_fn;
     } else {
         default_host_resolver->system_clock_fn = aws_sys_clock_get_ticks;
     }
 
+    if (options->resolver_thread_pool_size > 0 &&
+        s_resolver_thread_pool_start(resolver, options->resolver_thread_pool_size)) {
+        AWS_LOGF_ERROR(
+            AWS_LS_IO_DNS,
+            "id=%p: Failed to start resolver thread pool, error %s",
+            (void *)resolver,
+            aws_error_debug_str(aws_last_error()));
+
+        /* any pool threads that did launch clean up the resolver on their way out, without a shutdown callback */
+        AWS_ZERO_STRUCT(resolver->shutdown_options);
+
+        aws_mutex_lock(&default_host_resolver->resolver_lock);
+        default_host_resolver->state = DRS_SHUTTING_DOWN;
+        bool cleanup_resolver = s_default_resolver_is_drained(default_host_resolver);
+        aws_mutex_unlock(&default_host_resolver->resolver_lock);
+
+        if (default_host_resolver->thread_pool != NULL) {
+            s_resolver_thread_pool_shut_down(default_host_resolver->thread_pool);
+        }
+
+        if (cleanup_resolver) {
+            s_cleanup_default_resolver(resolver);
+        }
+
+        return NULL;
+    }
+
     return resolver;
 
 on_error:
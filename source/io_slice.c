@@ -0,0 +1,222 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/io/io_slice.h>
+
+struct aws_io_buffer *aws_io_buffer_new(struct aws_allocator *allocator, size_t capacity) {
+    struct aws_io_buffer *buffer = NULL;
+    uint8_t *memory = NULL;
+    if (!aws_mem_acquire_many(allocator, 2, &buffer, sizeof(struct aws_io_buffer), &memory, capacity)) {
+        return NULL;
+    }
+
+    buffer->allocator = allocator;
+    aws_atomic_init_int(&buffer->ref_count, 1);
+    buffer->data = aws_byte_buf_from_empty_array(memory, capacity);
+
+    return buffer;
+}
+
+struct aws_io_buffer *aws_io_buffer_acquire(struct aws_io_buffer *buffer) {
+    aws_atomic_fetch_add(&buffer->ref_count, 1);
+    return buffer;
+}
+
+void aws_io_buffer_release(struct aws_io_buffer *buffer) {
+    if (buffer && aws_atomic_fetch_sub(&buffer->ref_count, 1) == 1) {
+        aws_mem_release(buffer->allocator, buffer);
+    }
+}
+
+void aws_io_slice_chain_init(struct aws_io_slice_chain *chain, struct aws_allocator *allocator) {
+    AWS_ZERO_STRUCT(*chain);
+    chain->allocator = allocator;
+    aws_linked_list_init(&chain->slices);
+}
+
+static void s_slice_destroy(struct aws_allocator *allocator, struct aws_io_slice *slice) {
+    aws_io_buffer_release(slice->buffer);
+    aws_mem_release(allocator, slice);
+}
+
+void aws_io_slice_chain_clean_up(struct aws_io_slice_chain *chain) {
+    while (!aws_linked_list_empty(&chain->slices)) {
+        struct aws_io_slice *slice =
+            AWS_CONTAINER_OF(aws_linked_list_pop_front(&chain->slices), struct aws_io_slice, node);
+        s_slice_destroy(chain->allocator, slice);
+    }
+
+    chain->slice_count = 0;
+    chain->len = 0;
+}
+
+static struct aws_io_slice *s_slice_new(
+    struct aws_allocator *allocator,
+    struct aws_io_buffer *buffer,
+    struct aws_byte_cursor range) {
+
+    if (range.len > 0 &&
+        (range.ptr < buffer->data.buffer || range.ptr + range.len > buffer->data.buffer + buffer->data.capacity)) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    struct aws_io_slice *slice = aws_mem_calloc(allocator, 1, sizeof(struct aws_io_slice));
+    if (!slice) {
+        return NULL;
+    }
+
+    slice->buffer = aws_io_buffer_acquire(buffer);
+    slice->cursor = range;
+    return slice;
+}
+
+int aws_io_slice_chain_append(
+    struct aws_io_slice_chain *chain,
+    struct aws_io_buffer *buffer,
+    struct aws_byte_cursor range) {
+
+    struct aws_io_slice *slice = s_slice_new(chain->allocator, buffer, range);
+    if (!slice) {
+        return AWS_OP_ERR;
+    }
+
+    aws_linked_list_push_back(&chain->slices, &slice->node);
+    chain->slice_count += 1;
+    chain->len += range.len;
+    return AWS_OP_SUCCESS;
+}
+
+int aws_io_slice_chain_prepend(
+    struct aws_io_slice_chain *chain,
+    struct aws_io_buffer *buffer,
+    struct aws_byte_cursor range) {
+
+    struct aws_io_slice *slice = s_slice_new(chain->allocator, buffer, range);
+    if (!slice) {
+        return AWS_OP_ERR;
+    }
+
+    aws_linked_list_push_front(&chain->slices, &slice->node);
+    chain->slice_count += 1;
+    chain->len += range.len;
+    return AWS_OP_SUCCESS;
+}
+
+void aws_io_slice_chain_move(struct aws_io_slice_chain *dest, struct aws_io_slice_chain *src) {
+    AWS_PRECONDITION(dest->allocator == src->allocator);
+
+    aws_linked_list_move_all_back(&dest->slices, &src->slices);
+    dest->slice_count += src->slice_count;
+    dest->len += src->len;
+    src->slice_count = 0;
+    src->len = 0;
+}
+
+int aws_io_slice_chain_split(struct aws_io_slice_chain *chain, size_t offset, struct aws_io_slice_chain *tail) {
+    AWS_PRECONDITION(chain->allocator == tail->allocator);
+
+    if (offset > chain->len) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    /* find the slice containing the byte at offset */
+    size_t kept = 0;
+    struct aws_linked_list_node *node = aws_linked_list_begin(&chain->slices);
+    while (node != aws_linked_list_end(&chain->slices)) {
+        struct aws_io_slice *slice = AWS_CONTAINER_OF(node, struct aws_io_slice, node);
+        if (kept + slice->cursor.len > offset) {
+            break;
+        }
+        kept += slice->cursor.len;
+        node = aws_linked_list_next(node);
+    }
+
+    struct aws_io_slice_chain moved;
+    aws_io_slice_chain_init(&moved, chain->allocator);
+
+    if (node != aws_linked_list_end(&chain->slices) && kept < offset) {
+        /* the offset lands inside this slice: it keeps the front half, a new slice takes the back half */
+        struct aws_io_slice *slice = AWS_CONTAINER_OF(node, struct aws_io_slice, node);
+        struct aws_byte_cursor back = slice->cursor;
+        aws_byte_cursor_advance(&back, offset - kept);
+
+        struct aws_io_slice *back_slice = s_slice_new(chain->allocator, slice->buffer, back);
+        if (!back_slice) {
+            return AWS_OP_ERR;
+        }
+
+        slice->cursor.len -= back.len;
+        aws_linked_list_push_back(&moved.slices, &back_slice->node);
+        moved.slice_count += 1;
+        moved.len += back.len;
+        node = aws_linked_list_next(node);
+    }
+
+    while (node != aws_linked_list_end(&chain->slices)) {
+        struct aws_io_slice *slice = AWS_CONTAINER_OF(node, struct aws_io_slice, node);
+        node = aws_linked_list_next(node);
+
+        aws_linked_list_remove(&slice->node);
+        aws_linked_list_push_back(&moved.slices, &slice->node);
+        chain->slice_count -= 1;
+        moved.slice_count += 1;
+        moved.len += slice->cursor.len;
+    }
+
+    chain->len = offset;
+    aws_io_slice_chain_move(tail, &moved);
+
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * Sliced messages aren't pooled. Like pooled messages, they carry their own allocator so that the usual
+ * aws_mem_release(message->allocator, message) also releases the slices.
+ */
+struct sliced_message {
+    struct aws_io_message message;
+    struct aws_allocator message_allocator;
+    struct aws_allocator *allocator;
+    struct aws_io_slice_chain chain;
+};
+
+static void *s_sliced_message_mem_acquire(struct aws_allocator *allocator, size_t size) {
+    (void)allocator;
+    (void)size;
+
+    /* no one should ever call this ever. */
+    AWS_ASSERT(0);
+    return NULL;
+}
+
+static void s_sliced_message_mem_release(struct aws_allocator *allocator, void *ptr) {
+    struct sliced_message *sliced_message = allocator->impl;
+    AWS_ASSERT(ptr == &sliced_message->message);
+    (void)ptr;
+
+    aws_io_slice_chain_clean_up(&sliced_message->chain);
+    aws_mem_release(sliced_message->allocator, sliced_message);
+}
+
+struct aws_io_message *aws_io_message_new_sliced(struct aws_allocator *allocator) {
+    struct sliced_message *sliced_message = aws_mem_calloc(allocator, 1, sizeof(struct sliced_message));
+    if (!sliced_message) {
+        return NULL;
+    }
+
+    sliced_message->allocator = allocator;
+    aws_io_slice_chain_init(&sliced_message->chain, allocator);
+
+    sliced_message->message_allocator.impl = sliced_message;
+    sliced_message->message_allocator.mem_acquire = s_sliced_message_mem_acquire;
+    sliced_message->message_allocator.mem_release = s_sliced_message_mem_release;
+
+    sliced_message->message.allocator = &sliced_message->message_allocator;
+    sliced_message->message.message_type = AWS_IO_MESSAGE_APPLICATION_DATA;
+    sliced_message->message.slices = &sliced_message->chain;
+
+    return &sliced_message->message;
+}
@@ -7,27 +7,156 @@
 
 #include <aws/common/thread.h>
 
-int aws_memory_pool_init(
-    struct aws_memory_pool *mempool,
-    struct aws_allocator *alloc,
-    uint16_t ideal_segment_count,
-    size_t segment_size) {
+/* segments and slab headers are padded so that every segment keeps the allocator's alignment */
+#define MEMORY_POOL_ALIGNMENT 16
+#define MEMORY_POOL_DEFAULT_SLAB_SIZE (64 * 1024)
+/* how many acquires and releases go by between checks for slabs that demand no longer needs */
+#define MEMORY_POOL_TRIM_INTERVAL 1024
+
+/*
+ * A run of segments from a single allocation. Each segment is prefixed with a pointer to its slab, NULL for segments
+ * allocated individually once the pool reached its high-water mark.
+ */
+struct memory_slab {
+    struct aws_linked_list_node node;
+    size_t segment_count;
+    size_t free_count;
+    bool releasing;
+};
+
+static size_t s_align_up(size_t size) {
+    return (size + MEMORY_POOL_ALIGNMENT - 1) & ~(size_t)(MEMORY_POOL_ALIGNMENT - 1);
+}
+
+static size_t s_segment_header_size(void) {
+    return s_align_up(sizeof(struct memory_slab *));
+}
+
+static size_t s_segment_stride(const struct aws_memory_pool *mempool) {
+    return s_segment_header_size() + s_align_up(mempool->segment_size);
+}
 
-    mempool->alloc = alloc;
-    mempool->ideal_segment_count = ideal_segment_count;
-    mempool->segment_size = segment_size;
-    mempool->data_ptr = aws_mem_calloc(alloc, ideal_segment_count, sizeof(void *));
-    if (!mempool->data_ptr) {
+static struct memory_slab **s_segment_slab(void *segment) {
+    return (struct memory_slab **)((uint8_t *)segment - s_segment_header_size());
+}
+
+static int s_memory_pool_add_slab(struct aws_memory_pool *mempool) {
+    size_t segment_count = mempool->segments_per_slab;
+    if (mempool->max_segment_count) {
+        AWS_ASSERT(mempool->slab_segment_count < mempool->max_segment_count);
+        segment_count = aws_min_size(segment_count, mempool->max_segment_count - mempool->slab_segment_count);
+    }
+
+    /*
+     * Every segment held in slabs, in use or not, can end up on the stack at the same time. Reserve room for all of
+     * them, so that pushing a released segment back can't fail.
+     */
+    if (aws_array_list_ensure_capacity(&mempool->stack, mempool->slab_segment_count + segment_count - 1)) {
+        return AWS_OP_ERR;
+    }
+
+    size_t stride = s_segment_stride(mempool);
+    size_t slab_header_size = s_align_up(sizeof(struct memory_slab));
+    struct memory_slab *slab = aws_mem_acquire(mempool->slab_alloc, slab_header_size + segment_count * stride);
+    if (!slab) {
         return AWS_OP_ERR;
     }
 
-    aws_array_list_init_static(&mempool->stack, mempool->data_ptr, ideal_segment_count, sizeof(void *));
+    slab->segment_count = segment_count;
+    slab->free_count = segment_count;
+    slab->releasing = false;
+
+    for (size_t i = 0; i < segment_count; ++i) {
+        uint8_t *segment = (uint8_t *)slab + slab_header_size + i * stride + s_segment_header_size();
+        *s_segment_slab(segment) = slab;
+        aws_array_list_push_back(&mempool->stack, &segment);
+    }
+
+    aws_linked_list_push_back(&mempool->slabs, &slab->node);
+    mempool->slab_segment_count += segment_count;
+
+    return AWS_OP_SUCCESS;
+}
+
+/* Hands back slabs with no segments in use, keeping enough for the peak demand seen since the last trim. */
+static void s_memory_pool_trim(struct aws_memory_pool *mempool) {
+    size_t target = aws_max_size(mempool->ideal_segment_count, mempool->peak_outstanding);
+    mempool->peak_outstanding = mempool->outstanding;
+    mempool->ops_since_trim = 0;
+
+    if (mempool->slab_segment_count <= target) {
+        return;
+    }
+
+    struct aws_linked_list releasing;
+    aws_linked_list_init(&releasing);
+    size_t remaining_segment_count = mempool->slab_segment_count;
+
+    struct aws_linked_list_node *node = aws_linked_list_begin(&mempool->slabs);
+    while (node != aws_linked_list_end(&mempool->slabs)) {
+        struct memory_slab *slab = AWS_CONTAINER_OF(node, struct memory_slab, node);
+        node = aws_linked_list_next(node);
+
+        if (slab->free_count == slab->segment_count && remaining_segment_count - slab->segment_count >= target) {
+            slab->releasing = true;
+            remaining_segment_count -= slab->segment_count;
+            aws_linked_list_remove(&slab->node);
+            aws_linked_list_push_back(&releasing, &slab->node);
+        }
+    }
+
+    if (aws_linked_list_empty(&releasing)) {
+        return;
+    }
 
-    for (uint16_t i = 0; i < ideal_segment_count; ++i) {
-        void *memory = aws_mem_acquire(alloc, segment_size);
-        if (memory) {
-            aws_array_list_push_back(&mempool->stack, &memory);
+    size_t index = 0;
+    while (index < aws_array_list_length(&mempool->stack)) {
+        void *segment = NULL;
+        aws_array_list_get_at(&mempool->stack, &segment, index);
+        if ((*s_segment_slab(segment))->releasing) {
+            aws_array_list_swap(&mempool->stack, index, aws_array_list_length(&mempool->stack) - 1);
+            aws_array_list_pop_back(&mempool->stack);
         } else {
+            ++index;
+        }
+    }
+
+    while (!aws_linked_list_empty(&releasing)) {
+        struct memory_slab *slab = AWS_CONTAINER_OF(aws_linked_list_pop_front(&releasing), struct memory_slab, node);
+        aws_mem_release(mempool->slab_alloc, slab);
+    }
+
+    mempool->slab_segment_count = remaining_segment_count;
+}
+
+static void s_memory_pool_on_op(struct aws_memory_pool *mempool) {
+    if (++mempool->ops_since_trim >= MEMORY_POOL_TRIM_INTERVAL) {
+        s_memory_pool_trim(mempool);
+    }
+}
+
+int aws_memory_pool_init_from_options(struct aws_memory_pool *mempool, const struct aws_memory_pool_options *options) {
+    AWS_ZERO_STRUCT(*mempool);
+    mempool->alloc = options->alloc;
+    mempool->slab_alloc = options->slab_alloc ? options->slab_alloc : options->alloc;
+    mempool->ideal_segment_count = options->min_segment_count;
+    mempool->max_segment_count = options->max_segment_count;
+    if (mempool->max_segment_count && mempool->max_segment_count < options->min_segment_count) {
+        mempool->max_segment_count = options->min_segment_count;
+    }
+    mempool->segment_size = options->segment_size;
+
+    size_t slab_size = options->slab_size ? options->slab_size : MEMORY_POOL_DEFAULT_SLAB_SIZE;
+    mempool->segments_per_slab = aws_max_size(1, slab_size / s_segment_stride(mempool));
+    aws_linked_list_init(&mempool->slabs);
+
+    if (aws_array_list_init_dynamic(
+            &mempool->stack, mempool->alloc, aws_max_size(options->min_segment_count, 1), sizeof(void *))) {
+        return AWS_OP_ERR;
+    }
+
+    while (mempool->slab_segment_count < options->min_segment_count) {
+        if (s_memory_pool_add_slab(mempool)) {
             goto clean_up;
         }
     }
@@ -39,42 +168,85 @@ clean_up:
     return AWS_OP_ERR;
 }
 
-void aws_memory_pool_clean_up(struct aws_memory_pool *mempool) {
-    void *cur = NULL;
+int aws_memory_pool_init(
+    struct aws_memory_pool *mempool,
+    struct aws_allocator *alloc,
+    uint16_t ideal_segment_count,
+    size_t segment_size) {
 
-    while (aws_array_list_length(&mempool->stack) > 0) {
-        /* the only way this fails is not possible since I already checked the length. */
-        aws_array_list_back(&mempool->stack, &cur);
-        aws_array_list_pop_back(&mempool->stack);
-        aws_mem_release(mempool->alloc, cur);
+    struct aws_memory_pool_options options = {
+        .alloc = alloc,
+        .segment_size = segment_size,
+        .min_segment_count = ideal_segment_count,
+    };
+
+    return aws_memory_pool_init_from_options(mempool, &options);
+}
+
+void aws_memory_pool_clean_up(struct aws_memory_pool *mempool) {
+    while (!aws_linked_list_empty(&mempool->slabs)) {
+        struct memory_slab *slab =
+            AWS_CONTAINER_OF(aws_linked_list_pop_front(&mempool->slabs), struct memory_slab, node);
+        aws_mem_release(mempool->slab_alloc, slab);
     }
 
     aws_array_list_clean_up(&mempool->stack);
-    aws_mem_release(mempool->alloc, mempool->data_ptr);
+    mempool->slab_segment_count = 0;
 }
 
 void *aws_memory_pool_acquire(struct aws_memory_pool *mempool) {
-    void *back = NULL;
+    bool hit = true;
+    if (aws_array_list_length(&mempool->stack) == 0 &&
+        (!mempool->max_segment_count || mempool->slab_segment_count < mempool->max_segment_count)) {
+        hit = false;
+        /* on failure, fall back to an individual allocation below */
+        s_memory_pool_add_slab(mempool);
+    }
+
+    void *segment = NULL;
     if (aws_array_list_length(&mempool->stack) > 0) {
-        aws_array_list_back(&mempool->stack, &back);
+        aws_array_list_back(&mempool->stack, &segment);
         aws_array_list_pop_back(&mempool->stack);
+        (*s_segment_slab(segment))->free_count -= 1;
+    } else {
+        hit = false;
+        uint8_t *memory = aws_mem_acquire(mempool->alloc, s_segment_stride(mempool));
+        if (!memory) {
+            return NULL;
+        }
+        segment = memory + s_segment_header_size();
+        *s_segment_slab(segment) = NULL;
+        mempool->fallbacks += 1;
+    }
 
-        return back;
+    if (hit) {
+        mempool->hits += 1;
+    } else {
+        mempool->misses += 1;
     }
 
-    void *mem = aws_mem_acquire(mempool->alloc, mempool->segment_size);
-    return mem;
+    mempool->outstanding += 1;
+    mempool->peak_outstanding = aws_max_size(mempool->peak_outstanding, mempool->outstanding);
+    s_memory_pool_on_op(mempool);
+
+    return segment;
 }
 
 void aws_memory_pool_release(struct aws_memory_pool *mempool, void *to_release) {
-    size_t pool_size = aws_array_list_length(&mempool->stack);
-
-    if (pool_size >= mempool->ideal_segment_count) {
-        aws_mem_release(mempool->alloc, to_release);
-        return;
+    AWS_ASSERT(mempool->outstanding > 0);
+    mempool->outstanding -= 1;
+
+    struct memory_slab *slab = *s_segment_slab(to_release);
+    if (!slab) {
+        aws_mem_release(mempool->alloc, s_segment_slab(to_release));
+    } else {
+        slab->free_count += 1;
+        /* capacity for every slab segment was reserved when its slab was added */
+        int push_result = aws_array_list_push_back(&mempool->stack, &to_release);
+        AWS_FATAL_ASSERT(push_result == AWS_OP_SUCCESS);
     }
 
-    aws_array_list_push_back(&mempool->stack, &to_release);
+    s_memory_pool_on_op(mempool);
 }
 
 struct message_pool_allocator {
@@ -104,31 +276,91 @@ int aws_message_pool_init(
     struct aws_allocator *alloc,
     struct aws_message_pool_creation_args *args) {
 
+    AWS_ZERO_STRUCT(*msg_pool);
     msg_pool->alloc = alloc;
 
-    size_t msg_data_size = args->application_data_msg_data_size + MSG_OVERHEAD;
+    struct aws_memory_pool_options pool_options = {
+        .alloc = alloc,
+        .slab_alloc = args->slab_allocator,
+    };
+
+    size_t data_sizes[AWS_MESSAGE_POOL_MAX_SIZE_CLASSES];
+    uint8_t msg_counts[AWS_MESSAGE_POOL_MAX_SIZE_CLASSES];
+    size_t class_count = 0;
+
+    data_sizes[class_count] = args->small_block_msg_data_size;
+    msg_counts[class_count++] = args->small_block_msg_count;
+    data_sizes[class_count] = args->application_data_msg_data_size;
+    msg_counts[class_count++] = args->application_data_msg_count;
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(args->additional_msg_data_sizes); ++i) {
+        if (args->additional_msg_data_sizes[i]) {
+            /* created lazily, a loop that never sees this size shouldn't pay for it */
+            data_sizes[class_count] = args->additional_msg_data_sizes[i];
+            msg_counts[class_count++] = 0;
+        }
+    }
 
-    if (aws_memory_pool_init(
-            &msg_pool->application_data_pool, alloc, args->application_data_msg_count, msg_data_size)) {
-        return AWS_OP_ERR;
+    /* insertion sort, there are only a handful of classes. */
+    for (size_t i = 1; i < class_count; ++i) {
+        size_t data_size = data_sizes[i];
+        uint8_t msg_count = msg_counts[i];
+        size_t j = i;
+        for (; j > 0 && data_sizes[j - 1] > data_size; --j) {
+            data_sizes[j] = data_sizes[j - 1];
+            msg_counts[j] = msg_counts[j - 1];
+        }
+        data_sizes[j] = data_size;
+        msg_counts[j] = msg_count;
     }
 
-    size_t small_blk_data_size = args->small_block_msg_data_size + MSG_OVERHEAD;
+    for (size_t i = 0; i < class_count; ++i) {
+        if (msg_pool->size_class_count > 0 &&
+            msg_pool->size_classes[msg_pool->size_class_count - 1].segment_size == data_sizes[i] + MSG_OVERHEAD) {
+            continue;
+        }
 
-    if (aws_memory_pool_init(&msg_pool->small_block_pool, alloc, args->small_block_msg_count, small_blk_data_size)) {
-        aws_memory_pool_clean_up(&msg_pool->application_data_pool);
-        return AWS_OP_ERR;
+        pool_options.segment_size = data_sizes[i] + MSG_OVERHEAD;
+        pool_options.min_segment_count = msg_counts[i];
+        pool_options.max_segment_count = 0;
+        if (args->max_bytes_per_size_class) {
+            pool_options.max_segment_count =
+                aws_max_size(msg_counts[i], args->max_bytes_per_size_class / pool_options.segment_size);
+        }
+
+        struct aws_memory_pool *size_class = &msg_pool->size_classes[msg_pool->size_class_count];
+        if (aws_memory_pool_init_from_options(size_class, &pool_options)) {
+            goto clean_up;
+        }
+        msg_pool->size_class_count++;
     }
 
     return AWS_OP_SUCCESS;
+
+clean_up:
+    aws_message_pool_clean_up(msg_pool);
+    return AWS_OP_ERR;
 }
 
 void aws_message_pool_clean_up(struct aws_message_pool *msg_pool) {
-    aws_memory_pool_clean_up(&msg_pool->application_data_pool);
-    aws_memory_pool_clean_up(&msg_pool->small_block_pool);
+    for (size_t i = 0; i < msg_pool->size_class_count; ++i) {
+        aws_memory_pool_clean_up(&msg_pool->size_classes[i]);
+    }
     AWS_ZERO_STRUCT(*msg_pool);
 }
 
+/* Smallest size class that holds data_size bytes, or the largest class if none of them do. */
+static struct aws_memory_pool *s_message_pool_size_class(struct aws_message_pool *msg_pool, size_t data_size) {
+    AWS_ASSERT(msg_pool->size_class_count > 0);
+
+    for (size_t i = 0; i < msg_pool->size_class_count - 1; ++i) {
+        if (data_size <= msg_pool->size_classes[i].segment_size - MSG_OVERHEAD) {
+            return &msg_pool->size_classes[i];
+        }
+    }
+
+    return &msg_pool->size_classes[msg_pool->size_class_count - 1];
+}
+
 struct message_wrapper {
     struct aws_io_message message;
     struct message_pool_allocator msg_allocator;
@@ -143,15 +375,12 @@ struct aws_io_message *aws_message_pool_acquire(
     struct message_wrapper *message_wrapper = NULL;
     size_t max_size = 0;
     switch (message_type) {
-        case AWS_IO_MESSAGE_APPLICATION_DATA:
-            if (size_hint > msg_pool->small_block_pool.segment_size - MSG_OVERHEAD) {
-                message_wrapper = aws_memory_pool_acquire(&msg_pool->application_data_pool);
-                max_size = msg_pool->application_data_pool.segment_size - MSG_OVERHEAD;
-            } else {
-                message_wrapper = aws_memory_pool_acquire(&msg_pool->small_block_pool);
-                max_size = msg_pool->small_block_pool.segment_size - MSG_OVERHEAD;
-            }
+        case AWS_IO_MESSAGE_APPLICATION_DATA: {
+            struct aws_memory_pool *size_class = s_message_pool_size_class(msg_pool, size_hint);
+            message_wrapper = aws_memory_pool_acquire(size_class);
+            max_size = size_class->segment_size - MSG_OVERHEAD;
             break;
+        }
         default:
             AWS_ASSERT(0);
             aws_raise_error(AWS_IO_CHANNEL_UNKNOWN_MESSAGE_TYPE);
@@ -166,6 +395,7 @@ struct aws_io_message *aws_message_pool_acquire(
     message_wrapper->message.message_tag = 0;
     message_wrapper->message.user_data = NULL;
     message_wrapper->message.copy_mark = 0;
+    message_wrapper->message.slices = NULL;
     message_wrapper->message.on_completion = NULL;
     /* the buffer shares the allocation with the message. It's the bit at the end. */
     message_wrapper->message.message_data.buffer = message_wrapper->buffer_start;
@@ -192,14 +422,26 @@ void aws_message_pool_release(struct aws_message_pool *msg_pool, struct aws_io_m
 
     switch (message->message_type) {
         case AWS_IO_MESSAGE_APPLICATION_DATA:
-            if (message->message_data.capacity > msg_pool->small_block_pool.segment_size - MSG_OVERHEAD) {
-                aws_memory_pool_release(&msg_pool->application_data_pool, wrapper);
-            } else {
-                aws_memory_pool_release(&msg_pool->small_block_pool, wrapper);
-            }
+            /* capacity never exceeds the class the message came from, and always exceeds the class below it. */
+            aws_memory_pool_release(s_message_pool_size_class(msg_pool, message->message_data.capacity), wrapper);
             break;
         default:
             AWS_ASSERT(0);
             aws_raise_error(AWS_IO_CHANNEL_UNKNOWN_MESSAGE_TYPE);
     }
 }
+
+void aws_message_pool_get_statistics(
+    const struct aws_message_pool *msg_pool,
+    struct aws_message_pool_statistics *stats) {
+
+    AWS_ZERO_STRUCT(*stats);
+    for (size_t i = 0; i < msg_pool->size_class_count; ++i) {
+        const struct aws_memory_pool *size_class = &msg_pool->size_classes[i];
+        stats->hits += size_class->hits;
+        stats->misses += size_class->misses;
+        stats->fallbacks += size_class->fallbacks;
+        stats->outstanding += size_class->outstanding;
+        stats->bytes_reserved += size_class->slab_segment_count * s_segment_stride(size_class);
+    }
+}
@@ -0,0 +1,1195 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/io/dns_client.h>
+
+#include <aws/common/clock.h>
+#include <aws/common/condition_variable.h>
+#include <aws/common/device_random.h>
+#include <aws/common/mutex.h>
+#include <aws/common/ref_count.h>
+#include <aws/common/string.h>
+
+#include <aws/io/event_loop.h>
+#include <aws/io/file_utils.h>
+#include <aws/io/host_resolver.h>
+#include <aws/io/logging.h>
+
+#include <arpa/inet.h>
+
+#define DNS_PORT 53
+/* same as the libc resolver's MAXNS */
+#define DNS_MAX_NAMESERVERS 3
+#define DNS_DEFAULT_TIMEOUT_MS 5000
+#define DNS_DEFAULT_ATTEMPTS 2
+/* resolv.conf values are capped the way the libc resolver caps them */
+#define DNS_MAX_RESOLV_CONF_TIMEOUT_SECS 30
+#define DNS_MAX_RESOLV_CONF_ATTEMPTS 5
+
+/* a name that encodes to at most 255 bytes, not counting an optional trailing dot */
+#define DNS_MAX_NAME_LEN 253
+#define DNS_MAX_LABEL_LEN 63
+#define DNS_HEADER_LEN 12
+/* we don't advertise a larger EDNS payload size, but are lenient about what comes back */
+#define DNS_READ_BUFFER_SIZE 4096
+
+#define DNS_FLAG_QR 0x8000
+#define DNS_FLAG_TC 0x0200
+#define DNS_FLAG_RD 0x0100
+#define DNS_RCODE_MASK 0x000F
+#define DNS_RCODE_NOERROR 0
+#define DNS_RCODE_NXDOMAIN 3
+
+#define DNS_TYPE_A 1
+#define DNS_TYPE_CNAME 5
+#define DNS_TYPE_AAAA 28
+#define DNS_CLASS_IN 1
+
+/* CNAMEs followed from the queried name before the rest of an answer is ignored */
+#define DNS_MAX_CNAME_CHAIN 8
+
+static const char *s_default_resolv_conf_path = "/etc/resolv.conf";
+static const char *s_default_hosts_path = "/etc/hosts";
+
+struct dns_nameserver {
+    struct aws_socket_endpoint endpoint;
+    enum aws_socket_domain domain;
+};
+
+/* one name -> address mapping from the hosts file */
+struct dns_hosts_entry {
+    struct aws_string *name;
+    struct aws_string *address;
+    enum aws_address_record_type record_type;
+};
+
+struct aws_dns_client {
+    struct aws_allocator *allocator;
+    struct aws_event_loop_group *el_group;
+    struct aws_ref_count ref_count;
+
+    struct dns_nameserver nameservers[DNS_MAX_NAMESERVERS];
+    size_t nameserver_count;
+    uint64_t timeout_ns;
+    uint32_t attempts;
+
+    /* struct dns_hosts_entry */
+    struct aws_array_list hosts;
+};
+
+/* What came of one attempt at a query. */
+enum dns_attempt_outcome {
+    /* NOERROR, any matching records have been added to the request */
+    DNS_ATTEMPT_ANSWERED,
+    DNS_ATTEMPT_NXDOMAIN,
+    /* the UDP answer didn't fit, ask the same nameserver again over TCP */
+    DNS_ATTEMPT_TRUNCATED,
+    /* timeout, network error, SERVFAIL, garbage... move on to the next nameserver */
+    DNS_ATTEMPT_FAILED,
+    /* not (yet) an answer to this query, keep reading */
+    DNS_ATTEMPT_PENDING,
+};
+
+struct dns_resolve_request;
+
+/*
+ * A single question (A or AAAA) for the request's host. Everything about it happens on the request's event loop.
+ */
+struct dns_query {
+    struct dns_resolve_request *request;
+    uint16_t record_type;
+    uint16_t id;
+
+    /* the encoded query, preceded by the two byte length prefix that only goes out over TCP */
+    struct aws_byte_buf message;
+    struct aws_byte_buf response;
+
+    /* attempts made so far, the nameserver asked is attempt % nameserver_count */
+    uint32_t attempt;
+    bool use_tcp;
+
+    struct aws_socket socket;
+    bool socket_open;
+
+    /* true while the current attempt may still produce an outcome. Socket callbacks are ignored otherwise. */
+    bool attempt_active;
+    enum dns_attempt_outcome outcome;
+    int error_code;
+    struct aws_task timeout_task;
+    bool timeout_scheduled;
+
+    /*
+     * Attempts are wrapped up from a task rather than from whichever socket callback ended them, since sockets can't
+     * be cleaned up from inside all of their callbacks.
+     */
+    struct aws_task attempt_done_task;
+
+    bool nxdomain;
+};
+
+struct dns_resolve_request {
+    struct aws_allocator *allocator;
+    struct aws_dns_client *client;
+    struct aws_event_loop *event_loop;
+    struct aws_string *host_name;
+    aws_dns_client_on_resolved_fn *on_resolved;
+    void *user_data;
+
+    struct aws_task start_task;
+
+    /* struct aws_host_address, A and AAAA answers together */
+    struct aws_array_list addresses;
+
+    struct dns_query queries[2];
+    size_t queries_outstanding;
+};
+
+static bool s_is_blank(uint8_t c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/* Pops the next blank-separated token off line. Returns false at the end of the line, or where a comment starts. */
+static bool s_next_token(struct aws_byte_cursor *line, struct aws_byte_cursor *token) {
+    while (line->len > 0 && s_is_blank(*line->ptr)) {
+        aws_byte_cursor_advance(line, 1);
+    }
+
+    if (line->len == 0 || *line->ptr == '#' || *line->ptr == ';') {
+        return false;
+    }
+
+    size_t token_len = 0;
+    while (token_len < line->len && !s_is_blank(line->ptr[token_len])) {
+        ++token_len;
+    }
+
+    *token = aws_byte_cursor_advance(line, token_len);
+    return true;
+}
+
+/* Returns true if text is an IPv4 or IPv6 address literal, along with which of the two it is. */
+static bool s_parse_address_literal(struct aws_byte_cursor text, enum aws_address_record_type *record_type) {
+    char address[INET6_ADDRSTRLEN];
+    if (text.len == 0 || text.len >= sizeof(address)) {
+        return false;
+    }
+
+    memcpy(address, text.ptr, text.len);
+    address[text.len] = '\0';
+
+    uint8_t binary[16];
+    if (inet_pton(AF_INET, address, binary) == 1) {
+        *record_type = AWS_ADDRESS_RECORD_TYPE_A;
+        return true;
+    }
+
+    if (inet_pton(AF_INET6, address, binary) == 1) {
+        *record_type = AWS_ADDRESS_RECORD_TYPE_AAAA;
+        return true;
+    }
+
+    return false;
+}
+
+static int s_add_nameserver(struct aws_dns_client *client, struct aws_byte_cursor address, uint16_t port) {
+    enum aws_address_record_type record_type = AWS_ADDRESS_RECORD_TYPE_A;
+    if (!s_parse_address_literal(address, &record_type)) {
+        return aws_raise_error(AWS_IO_SOCKET_INVALID_ADDRESS);
+    }
+
+    if (client->nameserver_count == DNS_MAX_NAMESERVERS) {
+        AWS_LOGF_DEBUG(
+            AWS_LS_IO_DNS,
+            "id=%p: ignoring nameserver " PRInSTR ", only the first %d are used",
+            (void *)client,
+            AWS_BYTE_CURSOR_PRI(address),
+            DNS_MAX_NAMESERVERS);
+        return AWS_OP_SUCCESS;
+    }
+
+    struct dns_nameserver *nameserver = &client->nameservers[client->nameserver_count++];
+    AWS_ZERO_STRUCT(*nameserver);
+    memcpy(nameserver->endpoint.address, address.ptr, address.len);
+    nameserver->endpoint.port = port;
+    nameserver->domain = record_type == AWS_ADDRESS_RECORD_TYPE_AAAA ? AWS_SOCKET_IPV6 : AWS_SOCKET_IPV4;
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_parse_resolv_conf_option(struct aws_byte_cursor option, const char *name, uint32_t max, uint32_t *value) {
+    struct aws_byte_cursor prefix = aws_byte_cursor_from_c_str(name);
+    if (!aws_byte_cursor_starts_with(&option, &prefix)) {
+        return;
+    }
+
+    aws_byte_cursor_advance(&option, prefix.len);
+    uint64_t parsed = 0;
+    if (aws_byte_cursor_utf8_parse_u64(option, &parsed) == AWS_OP_SUCCESS && parsed > 0) {
+        *value = (uint32_t)aws_min_u64(parsed, max);
+    }
+}
+
+/*
+ * Picks up "nameserver" lines (unless the caller supplied nameservers) and the timeout and attempts options. A
+ * missing or unreadable file just leaves the defaults in place, as it does for the libc resolver.
+ */
+static void s_load_resolv_conf(
+    struct aws_dns_client *client,
+    const char *path,
+    bool load_nameservers,
+    uint32_t *timeout_secs,
+    uint32_t *attempts) {
+
+    struct aws_byte_buf contents;
+    if (aws_byte_buf_init_from_file(&contents, client->allocator, path)) {
+        AWS_LOGF_WARN(AWS_LS_IO_DNS, "id=%p: could not read %s, using resolver defaults", (void *)client, path);
+        return;
+    }
+
+    struct aws_byte_cursor file = aws_byte_cursor_from_buf(&contents);
+    struct aws_byte_cursor line;
+    AWS_ZERO_STRUCT(line);
+    while (aws_byte_cursor_next_split(&file, '\n', &line)) {
+        struct aws_byte_cursor remaining = line;
+        struct aws_byte_cursor keyword;
+        if (!s_next_token(&remaining, &keyword)) {
+            continue;
+        }
+
+        struct aws_byte_cursor value;
+        if (aws_byte_cursor_eq_c_str(&keyword, "nameserver")) {
+            if (load_nameservers && s_next_token(&remaining, &value) && s_add_nameserver(client, value, DNS_PORT)) {
+                AWS_LOGF_WARN(
+                    AWS_LS_IO_DNS,
+                    "id=%p: ignoring invalid nameserver " PRInSTR " in %s",
+                    (void *)client,
+                    AWS_BYTE_CURSOR_PRI(value),
+                    path);
+            }
+        } else if (aws_byte_cursor_eq_c_str(&keyword, "options")) {
+            while (s_next_token(&remaining, &value)) {
+                s_parse_resolv_conf_option(value, "timeout:", DNS_MAX_RESOLV_CONF_TIMEOUT_SECS, timeout_secs);
+                s_parse_resolv_conf_option(value, "attempts:", DNS_MAX_RESOLV_CONF_ATTEMPTS, attempts);
+            }
+        }
+    }
+
+    aws_byte_buf_clean_up(&contents);
+}
+
+static int s_load_hosts_file(struct aws_dns_client *client, const char *path) {
+    struct aws_byte_buf contents;
+    if (aws_byte_buf_init_from_file(&contents, client->allocator, path)) {
+        AWS_LOGF_DEBUG(AWS_LS_IO_DNS, "id=%p: could not read %s, no static host entries", (void *)client, path);
+        return AWS_OP_SUCCESS;
+    }
+
+    int result = AWS_OP_SUCCESS;
+    struct aws_byte_cursor file = aws_byte_cursor_from_buf(&contents);
+    struct aws_byte_cursor line;
+    AWS_ZERO_STRUCT(line);
+    while (result == AWS_OP_SUCCESS && aws_byte_cursor_next_split(&file, '\n', &line)) {
+        struct aws_byte_cursor remaining = line;
+        struct aws_byte_cursor address;
+        enum aws_address_record_type record_type = AWS_ADDRESS_RECORD_TYPE_A;
+        if (!s_next_token(&remaining, &address) || !s_parse_address_literal(address, &record_type)) {
+            continue;
+        }
+
+        struct aws_byte_cursor name;
+        while (s_next_token(&remaining, &name)) {
+            struct dns_hosts_entry entry = {
+                .name = aws_string_new_from_cursor(client->allocator, &name),
+                .address = aws_string_new_from_cursor(client->allocator, &address),
+                .record_type = record_type,
+            };
+
+            if (!entry.name || !entry.address || aws_array_list_push_back(&client->hosts, &entry)) {
+                aws_string_destroy(entry.name);
+                aws_string_destroy(entry.address);
+                result = AWS_OP_ERR;
+                break;
+            }
+        }
+    }
+
+    aws_byte_buf_clean_up(&contents);
+    return result;
+}
+
+static void s_dns_client_destroy(void *user_data) {
+    struct aws_dns_client *client = user_data;
+
+    for (size_t i = 0; i < aws_array_list_length(&client->hosts); ++i) {
+        struct dns_hosts_entry *entry = NULL;
+        aws_array_list_get_at_ptr(&client->hosts, (void **)&entry, i);
+        aws_string_destroy(entry->name);
+        aws_string_destroy(entry->address);
+    }
+    aws_array_list_clean_up(&client->hosts);
+
+    aws_event_loop_group_release(client->el_group);
+    aws_mem_release(client->allocator, client);
+}
+
+struct aws_dns_client *aws_dns_client_new(struct aws_allocator *allocator, const struct aws_dns_client_options *options) {
+    AWS_PRECONDITION(options && options->el_group);
+
+    if (options->nameserver_count > DNS_MAX_NAMESERVERS) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    struct aws_dns_client *client = aws_mem_calloc(allocator, 1, sizeof(struct aws_dns_client));
+    if (!client) {
+        return NULL;
+    }
+
+    client->allocator = allocator;
+    client->el_group = aws_event_loop_group_acquire(options->el_group);
+    aws_ref_count_init(&client->ref_count, client, s_dns_client_destroy);
+
+    if (aws_array_list_init_dynamic(&client->hosts, allocator, 8, sizeof(struct dns_hosts_entry))) {
+        goto on_error;
+    }
+
+    for (size_t i = 0; i < options->nameserver_count; ++i) {
+        const struct aws_socket_endpoint *endpoint = &options->nameservers[i];
+        if (s_add_nameserver(client, aws_byte_cursor_from_c_str(endpoint->address), endpoint->port)) {
+            goto on_error;
+        }
+    }
+
+    uint32_t timeout_secs = 0;
+    uint32_t attempts = 0;
+    s_load_resolv_conf(
+        client,
+        options->resolv_conf_path ? options->resolv_conf_path : s_default_resolv_conf_path,
+        options->nameserver_count == 0,
+        &timeout_secs,
+        &attempts);
+
+    if (client->nameserver_count == 0) {
+        /* what the libc resolver falls back to as well */
+        s_add_nameserver(client, aws_byte_cursor_from_c_str("127.0.0.1"), DNS_PORT);
+    }
+
+    if (s_load_hosts_file(client, options->hosts_path ? options->hosts_path : s_default_hosts_path)) {
+        goto on_error;
+    }
+
+    uint64_t timeout_ms = options->timeout_ms;
+    if (timeout_ms == 0) {
+        timeout_ms = timeout_secs > 0 ? (uint64_t)timeout_secs * 1000 : DNS_DEFAULT_TIMEOUT_MS;
+    }
+    client->timeout_ns = aws_timestamp_convert(timeout_ms, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+
+    client->attempts = options->attempts;
+    if (client->attempts == 0) {
+        client->attempts = attempts > 0 ? attempts : DNS_DEFAULT_ATTEMPTS;
+    }
+
+    AWS_LOGF_INFO(
+        AWS_LS_IO_DNS,
+        "id=%p: dns client created with %d nameservers, %llu ms timeout, %u attempts and %d static host entries",
+        (void *)client,
+        (int)client->nameserver_count,
+        (unsigned long long)timeout_ms,
+        client->attempts,
+        (int)aws_array_list_length(&client->hosts));
+
+    return client;
+
+on_error:
+    s_dns_client_destroy(client);
+    return NULL;
+}
+
+struct aws_dns_client *aws_dns_client_acquire(struct aws_dns_client *client) {
+    if (client != NULL) {
+        aws_ref_count_acquire(&client->ref_count);
+    }
+
+    return client;
+}
+
+void aws_dns_client_release(struct aws_dns_client *client) {
+    if (client != NULL) {
+        aws_ref_count_release(&client->ref_count);
+    }
+}
+
+static int s_add_address(
+    struct dns_resolve_request *request,
+    struct aws_byte_cursor address,
+    enum aws_address_record_type record_type,
+    uint64_t expiry) {
+
+    struct aws_host_address host_address;
+    AWS_ZERO_STRUCT(host_address);
+    host_address.allocator = request->allocator;
+    host_address.record_type = record_type;
+    host_address.expiry = expiry;
+    host_address.address = aws_string_new_from_cursor(request->allocator, &address);
+    host_address.host = aws_string_new_from_string(request->allocator, request->host_name);
+
+    if (!host_address.address || !host_address.host ||
+        aws_array_list_push_back(&request->addresses, &host_address)) {
+        aws_host_address_clean_up(&host_address);
+        return AWS_OP_ERR;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/* Drops addresses past the first `count`, e.g. the ones added from a response that turned out to be malformed. */
+static void s_truncate_addresses(struct dns_resolve_request *request, size_t count) {
+    while (aws_array_list_length(&request->addresses) > count) {
+        struct aws_host_address *address = NULL;
+        aws_array_list_back(&request->addresses, (void **)&address);
+        aws_host_address_clean_up(address);
+        aws_array_list_pop_back(&request->addresses);
+    }
+}
+
+/* Names are looked up without a trailing dot, whether or not the caller gave one. */
+static struct aws_byte_cursor s_query_name(const struct aws_string *host_name) {
+    struct aws_byte_cursor name = aws_byte_cursor_from_string(host_name);
+    if (name.len > 0 && name.ptr[name.len - 1] == '.') {
+        name.len -= 1;
+    }
+
+    return name;
+}
+
+/* Adds the addresses that can be known without asking anyone: an address literal, or hosts file entries. */
+static int s_resolve_locally(struct dns_resolve_request *request, struct aws_byte_cursor name) {
+    enum aws_address_record_type record_type = AWS_ADDRESS_RECORD_TYPE_A;
+    if (s_parse_address_literal(name, &record_type)) {
+        return s_add_address(request, name, record_type, 0);
+    }
+
+    struct aws_array_list *hosts = &request->client->hosts;
+    for (size_t i = 0; i < aws_array_list_length(hosts); ++i) {
+        struct dns_hosts_entry *entry = NULL;
+        aws_array_list_get_at_ptr(hosts, (void **)&entry, i);
+
+        struct aws_byte_cursor entry_name = aws_byte_cursor_from_string(entry->name);
+        if (aws_byte_cursor_eq_ignore_case(&entry_name, &name) &&
+            s_add_address(request, aws_byte_cursor_from_string(entry->address), entry->record_type, 0)) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_encode_query(struct dns_query *query, struct aws_byte_cursor name) {
+    if (name.len == 0 || name.len > DNS_MAX_NAME_LEN) {
+        return aws_raise_error(AWS_IO_DNS_INVALID_NAME);
+    }
+
+    /* length prefix, header, the name's labels plus their length bytes and the root label, type and class */
+    if (aws_byte_buf_init(&query->message, query->request->allocator, 2 + DNS_HEADER_LEN + name.len + 2 + 4)) {
+        return AWS_OP_ERR;
+    }
+
+    struct aws_byte_buf *message = &query->message;
+    aws_byte_buf_write_be16(message, 0);
+    aws_byte_buf_write_be16(message, query->id);
+    aws_byte_buf_write_be16(message, DNS_FLAG_RD);
+    aws_byte_buf_write_be16(message, 1);
+    aws_byte_buf_write_be16(message, 0);
+    aws_byte_buf_write_be16(message, 0);
+    aws_byte_buf_write_be16(message, 0);
+
+    struct aws_byte_cursor label;
+    AWS_ZERO_STRUCT(label);
+    while (aws_byte_cursor_next_split(&name, '.', &label)) {
+        if (label.len == 0 || label.len > DNS_MAX_LABEL_LEN) {
+            return aws_raise_error(AWS_IO_DNS_INVALID_NAME);
+        }
+
+        aws_byte_buf_write_u8(message, (uint8_t)label.len);
+        aws_byte_buf_write_from_whole_cursor(message, label);
+    }
+
+    aws_byte_buf_write_u8(message, 0);
+    aws_byte_buf_write_be16(message, query->record_type);
+    aws_byte_buf_write_be16(message, DNS_CLASS_IN);
+
+    size_t message_len = message->len - 2;
+    message->buffer[0] = (uint8_t)(message_len >> 8);
+    message->buffer[1] = (uint8_t)message_len;
+
+    return AWS_OP_SUCCESS;
+}
+
+/* a name read out of a message, as dotted text without the trailing dot */
+struct dns_name {
+    uint8_t buffer[DNS_MAX_NAME_LEN];
+    size_t len;
+};
+
+static struct aws_byte_cursor s_dns_name_cursor(const struct dns_name *name) {
+    return aws_byte_cursor_from_array(name->buffer, name->len);
+}
+
+/*
+ * Reads a possibly compressed name at cursor, which points into message, and advances cursor past it. Compression
+ * pointers have to point back to something earlier than themselves, so a hostile message can't make this loop.
+ */
+static bool s_read_name(struct aws_byte_cursor message, struct aws_byte_cursor *cursor, struct dns_name *name) {
+    name->len = 0;
+    struct aws_byte_cursor labels = *cursor;
+    bool jumped = false;
+
+    uint8_t label_len = 0;
+    while (aws_byte_cursor_read_u8(&labels, &label_len)) {
+        if (label_len == 0) {
+            if (!jumped) {
+                *cursor = labels;
+            }
+            return true;
+        }
+
+        if ((label_len & 0xC0) == 0xC0) {
+            uint8_t offset_low = 0;
+            if (!aws_byte_cursor_read_u8(&labels, &offset_low)) {
+                return false;
+            }
+
+            size_t pointer_offset = (size_t)(labels.ptr - message.ptr) - 2;
+            size_t offset = ((size_t)(label_len & 0x3F) << 8) | offset_low;
+            if (offset >= pointer_offset) {
+                return false;
+            }
+
+            /* the name ends here as far as the cursor is concerned, the rest of it lives elsewhere */
+            if (!jumped) {
+                *cursor = labels;
+                jumped = true;
+            }
+            labels = aws_byte_cursor_from_array(message.ptr + offset, message.len - offset);
+            continue;
+        }
+
+        struct aws_byte_cursor label = aws_byte_cursor_advance(&labels, label_len);
+        size_t separator_len = name->len > 0 ? 1 : 0;
+        if ((label_len & 0xC0) != 0 || label.ptr == NULL ||
+            name->len + separator_len + label_len > DNS_MAX_NAME_LEN) {
+            return false;
+        }
+
+        if (separator_len) {
+            name->buffer[name->len++] = '.';
+        }
+        memcpy(name->buffer + name->len, label.ptr, label_len);
+        name->len += label_len;
+    }
+
+    return false;
+}
+
+/* one resource record out of the answer section */
+struct dns_record {
+    struct dns_name owner;
+    uint16_t type;
+    uint16_t class;
+    uint32_t ttl;
+    struct aws_byte_cursor data;
+};
+
+static bool s_read_record(struct aws_byte_cursor message, struct aws_byte_cursor *cursor, struct dns_record *record) {
+    uint16_t data_len = 0;
+    if (!s_read_name(message, cursor, &record->owner) || !aws_byte_cursor_read_be16(cursor, &record->type) ||
+        !aws_byte_cursor_read_be16(cursor, &record->class) || !aws_byte_cursor_read_be32(cursor, &record->ttl) ||
+        !aws_byte_cursor_read_be16(cursor, &data_len) || data_len > cursor->len) {
+        return false;
+    }
+
+    record->data = aws_byte_cursor_advance(cursor, data_len);
+    return true;
+}
+
+/* the queried name, followed by the names it's an alias for */
+struct dns_cname_chain {
+    struct dns_name names[1 + DNS_MAX_CNAME_CHAIN];
+    size_t count;
+};
+
+static bool s_cname_chain_contains(const struct dns_cname_chain *chain, const struct dns_name *name) {
+    struct aws_byte_cursor name_cursor = s_dns_name_cursor(name);
+    for (size_t i = 0; i < chain->count; ++i) {
+        struct aws_byte_cursor chain_name = s_dns_name_cursor(&chain->names[i]);
+        if (aws_byte_cursor_eq_ignore_case(&chain_name, &name_cursor)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Follows the answer's CNAME records out from the queried name. Servers list them in order, but going over the
+ * answers until the chain stops growing doesn't rely on it.
+ */
+static bool s_follow_cname_chain(
+    struct aws_byte_cursor message,
+    struct aws_byte_cursor answers,
+    uint16_t answer_count,
+    struct dns_cname_chain *chain) {
+
+    size_t previous_count = 0;
+    while (chain->count > previous_count && chain->count < AWS_ARRAY_SIZE(chain->names)) {
+        previous_count = chain->count;
+
+        struct aws_byte_cursor records = answers;
+        for (uint16_t i = 0; i < answer_count && chain->count < AWS_ARRAY_SIZE(chain->names); ++i) {
+            struct dns_record record;
+            if (!s_read_record(message, &records, &record)) {
+                return false;
+            }
+
+            if (record.class != DNS_CLASS_IN || record.type != DNS_TYPE_CNAME ||
+                !s_cname_chain_contains(chain, &record.owner)) {
+                continue;
+            }
+
+            struct dns_name *target = &chain->names[chain->count];
+            struct aws_byte_cursor data = record.data;
+            if (!s_read_name(message, &data, target)) {
+                return false;
+            }
+
+            if (!s_cname_chain_contains(chain, target)) {
+                chain->count += 1;
+            }
+        }
+    }
+
+    return true;
+}
+
+static enum dns_attempt_outcome s_process_response(struct dns_query *query, struct aws_byte_cursor response) {
+    const struct aws_byte_cursor message = response;
+    uint16_t id = 0;
+    uint16_t flags = 0;
+    uint16_t question_count = 0;
+    uint16_t answer_count = 0;
+    if (!aws_byte_cursor_read_be16(&response, &id) || !aws_byte_cursor_read_be16(&response, &flags) ||
+        !aws_byte_cursor_read_be16(&response, &question_count) ||
+        !aws_byte_cursor_read_be16(&response, &answer_count) || !aws_byte_cursor_advance(&response, 4).ptr) {
+        return DNS_ATTEMPT_PENDING;
+    }
+
+    /* anything that isn't a response to our query is most likely stale or spoofed, so keep waiting for the real one */
+    if (id != query->id || !(flags & DNS_FLAG_QR)) {
+        return DNS_ATTEMPT_PENDING;
+    }
+
+    /* and so is one that doesn't echo back the question exactly as it was asked */
+    struct dns_resolve_request *request = query->request;
+    struct dns_cname_chain chain;
+    chain.count = 1;
+    uint16_t question_type = 0;
+    uint16_t question_class = 0;
+    if (question_count != 1 || !s_read_name(message, &response, &chain.names[0]) ||
+        !aws_byte_cursor_read_be16(&response, &question_type) ||
+        !aws_byte_cursor_read_be16(&response, &question_class)) {
+        return DNS_ATTEMPT_PENDING;
+    }
+
+    struct aws_byte_cursor query_name = s_query_name(request->host_name);
+    struct aws_byte_cursor question_name = s_dns_name_cursor(&chain.names[0]);
+    if (!aws_byte_cursor_eq_ignore_case(&question_name, &query_name) || question_type != query->record_type ||
+        question_class != DNS_CLASS_IN) {
+        AWS_LOGF_DEBUG(
+            AWS_LS_IO_DNS,
+            "static: ignoring response for %s that answers a different question",
+            aws_string_c_str(request->host_name));
+        return DNS_ATTEMPT_PENDING;
+    }
+
+    if (flags & DNS_FLAG_TC) {
+        return query->use_tcp ? DNS_ATTEMPT_FAILED : DNS_ATTEMPT_TRUNCATED;
+    }
+
+    switch (flags & DNS_RCODE_MASK) {
+        case DNS_RCODE_NOERROR:
+            break;
+        case DNS_RCODE_NXDOMAIN:
+            return DNS_ATTEMPT_NXDOMAIN;
+        default:
+            AWS_LOGF_DEBUG(
+                AWS_LS_IO_DNS,
+                "static: query for %s failed with rcode %d",
+                aws_string_c_str(request->host_name),
+                (int)(flags & DNS_RCODE_MASK));
+            return DNS_ATTEMPT_FAILED;
+    }
+
+    /* only records for the queried name, or a name it's an alias for, answer the question */
+    if (!s_follow_cname_chain(message, response, answer_count, &chain)) {
+        return DNS_ATTEMPT_FAILED;
+    }
+
+    uint64_t now = 0;
+    aws_sys_clock_get_ticks(&now);
+
+    size_t previous_count = aws_array_list_length(&request->addresses);
+    for (uint16_t i = 0; i < answer_count; ++i) {
+        struct dns_record record;
+        if (!s_read_record(message, &response, &record)) {
+            goto malformed;
+        }
+
+        /* CNAMEs and the like: the records for the name they point to come along in the same answer */
+        if (record.class != DNS_CLASS_IN || record.type != query->record_type) {
+            continue;
+        }
+
+        if (!s_cname_chain_contains(&chain, &record.owner)) {
+            AWS_LOGF_DEBUG(
+                AWS_LS_IO_DNS,
+                "static: ignoring record for " PRInSTR " in the answer for %s",
+                AWS_BYTE_CURSOR_PRI(s_dns_name_cursor(&record.owner)),
+                aws_string_c_str(request->host_name));
+            continue;
+        }
+
+        int family = record.type == DNS_TYPE_A ? AF_INET : AF_INET6;
+        char address[INET6_ADDRSTRLEN];
+        if (record.data.len != (record.type == DNS_TYPE_A ? 4u : 16u) ||
+            !inet_ntop(family, record.data.ptr, address, sizeof(address))) {
+            goto malformed;
+        }
+
+        /* TTLs with the top bit set are to be treated as 0 (RFC 2181) */
+        uint32_t ttl = record.ttl > INT32_MAX ? 0 : record.ttl;
+
+        enum aws_address_record_type record_type =
+            record.type == DNS_TYPE_A ? AWS_ADDRESS_RECORD_TYPE_A : AWS_ADDRESS_RECORD_TYPE_AAAA;
+        uint64_t expiry = now + aws_timestamp_convert(ttl, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL);
+        if (s_add_address(request, aws_byte_cursor_from_c_str(address), record_type, expiry)) {
+            goto malformed;
+        }
+    }
+
+    return DNS_ATTEMPT_ANSWERED;
+
+malformed:
+    s_truncate_addresses(request, previous_count);
+    return DNS_ATTEMPT_FAILED;
+}
+
+static void s_dns_query_end_attempt(struct dns_query *query, enum dns_attempt_outcome outcome, int error_code) {
+    if (!query->attempt_active) {
+        return;
+    }
+
+    query->attempt_active = false;
+    query->outcome = outcome;
+    query->error_code = error_code;
+    aws_event_loop_schedule_task_now(query->request->event_loop, &query->attempt_done_task);
+}
+
+/* Looks at what's been read so far. Over TCP, the message may still be incomplete. */
+static enum dns_attempt_outcome s_dns_query_process_read(struct dns_query *query) {
+    struct aws_byte_buf *response = &query->response;
+    if (!query->use_tcp) {
+        return s_process_response(query, aws_byte_cursor_from_buf(response));
+    }
+
+    if (response->len < 2) {
+        return DNS_ATTEMPT_PENDING;
+    }
+
+    size_t message_len = ((size_t)response->buffer[0] << 8) | response->buffer[1];
+    if (aws_byte_buf_reserve(response, 2 + message_len)) {
+        return DNS_ATTEMPT_FAILED;
+    }
+
+    if (response->len < 2 + message_len) {
+        return DNS_ATTEMPT_PENDING;
+    }
+
+    return s_process_response(query, aws_byte_cursor_from_array(response->buffer + 2, message_len));
+}
+
+static void s_on_query_readable(struct aws_socket *socket, int error_code, void *user_data) {
+    struct dns_query *query = user_data;
+
+    if (error_code) {
+        s_dns_query_end_attempt(query, DNS_ATTEMPT_FAILED, error_code);
+        return;
+    }
+
+    while (query->attempt_active) {
+        /* each UDP read is one whole datagram */
+        if (!query->use_tcp) {
+            query->response.len = 0;
+        }
+
+        size_t amount_read = 0;
+        if (aws_socket_read(socket, &query->response, &amount_read)) {
+            int read_error = aws_last_error();
+            if (read_error != AWS_IO_READ_WOULD_BLOCK) {
+                s_dns_query_end_attempt(query, DNS_ATTEMPT_FAILED, read_error);
+            }
+            return;
+        }
+
+        if (amount_read == 0 && query->use_tcp) {
+            s_dns_query_end_attempt(query, DNS_ATTEMPT_FAILED, AWS_IO_SOCKET_CLOSED);
+            return;
+        }
+
+        enum dns_attempt_outcome outcome = s_dns_query_process_read(query);
+        if (outcome != DNS_ATTEMPT_PENDING) {
+            s_dns_query_end_attempt(query, outcome, outcome == DNS_ATTEMPT_FAILED ? AWS_IO_DNS_QUERY_FAILED : 0);
+        }
+    }
+}
+
+static void s_on_query_written(struct aws_socket *socket, int error_code, size_t bytes_written, void *user_data) {
+    (void)socket;
+    (void)bytes_written;
+    struct dns_query *query = user_data;
+
+    if (error_code) {
+        s_dns_query_end_attempt(query, DNS_ATTEMPT_FAILED, error_code);
+    }
+}
+
+static void s_on_query_connected(struct aws_socket *socket, int error_code, void *user_data) {
+    struct dns_query *query = user_data;
+
+    if (error_code) {
+        s_dns_query_end_attempt(query, DNS_ATTEMPT_FAILED, error_code);
+        return;
+    }
+
+    struct aws_byte_cursor message = aws_byte_cursor_from_buf(&query->message);
+    if (!query->use_tcp) {
+        aws_byte_cursor_advance(&message, 2);
+    }
+
+    if (aws_socket_subscribe_to_readable_events(socket, s_on_query_readable, query) ||
+        aws_socket_write(socket, &message, s_on_query_written, query)) {
+        s_dns_query_end_attempt(query, DNS_ATTEMPT_FAILED, aws_last_error());
+    }
+}
+
+static void s_on_query_timeout(struct aws_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    struct dns_query *query = arg;
+
+    if (status != AWS_TASK_STATUS_RUN_READY) {
+        return;
+    }
+
+    query->timeout_scheduled = false;
+    s_dns_query_end_attempt(query, DNS_ATTEMPT_FAILED, AWS_IO_SOCKET_TIMEOUT);
+}
+
+static void s_dns_query_start_attempt(struct dns_query *query) {
+    struct dns_resolve_request *request = query->request;
+    struct aws_dns_client *client = request->client;
+    const struct dns_nameserver *nameserver = &client->nameservers[query->attempt % client->nameserver_count];
+
+    AWS_LOGF_TRACE(
+        AWS_LS_IO_DNS,
+        "static: querying %s:%d over %s for %s records of %s",
+        nameserver->endpoint.address,
+        (int)nameserver->endpoint.port,
+        query->use_tcp ? "tcp" : "udp",
+        query->record_type == DNS_TYPE_A ? "A" : "AAAA",
+        aws_string_c_str(request->host_name));
+
+    query->attempt_active = true;
+    query->response.len = 0;
+
+    uint64_t now = 0;
+    aws_event_loop_current_clock_time(request->event_loop, &now);
+    aws_event_loop_schedule_task_future(request->event_loop, &query->timeout_task, now + client->timeout_ns);
+    query->timeout_scheduled = true;
+
+    struct aws_socket_options options = {
+        .type = query->use_tcp ? AWS_SOCKET_STREAM : AWS_SOCKET_DGRAM,
+        .domain = nameserver->domain,
+        .connect_timeout_ms =
+            (uint32_t)aws_timestamp_convert(client->timeout_ns, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_MILLIS, NULL),
+    };
+
+    if (aws_socket_init(&query->socket, request->allocator, &options)) {
+        s_dns_query_end_attempt(query, DNS_ATTEMPT_FAILED, aws_last_error());
+        return;
+    }
+
+    query->socket_open = true;
+    if (aws_socket_connect(&query->socket, &nameserver->endpoint, request->event_loop, s_on_query_connected, query)) {
+        s_dns_query_end_attempt(query, DNS_ATTEMPT_FAILED, aws_last_error());
+    }
+}
+
+static void s_dns_resolve_request_complete(struct dns_resolve_request *request, int error_code);
+
+static int s_dns_resolve_request_error(struct dns_resolve_request *request) {
+    if (aws_array_list_length(&request->addresses) > 0) {
+        return AWS_ERROR_SUCCESS;
+    }
+
+    if (request->queries[0].nxdomain && request->queries[1].nxdomain) {
+        return AWS_IO_DNS_INVALID_NAME;
+    }
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(request->queries); ++i) {
+        if (request->queries[i].error_code) {
+            return AWS_IO_DNS_QUERY_FAILED;
+        }
+    }
+
+    /* the name exists, but has neither A nor AAAA records */
+    return AWS_IO_DNS_NO_ADDRESS_FOR_HOST;
+}
+
+static void s_on_query_attempt_done(struct aws_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    (void)status;
+    struct dns_query *query = arg;
+    struct dns_resolve_request *request = query->request;
+    struct aws_dns_client *client = request->client;
+
+    if (query->timeout_scheduled) {
+        query->timeout_scheduled = false;
+        aws_event_loop_cancel_task(request->event_loop, &query->timeout_task);
+    }
+
+    if (query->socket_open) {
+        query->socket_open = false;
+        aws_socket_close(&query->socket);
+        aws_socket_clean_up(&query->socket);
+    }
+
+    switch (query->outcome) {
+        case DNS_ATTEMPT_TRUNCATED:
+            query->use_tcp = true;
+            s_dns_query_start_attempt(query);
+            return;
+        case DNS_ATTEMPT_FAILED:
+            AWS_LOGF_DEBUG(
+                AWS_LS_IO_DNS,
+                "static: attempt %u at resolving %s failed with error %s",
+                query->attempt,
+                aws_string_c_str(request->host_name),
+                aws_error_debug_str(query->error_code));
+
+            query->use_tcp = false;
+            if (++query->attempt < client->attempts * client->nameserver_count) {
+                s_dns_query_start_attempt(query);
+                return;
+            }
+            break;
+        case DNS_ATTEMPT_NXDOMAIN:
+            query->nxdomain = true;
+            break;
+        default:
+            query->error_code = AWS_ERROR_SUCCESS;
+            break;
+    }
+
+    if (--request->queries_outstanding == 0) {
+        s_dns_resolve_request_complete(request, s_dns_resolve_request_error(request));
+    }
+}
+
+static void s_dns_resolve_request_complete(struct dns_resolve_request *request, int error_code) {
+    AWS_LOGF_DEBUG(
+        AWS_LS_IO_DNS,
+        "static: resolving %s completed with %d addresses, error %s",
+        aws_string_c_str(request->host_name),
+        (int)aws_array_list_length(&request->addresses),
+        aws_error_debug_str(error_code));
+
+    request->on_resolved(
+        request->client, request->host_name, error_code, error_code ? NULL : &request->addresses, request->user_data);
+
+    s_truncate_addresses(request, 0);
+    aws_array_list_clean_up(&request->addresses);
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(request->queries); ++i) {
+        aws_byte_buf_clean_up(&request->queries[i].message);
+        aws_byte_buf_clean_up(&request->queries[i].response);
+    }
+
+    aws_string_destroy(request->host_name);
+    aws_dns_client_release(request->client);
+    aws_mem_release(request->allocator, request);
+}
+
+static void s_dns_resolve_start_task(struct aws_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    struct dns_resolve_request *request = arg;
+
+    if (status != AWS_TASK_STATUS_RUN_READY) {
+        s_dns_resolve_request_complete(request, AWS_IO_EVENT_LOOP_SHUTDOWN);
+        return;
+    }
+
+    struct aws_byte_cursor name = s_query_name(request->host_name);
+    if (s_resolve_locally(request, name)) {
+        s_dns_resolve_request_complete(request, aws_last_error());
+        return;
+    }
+
+    if (aws_array_list_length(&request->addresses) > 0) {
+        s_dns_resolve_request_complete(request, AWS_ERROR_SUCCESS);
+        return;
+    }
+
+    const uint16_t record_types[] = {DNS_TYPE_A, DNS_TYPE_AAAA};
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(request->queries); ++i) {
+        struct dns_query *query = &request->queries[i];
+        query->request = request;
+        query->record_type = record_types[i];
+
+        /* random ids make spoofed answers harder to pass off as ours */
+        if (aws_device_random_u16(&query->id)) {
+            s_dns_resolve_request_complete(request, aws_last_error());
+            return;
+        }
+
+        if (s_encode_query(query, name) ||
+            aws_byte_buf_init(&query->response, request->allocator, DNS_READ_BUFFER_SIZE)) {
+            s_dns_resolve_request_complete(request, aws_last_error());
+            return;
+        }
+
+        aws_task_init(&query->timeout_task, s_on_query_timeout, query, "dns_query_timeout");
+        aws_task_init(&query->attempt_done_task, s_on_query_attempt_done, query, "dns_query_attempt_done");
+    }
+
+    /* A and AAAA go out in parallel */
+    request->queries_outstanding = AWS_ARRAY_SIZE(request->queries);
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(request->queries); ++i) {
+        s_dns_query_start_attempt(&request->queries[i]);
+    }
+}
+
+int aws_dns_client_resolve(
+    struct aws_dns_client *client,
+    const struct aws_string *host_name,
+    aws_dns_client_on_resolved_fn *on_resolved,
+    void *user_data) {
+
+    AWS_PRECONDITION(client && host_name && on_resolved);
+
+    struct dns_resolve_request *request = aws_mem_calloc(client->allocator, 1, sizeof(struct dns_resolve_request));
+    if (!request) {
+        return AWS_OP_ERR;
+    }
+
+    request->allocator = client->allocator;
+    request->on_resolved = on_resolved;
+    request->user_data = user_data;
+    request->host_name = aws_string_new_from_string(client->allocator, host_name);
+    if (!request->host_name ||
+        aws_array_list_init_dynamic(&request->addresses, client->allocator, 4, sizeof(struct aws_host_address))) {
+        aws_string_destroy(request->host_name);
+        aws_mem_release(client->allocator, request);
+        return AWS_OP_ERR;
+    }
+
+    request->client = aws_dns_client_acquire(client);
+    request->event_loop = aws_event_loop_group_get_next_loop(client->el_group);
+
+    aws_task_init(&request->start_task, s_dns_resolve_start_task, request, "dns_resolve_start");
+    aws_event_loop_schedule_task_now(request->event_loop, &request->start_task);
+
+    return AWS_OP_SUCCESS;
+}
+
+struct dns_blocking_resolve {
+    struct aws_mutex mutex;
+    struct aws_condition_variable signal;
+    struct aws_array_list *output_addresses;
+    int error_code;
+    bool completed;
+};
+
+static bool s_blocking_resolve_completed(void *user_data) {
+    struct dns_blocking_resolve *resolve = user_data;
+    return resolve->completed;
+}
+
+static void s_on_blocking_resolve_completed(
+    struct aws_dns_client *client,
+    const struct aws_string *host_name,
+    int error_code,
+    const struct aws_array_list *addresses,
+    void *user_data) {
+
+    (void)client;
+    (void)host_name;
+    struct dns_blocking_resolve *resolve = user_data;
+
+    aws_mutex_lock(&resolve->mutex);
+    resolve->error_code = error_code;
+
+    for (size_t i = 0; !error_code && i < aws_array_list_length(addresses); ++i) {
+        struct aws_host_address *address = NULL;
+        aws_array_list_get_at_ptr(addresses, (void **)&address, i);
+
+        struct aws_host_address address_copy;
+        if (aws_host_address_copy(address, &address_copy)) {
+            resolve->error_code = aws_last_error();
+            break;
+        }
+
+        if (aws_array_list_push_back(resolve->output_addresses, &address_copy)) {
+            aws_host_address_clean_up(&address_copy);
+            resolve->error_code = aws_last_error();
+            break;
+        }
+    }
+
+    /* notify before unlocking: the waiter's stack owns all of this */
+    resolve->completed = true;
+    aws_condition_variable_notify_one(&resolve->signal);
+    aws_mutex_unlock(&resolve->mutex);
+}
+
+int aws_dns_client_resolve_host(
+    struct aws_allocator *allocator,
+    const struct aws_string *host_name,
+    struct aws_array_list *output_addresses,
+    void *user_data) {
+
+    (void)allocator;
+    struct aws_dns_client *client = user_data;
+
+    struct dns_blocking_resolve resolve = {
+        .mutex = AWS_MUTEX_INIT,
+        .signal = AWS_CONDITION_VARIABLE_INIT,
+        .output_addresses = output_addresses,
+    };
+
+    /* the callback always comes from an event loop thread, so holding the lock across the call is fine */
+    aws_mutex_lock(&resolve.mutex);
+    if (aws_dns_client_resolve(client, host_name, s_on_blocking_resolve_completed, &resolve)) {
+        aws_mutex_unlock(&resolve.mutex);
+        return AWS_OP_ERR;
+    }
+
+    aws_condition_variable_wait_pred(&resolve.signal, &resolve.mutex, s_blocking_resolve_completed, &resolve);
+    aws_mutex_unlock(&resolve.mutex);
+
+    if (resolve.error_code) {
+        return aws_raise_error(resolve.error_code);
+    }
+
+    return AWS_OP_SUCCESS;
+}
@@ -50,6 +50,7 @@ int aws_default_dns_resolve(
 
     for (iter = result; iter != NULL; iter = iter->ai_next) {
         struct aws_host_address host_address;
+        AWS_ZERO_STRUCT(host_address);
 
         AWS_ZERO_ARRAY(address_buffer);
 
@@ -20,6 +20,7 @@
 #include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #if defined(__MACH__)
@@ -1236,13 +1237,20 @@ int aws_socket_set_options(struct aws_socket *socket, const struct aws_socket_op
     return AWS_OP_SUCCESS;
 }
 
+/* most iovecs handed to a single sendmsg() call, well under IOV_MAX everywhere */
+#define MAX_WRITE_IOVECS 64
+
 struct write_request {
-    struct aws_byte_cursor cursor_cpy;
     aws_socket_on_write_completed_fn *written_fn;
     void *write_user_data;
     struct aws_linked_list_node node;
     size_t original_buffer_len;
+    size_t remaining_len;
     int error_code;
+    /* cursors[cursor_index] is the next one to write, advanced past whatever has already been sent */
+    size_t cursor_index;
+    size_t cursor_count;
+    struct aws_byte_cursor cursors[];
 };
 
 struct posix_socket_close_args {
@@ -1360,7 +1368,7 @@ int aws_socket_close(struct aws_socket *socket) {
         while (!aws_linked_list_empty(&socket_impl->written_queue)) {
             struct aws_linked_list_node *node = aws_linked_list_pop_front(&socket_impl->written_queue);
             struct write_request *write_request = AWS_CONTAINER_OF(node, struct write_request, node);
-            size_t bytes_written = write_request->original_buffer_len - write_request->cursor_cpy.len;
+            size_t bytes_written = write_request->original_buffer_len - write_request->remaining_len;
             write_request->written_fn(socket, write_request->error_code, bytes_written, write_request->write_user_data);
             aws_mem_release(socket->allocator, write_request);
         }
@@ -1368,7 +1376,7 @@ int aws_socket_close(struct aws_socket *socket) {
         while (!aws_linked_list_empty(&socket_impl->write_queue)) {
             struct aws_linked_list_node *node = aws_linked_list_pop_front(&socket_impl->write_queue);
             struct write_request *write_request = AWS_CONTAINER_OF(node, struct write_request, node);
-            size_t bytes_written = write_request->original_buffer_len - write_request->cursor_cpy.len;
+            size_t bytes_written = write_request->original_buffer_len - write_request->remaining_len;
             write_request->written_fn(socket, AWS_IO_SOCKET_CLOSED, bytes_written, write_request->write_user_data);
             aws_mem_release(socket->allocator, write_request);
         }
@@ -1424,7 +1432,7 @@ static void s_written_task(struct aws_task *task, void *arg, enum aws_task_statu
         do {
             struct aws_linked_list_node *node = aws_linked_list_pop_front(&socket_impl->written_queue);
             struct write_request *write_request = AWS_CONTAINER_OF(node, struct write_request, node);
-            size_t bytes_written = write_request->original_buffer_len - write_request->cursor_cpy.len;
+            size_t bytes_written = write_request->original_buffer_len - write_request->remaining_len;
             write_request->written_fn(socket, write_request->error_code, bytes_written, write_request->write_user_data);
             aws_mem_release(socket_impl->allocator, write_request);
             if (node == stop_after) {
@@ -1473,10 +1481,28 @@ static int s_process_write_requests(struct aws_socket *socket, struct write_requ
             (void *)socket,
             socket->io_handle.data.fd,
             (unsigned long long)write_request->original_buffer_len,
-            (unsigned long long)write_request->cursor_cpy.len);
+            (unsigned long long)write_request->remaining_len);
 
-        ssize_t written =
-            send(socket->io_handle.data.fd, write_request->cursor_cpy.ptr, write_request->cursor_cpy.len, NO_SIGNAL);
+        ssize_t written = 0;
+        size_t pending_cursors = write_request->cursor_count - write_request->cursor_index;
+        if (pending_cursors == 1) {
+            struct aws_byte_cursor *cursor = &write_request->cursors[write_request->cursor_index];
+            written = send(socket->io_handle.data.fd, cursor->ptr, cursor->len, NO_SIGNAL);
+        } else {
+            struct iovec iovecs[MAX_WRITE_IOVECS];
+            size_t iovec_count = aws_min_size(pending_cursors, MAX_WRITE_IOVECS);
+            for (size_t i = 0; i < iovec_count; ++i) {
+                struct aws_byte_cursor *cursor = &write_request->cursors[write_request->cursor_index + i];
+                iovecs[i].iov_base = cursor->ptr;
+                iovecs[i].iov_len = cursor->len;
+            }
+
+            struct msghdr msg;
+            AWS_ZERO_STRUCT(msg);
+            msg.msg_iov = iovecs;
+            msg.msg_iovlen = iovec_count;
+            written = sendmsg(socket->io_handle.data.fd, &msg, NO_SIGNAL);
+        }
 
         AWS_LOGF_TRACE(
             AWS_LS_IO_SOCKET,
@@ -1517,15 +1543,26 @@ static int s_process_write_requests(struct aws_socket *socket, struct write_requ
             break;
         }
 
-        size_t remaining_to_write = write_request->cursor_cpy.len;
+        size_t remaining_to_write = write_request->remaining_len;
+
+        write_request->remaining_len -= (size_t)written;
+        size_t to_advance = (size_t)written;
+        while (write_request->cursor_index < write_request->cursor_count) {
+            struct aws_byte_cursor *cursor = &write_request->cursors[write_request->cursor_index];
+            if (to_advance < cursor->len) {
+                aws_byte_cursor_advance(cursor, to_advance);
+                break;
+            }
+            to_advance -= cursor->len;
+            write_request->cursor_index++;
+        }
 
-        aws_byte_cursor_advance(&write_request->cursor_cpy, (size_t)written);
         AWS_LOGF_TRACE(
             AWS_LS_IO_SOCKET,
             "id=%p fd=%d: remaining write request to write %llu",
             (void *)socket,
             socket->io_handle.data.fd,
-            (unsigned long long)write_request->cursor_cpy.len);
+            (unsigned long long)write_request->remaining_len);
 
         if ((size_t)written == remaining_to_write) {
             AWS_LOGF_TRACE(
@@ -1696,6 +1733,17 @@ int aws_socket_subscribe_to_readable_events(
 }
 
 int aws_socket_read(struct aws_socket *socket, struct aws_byte_buf *buffer, size_t *amount_read) {
+    return aws_socket_readv(socket, buffer, 1, amount_read);
+}
+
+/* most iovecs handed to a single readv() call, well under IOV_MAX everywhere */
+#define MAX_READ_IOVECS 64
+
+int aws_socket_readv(
+    struct aws_socket *socket,
+    struct aws_byte_buf *buffers,
+    size_t buffer_count,
+    size_t *amount_read) {
     AWS_ASSERT(amount_read);
 
     if (!aws_event_loop_thread_is_callers_thread(socket->event_loop)) {
@@ -1717,13 +1765,35 @@ int aws_socket_read(struct aws_socket *socket, struct aws_byte_buf *buffer, size
         return aws_raise_error(AWS_IO_SOCKET_NOT_CONNECTED);
     }
 
-    ssize_t read_val = read(socket->io_handle.data.fd, buffer->buffer + buffer->len, buffer->capacity - buffer->len);
+    AWS_ASSERT(buffer_count > 0);
+    struct iovec iovecs[MAX_READ_IOVECS];
+    size_t iovec_count = aws_min_size(buffer_count, MAX_READ_IOVECS);
+    size_t space = 0;
+    for (size_t i = 0; i < iovec_count; ++i) {
+        iovecs[i].iov_base = buffers[i].buffer + buffers[i].len;
+        iovecs[i].iov_len = buffers[i].capacity - buffers[i].len;
+        space += iovecs[i].iov_len;
+    }
+
+    ssize_t read_val = readv(socket->io_handle.data.fd, iovecs, (int)iovec_count);
     AWS_LOGF_TRACE(
-        AWS_LS_IO_SOCKET, "id=%p fd=%d: read of %d", (void *)socket, socket->io_handle.data.fd, (int)read_val);
+        AWS_LS_IO_SOCKET,
+        "id=%p fd=%d: read of %d into %d buffers",
+        (void *)socket,
+        socket->io_handle.data.fd,
+        (int)read_val,
+        (int)iovec_count);
 
     if (read_val > 0) {
         *amount_read = (size_t)read_val;
-        buffer->len += *amount_read;
+
+        /* the kernel fills the iovecs in order, so do the same with the buffers' lengths */
+        size_t remaining = *amount_read;
+        for (size_t i = 0; i < iovec_count && remaining > 0; ++i) {
+            size_t filled = aws_min_size(remaining, iovecs[i].iov_len);
+            buffers[i].len += filled;
+            remaining -= filled;
+        }
         return AWS_OP_SUCCESS;
     }
 
@@ -1733,7 +1803,7 @@ int aws_socket_read(struct aws_socket *socket, struct aws_byte_buf *buffer, size
             AWS_LS_IO_SOCKET, "id=%p fd=%d: zero read, socket is closed", (void *)socket, socket->io_handle.data.fd);
         *amount_read = 0;
 
-        if (buffer->capacity - buffer->len > 0) {
+        if (space > 0) {
             return aws_raise_error(AWS_IO_SOCKET_CLOSED);
         }
 
@@ -1774,6 +1844,15 @@ int aws_socket_write(
     const struct aws_byte_cursor *cursor,
     aws_socket_on_write_completed_fn *written_fn,
     void *user_data) {
+    return aws_socket_writev(socket, cursor, 1, written_fn, user_data);
+}
+
+int aws_socket_writev(
+    struct aws_socket *socket,
+    const struct aws_byte_cursor *cursors,
+    size_t cursor_count,
+    aws_socket_on_write_completed_fn *written_fn,
+    void *user_data) {
     if (!aws_event_loop_thread_is_callers_thread(socket->event_loop)) {
         return aws_raise_error(AWS_ERROR_IO_EVENT_LOOP_THREAD_ONLY);
     }
@@ -1788,17 +1867,23 @@ int aws_socket_write(
     }
 
     AWS_ASSERT(written_fn);
+    AWS_ASSERT(cursor_count > 0);
     struct posix_socket *socket_impl = socket->impl;
-    struct write_request *write_request = aws_mem_calloc(socket->allocator, 1, sizeof(struct write_request));
+    struct write_request *write_request = aws_mem_calloc(
+        socket->allocator, 1, sizeof(struct write_request) + cursor_count * sizeof(struct aws_byte_cursor));
 
     if (!write_request) {
         return AWS_OP_ERR;
     }
 
-    write_request->original_buffer_len = cursor->len;
+    for (size_t i = 0; i < cursor_count; ++i) {
+        write_request->cursors[i] = cursors[i];
+        write_request->original_buffer_len += cursors[i].len;
+    }
+    write_request->remaining_len = write_request->original_buffer_len;
+    write_request->cursor_count = cursor_count;
     write_request->written_fn = written_fn;
     write_request->write_user_data = user_data;
-    write_request->cursor_cpy = *cursor;
     aws_linked_list_push_back(&socket_impl->write_queue, &write_request->node);
 
     return s_process_write_requests(socket, write_request);
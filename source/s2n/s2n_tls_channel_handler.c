@@ -4,6 +4,8 @@
  */
 #include <aws/io/tls_channel_handler.h>
 
+#include <aws/cal/hash.h>
+
 #include <aws/io/channel.h>
 #include <aws/io/event_loop.h>
 #include <aws/io/file_utils.h>
@@ -12,7 +14,12 @@
 #include <aws/io/private/tls_channel_handler_shared.h>
 #include <aws/io/statistics.h>
 
+#include <aws/common/atomics.h>
+#include <aws/common/clock.h>
+#include <aws/common/device_random.h>
 #include <aws/common/encoding.h>
+#include <aws/common/lru_cache.h>
+#include <aws/common/mutex.h>
 #include <aws/common/string.h>
 #include <aws/common/task_scheduler.h>
 #include <aws/common/thread.h>
@@ -28,14 +35,43 @@
 #define KB_1 1024
 #define MAX_RECORD_SIZE (KB_1 * 16)
 #define EST_HANDSHAKE_SIZE (7 * KB_1)
+/* upper bound on the number of buffered writes handed to a single s2n_sendv() call */
+#define MAX_COALESCED_WRITES 64
+/* defaults for AWS_IO_TLS_RECORD_SIZE_DYNAMIC */
+#define DEFAULT_DYNAMIC_RECORD_RESIZE_THRESHOLD (KB_1 * KB_1)
+#define DEFAULT_DYNAMIC_RECORD_IDLE_TIMEOUT_SECS 1
+/* session resumption defaults */
+#define DEFAULT_SESSION_CACHE_MAX_ENTRIES 256
+#define DEFAULT_SESSION_TICKET_KEY_LIFETIME_SECS (2 * 60 * 60)
+/* s2n has no way to add keys safely once the config is shared, so enough keys to cover 24 lifetimes (2 days by
+ * default) are provisioned up front with staggered intro times. Once the last one retires, no more tickets are
+ * issued. */
+#define SESSION_TICKET_KEY_COUNT 24
+#define SESSION_TICKET_KEY_LEN 32
+#define TLS_RECORD_HEADER_LEN 5
+/* default bound on queued handshake private key operations, per offload worker thread */
+#define DEFAULT_HANDSHAKE_OFFLOAD_QUEUE_PER_THREAD 64
 
 static const char *s_default_ca_dir = NULL;
 static const char *s_default_ca_file = NULL;
 
+/*
+ * Tracks TLS record boundaries in a byte stream passing between s2n and the channel, since s2n doesn't report how many
+ * records it has produced or consumed.
+ */
+struct s2n_record_counter {
+    uint8_t header[TLS_RECORD_HEADER_LEN];
+    size_t header_len;
+    size_t body_remaining;
+};
+
 struct s2n_handler {
     struct aws_channel_handler handler;
     struct aws_tls_channel_handler_shared shared_state;
     struct s2n_connection *connection;
+    s2n_mode mode;
+    /* id of the ctx the connection was set up from, so it goes back to the right place in the connection cache */
+    uint64_t ctx_id;
     struct aws_channel_slot *slot;
     struct aws_linked_list input_queue;
     struct aws_byte_buf protocol;
@@ -47,13 +83,135 @@ struct s2n_handler {
     aws_tls_on_data_read_fn *on_data_read;
     aws_tls_on_error_fn *on_error;
     void *user_data;
+    /* "server_name:port" key into the ctx's session cache, client mode only */
+    struct aws_string *session_cache_key;
+    struct s2n_session_cache *session_cache;
+    /* worker pool for handshake private key operations, NULL if they run inline */
+    struct s2n_handshake_offload_pool *handshake_offload_pool;
+    struct s2n_record_counter read_records;
+    struct s2n_record_counter write_records;
+    /* application messages buffered for write coalescing, in the order they were written */
+    struct aws_linked_list pending_writes;
+    size_t pending_write_bytes;
+    size_t pending_write_count;
+    size_t write_coalescing_threshold;
+    uint64_t write_coalescing_max_delay_ns;
+    struct aws_channel_task flush_task;
+    bool flush_task_scheduled;
+    /* client mode: writes made before negotiation finished, not yet handed to s2n as early data */
+    struct aws_linked_list early_data_writes;
+    /* client mode: writes sent as early data, completed or resent once the server accepts or rejects them */
+    struct aws_linked_list early_data_sent;
+    /* server mode: decrypted early data, delivered downstream once negotiation finishes */
+    struct aws_linked_list early_data_reads;
+    uint32_t early_data_budget;
+    enum aws_tls_early_data_status early_data_status;
+    /* client mode: pre-negotiation writes are queued instead of rejected */
+    bool early_data_enabled;
+    bool early_data_requested;
+    /* client mode: early data can no longer be sent, queued writes wait for the handshake */
+    bool early_data_closed;
     bool advertise_alpn_message;
     bool negotiation_finished;
 };
 
 struct s2n_ctx {
     struct aws_tls_ctx ctx;
+    /* unique per ctx, unlike its address, which a later ctx may be allocated at */
+    uint64_t id;
     struct s2n_config *s2n_config;
+    size_t write_coalescing_threshold;
+    uint64_t write_coalescing_max_delay_ns;
+    enum aws_tls_record_size_policy record_size_policy;
+    uint32_t dynamic_record_resize_threshold;
+    uint16_t dynamic_record_idle_timeout_secs;
+    struct s2n_session_cache *session_cache;
+    struct s2n_handshake_offload_pool *handshake_offload_pool;
+    struct s2n_shared_cert_chain *cert_chain;
+    uint32_t max_early_data_size;
+};
+
+/*
+ * A parsed certificate chain and private key, shared by every s2n_ctx created from the same PEM contents. s2n requires
+ * the chain to outlive every config it's added to, so each ctx holds a reference until its config has been freed.
+ */
+struct s2n_shared_cert_chain {
+    struct aws_allocator *allocator;
+    /* SHA-256 of the certificate and private key PEM, so the table never holds a copy of the key itself */
+    uint8_t digest[AWS_SHA256_LEN];
+    struct aws_byte_cursor cache_key;
+    struct s2n_cert_chain_and_key *chain_and_key;
+    /* guarded by s_credential_cache.lock */
+    size_t ref_count;
+    bool in_cache;
+};
+
+/*
+ * Process-wide cache of parsed credentials. Entries are not owned by the table: they're removed once their last
+ * reference is released, or dropped from lookup (but left alive for their current users) on reload.
+ */
+struct s2n_credential_cache {
+    struct aws_mutex lock;
+    /* struct aws_byte_cursor * -> struct s2n_shared_cert_chain * */
+    struct aws_hash_table cert_chains;
+    bool initialized;
+};
+
+static struct s2n_credential_cache s_credential_cache = {.lock = AWS_MUTEX_INIT};
+
+/*
+ * Client-side cache of serialized s2n sessions, keyed by "server_name:port". It's owned by the s2n_ctx and shared by
+ * every connection made from it, so all access goes through the lock.
+ */
+struct s2n_session_cache {
+    struct aws_allocator *allocator;
+    struct aws_mutex lock;
+    /* struct aws_string * -> struct aws_byte_buf * */
+    struct aws_cache *sessions;
+};
+
+/*
+ * Bounded pool of worker threads that performs s2n's asynchronous private key operations off of the event loop.
+ * Owned by the s2n_ctx; jobs are queued FIFO and the results are posted back to the originating channel.
+ */
+struct s2n_handshake_offload_pool {
+    struct aws_allocator *allocator;
+    struct aws_mutex lock;
+    struct aws_condition_variable signal;
+    /* struct s2n_pkey_op_job */
+    struct aws_linked_list queue;
+    size_t queued;
+    size_t max_queued;
+    struct aws_thread *threads;
+    size_t thread_count;
+    bool shutting_down;
+};
+
+/*
+ * A single private key operation in flight. Holds the channel alive until the result has been applied.
+ * Jobs come from the offload pool's allocator, not the handler's: that may be the channel's arena, which only the
+ * channel's thread may use, and a job whose completion task gets canceled is destroyed on the worker's thread.
+ */
+struct s2n_pkey_op_job {
+    struct aws_linked_list_node node;
+    struct aws_allocator *allocator;
+    struct s2n_handler *s2n_handler;
+    struct aws_channel *channel;
+    struct s2n_async_pkey_op *op;
+    struct s2n_cert_private_key *key;
+    struct aws_channel_task completion_task;
+    uint64_t duration_ns;
+    bool performed;
+};
+
+/*
+ * Several coalesced writes go out through a single s2n_sendv() call, so only one downstream message carries a
+ * completion callback. This holds on to the original messages until that callback fires so each of them can be
+ * completed in order.
+ */
+struct s2n_coalesced_write {
+    struct aws_allocator *allocator;
+    struct aws_linked_list messages;
 };
 
 static const char *s_determine_default_pki_dir(void) {
@@ -114,8 +272,18 @@ static const char *s_determine_default_pki_ca_file(void) {
     return NULL;
 }
 
+static bool s_cert_chain_cache_key_eq(const void *a, const void *b) {
+    return aws_byte_cursor_eq(a, b);
+}
+
+static int s_cert_chain_evict(void *context, struct aws_hash_element *element) {
+    (void)context;
+    struct s2n_shared_cert_chain *cert_chain = element->value;
+    cert_chain->in_cache = false;
+    return AWS_COMMON_HASH_TABLE_ITER_CONTINUE | AWS_COMMON_HASH_TABLE_ITER_DELETE;
+}
+
 void aws_tls_init_static_state(struct aws_allocator *alloc) {
-    (void)alloc;
     AWS_LOGF_INFO(AWS_LS_IO_TLS, "static: Initializing TLS using s2n.");
 
     setenv("S2N_ENABLE_CLIENT_MODE", "1", 1);
@@ -129,12 +297,176 @@ void aws_tls_init_static_state(struct aws_allocator *alloc) {
         "ctx: Based on OS, we detected the default PKI path as %s, and ca file as %s",
         s_default_ca_dir,
         s_default_ca_file);
+
+    aws_mutex_lock(&s_credential_cache.lock);
+    /* a failure here only means certificates won't be shared between contexts */
+    s_credential_cache.initialized = !aws_hash_table_init(
+        &s_credential_cache.cert_chains, alloc, 16, aws_hash_byte_cursor_ptr, s_cert_chain_cache_key_eq, NULL, NULL);
+    aws_mutex_unlock(&s_credential_cache.lock);
 }
 
 void aws_tls_clean_up_static_state(void) {
+    aws_mutex_lock(&s_credential_cache.lock);
+    if (s_credential_cache.initialized) {
+        aws_hash_table_foreach(&s_credential_cache.cert_chains, s_cert_chain_evict, NULL);
+        aws_hash_table_clean_up(&s_credential_cache.cert_chains);
+        s_credential_cache.initialized = false;
+    }
+    aws_mutex_unlock(&s_credential_cache.lock);
+
     s2n_cleanup();
 }
 
+void aws_tls_reload_credential_cache(void) {
+    aws_mutex_lock(&s_credential_cache.lock);
+    if (s_credential_cache.initialized) {
+        aws_hash_table_foreach(&s_credential_cache.cert_chains, s_cert_chain_evict, NULL);
+    }
+
+    s_default_ca_dir = s_determine_default_pki_dir();
+    s_default_ca_file = s_determine_default_pki_ca_file();
+    aws_mutex_unlock(&s_credential_cache.lock);
+
+    AWS_LOGF_INFO(
+        AWS_LS_IO_TLS,
+        "static: Credential cache reloaded, default PKI path is %s, and ca file is %s",
+        s_default_ca_dir,
+        s_default_ca_file);
+}
+
+size_t aws_tls_credential_cache_entry_count(void) {
+    size_t entry_count = 0;
+    aws_mutex_lock(&s_credential_cache.lock);
+    if (s_credential_cache.initialized) {
+        entry_count = aws_hash_table_get_entry_count(&s_credential_cache.cert_chains);
+    }
+    aws_mutex_unlock(&s_credential_cache.lock);
+
+    return entry_count;
+}
+
+static void s_shared_cert_chain_destroy(struct s2n_shared_cert_chain *cert_chain) {
+    if (cert_chain->chain_and_key) {
+        s2n_cert_chain_and_key_free(cert_chain->chain_and_key);
+    }
+    aws_mem_release(cert_chain->allocator, cert_chain);
+}
+
+static void s_shared_cert_chain_release(struct s2n_shared_cert_chain *cert_chain) {
+    if (!cert_chain) {
+        return;
+    }
+
+    aws_mutex_lock(&s_credential_cache.lock);
+    bool last_ref = --cert_chain->ref_count == 0;
+    if (last_ref && cert_chain->in_cache) {
+        aws_hash_table_remove(&s_credential_cache.cert_chains, &cert_chain->cache_key, NULL, NULL);
+    }
+    aws_mutex_unlock(&s_credential_cache.lock);
+
+    if (last_ref) {
+        s_shared_cert_chain_destroy(cert_chain);
+    }
+}
+
+/* Returns a referenced entry for the contents of certificate and private_key, parsing them only if nobody has yet. */
+static struct s2n_shared_cert_chain *s_shared_cert_chain_acquire(
+    struct aws_allocator *allocator,
+    const struct aws_byte_buf *certificate,
+    const struct aws_byte_buf *private_key) {
+
+    struct s2n_shared_cert_chain *cert_chain = aws_mem_calloc(allocator, 1, sizeof(struct s2n_shared_cert_chain));
+    if (!cert_chain) {
+        return NULL;
+    }
+    cert_chain->allocator = allocator;
+    cert_chain->ref_count = 1;
+
+    /* both halves keep their null terminators so they can be handed to s2n straight out of this buffer, and so the
+     * boundary between them is part of the digest */
+    struct aws_byte_buf pem;
+    AWS_ZERO_STRUCT(pem);
+    if (aws_byte_buf_init(&pem, allocator, certificate->len + private_key->len + 2)) {
+        goto on_error;
+    }
+    struct aws_byte_cursor certificate_cur = aws_byte_cursor_from_buf(certificate);
+    struct aws_byte_cursor private_key_cur = aws_byte_cursor_from_buf(private_key);
+    aws_byte_buf_append(&pem, &certificate_cur);
+    aws_byte_buf_append_byte_dynamic(&pem, 0);
+    aws_byte_buf_append(&pem, &private_key_cur);
+    aws_byte_buf_append_byte_dynamic(&pem, 0);
+
+    struct aws_byte_buf digest_buf = aws_byte_buf_from_empty_array(cert_chain->digest, sizeof(cert_chain->digest));
+    struct aws_byte_cursor pem_cur = aws_byte_cursor_from_buf(&pem);
+    if (aws_sha256_compute(allocator, &pem_cur, &digest_buf, 0)) {
+        goto on_error;
+    }
+    cert_chain->cache_key = aws_byte_cursor_from_buf(&digest_buf);
+
+    aws_mutex_lock(&s_credential_cache.lock);
+    struct aws_hash_element *element = NULL;
+    if (s_credential_cache.initialized) {
+        aws_hash_table_find(&s_credential_cache.cert_chains, &cert_chain->cache_key, &element);
+    }
+    if (element) {
+        struct s2n_shared_cert_chain *cached = element->value;
+        cached->ref_count += 1;
+        aws_mutex_unlock(&s_credential_cache.lock);
+
+        AWS_LOGF_DEBUG(AWS_LS_IO_TLS, "ctx: Reusing parsed certificate and key from the credential cache.");
+        aws_byte_buf_clean_up_secure(&pem);
+        s_shared_cert_chain_destroy(cert_chain);
+        return cached;
+    }
+    aws_mutex_unlock(&s_credential_cache.lock);
+
+    /* parse outside of the lock, it's the expensive part */
+    cert_chain->chain_and_key = s2n_cert_chain_and_key_new();
+    if (!cert_chain->chain_and_key ||
+        s2n_cert_chain_and_key_load_pem(
+            cert_chain->chain_and_key,
+            (const char *)pem.buffer,
+            (const char *)pem.buffer + certificate->len + 1)) {
+        AWS_LOGF_ERROR(
+            AWS_LS_IO_TLS,
+            "ctx: configuration error %s (%s)",
+            s2n_strerror(s2n_errno, "EN"),
+            s2n_strerror_debug(s2n_errno, "EN"));
+        aws_raise_error(AWS_IO_TLS_CTX_ERROR);
+        goto on_error;
+    }
+
+    aws_mutex_lock(&s_credential_cache.lock);
+    element = NULL;
+    if (s_credential_cache.initialized) {
+        aws_hash_table_find(&s_credential_cache.cert_chains, &cert_chain->cache_key, &element);
+    }
+    if (element) {
+        /* somebody else parsed the same contents while we were, use theirs */
+        struct s2n_shared_cert_chain *cached = element->value;
+        cached->ref_count += 1;
+        aws_mutex_unlock(&s_credential_cache.lock);
+
+        aws_byte_buf_clean_up_secure(&pem);
+        s_shared_cert_chain_destroy(cert_chain);
+        return cached;
+    }
+    if (s_credential_cache.initialized) {
+        cert_chain->in_cache =
+            aws_hash_table_put(&s_credential_cache.cert_chains, &cert_chain->cache_key, cert_chain, NULL) ==
+            AWS_OP_SUCCESS;
+    }
+    aws_mutex_unlock(&s_credential_cache.lock);
+
+    aws_byte_buf_clean_up_secure(&pem);
+    return cert_chain;
+
+on_error:
+    aws_byte_buf_clean_up_secure(&pem);
+    s_shared_cert_chain_destroy(cert_chain);
+    return NULL;
+}
+
 bool aws_tls_is_alpn_available(void) {
     return true;
 }
@@ -158,6 +490,136 @@ bool aws_tls_is_cipher_pref_supported(enum aws_tls_cipher_pref cipher_pref) {
     }
 }
 
+static void s_session_cache_entry_destroy(void *value) {
+    struct aws_byte_buf *session = value;
+    struct aws_allocator *allocator = session->allocator;
+    aws_byte_buf_clean_up_secure(session);
+    aws_mem_release(allocator, session);
+}
+
+static struct s2n_session_cache *s_session_cache_new(struct aws_allocator *allocator, size_t max_entries) {
+    struct s2n_session_cache *cache = aws_mem_calloc(allocator, 1, sizeof(struct s2n_session_cache));
+    if (!cache) {
+        return NULL;
+    }
+
+    cache->allocator = allocator;
+    cache->sessions = aws_cache_new_lru(
+        allocator,
+        aws_hash_string,
+        aws_hash_callback_string_eq,
+        aws_hash_callback_string_destroy,
+        s_session_cache_entry_destroy,
+        max_entries);
+
+    if (!cache->sessions) {
+        aws_mem_release(allocator, cache);
+        return NULL;
+    }
+
+    aws_mutex_init(&cache->lock);
+    return cache;
+}
+
+static void s_session_cache_destroy(struct s2n_session_cache *cache) {
+    if (cache) {
+        aws_cache_destroy(cache->sessions);
+        aws_mutex_clean_up(&cache->lock);
+        aws_mem_release(cache->allocator, cache);
+    }
+}
+
+static struct aws_string *s_session_cache_key_new(
+    struct aws_allocator *allocator,
+    const struct aws_string *server_name,
+    uint16_t port) {
+
+    char port_str[8];
+    snprintf(port_str, sizeof(port_str), ":%u", (unsigned)port);
+
+    struct aws_byte_buf key_buf;
+    if (aws_byte_buf_init(&key_buf, allocator, server_name->len + sizeof(port_str))) {
+        return NULL;
+    }
+
+    struct aws_byte_cursor server_name_cur = aws_byte_cursor_from_string(server_name);
+    struct aws_byte_cursor port_cur = aws_byte_cursor_from_c_str(port_str);
+    aws_byte_buf_append(&key_buf, &server_name_cur);
+    aws_byte_buf_append(&key_buf, &port_cur);
+
+    struct aws_string *key = aws_string_new_from_buf(allocator, &key_buf);
+    aws_byte_buf_clean_up(&key_buf);
+    return key;
+}
+
+/* Offers the cached session for key (if any) on connection. Returns true if a session was set. */
+static bool s_session_cache_apply(
+    struct s2n_session_cache *cache,
+    const struct aws_string *key,
+    struct s2n_connection *connection) {
+
+    bool applied = false;
+    aws_mutex_lock(&cache->lock);
+
+    struct aws_byte_buf *session = NULL;
+    if (!aws_cache_find(cache->sessions, key, (void **)&session) && session) {
+        applied = s2n_connection_set_session(connection, session->buffer, session->len) == S2N_SUCCESS;
+        if (!applied) {
+            /* stale or corrupt, don't bother offering it again */
+            aws_cache_remove(cache->sessions, key);
+        }
+    }
+
+    aws_mutex_unlock(&cache->lock);
+    return applied;
+}
+
+static void s_session_cache_store(
+    struct s2n_session_cache *cache,
+    const struct aws_string *key,
+    struct s2n_connection *connection) {
+
+    int session_len = s2n_connection_get_session_length(connection);
+    if (session_len <= 0) {
+        return;
+    }
+
+    struct aws_byte_buf *session = aws_mem_calloc(cache->allocator, 1, sizeof(struct aws_byte_buf));
+    if (!session) {
+        return;
+    }
+
+    if (aws_byte_buf_init(session, cache->allocator, (size_t)session_len)) {
+        goto on_error;
+    }
+
+    int written = s2n_connection_get_session(connection, session->buffer, session->capacity);
+    if (written <= 0) {
+        goto on_error;
+    }
+    session->len = (size_t)written;
+
+    struct aws_string *key_copy = aws_string_new_from_string(cache->allocator, key);
+    if (!key_copy) {
+        goto on_error;
+    }
+
+    aws_mutex_lock(&cache->lock);
+    /* the cache owns key_copy and session from here on, and puts replace any existing entry for this endpoint */
+    int put_result = aws_cache_put(cache->sessions, key_copy, session);
+    aws_mutex_unlock(&cache->lock);
+
+    if (put_result) {
+        aws_string_destroy(key_copy);
+        s_session_cache_entry_destroy(session);
+    }
+
+    return;
+
+on_error:
+    s_session_cache_entry_destroy(session);
+}
+
 static int s_generic_read(struct s2n_handler *handler, struct aws_byte_buf *buf) {
 
     size_t written = 0;
@@ -194,11 +656,48 @@ static int s_generic_read(struct s2n_handler *handler, struct aws_byte_buf *buf)
     return -1;
 }
 
+/* Feeds the next len bytes of the stream through counter, and returns the number of records that started in them. */
+static uint64_t s_record_counter_update(struct s2n_record_counter *counter, const uint8_t *data, size_t len) {
+    uint64_t records = 0;
+
+    while (len) {
+        if (counter->body_remaining) {
+            size_t skip = len < counter->body_remaining ? len : counter->body_remaining;
+            counter->body_remaining -= skip;
+            data += skip;
+            len -= skip;
+            continue;
+        }
+
+        counter->header[counter->header_len++] = *data++;
+        len--;
+
+        if (counter->header_len == TLS_RECORD_HEADER_LEN) {
+            /* content type, protocol version, then a 2 byte length */
+            counter->body_remaining = ((size_t)counter->header[3] << 8) | counter->header[4];
+            counter->header_len = 0;
+            records++;
+        }
+    }
+
+    return records;
+}
+
 static int s_s2n_handler_recv(void *io_context, uint8_t *buf, uint32_t len) {
     struct s2n_handler *handler = (struct s2n_handler *)io_context;
 
     struct aws_byte_buf read_buffer = aws_byte_buf_from_array(buf, len);
-    return s_generic_read(handler, &read_buffer);
+    int read = s_generic_read(handler, &read_buffer);
+
+    if (read > 0) {
+        /* always tracked so the counter stays aligned, but only application traffic is reported */
+        uint64_t records = s_record_counter_update(&handler->read_records, buf, (size_t)read);
+        if (handler->negotiation_finished) {
+            handler->shared_state.stats.records_decrypted += records;
+        }
+    }
+
+    return read;
 }
 
 static int s_generic_send(struct s2n_handler *handler, struct aws_byte_buf *buf) {
@@ -254,14 +753,103 @@ static int s_s2n_handler_send(void *io_context, const uint8_t *buf, uint32_t len
     struct s2n_handler *handler = (struct s2n_handler *)io_context;
     struct aws_byte_buf send_buf = aws_byte_buf_from_array(buf, len);
 
-    return s_generic_send(handler, &send_buf);
+    int sent = s_generic_send(handler, &send_buf);
+
+    if (sent > 0) {
+        uint64_t records = s_record_counter_update(&handler->write_records, buf, (size_t)sent);
+        if (handler->negotiation_finished) {
+            handler->shared_state.stats.records_encrypted += records;
+        }
+    }
+
+    return sent;
 }
 
+static void s_update_blocked_stats(struct s2n_handler *s2n_handler, s2n_blocked_status blocked) {
+    if (blocked == S2N_BLOCKED_ON_READ) {
+        s2n_handler->shared_state.stats.blocked_on_read_count += 1;
+    } else if (blocked == S2N_BLOCKED_ON_WRITE) {
+        s2n_handler->shared_state.stats.blocked_on_write_count += 1;
+    }
+}
+
+static enum aws_tls_versions s_s2n_to_aws_tls_version(int s2n_version) {
+    switch (s2n_version) {
+        case S2N_SSLv3:
+            return AWS_IO_SSLv3;
+        case S2N_TLS10:
+            return AWS_IO_TLSv1;
+        case S2N_TLS11:
+            return AWS_IO_TLSv1_1;
+        case S2N_TLS12:
+            return AWS_IO_TLSv1_2;
+        case S2N_TLS13:
+            return AWS_IO_TLSv1_3;
+        default:
+            return AWS_IO_TLS_VER_SYS_DEFAULTS;
+    }
+}
+
+/* Records the calculate-once parts of the handshake breakdown. */
+static void s_record_handshake_stats(struct s2n_handler *s2n_handler) {
+    struct aws_crt_statistics_tls *stats = &s2n_handler->shared_state.stats;
+    struct s2n_connection *connection = s2n_handler->connection;
+
+    stats->session_resumed = s2n_connection_is_session_resumed(connection) == 1;
+    stats->handshake_bytes_sent = s2n_connection_get_wire_bytes_out(connection);
+    stats->handshake_bytes_received = s2n_connection_get_wire_bytes_in(connection);
+    stats->protocol_version = s_s2n_to_aws_tls_version(s2n_connection_get_actual_protocol_version(connection));
+
+    uint8_t cipher_first = 0;
+    uint8_t cipher_second = 0;
+    if (s2n_connection_get_cipher_iana_value(connection, &cipher_first, &cipher_second) == S2N_SUCCESS) {
+        stats->cipher_suite = (uint16_t)((cipher_first << 8) | cipher_second);
+    }
+}
+
+static void s_complete_write_messages(struct aws_channel *channel, struct aws_linked_list *messages, int error_code) {
+    while (!aws_linked_list_empty(messages)) {
+        struct aws_linked_list_node *node = aws_linked_list_pop_front(messages);
+        struct aws_io_message *message = AWS_CONTAINER_OF(node, struct aws_io_message, queueing_handle);
+
+        if (message->on_completion) {
+            message->on_completion(channel, message, error_code, message->user_data);
+        }
+
+        aws_mem_release(message->allocator, message);
+    }
+}
+
+static void s_on_coalesced_write_completed(
+    struct aws_channel *channel,
+    struct aws_io_message *message,
+    int err_code,
+    void *user_data) {
+    (void)message;
+
+    struct s2n_coalesced_write *coalesced_write = user_data;
+    s_complete_write_messages(channel, &coalesced_write->messages, err_code);
+    aws_mem_release(coalesced_write->allocator, coalesced_write);
+}
+
+static void s_connection_release(
+    struct aws_channel_slot *slot,
+    struct s2n_connection *connection,
+    s2n_mode mode,
+    uint64_t ctx_id);
+
 static void s_s2n_handler_destroy(struct aws_channel_handler *handler) {
     if (handler) {
         struct s2n_handler *s2n_handler = (struct s2n_handler *)handler->impl;
+        s_complete_write_messages(s2n_handler->slot->channel, &s2n_handler->pending_writes, AWS_IO_SOCKET_CLOSED);
+        s_complete_write_messages(s2n_handler->slot->channel, &s2n_handler->early_data_sent, AWS_IO_SOCKET_CLOSED);
+        s_complete_write_messages(s2n_handler->slot->channel, &s2n_handler->early_data_writes, AWS_IO_SOCKET_CLOSED);
+        s_complete_write_messages(s2n_handler->slot->channel, &s2n_handler->early_data_reads, AWS_IO_SOCKET_CLOSED);
         aws_tls_channel_handler_shared_clean_up(&s2n_handler->shared_state);
-        s2n_connection_free(s2n_handler->connection);
+        s_connection_release(s2n_handler->slot, s2n_handler->connection, s2n_handler->mode, s2n_handler->ctx_id);
+        if (s2n_handler->session_cache_key) {
+            aws_string_destroy(s2n_handler->session_cache_key);
+        }
         aws_mem_release(handler->alloc, (void *)s2n_handler);
     }
 }
@@ -281,11 +869,218 @@ static void s_on_negotiation_result(
     }
 }
 
+static int s_s2n_handler_flush_pending_writes(struct s2n_handler *s2n_handler);
+
+static void s_early_data_stop(struct s2n_handler *s2n_handler, int s2n_error) {
+    AWS_LOGF_DEBUG(
+        AWS_LS_IO_TLS,
+        "id=%p: Not sending (more) early data: %s (%s)",
+        (void *)&s2n_handler->handler,
+        s2n_strerror(s2n_error, "EN"),
+        s2n_strerror_debug(s2n_error, "EN"));
+    s2n_handler->early_data_closed = true;
+}
+
+/*
+ * Client mode: hands queued pre-negotiation writes to s2n as early data. Only whole messages that fit in what's left of
+ * the early data allowance are sent, anything else waits for the handshake to finish. Early data being refused is not
+ * an error, the writes are simply sent normally afterwards.
+ */
+static int s_send_early_data(struct s2n_handler *s2n_handler) {
+    if (!s2n_handler->early_data_enabled || s2n_handler->early_data_closed) {
+        return AWS_OP_SUCCESS;
+    }
+
+    s2n_blocked_status blocked = S2N_NOT_BLOCKED;
+    ssize_t data_sent = 0;
+
+    if (!s2n_handler->early_data_requested) {
+        s2n_handler->early_data_requested = true;
+        /* an empty write is enough for the ClientHello to advertise early data, even if nothing has been queued yet */
+        if (s2n_send_early_data(s2n_handler->connection, NULL, 0, &data_sent, &blocked) &&
+            s2n_error_get_type(s2n_errno) != S2N_ERR_T_BLOCKED) {
+            s_early_data_stop(s2n_handler, s2n_errno);
+            return AWS_OP_SUCCESS;
+        }
+    }
+
+    while (!aws_linked_list_empty(&s2n_handler->early_data_writes)) {
+        struct aws_io_message *message = AWS_CONTAINER_OF(
+            aws_linked_list_front(&s2n_handler->early_data_writes), struct aws_io_message, queueing_handle);
+
+        uint32_t remaining = 0;
+        if (s2n_connection_get_remaining_early_data_size(s2n_handler->connection, &remaining)) {
+            s_early_data_stop(s2n_handler, s2n_errno);
+            return AWS_OP_SUCCESS;
+        }
+
+        size_t allowed = aws_min_size(remaining, s2n_handler->early_data_budget);
+        if (message->message_data.len > allowed) {
+            /* stop here rather than skip ahead, writes have to reach the peer in order */
+            s2n_handler->early_data_closed = true;
+            return AWS_OP_SUCCESS;
+        }
+
+        blocked = S2N_NOT_BLOCKED;
+        data_sent = 0;
+        int send_code = s2n_send_early_data(
+            s2n_handler->connection,
+            message->message_data.buffer,
+            (ssize_t)message->message_data.len,
+            &data_sent,
+            &blocked);
+        int s2n_error = s2n_errno;
+        s_update_blocked_stats(s2n_handler, blocked);
+
+        if (data_sent > 0 && (size_t)data_sent < message->message_data.len) {
+            /* part of the message may already have been accepted, it can't be resent normally after this */
+            return aws_raise_error(AWS_IO_TLS_ERROR_WRITE_FAILURE);
+        }
+
+        if (data_sent > 0) {
+            aws_linked_list_pop_front(&s2n_handler->early_data_writes);
+            aws_linked_list_push_back(&s2n_handler->early_data_sent, &message->queueing_handle);
+            s2n_handler->early_data_budget -= (uint32_t)data_sent;
+            s2n_handler->shared_state.stats.bytes_encrypted += (uint64_t)data_sent;
+        }
+
+        if (send_code && s2n_error_get_type(s2n_error) != S2N_ERR_T_BLOCKED) {
+            s_early_data_stop(s2n_handler, s2n_error);
+            return AWS_OP_SUCCESS;
+        }
+
+        if (data_sent == 0) {
+            break;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/* Server mode: decrypts whatever early data the client sent into messages held until negotiation finishes. */
+static int s_receive_early_data(struct s2n_handler *s2n_handler) {
+    struct aws_channel *channel = s2n_handler->slot->channel;
+    s2n_blocked_status blocked = S2N_NOT_BLOCKED;
+
+    do {
+        struct aws_io_message *message = aws_channel_acquire_message_from_pool(
+            channel, AWS_IO_MESSAGE_APPLICATION_DATA, aws_channel_max_fragment_size(channel));
+        if (!message) {
+            return AWS_OP_ERR;
+        }
+
+        ssize_t data_received = 0;
+        int recv_code = s2n_recv_early_data(
+            s2n_handler->connection,
+            message->message_data.buffer,
+            (ssize_t)message->message_data.capacity,
+            &data_received,
+            &blocked);
+        int s2n_error = s2n_errno;
+
+        if (data_received > 0) {
+            message->message_data.len = (size_t)data_received;
+            s2n_handler->shared_state.stats.bytes_decrypted += (uint64_t)data_received;
+            aws_linked_list_push_back(&s2n_handler->early_data_reads, &message->queueing_handle);
+        } else {
+            aws_mem_release(message->allocator, message);
+        }
+
+        if (recv_code && s2n_error_get_type(s2n_error) != S2N_ERR_T_BLOCKED) {
+            AWS_LOGF_WARN(
+                AWS_LS_IO_TLS,
+                "id=%p: failed to read early data: %s (%s)",
+                (void *)&s2n_handler->handler,
+                s2n_strerror(s2n_error, "EN"),
+                s2n_strerror_debug(s2n_error, "EN"));
+            return aws_raise_error(AWS_IO_TLS_ERROR_NEGOTIATION_FAILURE);
+        }
+
+        if (data_received == 0) {
+            break;
+        }
+    } while (blocked == S2N_NOT_BLOCKED);
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_record_early_data_status(struct s2n_handler *s2n_handler) {
+    s2n_early_data_status_t status = S2N_EARLY_DATA_STATUS_NOT_REQUESTED;
+    if (s2n_connection_get_early_data_status(s2n_handler->connection, &status)) {
+        return;
+    }
+
+    switch (status) {
+        case S2N_EARLY_DATA_STATUS_OK:
+        case S2N_EARLY_DATA_STATUS_END:
+            s2n_handler->early_data_status = AWS_IO_TLS_EARLY_DATA_ACCEPTED;
+            break;
+        case S2N_EARLY_DATA_STATUS_REJECTED:
+            s2n_handler->early_data_status = AWS_IO_TLS_EARLY_DATA_REJECTED;
+            break;
+        default:
+            s2n_handler->early_data_status = AWS_IO_TLS_EARLY_DATA_NOT_REQUESTED;
+    }
+}
+
+static void s_move_to_pending_writes(struct s2n_handler *s2n_handler, struct aws_linked_list *messages) {
+    while (!aws_linked_list_empty(messages)) {
+        struct aws_linked_list_node *node = aws_linked_list_pop_front(messages);
+        struct aws_io_message *message = AWS_CONTAINER_OF(node, struct aws_io_message, queueing_handle);
+        aws_linked_list_push_back(&s2n_handler->pending_writes, node);
+        s2n_handler->pending_write_bytes += message->message_data.len;
+        s2n_handler->pending_write_count += 1;
+    }
+}
+
+/* Client mode: settles the writes made during negotiation, depending on what the server did with the early data. */
+static void s_finish_early_data_writes(struct s2n_handler *s2n_handler) {
+    if (s2n_handler->early_data_status == AWS_IO_TLS_EARLY_DATA_ACCEPTED) {
+        s_complete_write_messages(s2n_handler->slot->channel, &s2n_handler->early_data_sent, AWS_OP_SUCCESS);
+    } else {
+        s_move_to_pending_writes(s2n_handler, &s2n_handler->early_data_sent);
+    }
+    s_move_to_pending_writes(s2n_handler, &s2n_handler->early_data_writes);
+
+    /* a failed flush completes the messages and shuts the channel down on its own */
+    s_s2n_handler_flush_pending_writes(s2n_handler);
+}
+
+/* Server mode: hands the early data downstream, after the negotiation result so it follows the ALPN message. */
+static void s_deliver_early_data_reads(struct s2n_handler *s2n_handler) {
+    struct aws_channel_slot *slot = s2n_handler->slot;
+
+    while (!aws_linked_list_empty(&s2n_handler->early_data_reads)) {
+        struct aws_linked_list_node *node = aws_linked_list_pop_front(&s2n_handler->early_data_reads);
+        struct aws_io_message *message = AWS_CONTAINER_OF(node, struct aws_io_message, queueing_handle);
+
+        if (s2n_handler->on_data_read) {
+            s2n_handler->on_data_read(&s2n_handler->handler, slot, &message->message_data, s2n_handler->user_data);
+        }
+
+        if (slot->adj_right) {
+            if (aws_channel_slot_send_message(slot, message, AWS_CHANNEL_DIR_READ)) {
+                aws_mem_release(message->allocator, message);
+                aws_channel_shutdown(slot->channel, aws_last_error());
+                return;
+            }
+        } else {
+            aws_mem_release(message->allocator, message);
+        }
+    }
+}
+
 static int s_drive_negotiation(struct aws_channel_handler *handler) {
     struct s2n_handler *s2n_handler = (struct s2n_handler *)handler->impl;
 
     aws_on_drive_tls_negotiation(&s2n_handler->shared_state);
 
+    if (s_send_early_data(s2n_handler)) {
+        s2n_handler->negotiation_finished = false;
+        s_on_negotiation_result(handler, s2n_handler->slot, aws_last_error(), s2n_handler->user_data);
+        return AWS_OP_ERR;
+    }
+
     s2n_blocked_status blocked = S2N_NOT_BLOCKED;
     do {
         int negotiation_code = s2n_negotiate(s2n_handler->connection, &blocked);
@@ -294,6 +1089,22 @@ static int s_drive_negotiation(struct aws_channel_handler *handler) {
         if (negotiation_code == S2N_ERR_T_OK) {
             s2n_handler->negotiation_finished = true;
 
+            s_record_handshake_stats(s2n_handler);
+            s_record_early_data_status(s2n_handler);
+            AWS_LOGF_DEBUG(
+                AWS_LS_IO_TLS,
+                "id=%p: %s handshake completed after %" PRIu32 " read waits, cipher suite 0x%04X",
+                (void *)handler,
+                s2n_handler->shared_state.stats.session_resumed ? "Resumed" : "Full",
+                s2n_handler->shared_state.stats.handshake_read_waits,
+                (unsigned)s2n_handler->shared_state.stats.cipher_suite);
+
+            if (s2n_handler->session_cache_key) {
+                /* the server may have issued a fresh ticket even on a resumed handshake, so always refresh */
+                s_session_cache_store(
+                    s2n_handler->session_cache, s2n_handler->session_cache_key, s2n_handler->connection);
+            }
+
             const char *protocol = s2n_get_application_protocol(s2n_handler->connection);
             if (protocol) {
                 AWS_LOGF_DEBUG(AWS_LS_IO_TLS, "id=%p: Alpn protocol negotiated as %s", (void *)handler, protocol);
@@ -327,6 +1138,11 @@ static int s_drive_negotiation(struct aws_channel_handler *handler) {
 
             s_on_negotiation_result(handler, s2n_handler->slot, AWS_OP_SUCCESS, s2n_handler->user_data);
 
+            if (s2n_handler->early_data_enabled) {
+                s_finish_early_data_writes(s2n_handler);
+            }
+            s_deliver_early_data_reads(s2n_handler);
+
             break;
         }
         if (s2n_error_get_type(s2n_error) != S2N_ERR_T_BLOCKED) {
@@ -356,6 +1172,20 @@ static int s_drive_negotiation(struct aws_channel_handler *handler) {
 
             return AWS_OP_ERR;
         }
+
+        s_update_blocked_stats(s2n_handler, blocked);
+        if (blocked == S2N_BLOCKED_ON_READ) {
+            s2n_handler->shared_state.stats.handshake_read_waits += 1;
+        }
+
+        if (blocked == S2N_BLOCKED_ON_EARLY_DATA) {
+            if (s_receive_early_data(s2n_handler)) {
+                s2n_handler->negotiation_finished = false;
+                s_on_negotiation_result(handler, s2n_handler->slot, aws_last_error(), s2n_handler->user_data);
+                return AWS_OP_ERR;
+            }
+            blocked = S2N_NOT_BLOCKED;
+        }
     } while (blocked == S2N_NOT_BLOCKED);
 
     return AWS_OP_SUCCESS;
@@ -386,6 +1216,212 @@ int aws_tls_client_handler_start_negotiation(struct aws_channel_handler *handler
     return AWS_OP_SUCCESS;
 }
 
+static void s_handshake_offload_worker(void *arg) {
+    struct s2n_handshake_offload_pool *pool = arg;
+
+    aws_mutex_lock(&pool->lock);
+    while (true) {
+        while (aws_linked_list_empty(&pool->queue) && !pool->shutting_down) {
+            aws_condition_variable_wait(&pool->signal, &pool->lock);
+        }
+
+        /* drain whatever is queued before honoring shutdown, every job has to get back to its channel */
+        if (aws_linked_list_empty(&pool->queue)) {
+            break;
+        }
+
+        struct aws_linked_list_node *node = aws_linked_list_pop_front(&pool->queue);
+        pool->queued -= 1;
+        aws_mutex_unlock(&pool->lock);
+
+        struct s2n_pkey_op_job *job = AWS_CONTAINER_OF(node, struct s2n_pkey_op_job, node);
+        uint64_t start_ns = 0;
+        aws_high_res_clock_get_ticks(&start_ns);
+        job->performed = s2n_async_pkey_op_perform(job->op, job->key) == S2N_SUCCESS;
+        uint64_t end_ns = 0;
+        aws_high_res_clock_get_ticks(&end_ns);
+        job->duration_ns = end_ns - start_ns;
+        aws_channel_schedule_task_now(job->channel, &job->completion_task);
+
+        aws_mutex_lock(&pool->lock);
+    }
+    aws_mutex_unlock(&pool->lock);
+}
+
+static void s_handshake_offload_pool_destroy(struct s2n_handshake_offload_pool *pool) {
+    if (!pool) {
+        return;
+    }
+
+    aws_mutex_lock(&pool->lock);
+    pool->shutting_down = true;
+    aws_mutex_unlock(&pool->lock);
+    aws_condition_variable_notify_all(&pool->signal);
+
+    for (size_t i = 0; i < pool->thread_count; ++i) {
+        aws_thread_join(&pool->threads[i]);
+        aws_thread_clean_up(&pool->threads[i]);
+    }
+
+    AWS_ASSERT(aws_linked_list_empty(&pool->queue));
+    aws_mem_release(pool->allocator, pool->threads);
+    aws_condition_variable_clean_up(&pool->signal);
+    aws_mutex_clean_up(&pool->lock);
+    aws_mem_release(pool->allocator, pool);
+}
+
+static struct s2n_handshake_offload_pool *s_handshake_offload_pool_new(
+    struct aws_allocator *allocator,
+    size_t thread_count,
+    size_t max_queued) {
+
+    struct s2n_handshake_offload_pool *pool = aws_mem_calloc(allocator, 1, sizeof(struct s2n_handshake_offload_pool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->allocator = allocator;
+    pool->max_queued = max_queued ? max_queued : thread_count * DEFAULT_HANDSHAKE_OFFLOAD_QUEUE_PER_THREAD;
+    aws_linked_list_init(&pool->queue);
+    aws_mutex_init(&pool->lock);
+    aws_condition_variable_init(&pool->signal);
+
+    pool->threads = aws_mem_calloc(allocator, thread_count, sizeof(struct aws_thread));
+    if (!pool->threads) {
+        goto on_error;
+    }
+
+    for (size_t i = 0; i < thread_count; ++i) {
+        if (aws_thread_init(&pool->threads[i], allocator)) {
+            goto on_error;
+        }
+
+        if (aws_thread_launch(&pool->threads[i], s_handshake_offload_worker, pool, NULL)) {
+            aws_thread_clean_up(&pool->threads[i]);
+            goto on_error;
+        }
+
+        pool->thread_count += 1;
+    }
+
+    return pool;
+
+on_error:
+    /* only the threads that actually launched get joined */
+    s_handshake_offload_pool_destroy(pool);
+    return NULL;
+}
+
+/* Returns false if the pool is saturated, in which case the caller should perform the operation itself. */
+static bool s_handshake_offload_pool_submit(struct s2n_handshake_offload_pool *pool, struct s2n_pkey_op_job *job) {
+    bool submitted = false;
+
+    aws_mutex_lock(&pool->lock);
+    if (!pool->shutting_down && pool->queued < pool->max_queued) {
+        aws_linked_list_push_back(&pool->queue, &job->node);
+        pool->queued += 1;
+        submitted = true;
+    }
+    aws_mutex_unlock(&pool->lock);
+
+    if (submitted) {
+        aws_condition_variable_notify_one(&pool->signal);
+    }
+
+    return submitted;
+}
+
+static void s_pkey_op_job_destroy(struct s2n_pkey_op_job *job) {
+    s2n_async_pkey_op_free(job->op);
+    struct aws_channel *channel = job->channel;
+    aws_mem_release(job->allocator, job);
+    aws_channel_release_hold(channel);
+}
+
+/* Runs on the channel's thread once a worker has performed the operation, and resumes the handshake. */
+static void s_pkey_op_completion_task(struct aws_channel_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    struct s2n_pkey_op_job *job = arg;
+
+    if (status == AWS_TASK_STATUS_RUN_READY) {
+        struct s2n_handler *s2n_handler = job->s2n_handler;
+        struct aws_channel_handler *handler = &s2n_handler->handler;
+        s2n_handler->shared_state.stats.private_key_op_ns += job->duration_ns;
+
+        if (!job->performed || s2n_async_pkey_op_apply(job->op, s2n_handler->connection)) {
+            AWS_LOGF_WARN(
+                AWS_LS_IO_TLS,
+                "id=%p: offloaded private key operation failed with error %s (%s)",
+                (void *)handler,
+                s2n_strerror(s2n_errno, "EN"),
+                s2n_strerror_debug(s2n_errno, "EN"));
+            s_on_negotiation_result(
+                handler, s2n_handler->slot, AWS_IO_TLS_ERROR_NEGOTIATION_FAILURE, s2n_handler->user_data);
+            aws_channel_shutdown(job->channel, AWS_IO_TLS_ERROR_NEGOTIATION_FAILURE);
+        } else if (s_drive_negotiation(handler)) {
+            aws_channel_shutdown(job->channel, AWS_IO_TLS_ERROR_NEGOTIATION_FAILURE);
+        }
+    }
+
+    s_pkey_op_job_destroy(job);
+}
+
+/*
+ * s2n invokes this from inside s2n_negotiate() whenever the handshake needs the private key. The operation is handed
+ * to the ctx's worker pool and s2n_negotiate() reports itself blocked until the completion task applies the result.
+ */
+static int s_s2n_async_pkey_callback(struct s2n_connection *conn, struct s2n_async_pkey_op *op) {
+    struct s2n_handler *s2n_handler = s2n_connection_get_ctx(conn);
+
+    struct s2n_cert_chain_and_key *cert = s2n_connection_get_selected_cert(conn);
+    struct s2n_cert_private_key *key = cert ? s2n_cert_chain_and_key_get_private_key(cert) : NULL;
+    if (!key) {
+        s2n_async_pkey_op_free(op);
+        return S2N_FAILURE;
+    }
+
+    if (s2n_handler && s2n_handler->handshake_offload_pool) {
+        struct aws_allocator *allocator = s2n_handler->handshake_offload_pool->allocator;
+        struct s2n_pkey_op_job *job = aws_mem_calloc(allocator, 1, sizeof(struct s2n_pkey_op_job));
+        if (job) {
+            job->allocator = allocator;
+            job->s2n_handler = s2n_handler;
+            job->channel = s2n_handler->slot->channel;
+            job->op = op;
+            job->key = key;
+            aws_channel_task_init(&job->completion_task, s_pkey_op_completion_task, job, "s2n_pkey_op_completion");
+            aws_channel_acquire_hold(job->channel);
+
+            if (s_handshake_offload_pool_submit(s2n_handler->handshake_offload_pool, job)) {
+                return S2N_SUCCESS;
+            }
+
+            struct aws_channel *channel = job->channel;
+            aws_mem_release(allocator, job);
+            aws_channel_release_hold(channel);
+        }
+
+        AWS_LOGF_DEBUG(
+            AWS_LS_IO_TLS, "id=%p: handshake offload queue is full, signing inline", (void *)&s2n_handler->handler);
+    }
+
+    /* s2n allows completing the operation synchronously from within the callback */
+    int result = S2N_SUCCESS;
+    uint64_t start_ns = 0;
+    aws_high_res_clock_get_ticks(&start_ns);
+    if (s2n_async_pkey_op_perform(op, key) || s2n_async_pkey_op_apply(op, conn)) {
+        result = S2N_FAILURE;
+    }
+    s2n_async_pkey_op_free(op);
+
+    if (s2n_handler) {
+        uint64_t end_ns = 0;
+        aws_high_res_clock_get_ticks(&end_ns);
+        s2n_handler->shared_state.stats.private_key_op_ns += end_ns - start_ns;
+    }
+    return result;
+}
+
 static int s_s2n_handler_process_read_message(
     struct aws_channel_handler *handler,
     struct aws_channel_slot *slot,
@@ -417,98 +1453,316 @@ static int s_s2n_handler_process_read_message(
     AWS_LOGF_TRACE(
         AWS_LS_IO_TLS, "id=%p: Downstream window %llu", (void *)handler, (unsigned long long)downstream_window);
 
-    while (processed < downstream_window && blocked == S2N_NOT_BLOCKED) {
+    while (processed < downstream_window && blocked == S2N_NOT_BLOCKED) {
+
+        struct aws_io_message *outgoing_read_message = aws_channel_acquire_message_from_pool(
+            slot->channel, AWS_IO_MESSAGE_APPLICATION_DATA, downstream_window - processed);
+        if (!outgoing_read_message) {
+            return AWS_OP_ERR;
+        }
+
+        ssize_t read = s2n_recv(
+            s2n_handler->connection,
+            outgoing_read_message->message_data.buffer,
+            outgoing_read_message->message_data.capacity,
+            &blocked);
+
+        AWS_LOGF_TRACE(AWS_LS_IO_TLS, "id=%p: Bytes read %lld", (void *)handler, (long long)read);
+        s_update_blocked_stats(s2n_handler, blocked);
+
+        /* weird race where we received an alert from the peer, but s2n doesn't tell us about it.....
+         * if this happens, it's a graceful shutdown, so kick it off here.
+         *
+         * In other words, s2n, upon graceful shutdown, follows the unix EOF idiom. So just shutdown with
+         * SUCCESS.
+         */
+        if (read == 0) {
+            AWS_LOGF_DEBUG(
+                AWS_LS_IO_TLS,
+                "id=%p: Alert code %d",
+                (void *)handler,
+                s2n_connection_get_alert(s2n_handler->connection));
+            aws_mem_release(outgoing_read_message->allocator, outgoing_read_message);
+            aws_channel_shutdown(slot->channel, AWS_OP_SUCCESS);
+            return AWS_OP_SUCCESS;
+        }
+
+        if (read < 0) {
+            aws_mem_release(outgoing_read_message->allocator, outgoing_read_message);
+            continue;
+        };
+
+        processed += read;
+        outgoing_read_message->message_data.len = (size_t)read;
+        s2n_handler->shared_state.stats.bytes_decrypted += (uint64_t)read;
+
+        if (s2n_handler->on_data_read) {
+            s2n_handler->on_data_read(handler, slot, &outgoing_read_message->message_data, s2n_handler->user_data);
+        }
+
+        if (slot->adj_right) {
+            aws_channel_slot_send_message(slot, outgoing_read_message, AWS_CHANNEL_DIR_READ);
+        } else {
+            aws_mem_release(outgoing_read_message->allocator, outgoing_read_message);
+        }
+    }
+
+    AWS_LOGF_TRACE(
+        AWS_LS_IO_TLS,
+        "id=%p: Remaining window for this event-loop tick: %llu",
+        (void *)handler,
+        (unsigned long long)downstream_window - processed);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_s2n_handler_send_message(struct s2n_handler *s2n_handler, struct aws_io_message *message) {
+    s2n_handler->latest_message_on_completion = message->on_completion;
+    s2n_handler->latest_message_completion_user_data = message->user_data;
+
+    s2n_blocked_status blocked;
+    ssize_t write_code =
+        s2n_send(s2n_handler->connection, message->message_data.buffer, (ssize_t)message->message_data.len, &blocked);
+
+    AWS_LOGF_TRACE(
+        AWS_LS_IO_TLS, "id=%p: Bytes written: %llu", (void *)&s2n_handler->handler, (unsigned long long)write_code);
+    s_update_blocked_stats(s2n_handler, blocked);
+    if (write_code > 0) {
+        s2n_handler->shared_state.stats.bytes_encrypted += (uint64_t)write_code;
+    }
+
+    ssize_t message_len = (ssize_t)message->message_data.len;
+
+    if (write_code < message_len) {
+        return aws_raise_error(AWS_IO_TLS_ERROR_WRITE_FAILURE);
+    }
+
+    aws_mem_release(message->allocator, message);
+
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * Encrypts a batch of at most MAX_COALESCED_WRITES messages with a single s2n_sendv() call so that s2n packs the data
+ * into as few records as possible. The messages are always consumed. On failure they are completed with an error and
+ * the channel is shut down.
+ */
+static int s_s2n_handler_flush_batch(
+    struct s2n_handler *s2n_handler,
+    struct aws_linked_list *batch,
+    size_t flushed_count,
+    size_t flushed_bytes) {
+    AWS_PRECONDITION(flushed_count > 0 && flushed_count <= MAX_COALESCED_WRITES);
+
+    struct aws_channel *channel = s2n_handler->slot->channel;
+    int error_code = AWS_ERROR_SUCCESS;
+    struct aws_linked_list flushed;
+    aws_linked_list_init(&flushed);
+    aws_linked_list_swap_contents(&flushed, batch);
+
+    AWS_LOGF_TRACE(
+        AWS_LS_IO_TLS,
+        "id=%p: Flushing %llu coalesced writes totaling %llu bytes",
+        (void *)&s2n_handler->handler,
+        (unsigned long long)flushed_count,
+        (unsigned long long)flushed_bytes);
+
+    if (flushed_count == 1) {
+        struct aws_io_message *message =
+            AWS_CONTAINER_OF(aws_linked_list_front(&flushed), struct aws_io_message, queueing_handle);
+        if (s_s2n_handler_send_message(s2n_handler, message)) {
+            if (!s2n_handler->latest_message_on_completion) {
+                /* the completion was already handed to a downstream message, don't invoke it twice. */
+                message->on_completion = NULL;
+            }
+            s2n_handler->latest_message_on_completion = NULL;
+            s2n_handler->latest_message_completion_user_data = NULL;
+            goto error;
+        }
+
+        return AWS_OP_SUCCESS;
+    }
+
+    struct iovec iov[MAX_COALESCED_WRITES];
+    size_t iov_count = 0;
+    bool needs_completion = false;
+    for (struct aws_linked_list_node *node = aws_linked_list_begin(&flushed); node != aws_linked_list_end(&flushed);
+         node = aws_linked_list_next(node)) {
+        struct aws_io_message *message = AWS_CONTAINER_OF(node, struct aws_io_message, queueing_handle);
+        iov[iov_count].iov_base = message->message_data.buffer;
+        iov[iov_count].iov_len = message->message_data.len;
+        iov_count++;
+        needs_completion |= message->on_completion != NULL;
+    }
+
+    struct s2n_coalesced_write *coalesced_write = NULL;
+    if (needs_completion) {
+        coalesced_write = aws_mem_calloc(s2n_handler->handler.alloc, 1, sizeof(struct s2n_coalesced_write));
+        if (!coalesced_write) {
+            goto error;
+        }
+
+        coalesced_write->allocator = s2n_handler->handler.alloc;
+        aws_linked_list_init(&coalesced_write->messages);
+        aws_linked_list_swap_contents(&coalesced_write->messages, &flushed);
+        s2n_handler->latest_message_on_completion = s_on_coalesced_write_completed;
+        s2n_handler->latest_message_completion_user_data = coalesced_write;
+    }
+
+    s2n_blocked_status blocked;
+    ssize_t write_code = s2n_sendv(s2n_handler->connection, iov, (ssize_t)iov_count, &blocked);
+
+    AWS_LOGF_TRACE(
+        AWS_LS_IO_TLS, "id=%p: Bytes written: %llu", (void *)&s2n_handler->handler, (unsigned long long)write_code);
+    s_update_blocked_stats(s2n_handler, blocked);
+    if (write_code > 0) {
+        s2n_handler->shared_state.stats.bytes_encrypted += (uint64_t)write_code;
+    }
+
+    if (write_code < (ssize_t)flushed_bytes) {
+        aws_raise_error(AWS_IO_TLS_ERROR_WRITE_FAILURE);
+
+        /* if the completion never made it onto a downstream message, take the messages back and fail them here. */
+        if (coalesced_write && s2n_handler->latest_message_completion_user_data == coalesced_write) {
+            s2n_handler->latest_message_on_completion = NULL;
+            s2n_handler->latest_message_completion_user_data = NULL;
+            aws_linked_list_swap_contents(&flushed, &coalesced_write->messages);
+            aws_mem_release(coalesced_write->allocator, coalesced_write);
+        }
+        goto error;
+    }
+
+    /* if no write asked for a completion, the plaintext can go back to the pool right away. */
+    s_complete_write_messages(channel, &flushed, AWS_ERROR_SUCCESS);
+
+    return AWS_OP_SUCCESS;
+
+error:
+    error_code = aws_last_error();
+    AWS_LOGF_ERROR(
+        AWS_LS_IO_TLS,
+        "id=%p: Failed to flush coalesced writes with error %s",
+        (void *)&s2n_handler->handler,
+        aws_error_name(error_code));
+    s_complete_write_messages(channel, &flushed, error_code);
+    aws_channel_shutdown(channel, error_code);
+    return AWS_OP_ERR;
+}
 
-        struct aws_io_message *outgoing_read_message = aws_channel_acquire_message_from_pool(
-            slot->channel, AWS_IO_MESSAGE_APPLICATION_DATA, downstream_window - processed);
-        if (!outgoing_read_message) {
-            return AWS_OP_ERR;
+/*
+ * Flushes everything in pending_writes, MAX_COALESCED_WRITES messages per s2n_sendv() call. Early data settling can
+ * queue more than that at once, so this can't assume a single batch. The pending messages are always consumed. On
+ * failure every message not yet handed to s2n is completed with an error and the channel is shut down.
+ */
+static int s_s2n_handler_flush_pending_writes(struct s2n_handler *s2n_handler) {
+    while (!aws_linked_list_empty(&s2n_handler->pending_writes)) {
+        struct aws_linked_list batch;
+        aws_linked_list_init(&batch);
+        size_t batch_count = 0;
+        size_t batch_bytes = 0;
+
+        while (batch_count < MAX_COALESCED_WRITES && !aws_linked_list_empty(&s2n_handler->pending_writes)) {
+            struct aws_linked_list_node *node = aws_linked_list_pop_front(&s2n_handler->pending_writes);
+            struct aws_io_message *message = AWS_CONTAINER_OF(node, struct aws_io_message, queueing_handle);
+            aws_linked_list_push_back(&batch, node);
+            batch_bytes += message->message_data.len;
+            batch_count += 1;
         }
 
-        ssize_t read = s2n_recv(
-            s2n_handler->connection,
-            outgoing_read_message->message_data.buffer,
-            outgoing_read_message->message_data.capacity,
-            &blocked);
-
-        AWS_LOGF_TRACE(AWS_LS_IO_TLS, "id=%p: Bytes read %lld", (void *)handler, (long long)read);
+        s2n_handler->pending_write_bytes -= batch_bytes;
+        s2n_handler->pending_write_count -= batch_count;
 
-        /* weird race where we received an alert from the peer, but s2n doesn't tell us about it.....
-         * if this happens, it's a graceful shutdown, so kick it off here.
-         *
-         * In other words, s2n, upon graceful shutdown, follows the unix EOF idiom. So just shutdown with
-         * SUCCESS.
-         */
-        if (read == 0) {
-            AWS_LOGF_DEBUG(
-                AWS_LS_IO_TLS,
-                "id=%p: Alert code %d",
-                (void *)handler,
-                s2n_connection_get_alert(s2n_handler->connection));
-            aws_mem_release(outgoing_read_message->allocator, outgoing_read_message);
-            aws_channel_shutdown(slot->channel, AWS_OP_SUCCESS);
-            return AWS_OP_SUCCESS;
+        if (s_s2n_handler_flush_batch(s2n_handler, &batch, batch_count, batch_bytes)) {
+            int error_code = aws_last_error();
+            s_complete_write_messages(s2n_handler->slot->channel, &s2n_handler->pending_writes, error_code);
+            s2n_handler->pending_write_bytes = 0;
+            s2n_handler->pending_write_count = 0;
+            return aws_raise_error(error_code);
         }
+    }
 
-        if (read < 0) {
-            aws_mem_release(outgoing_read_message->allocator, outgoing_read_message);
-            continue;
-        };
+    return AWS_OP_SUCCESS;
+}
 
-        processed += read;
-        outgoing_read_message->message_data.len = (size_t)read;
+static void s_flush_task(struct aws_channel_task *task, void *arg, aws_task_status status) {
+    (void)task;
+    struct s2n_handler *s2n_handler = arg;
+    s2n_handler->flush_task_scheduled = false;
 
-        if (s2n_handler->on_data_read) {
-            s2n_handler->on_data_read(handler, slot, &outgoing_read_message->message_data, s2n_handler->user_data);
-        }
+    if (status == AWS_TASK_STATUS_RUN_READY) {
+        s_s2n_handler_flush_pending_writes(s2n_handler);
+    }
+}
 
-        if (slot->adj_right) {
-            aws_channel_slot_send_message(slot, outgoing_read_message, AWS_CHANNEL_DIR_READ);
-        } else {
-            aws_mem_release(outgoing_read_message->allocator, outgoing_read_message);
-        }
+static void s_schedule_flush_task(struct s2n_handler *s2n_handler) {
+    if (s2n_handler->flush_task_scheduled) {
+        return;
     }
 
-    AWS_LOGF_TRACE(
-        AWS_LS_IO_TLS,
-        "id=%p: Remaining window for this event-loop tick: %llu",
-        (void *)handler,
-        (unsigned long long)downstream_window - processed);
+    s2n_handler->flush_task_scheduled = true;
+    aws_channel_task_init(&s2n_handler->flush_task, s_flush_task, s2n_handler, "s2n_channel_handler_flush");
 
-    return AWS_OP_SUCCESS;
+    struct aws_channel *channel = s2n_handler->slot->channel;
+    uint64_t now = 0;
+    if (s2n_handler->write_coalescing_max_delay_ns && !aws_channel_current_clock_time(channel, &now)) {
+        uint64_t run_at = aws_add_u64_saturating(now, s2n_handler->write_coalescing_max_delay_ns);
+        aws_channel_schedule_task_future(channel, &s2n_handler->flush_task, run_at);
+    } else {
+        aws_channel_schedule_task_now(channel, &s2n_handler->flush_task);
+    }
 }
 
 static int s_s2n_handler_process_write_message(
     struct aws_channel_handler *handler,
     struct aws_channel_slot *slot,
     struct aws_io_message *message) {
-    (void)slot;
     struct s2n_handler *s2n_handler = (struct s2n_handler *)handler->impl;
 
-    if (AWS_UNLIKELY(!s2n_handler->negotiation_finished)) {
-        return aws_raise_error(AWS_IO_TLS_ERROR_NOT_NEGOTIATED);
+    if (AWS_UNLIKELY(message->slices != NULL)) {
+        /* the payload isn't in message_data, which is all this handler knows how to encrypt */
+        return aws_raise_error(AWS_IO_CHANNEL_UNKNOWN_MESSAGE_TYPE);
     }
 
-    s2n_handler->latest_message_on_completion = message->on_completion;
-    s2n_handler->latest_message_completion_user_data = message->user_data;
+    if (AWS_UNLIKELY(!s2n_handler->negotiation_finished)) {
+        if (!s2n_handler->early_data_enabled) {
+            return aws_raise_error(AWS_IO_TLS_ERROR_NOT_NEGOTIATED);
+        }
 
-    s2n_blocked_status blocked;
-    ssize_t write_code =
-        s2n_send(s2n_handler->connection, message->message_data.buffer, (ssize_t)message->message_data.len, &blocked);
+        aws_linked_list_push_back(&s2n_handler->early_data_writes, &message->queueing_handle);
+        /* before the ClientHello goes out the write is picked up by the first negotiation step instead */
+        if (s2n_handler->early_data_requested && s_send_early_data(s2n_handler)) {
+            aws_channel_shutdown(slot->channel, aws_last_error());
+        }
+        return AWS_OP_SUCCESS;
+    }
 
-    AWS_LOGF_TRACE(AWS_LS_IO_TLS, "id=%p: Bytes written: %llu", (void *)handler, (unsigned long long)write_code);
+    size_t threshold = s2n_handler->write_coalescing_threshold;
+    if (!threshold ||
+        (aws_linked_list_empty(&s2n_handler->pending_writes) && message->message_data.len >= threshold)) {
+        return s_s2n_handler_send_message(s2n_handler, message);
+    }
 
-    ssize_t message_len = (ssize_t)message->message_data.len;
+    aws_linked_list_push_back(&s2n_handler->pending_writes, &message->queueing_handle);
+    s2n_handler->pending_write_bytes += message->message_data.len;
+    s2n_handler->pending_write_count += 1;
 
-    if (write_code < message_len) {
-        return aws_raise_error(AWS_IO_TLS_ERROR_WRITE_FAILURE);
+    if (s2n_handler->pending_write_bytes >= threshold || s2n_handler->pending_write_count >= MAX_COALESCED_WRITES) {
+        /* the message now belongs to this handler; a failed flush completes it and shuts the channel down. */
+        s_s2n_handler_flush_pending_writes(s2n_handler);
+        return AWS_OP_SUCCESS;
     }
 
-    aws_mem_release(message->allocator, message);
-
+    s_schedule_flush_task(s2n_handler);
     return AWS_OP_SUCCESS;
 }
 
+int aws_tls_handler_flush(struct aws_channel_handler *handler) {
+    struct s2n_handler *s2n_handler = (struct s2n_handler *)handler->impl;
+    AWS_PRECONDITION(aws_channel_thread_is_callers_thread(s2n_handler->slot->channel));
+
+    return s_s2n_handler_flush_pending_writes(s2n_handler);
+}
+
 static int s_s2n_handler_shutdown(
     struct aws_channel_handler *handler,
     struct aws_channel_slot *slot,
@@ -520,19 +1774,37 @@ static int s_s2n_handler_shutdown(
     if (dir == AWS_CHANNEL_DIR_WRITE) {
         if (!abort_immediately && error_code != AWS_IO_SOCKET_CLOSED) {
             AWS_LOGF_DEBUG(AWS_LS_IO_TLS, "id=%p: Shutting down write direction", (void *)handler)
+            /* anything still buffered has to go out ahead of the close_notify alert. */
+            if (s_s2n_handler_flush_pending_writes(s2n_handler)) {
+                return aws_channel_slot_on_handler_shutdown_complete(slot, dir, error_code, abort_immediately);
+            }
+
             s2n_blocked_status blocked;
             /* make a best effort, but the channel is going away after this run, so.... you only get one shot anyways */
             s2n_shutdown(s2n_handler->connection, &blocked);
+        } else {
+            s_complete_write_messages(slot->channel, &s2n_handler->pending_writes, AWS_IO_SOCKET_CLOSED);
+            s_complete_write_messages(slot->channel, &s2n_handler->early_data_sent, AWS_IO_SOCKET_CLOSED);
+            s_complete_write_messages(slot->channel, &s2n_handler->early_data_writes, AWS_IO_SOCKET_CLOSED);
+            s2n_handler->pending_write_bytes = 0;
+            s2n_handler->pending_write_count = 0;
         }
     } else {
         AWS_LOGF_DEBUG(
             AWS_LS_IO_TLS, "id=%p: Shutting down read direction with error code %d", (void *)handler, error_code);
 
+        /* TLS 1.3 tickets arrive after the handshake, so pick up whatever the server sent over the connection's life */
+        if (s2n_handler->session_cache_key && s2n_handler->negotiation_finished) {
+            s_session_cache_store(s2n_handler->session_cache, s2n_handler->session_cache_key, s2n_handler->connection);
+        }
+
         while (!aws_linked_list_empty(&s2n_handler->input_queue)) {
             struct aws_linked_list_node *node = aws_linked_list_pop_front(&s2n_handler->input_queue);
             struct aws_io_message *message = AWS_CONTAINER_OF(node, struct aws_io_message, queueing_handle);
             aws_mem_release(message->allocator, message);
         }
+
+        s_complete_write_messages(slot->channel, &s2n_handler->early_data_reads, AWS_IO_SOCKET_CLOSED);
     }
 
     return aws_channel_slot_on_handler_shutdown_complete(slot, dir, error_code, abort_immediately);
@@ -625,6 +1897,11 @@ struct aws_byte_buf aws_tls_handler_server_name(struct aws_channel_handler *hand
     return s2n_handler->server_name;
 }
 
+enum aws_tls_early_data_status aws_tls_handler_early_data_status(struct aws_channel_handler *handler) {
+    struct s2n_handler *s2n_handler = (struct s2n_handler *)handler->impl;
+    return s2n_handler->early_data_status;
+}
+
 static struct aws_channel_handler_vtable s_handler_vtable = {
     .destroy = s_s2n_handler_destroy,
     .process_read_message = s_s2n_handler_process_read_message,
@@ -715,6 +1992,198 @@ static int s_s2n_tls_channel_handler_schedule_thread_local_cleanup(struct aws_ch
     return AWS_OP_SUCCESS;
 }
 
+/* how many wiped connections of each mode an event loop keeps for reuse */
+#define S2N_CONNECTION_CACHE_SIZE 16
+
+static size_t s_connection_cache_key = 0; /* Address of variable serves as key in hash table */
+
+static struct aws_atomic_var s_next_ctx_id = AWS_ATOMIC_INIT_INT(1);
+
+/*
+ * Channels created with a recycler don't free their s2n connections, they wipe them and leave them in this cache on
+ * their event loop for the next TLS handler of the same mode and ctx on that loop. Only reusing a connection for the
+ * ctx it came from means whatever per-connection settings survive the wipe, e.g. record size preferences, still match.
+ */
+struct s2n_connection_cache {
+    struct aws_allocator *allocator;
+    /* struct s2n_cached_connection, indexed by s2n_mode */
+    struct aws_array_list connections[2];
+};
+
+struct s2n_cached_connection {
+    uint64_t ctx_id;
+    struct s2n_connection *connection;
+};
+
+static void s_connection_cache_removed(struct aws_event_loop_local_object *object) {
+    struct s2n_connection_cache *cache = object->object;
+
+    for (size_t mode = 0; mode < AWS_ARRAY_SIZE(cache->connections); ++mode) {
+        struct s2n_cached_connection cached;
+        while (aws_array_list_back(&cache->connections[mode], &cached) == AWS_OP_SUCCESS) {
+            aws_array_list_pop_back(&cache->connections[mode]);
+            s2n_connection_free(cached.connection);
+        }
+        aws_array_list_clean_up(&cache->connections[mode]);
+    }
+
+    aws_mem_release(cache->allocator, object);
+}
+
+/*
+ * The slot's event loop's connection cache, or NULL if its channel doesn't recycle. If allocator is set, the cache is
+ * created with it when there isn't one yet. It outlives the channel, so it must not be the channel's arena.
+ */
+static struct s2n_connection_cache *s_connection_cache_get(
+    struct aws_channel_slot *slot,
+    struct aws_allocator *allocator) {
+    struct aws_channel *channel = slot->channel;
+    if (!aws_channel_get_recycler(channel)) {
+        return NULL;
+    }
+
+    struct aws_event_loop_local_object existing;
+    AWS_ZERO_STRUCT(existing);
+    if (aws_channel_fetch_local_object(channel, &s_connection_cache_key, &existing) == AWS_OP_SUCCESS) {
+        return existing.object;
+    }
+
+    if (!allocator) {
+        return NULL;
+    }
+
+    struct aws_event_loop_local_object *object = NULL;
+    struct s2n_connection_cache *cache = NULL;
+    if (!aws_mem_acquire_many(
+            allocator,
+            2,
+            &object,
+            sizeof(struct aws_event_loop_local_object),
+            &cache,
+            sizeof(struct s2n_connection_cache))) {
+        return NULL;
+    }
+
+    AWS_ZERO_STRUCT(*cache);
+    cache->allocator = allocator;
+    for (size_t mode = 0; mode < AWS_ARRAY_SIZE(cache->connections); ++mode) {
+        if (aws_array_list_init_dynamic(
+                &cache->connections[mode],
+                allocator,
+                S2N_CONNECTION_CACHE_SIZE,
+                sizeof(struct s2n_cached_connection))) {
+            goto on_error;
+        }
+    }
+
+    object->key = &s_connection_cache_key;
+    object->object = cache;
+    object->on_object_removed = s_connection_cache_removed;
+    if (aws_channel_put_local_object(channel, &s_connection_cache_key, object)) {
+        goto on_error;
+    }
+
+    return cache;
+
+on_error:
+    for (size_t mode = 0; mode < AWS_ARRAY_SIZE(cache->connections); ++mode) {
+        aws_array_list_clean_up(&cache->connections[mode]);
+    }
+    aws_mem_release(allocator, object);
+    return NULL;
+}
+
+static struct s2n_connection *s_connection_acquire(
+    struct aws_channel_slot *slot,
+    s2n_mode mode,
+    uint64_t ctx_id,
+    struct aws_allocator *allocator) {
+    struct s2n_connection_cache *cache = s_connection_cache_get(slot, allocator);
+
+    if (cache) {
+        struct aws_array_list *connections = &cache->connections[mode];
+        /* most recently released first, the order of the rest doesn't matter */
+        for (size_t i = aws_array_list_length(connections); i > 0; --i) {
+            struct s2n_cached_connection cached;
+            aws_array_list_get_at(connections, &cached, i - 1);
+            if (cached.ctx_id == ctx_id) {
+                aws_array_list_swap(connections, i - 1, aws_array_list_length(connections) - 1);
+                aws_array_list_pop_back(connections);
+                return cached.connection;
+            }
+        }
+    }
+
+    return s2n_connection_new(mode);
+}
+
+static void s_connection_release(
+    struct aws_channel_slot *slot,
+    struct s2n_connection *connection,
+    s2n_mode mode,
+    uint64_t ctx_id) {
+    struct s2n_connection_cache *cache = s_connection_cache_get(slot, NULL);
+    struct s2n_cached_connection cached = {
+        .ctx_id = ctx_id,
+        .connection = connection,
+    };
+
+    /* when it's full, the oldest connection makes room */
+    if (cache && aws_array_list_length(&cache->connections[mode]) == S2N_CONNECTION_CACHE_SIZE) {
+        struct s2n_cached_connection oldest;
+        aws_array_list_front(&cache->connections[mode], &oldest);
+        aws_array_list_pop_front(&cache->connections[mode]);
+        s2n_connection_free(oldest.connection);
+    }
+
+    if (cache && s2n_connection_wipe(connection) == S2N_SUCCESS &&
+        aws_array_list_push_back(&cache->connections[mode], &cached) == AWS_OP_SUCCESS) {
+        return;
+    }
+
+    s2n_connection_free(connection);
+}
+
+static int s_s2n_apply_record_size_policy(struct s2n_handler *s2n_handler, struct s2n_ctx *s2n_ctx) {
+    int result = S2N_SUCCESS;
+
+    switch (s2n_ctx->record_size_policy) {
+        case AWS_IO_TLS_RECORD_SIZE_LOW_LATENCY:
+            result = s2n_connection_prefer_low_latency(s2n_handler->connection);
+            break;
+        case AWS_IO_TLS_RECORD_SIZE_THROUGHPUT:
+            result = s2n_connection_prefer_throughput(s2n_handler->connection);
+            break;
+        case AWS_IO_TLS_RECORD_SIZE_DYNAMIC:
+            /* s2n starts out with small records until resize_threshold bytes have gone out, and drops back to them
+             * after timeout_threshold seconds without a write. Throughput mode is the size it ramps up to. */
+            result = s2n_connection_prefer_throughput(s2n_handler->connection);
+            if (result == S2N_SUCCESS) {
+                result = s2n_connection_set_dynamic_record_threshold(
+                    s2n_handler->connection,
+                    s2n_ctx->dynamic_record_resize_threshold,
+                    s2n_ctx->dynamic_record_idle_timeout_secs);
+            }
+            break;
+        case AWS_IO_TLS_RECORD_SIZE_DEFAULT:
+        default:
+            break;
+    }
+
+    if (result != S2N_SUCCESS) {
+        AWS_LOGF_ERROR(
+            AWS_LS_IO_TLS,
+            "id=%p: failed to apply record size policy %d: %s (%s)",
+            (void *)&s2n_handler->handler,
+            (int)s2n_ctx->record_size_policy,
+            s2n_strerror(s2n_errno, "EN"),
+            s2n_strerror_debug(s2n_errno, "EN"));
+        return aws_raise_error(AWS_IO_TLS_CTX_ERROR);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
 static struct aws_channel_handler *s_new_tls_handler(
     struct aws_allocator *allocator,
     struct aws_tls_connection_options *options,
@@ -728,7 +2197,9 @@ static struct aws_channel_handler *s_new_tls_handler(
     }
 
     struct s2n_ctx *s2n_ctx = (struct s2n_ctx *)options->ctx->impl;
-    s2n_handler->connection = s2n_connection_new(mode);
+    s2n_handler->mode = mode;
+    s2n_handler->ctx_id = s2n_ctx->id;
+    s2n_handler->connection = s_connection_acquire(slot, mode, s2n_ctx->id, s2n_ctx->ctx.alloc);
 
     if (!s2n_handler->connection) {
         goto cleanup_s2n_handler;
@@ -750,6 +2221,13 @@ static struct aws_channel_handler *s_new_tls_handler(
     s2n_handler->latest_message_on_completion = NULL;
     s2n_handler->slot = slot;
     aws_linked_list_init(&s2n_handler->input_queue);
+    aws_linked_list_init(&s2n_handler->pending_writes);
+    aws_linked_list_init(&s2n_handler->early_data_writes);
+    aws_linked_list_init(&s2n_handler->early_data_sent);
+    aws_linked_list_init(&s2n_handler->early_data_reads);
+    s2n_handler->early_data_status = AWS_IO_TLS_EARLY_DATA_NOT_REQUESTED;
+    s2n_handler->write_coalescing_threshold = s2n_ctx->write_coalescing_threshold;
+    s2n_handler->write_coalescing_max_delay_ns = s2n_ctx->write_coalescing_max_delay_ns;
 
     s2n_handler->protocol = aws_byte_buf_from_array(NULL, 0);
 
@@ -768,6 +2246,8 @@ static struct aws_channel_handler *s_new_tls_handler(
     s2n_connection_set_send_cb(s2n_handler->connection, s_s2n_handler_send);
     s2n_connection_set_send_ctx(s2n_handler->connection, s2n_handler);
     s2n_connection_set_blinding(s2n_handler->connection, S2N_SELF_SERVICE_BLINDING);
+    s2n_connection_set_ctx(s2n_handler->connection, s2n_handler);
+    s2n_handler->handshake_offload_pool = s2n_ctx->handshake_offload_pool;
 
     if (options->alpn_list) {
         AWS_LOGF_DEBUG(
@@ -808,6 +2288,39 @@ static struct aws_channel_handler *s_new_tls_handler(
         goto cleanup_conn;
     }
 
+    if (s_s2n_apply_record_size_policy(s2n_handler, s2n_ctx)) {
+        goto cleanup_conn;
+    }
+
+    if (mode == S2N_CLIENT && s2n_ctx->session_cache && options->server_name) {
+        s2n_handler->session_cache = s2n_ctx->session_cache;
+        s2n_handler->session_cache_key = s_session_cache_key_new(allocator, options->server_name, options->port);
+        if (!s2n_handler->session_cache_key) {
+            goto cleanup_conn;
+        }
+
+        if (s_session_cache_apply(s2n_ctx->session_cache, s2n_handler->session_cache_key, s2n_handler->connection)) {
+            AWS_LOGF_DEBUG(
+                AWS_LS_IO_TLS,
+                "id=%p: Offering cached session for %s",
+                (void *)&s2n_handler->handler,
+                aws_string_c_str(s2n_handler->session_cache_key));
+
+            /* early data can only ride along with a resumed session */
+            if (s2n_ctx->max_early_data_size && options->early_data_replay_safe) {
+                s2n_handler->early_data_enabled = true;
+                s2n_handler->early_data_budget = s2n_ctx->max_early_data_size;
+            }
+        }
+    }
+
+    if (mode == S2N_SERVER && s2n_ctx->max_early_data_size && !options->early_data_replay_safe) {
+        if (s2n_connection_set_server_max_early_data_size(s2n_handler->connection, 0)) {
+            aws_raise_error(AWS_IO_TLS_CTX_ERROR);
+            goto cleanup_conn;
+        }
+    }
+
     if (s_s2n_tls_channel_handler_schedule_thread_local_cleanup(slot)) {
         goto cleanup_conn;
     }
@@ -815,7 +2328,10 @@ static struct aws_channel_handler *s_new_tls_handler(
     return &s2n_handler->handler;
 
 cleanup_conn:
-    s2n_connection_free(s2n_handler->connection);
+    if (s2n_handler->session_cache_key) {
+        aws_string_destroy(s2n_handler->session_cache_key);
+    }
+    s_connection_release(slot, s2n_handler->connection, mode, s2n_handler->ctx_id);
 
 cleanup_s2n_handler:
     aws_mem_release(allocator, s2n_handler);
@@ -842,10 +2358,58 @@ struct aws_channel_handler *aws_tls_server_handler_new(
 static void s_s2n_ctx_destroy(struct s2n_ctx *s2n_ctx) {
     if (s2n_ctx != NULL) {
         s2n_config_free(s2n_ctx->s2n_config);
+        s_shared_cert_chain_release(s2n_ctx->cert_chain);
+        s_session_cache_destroy(s2n_ctx->session_cache);
+        s_handshake_offload_pool_destroy(s2n_ctx->handshake_offload_pool);
         aws_mem_release(s2n_ctx->ctx.alloc, s2n_ctx);
     }
 }
 
+static int s_s2n_config_setup_session_tickets(struct s2n_config *config, uint32_t key_lifetime_secs) {
+    if (s2n_config_set_session_tickets_onoff(config, 1) ||
+        s2n_config_set_ticket_encrypt_decrypt_key_lifetime(config, key_lifetime_secs) ||
+        s2n_config_set_ticket_decrypt_key_lifetime(config, key_lifetime_secs)) {
+        goto on_s2n_error;
+    }
+
+    uint64_t now_ns = 0;
+    if (aws_sys_clock_get_ticks(&now_ns)) {
+        return AWS_OP_ERR;
+    }
+    uint64_t now_secs = aws_timestamp_convert(now_ns, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_SECS, NULL);
+
+    for (size_t i = 0; i < SESSION_TICKET_KEY_COUNT; ++i) {
+        uint8_t key[SESSION_TICKET_KEY_LEN];
+        struct aws_byte_buf key_buf = aws_byte_buf_from_empty_array(key, sizeof(key));
+        if (aws_device_random_buffer(&key_buf)) {
+            return AWS_OP_ERR;
+        }
+
+        char key_name[16];
+        snprintf(key_name, sizeof(key_name), "aws-c-io-%02d", (int)i);
+
+        /* an intro time of 0 means "now" to s2n */
+        uint64_t intro_time = i == 0 ? 0 : now_secs + i * (uint64_t)key_lifetime_secs;
+        int result = s2n_config_add_ticket_crypto_key(
+            config, (const uint8_t *)key_name, (uint32_t)strlen(key_name), key, sizeof(key), intro_time);
+        aws_secure_zero(key, sizeof(key));
+
+        if (result) {
+            goto on_s2n_error;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+
+on_s2n_error:
+    AWS_LOGF_ERROR(
+        AWS_LS_IO_TLS,
+        "ctx: failed to configure session tickets: %s (%s)",
+        s2n_strerror(s2n_errno, "EN"),
+        s2n_strerror_debug(s2n_errno, "EN"));
+    return aws_raise_error(AWS_IO_TLS_CTX_ERROR);
+}
+
 static struct aws_tls_ctx *s_tls_ctx_new(
     struct aws_allocator *alloc,
     const struct aws_tls_ctx_options *options,
@@ -856,6 +2420,8 @@ static struct aws_tls_ctx *s_tls_ctx_new(
         return NULL;
     }
 
+    s2n_ctx->id = (uint64_t)aws_atomic_fetch_add(&s_next_ctx_id, 1);
+
     if (!aws_tls_is_cipher_pref_supported(options->cipher_pref)) {
         aws_raise_error(AWS_IO_TLS_CIPHER_PREF_UNSUPPORTED);
         AWS_LOGF_ERROR(AWS_LS_IO_TLS, "static: TLS Cipher Preference is not supported: %d.", options->cipher_pref);
@@ -871,27 +2437,26 @@ static struct aws_tls_ctx *s_tls_ctx_new(
         goto cleanup_s2n_ctx;
     }
 
+    const char *security_policy = NULL;
     switch (options->minimum_tls_version) {
         case AWS_IO_SSLv3:
-            s2n_config_set_cipher_preferences(s2n_ctx->s2n_config, "CloudFront-SSL-v-3");
+            security_policy = "CloudFront-SSL-v-3";
             break;
         case AWS_IO_TLSv1:
-            s2n_config_set_cipher_preferences(s2n_ctx->s2n_config, "CloudFront-TLS-1-0-2014");
+            security_policy = "CloudFront-TLS-1-0-2014";
             break;
         case AWS_IO_TLSv1_1:
-            s2n_config_set_cipher_preferences(s2n_ctx->s2n_config, "ELBSecurityPolicy-TLS-1-1-2017-01");
+            security_policy = "ELBSecurityPolicy-TLS-1-1-2017-01";
             break;
         case AWS_IO_TLSv1_2:
-            s2n_config_set_cipher_preferences(s2n_ctx->s2n_config, "ELBSecurityPolicy-TLS-1-2-Ext-2018-06");
+            security_policy = "ELBSecurityPolicy-TLS-1-2-Ext-2018-06";
             break;
         case AWS_IO_TLSv1_3:
-            AWS_LOGF_ERROR(AWS_LS_IO_TLS, "TLS 1.3 is not supported yet.");
-            /* sorry guys, we'll add this as soon as s2n does. */
-            aws_raise_error(AWS_IO_TLS_VERSION_UNSUPPORTED);
-            goto cleanup_s2n_ctx;
+            security_policy = "AWS-CRT-SDK-TLSv1.3";
+            break;
         case AWS_IO_TLS_VER_SYS_DEFAULTS:
         default:
-            s2n_config_set_cipher_preferences(s2n_ctx->s2n_config, "ELBSecurityPolicy-TLS-1-1-2017-01");
+            security_policy = "ELBSecurityPolicy-TLS-1-1-2017-01";
     }
 
     switch (options->cipher_pref) {
@@ -899,19 +2464,19 @@ static struct aws_tls_ctx *s_tls_ctx_new(
             /* No-Op, if the user configured a minimum_tls_version then a version-specific Cipher Preference was set */
             break;
         case AWS_IO_TLS_CIPHER_PREF_KMS_PQ_TLSv1_0_2019_06:
-            s2n_config_set_cipher_preferences(s2n_ctx->s2n_config, "KMS-PQ-TLS-1-0-2019-06");
+            security_policy = "KMS-PQ-TLS-1-0-2019-06";
             break;
         case AWS_IO_TLS_CIPHER_PREF_KMS_PQ_SIKE_TLSv1_0_2019_11:
-            s2n_config_set_cipher_preferences(s2n_ctx->s2n_config, "PQ-SIKE-TEST-TLS-1-0-2019-11");
+            security_policy = "PQ-SIKE-TEST-TLS-1-0-2019-11";
             break;
         case AWS_IO_TLS_CIPHER_PREF_KMS_PQ_TLSv1_0_2020_02:
-            s2n_config_set_cipher_preferences(s2n_ctx->s2n_config, "KMS-PQ-TLS-1-0-2020-02");
+            security_policy = "KMS-PQ-TLS-1-0-2020-02";
             break;
         case AWS_IO_TLS_CIPHER_PREF_KMS_PQ_SIKE_TLSv1_0_2020_02:
-            s2n_config_set_cipher_preferences(s2n_ctx->s2n_config, "PQ-SIKE-TEST-TLS-1-0-2020-02");
+            security_policy = "PQ-SIKE-TEST-TLS-1-0-2020-02";
             break;
         case AWS_IO_TLS_CIPHER_PREF_KMS_PQ_TLSv1_0_2020_07:
-            s2n_config_set_cipher_preferences(s2n_ctx->s2n_config, "KMS-PQ-TLS-1-0-2020-07");
+            security_policy = "KMS-PQ-TLS-1-0-2020-07";
             break;
         default:
             AWS_LOGF_ERROR(AWS_LS_IO_TLS, "Unrecognized TLS Cipher Preference: %d", options->cipher_pref);
@@ -919,6 +2484,17 @@ static struct aws_tls_ctx *s_tls_ctx_new(
             goto cleanup_s2n_ctx;
     }
 
+    if (s2n_config_set_cipher_preferences(s2n_ctx->s2n_config, security_policy)) {
+        AWS_LOGF_ERROR(
+            AWS_LS_IO_TLS,
+            "ctx: s2n does not support security policy %s: %s (%s)",
+            security_policy,
+            s2n_strerror(s2n_errno, "EN"),
+            s2n_strerror_debug(s2n_errno, "EN"));
+        aws_raise_error(AWS_IO_TLS_CIPHER_PREF_UNSUPPORTED);
+        goto cleanup_s2n_config;
+    }
+
     if (options->certificate.len && options->private_key.len) {
         AWS_LOGF_DEBUG(AWS_LS_IO_TLS, "ctx: Certificate and key have been set, setting them up now.");
 
@@ -934,8 +2510,13 @@ static struct aws_tls_ctx *s_tls_ctx_new(
             goto cleanup_s2n_ctx;
         }
 
-        int err_code = s2n_config_add_cert_chain_and_key(
-            s2n_ctx->s2n_config, (const char *)options->certificate.buffer, (const char *)options->private_key.buffer);
+        s2n_ctx->cert_chain = s_shared_cert_chain_acquire(alloc, &options->certificate, &options->private_key);
+        if (!s2n_ctx->cert_chain) {
+            goto cleanup_s2n_config;
+        }
+
+        int err_code =
+            s2n_config_add_cert_chain_and_key_to_store(s2n_ctx->s2n_config, s2n_ctx->cert_chain->chain_and_key);
 
         if (mode == S2N_CLIENT) {
             s2n_config_set_client_auth_type(s2n_ctx->s2n_config, S2N_CERT_AUTH_REQUIRED);
@@ -1005,14 +2586,20 @@ static struct aws_tls_ctx *s_tls_ctx_new(
         }
 
         if (!options->ca_path && !options->ca_file.len) {
-            if (s2n_config_set_verification_ca_location(s2n_ctx->s2n_config, s_default_ca_file, s_default_ca_dir)) {
+            /* these can be swapped out by aws_tls_reload_credential_cache() */
+            aws_mutex_lock(&s_credential_cache.lock);
+            const char *default_ca_file = s_default_ca_file;
+            const char *default_ca_dir = s_default_ca_dir;
+            aws_mutex_unlock(&s_credential_cache.lock);
+
+            if (s2n_config_set_verification_ca_location(s2n_ctx->s2n_config, default_ca_file, default_ca_dir)) {
                 AWS_LOGF_ERROR(
                     AWS_LS_IO_TLS,
                     "ctx: configuration error %s (%s)",
                     s2n_strerror(s2n_errno, "EN"),
                     s2n_strerror_debug(s2n_errno, "EN"));
                 AWS_LOGF_ERROR(
-                    AWS_LS_IO_TLS, "Failed to set ca_path: %s and ca_file %s\n", s_default_ca_dir, s_default_ca_file);
+                    AWS_LS_IO_TLS, "Failed to set ca_path: %s and ca_file %s\n", default_ca_dir, default_ca_file);
                 aws_raise_error(AWS_IO_TLS_CTX_ERROR);
                 goto cleanup_s2n_config;
             }
@@ -1060,6 +2647,85 @@ static struct aws_tls_ctx *s_tls_ctx_new(
         }
     }
 
+    s2n_ctx->write_coalescing_threshold = options->write_coalescing_threshold;
+    s2n_ctx->write_coalescing_max_delay_ns = aws_timestamp_convert(
+        options->write_coalescing_max_delay_ms, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+
+    if (options->enable_session_resumption) {
+        if (mode == S2N_SERVER) {
+            uint32_t key_lifetime = options->session_ticket_key_lifetime_secs
+                                        ? options->session_ticket_key_lifetime_secs
+                                        : DEFAULT_SESSION_TICKET_KEY_LIFETIME_SECS;
+            if (s_s2n_config_setup_session_tickets(s2n_ctx->s2n_config, key_lifetime)) {
+                goto cleanup_s2n_config;
+            }
+        } else {
+            if (s2n_config_set_session_tickets_onoff(s2n_ctx->s2n_config, 1)) {
+                AWS_LOGF_ERROR(
+                    AWS_LS_IO_TLS,
+                    "ctx: failed to enable session tickets: %s (%s)",
+                    s2n_strerror(s2n_errno, "EN"),
+                    s2n_strerror_debug(s2n_errno, "EN"));
+                aws_raise_error(AWS_IO_TLS_CTX_ERROR);
+                goto cleanup_s2n_config;
+            }
+
+            size_t max_entries = options->session_cache_max_entries ? options->session_cache_max_entries
+                                                                     : DEFAULT_SESSION_CACHE_MAX_ENTRIES;
+            s2n_ctx->session_cache = s_session_cache_new(alloc, max_entries);
+            if (!s2n_ctx->session_cache) {
+                goto cleanup_s2n_config;
+            }
+        }
+    }
+
+    if (options->max_early_data_size) {
+        if (!options->enable_session_resumption || options->minimum_tls_version != AWS_IO_TLSv1_3) {
+            AWS_LOGF_ERROR(
+                AWS_LS_IO_TLS, "ctx: early data requires session resumption and a minimum TLS version of 1.3.");
+            aws_raise_error(AWS_IO_TLS_CTX_ERROR);
+            goto cleanup_s2n_config;
+        }
+
+        s2n_ctx->max_early_data_size = options->max_early_data_size;
+        if (mode == S2N_SERVER &&
+            s2n_config_set_server_max_early_data_size(s2n_ctx->s2n_config, options->max_early_data_size)) {
+            AWS_LOGF_ERROR(
+                AWS_LS_IO_TLS,
+                "ctx: failed to configure early data: %s (%s)",
+                s2n_strerror(s2n_errno, "EN"),
+                s2n_strerror_debug(s2n_errno, "EN"));
+            aws_raise_error(AWS_IO_TLS_CTX_ERROR);
+            goto cleanup_s2n_config;
+        }
+    }
+
+    if (options->handshake_offload_threads) {
+        s2n_ctx->handshake_offload_pool = s_handshake_offload_pool_new(
+            alloc, options->handshake_offload_threads, options->handshake_offload_max_queued);
+        if (!s2n_ctx->handshake_offload_pool) {
+            goto cleanup_s2n_config;
+        }
+
+        if (s2n_config_set_async_pkey_callback(s2n_ctx->s2n_config, s_s2n_async_pkey_callback)) {
+            AWS_LOGF_ERROR(
+                AWS_LS_IO_TLS,
+                "ctx: failed to install async private key callback: %s (%s)",
+                s2n_strerror(s2n_errno, "EN"),
+                s2n_strerror_debug(s2n_errno, "EN"));
+            aws_raise_error(AWS_IO_TLS_CTX_ERROR);
+            goto cleanup_s2n_config;
+        }
+    }
+
+    s2n_ctx->record_size_policy = options->record_size_policy;
+    s2n_ctx->dynamic_record_resize_threshold = options->dynamic_record_resize_threshold
+                                                   ? options->dynamic_record_resize_threshold
+                                                   : DEFAULT_DYNAMIC_RECORD_RESIZE_THRESHOLD;
+    s2n_ctx->dynamic_record_idle_timeout_secs = options->dynamic_record_idle_timeout_secs
+                                                    ? options->dynamic_record_idle_timeout_secs
+                                                    : DEFAULT_DYNAMIC_RECORD_IDLE_TIMEOUT_SECS;
+
     if (options->max_fragment_size == 512) {
         s2n_config_send_max_fragment_length(s2n_ctx->s2n_config, S2N_TLS_MAX_FRAG_LEN_512);
     } else if (options->max_fragment_size == 1024) {
@@ -1073,7 +2739,10 @@ static struct aws_tls_ctx *s_tls_ctx_new(
     return &s2n_ctx->ctx;
 
 cleanup_s2n_config:
+    s_session_cache_destroy(s2n_ctx->session_cache);
+    s_handshake_offload_pool_destroy(s2n_ctx->handshake_offload_pool);
     s2n_config_free(s2n_ctx->s2n_config);
+    s_shared_cert_chain_release(s2n_ctx->cert_chain);
 
 cleanup_s2n_ctx:
     aws_mem_release(alloc, s2n_ctx);
@@ -7,7 +7,10 @@
 #include <aws/common/error.h>
 #include <aws/common/task_scheduler.h>
 
+#include <aws/io/channel.h>
+
 #include <aws/io/event_loop.h>
+#include <aws/io/io_slice.h>
 #include <aws/io/logging.h>
 #include <aws/io/socket.h>
 #include <aws/io/statistics.h>
@@ -16,15 +19,70 @@
 #    pragma warning(disable : 4204) /* non-constant aggregate initializer */
 #endif
 
+/* writes of up to this many cursors are gathered without allocating */
+#define STACK_WRITE_CURSORS 16
+
+/* most pool messages filled by a single vectored read */
+#define MAX_READ_MESSAGES 16
+
+/* bounds on how much all the busy sockets of an event loop may read per tick, between them */
+#define LOOP_READ_BUDGET_MIN (16 * 1024)
+#define LOOP_READ_BUDGET_INITIAL (64 * 1024)
+#define LOOP_READ_BUDGET_MAX (4 * 1024 * 1024)
+/* a socket gets at least a quarter, and at most 16 times, its max_read_size per tick */
+#define READ_BUDGET_MIN_SHIFT 2
+#define READ_BUDGET_MAX_SHIFT 4
+/* how long a socket that yielded should wait to read again. The loop budget shrinks past it, and grows well under it */
+#define READ_DELAY_TARGET_NS (1000 * 1000)
+/* how long write shutdown waits for writes already handed to the socket to go out, before closing it regardless */
+#define WRITE_DRAIN_TIMEOUT_NS (3ULL * 1000 * 1000 * 1000)
+
+/*
+ * Read budget state shared by every socket handler on an event loop, as a loop local object. The loop budget is split
+ * between the sockets that keep using up their share, and adapts to how long a socket that yields has to wait to get
+ * its next turn: that's the rest of the loop's tick.
+ */
+struct socket_read_budget {
+    struct aws_allocator *allocator;
+    size_t loop_budget;
+    /* sockets that used up their budget on their last read and are waiting on their next turn */
+    size_t busy_sockets;
+    /* smoothed delay between a socket yielding and reading again */
+    uint64_t read_delay_ns;
+};
+
+static int s_read_budget_key = 0;
+
 struct socket_handler {
     struct aws_socket *socket;
     struct aws_channel_slot *slot;
     size_t max_rw_size;
+    /* NULL until the first read, or if it couldn't be set up, in which case max_rw_size is the budget */
+    struct socket_read_budget *read_budget;
+    /* when the handler last yielded, having used up its budget */
+    uint64_t yield_timestamp;
+    bool read_budget_exhausted;
     struct aws_channel_task read_task_storage;
     struct aws_channel_task shutdown_task_storage;
+    struct aws_channel_task drain_timeout_task_storage;
     struct aws_crt_statistics_socket stats;
+    /* while corked, write messages wait here and go out in a single vectored write on uncork */
+    struct aws_linked_list corked_writes;
+    /* writes handed to the socket whose completion hasn't fired yet */
+    size_t pending_socket_writes;
     int shutdown_err_code;
     bool shutdown_in_progress;
+    bool write_corked;
+    /* write shutdown is waiting on pending_socket_writes to reach 0 before closing the socket */
+    bool close_when_writes_drain;
+};
+
+static void s_on_socket_write_drained(struct socket_handler *socket_handler);
+
+/* several messages handed to the socket in a single vectored write. */
+struct socket_write_batch {
+    struct aws_allocator *allocator;
+    struct aws_linked_list messages;
 };
 
 static int s_socket_process_read_message(
@@ -47,6 +105,11 @@ static int s_socket_process_read_message(
     return aws_raise_error(AWS_IO_CHANNEL_ERROR_ERROR_CANT_ACCEPT_INPUT);
 }
 
+/* bytes a write message puts on the wire, and counts against the channel's write window */
+static size_t s_message_write_len(struct aws_io_message *message) {
+    return message->slices ? message->slices->len : message->message_data.len;
+}
+
 /* invoked by the socket when a write has completed or failed. */
 static void s_on_socket_write_complete(
     struct aws_socket *socket,
@@ -57,6 +120,7 @@ static void s_on_socket_write_complete(
     if (user_data) {
         struct aws_io_message *message = user_data;
         struct aws_channel *channel = message->owning_channel;
+        size_t message_len = s_message_write_len(message);
         AWS_LOGF_TRACE(
             AWS_LS_IO_SOCKET_HANDLER,
             "static: write of size %llu, completed on channel %p",
@@ -67,41 +131,329 @@ static void s_on_socket_write_complete(
             message->on_completion(channel, message, error_code, message->user_data);
         }
 
+        struct socket_handler *socket_handler = NULL;
         if (socket && socket->handler) {
-            struct socket_handler *socket_handler = socket->handler->impl;
+            socket_handler = socket->handler->impl;
             socket_handler->stats.bytes_written += amount_written;
         }
 
         aws_mem_release(message->allocator, message);
+        aws_channel_decrement_pending_write_bytes(channel, message_len);
 
         if (error_code) {
             aws_channel_shutdown(channel, error_code);
         }
+
+        if (socket_handler) {
+            s_on_socket_write_drained(socket_handler);
+        }
+    }
+}
+
+/* invoked by the socket when a batched write has completed or failed, completes every message in the batch. */
+static void s_on_socket_batch_write_complete(
+    struct aws_socket *socket,
+    int error_code,
+    size_t amount_written,
+    void *user_data) {
+
+    struct socket_write_batch *batch = user_data;
+    struct aws_channel *channel = NULL;
+    size_t message_count = 0;
+    size_t batch_len = 0;
+
+    while (!aws_linked_list_empty(&batch->messages)) {
+        struct aws_io_message *message =
+            AWS_CONTAINER_OF(aws_linked_list_pop_front(&batch->messages), struct aws_io_message, queueing_handle);
+        channel = message->owning_channel;
+        message_count += 1;
+        batch_len += s_message_write_len(message);
+
+        if (message->on_completion) {
+            message->on_completion(channel, message, error_code, message->user_data);
+        }
+
+        aws_mem_release(message->allocator, message);
+    }
+
+    AWS_LOGF_TRACE(
+        AWS_LS_IO_SOCKET_HANDLER,
+        "static: write of %llu messages, size %llu, completed on channel %p",
+        (unsigned long long)message_count,
+        (unsigned long long)amount_written,
+        (void *)channel);
+
+    struct socket_handler *socket_handler = NULL;
+    if (socket && socket->handler) {
+        socket_handler = socket->handler->impl;
+        socket_handler->stats.bytes_written += amount_written;
+    }
+
+    aws_mem_release(batch->allocator, batch);
+
+    if (channel) {
+        aws_channel_decrement_pending_write_bytes(channel, batch_len);
+
+        if (error_code) {
+            aws_channel_shutdown(channel, error_code);
+        }
+    }
+
+    if (socket_handler) {
+        s_on_socket_write_drained(socket_handler);
+    }
+}
+
+static size_t s_message_cursor_count(struct aws_io_message *message) {
+    return message->slices ? message->slices->slice_count : 1;
+}
+
+static size_t s_gather_message_cursors(struct aws_io_message *message, struct aws_byte_cursor *cursors) {
+    if (!message->slices) {
+        cursors[0] = aws_byte_cursor_from_buf(&message->message_data);
+        return 1;
+    }
+
+    size_t cursor_count = 0;
+    struct aws_linked_list *slices = &message->slices->slices;
+    for (struct aws_linked_list_node *node = aws_linked_list_begin(slices); node != aws_linked_list_end(slices);
+         node = aws_linked_list_next(node)) {
+        cursors[cursor_count++] = AWS_CONTAINER_OF(node, struct aws_io_slice, node)->cursor;
+    }
+    return cursor_count;
+}
+
+/*
+ * Hands every message in the list to the socket in a single vectored write. On success the messages belong to the
+ * socket until the write completes, on failure they're left in the list.
+ */
+static int s_socket_write_messages(
+    struct socket_handler *socket_handler,
+    struct aws_allocator *allocator,
+    struct aws_linked_list *messages) {
+
+    size_t total_cursors = 0;
+    for (struct aws_linked_list_node *node = aws_linked_list_begin(messages); node != aws_linked_list_end(messages);
+         node = aws_linked_list_next(node)) {
+        total_cursors += s_message_cursor_count(AWS_CONTAINER_OF(node, struct aws_io_message, queueing_handle));
+    }
+
+    struct aws_byte_cursor stack_cursors[STACK_WRITE_CURSORS];
+    struct aws_byte_cursor *cursors = stack_cursors;
+    struct socket_write_batch *batch = NULL;
+    if (total_cursors > STACK_WRITE_CURSORS) {
+        if (!aws_mem_acquire_many(
+                allocator,
+                2,
+                &batch,
+                sizeof(struct socket_write_batch),
+                &cursors,
+                total_cursors * sizeof(struct aws_byte_cursor))) {
+            return AWS_OP_ERR;
+        }
+    } else {
+        batch = aws_mem_calloc(allocator, 1, sizeof(struct socket_write_batch));
+        if (!batch) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    batch->allocator = allocator;
+    aws_linked_list_init(&batch->messages);
+
+    size_t cursor_count = 0;
+    for (struct aws_linked_list_node *node = aws_linked_list_begin(messages); node != aws_linked_list_end(messages);
+         node = aws_linked_list_next(node)) {
+        struct aws_io_message *message = AWS_CONTAINER_OF(node, struct aws_io_message, queueing_handle);
+        cursor_count += s_gather_message_cursors(message, &cursors[cursor_count]);
+    }
+
+    int result = AWS_OP_SUCCESS;
+    if (cursor_count == 0) {
+        struct aws_byte_cursor empty;
+        AWS_ZERO_STRUCT(empty);
+        result = aws_socket_write(socket_handler->socket, &empty, s_on_socket_batch_write_complete, batch);
+    } else {
+        result =
+            aws_socket_writev(socket_handler->socket, cursors, cursor_count, s_on_socket_batch_write_complete, batch);
+    }
+
+    if (result) {
+        aws_mem_release(allocator, batch);
+        return AWS_OP_ERR;
+    }
+
+    /* the cursors have been copied into the write request, the batch now just tracks the messages to complete */
+    aws_linked_list_move_all_back(&batch->messages, messages);
+    socket_handler->pending_socket_writes += 1;
+    socket_handler->stats.write_requests += 1;
+    return AWS_OP_SUCCESS;
+}
+
+/* Hands every slice of a scatter-gather message to the socket in a single vectored write. */
+static int s_socket_write_sliced_message(struct socket_handler *socket_handler, struct aws_io_message *message) {
+    struct aws_io_slice_chain *chain = message->slices;
+
+    struct aws_byte_cursor stack_cursors[STACK_WRITE_CURSORS];
+    struct aws_byte_cursor *cursors = stack_cursors;
+    if (chain->slice_count > STACK_WRITE_CURSORS) {
+        cursors = aws_mem_acquire(chain->allocator, chain->slice_count * sizeof(struct aws_byte_cursor));
+        if (!cursors) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    size_t cursor_count = s_gather_message_cursors(message, cursors);
+
+    int result = AWS_OP_SUCCESS;
+    if (cursor_count == 0) {
+        struct aws_byte_cursor empty;
+        AWS_ZERO_STRUCT(empty);
+        result = aws_socket_write(socket_handler->socket, &empty, s_on_socket_write_complete, message);
+    } else {
+        result =
+            aws_socket_writev(socket_handler->socket, cursors, cursor_count, s_on_socket_write_complete, message);
+    }
+
+    if (cursors != stack_cursors) {
+        aws_mem_release(chain->allocator, cursors);
+    }
+
+    if (result == AWS_OP_SUCCESS) {
+        socket_handler->pending_socket_writes += 1;
+        socket_handler->stats.write_requests += 1;
     }
+
+    return result;
 }
 
 static int s_socket_process_write_message(
     struct aws_channel_handler *handler,
     struct aws_channel_slot *slot,
     struct aws_io_message *message) {
-    (void)slot;
     struct socket_handler *socket_handler = handler->impl;
+    size_t message_len = s_message_write_len(message);
 
     AWS_LOGF_TRACE(
         AWS_LS_IO_SOCKET_HANDLER,
         "id=%p: writing message of size %llu",
         (void *)handler,
-        (unsigned long long)message->message_data.len);
+        (unsigned long long)message_len);
 
     if (!aws_socket_is_open(socket_handler->socket)) {
         return aws_raise_error(AWS_IO_SOCKET_CLOSED);
     }
 
-    struct aws_byte_cursor cursor = aws_byte_cursor_from_buf(&message->message_data);
-    if (aws_socket_write(socket_handler->socket, &cursor, s_on_socket_write_complete, message)) {
+    /* sliced messages don't come from a channel's pool, completion needs to know where they were written */
+    if (!message->owning_channel) {
+        message->owning_channel = slot->channel;
+    }
+
+    if (socket_handler->write_corked) {
+        aws_linked_list_push_back(&socket_handler->corked_writes, &message->queueing_handle);
+        aws_channel_increment_pending_write_bytes(slot->channel, message_len);
+        return AWS_OP_SUCCESS;
+    }
+
+    if (message->slices) {
+        if (s_socket_write_sliced_message(socket_handler, message)) {
+            return AWS_OP_ERR;
+        }
+    } else {
+        struct aws_byte_cursor cursor = aws_byte_cursor_from_buf(&message->message_data);
+        if (aws_socket_write(socket_handler->socket, &cursor, s_on_socket_write_complete, message)) {
+            return AWS_OP_ERR;
+        }
+        socket_handler->pending_socket_writes += 1;
+        socket_handler->stats.write_requests += 1;
+    }
+
+    /* the write completes asynchronously, so it's still pending here */
+    aws_channel_increment_pending_write_bytes(slot->channel, message_len);
+    return AWS_OP_SUCCESS;
+}
+
+static int s_socket_process_write_messages(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    struct aws_linked_list *messages) {
+    struct socket_handler *socket_handler = handler->impl;
+
+    if (!aws_socket_is_open(socket_handler->socket)) {
+        return aws_raise_error(AWS_IO_SOCKET_CLOSED);
+    }
+
+    size_t batch_len = 0;
+    for (struct aws_linked_list_node *node = aws_linked_list_begin(messages); node != aws_linked_list_end(messages);
+         node = aws_linked_list_next(node)) {
+        struct aws_io_message *message = AWS_CONTAINER_OF(node, struct aws_io_message, queueing_handle);
+        if (!message->owning_channel) {
+            message->owning_channel = slot->channel;
+        }
+        batch_len += s_message_write_len(message);
+    }
+
+    if (socket_handler->write_corked) {
+        aws_linked_list_move_all_back(&socket_handler->corked_writes, messages);
+    } else if (s_socket_write_messages(socket_handler, handler->alloc, messages)) {
         return AWS_OP_ERR;
     }
 
+    aws_channel_increment_pending_write_bytes(slot->channel, batch_len);
+    return AWS_OP_SUCCESS;
+}
+
+/* completes messages that will never be written, e.g. corked writes still pending when the socket closes. */
+static void s_fail_pending_writes(struct aws_linked_list *messages, int error_code) {
+    while (!aws_linked_list_empty(messages)) {
+        struct aws_io_message *message =
+            AWS_CONTAINER_OF(aws_linked_list_pop_front(messages), struct aws_io_message, queueing_handle);
+        struct aws_channel *channel = message->owning_channel;
+        size_t message_len = s_message_write_len(message);
+
+        if (message->on_completion) {
+            message->on_completion(channel, message, error_code, message->user_data);
+        }
+
+        aws_mem_release(message->allocator, message);
+        aws_channel_decrement_pending_write_bytes(channel, message_len);
+    }
+}
+
+static int s_socket_flush_corked_writes(struct aws_channel_handler *handler) {
+    struct socket_handler *socket_handler = handler->impl;
+
+    if (aws_linked_list_empty(&socket_handler->corked_writes)) {
+        return AWS_OP_SUCCESS;
+    }
+
+    AWS_LOGF_TRACE(AWS_LS_IO_SOCKET_HANDLER, "id=%p: flushing corked writes", (void *)handler);
+
+    if (!aws_socket_is_open(socket_handler->socket)) {
+        s_fail_pending_writes(&socket_handler->corked_writes, AWS_IO_SOCKET_CLOSED);
+        return aws_raise_error(AWS_IO_SOCKET_CLOSED);
+    }
+
+    if (s_socket_write_messages(socket_handler, handler->alloc, &socket_handler->corked_writes)) {
+        int error_code = aws_last_error();
+        s_fail_pending_writes(&socket_handler->corked_writes, error_code);
+        return aws_raise_error(error_code);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_socket_set_write_cork(struct aws_channel_handler *handler, struct aws_channel_slot *slot, bool corked) {
+    (void)slot;
+    struct socket_handler *socket_handler = handler->impl;
+
+    AWS_LOGF_TRACE(AWS_LS_IO_SOCKET_HANDLER, "id=%p: writes %s", (void *)handler, corked ? "corked" : "uncorked");
+
+    socket_handler->write_corked = corked;
+    if (!corked) {
+        return s_socket_flush_corked_writes(handler);
+    }
+
     return AWS_OP_SUCCESS;
 }
 
@@ -109,12 +461,116 @@ static void s_read_task(struct aws_channel_task *task, void *arg, aws_task_statu
 
 static void s_on_readable_notification(struct aws_socket *socket, int error_code, void *user_data);
 
+static void s_read_budget_removed(struct aws_event_loop_local_object *object) {
+    struct socket_read_budget *read_budget = object->object;
+    aws_mem_release(read_budget->allocator, object);
+}
+
+/*
+ * The event loop's shared read budget, created on first use. It outlives the channel, so it's allocated with the
+ * socket's allocator rather than the handler's, which may be the channel's arena.
+ */
+static struct socket_read_budget *s_read_budget_get(struct socket_handler *socket_handler) {
+    struct aws_channel *channel = socket_handler->slot->channel;
+
+    struct aws_event_loop_local_object existing;
+    AWS_ZERO_STRUCT(existing);
+    if (aws_channel_fetch_local_object(channel, &s_read_budget_key, &existing) == AWS_OP_SUCCESS) {
+        return existing.object;
+    }
+
+    struct aws_allocator *allocator = socket_handler->socket->allocator;
+    struct aws_event_loop_local_object *object = NULL;
+    struct socket_read_budget *read_budget = NULL;
+    if (!aws_mem_acquire_many(
+            allocator,
+            2,
+            &object,
+            sizeof(struct aws_event_loop_local_object),
+            &read_budget,
+            sizeof(struct socket_read_budget))) {
+        return NULL;
+    }
+
+    AWS_ZERO_STRUCT(*read_budget);
+    read_budget->allocator = allocator;
+    read_budget->loop_budget = LOOP_READ_BUDGET_INITIAL;
+
+    object->key = &s_read_budget_key;
+    object->object = read_budget;
+    object->on_object_removed = s_read_budget_removed;
+    if (aws_channel_put_local_object(channel, &s_read_budget_key, object)) {
+        aws_mem_release(allocator, object);
+        return NULL;
+    }
+
+    return read_budget;
+}
+
+/* this socket's share of the loop budget for this tick, bounded by its max_read_size */
+static size_t s_read_budget_for_tick(struct socket_handler *socket_handler) {
+    if (!socket_handler->read_budget) {
+        socket_handler->read_budget = s_read_budget_get(socket_handler);
+        if (!socket_handler->read_budget) {
+            return socket_handler->max_rw_size;
+        }
+    }
+
+    struct socket_read_budget *read_budget = socket_handler->read_budget;
+    size_t busy_sockets = read_budget->busy_sockets + (socket_handler->read_budget_exhausted ? 0 : 1);
+    size_t share = read_budget->loop_budget / busy_sockets;
+
+    size_t min_budget = aws_max_size(1, socket_handler->max_rw_size >> READ_BUDGET_MIN_SHIFT);
+    size_t max_budget = aws_mul_size_saturating(socket_handler->max_rw_size, (size_t)1 << READ_BUDGET_MAX_SHIFT);
+    return aws_max_size(min_budget, aws_min_size(share, max_budget));
+}
+
+/* tracks whether this socket is one of the loop's busy sockets, i.e. whether it used up its budget last time. */
+static void s_set_read_budget_exhausted(struct socket_handler *socket_handler, bool exhausted) {
+    if (socket_handler->read_budget_exhausted == exhausted) {
+        return;
+    }
+
+    socket_handler->read_budget_exhausted = exhausted;
+    if (socket_handler->read_budget) {
+        if (exhausted) {
+            socket_handler->read_budget->busy_sockets += 1;
+        } else {
+            socket_handler->read_budget->busy_sockets -= 1;
+        }
+    }
+}
+
+/*
+ * Called when a socket that yielded gets its next turn. A long wait means the loop's ticks are slow, so every busy
+ * socket reads less, a short one means there's room for them to read more.
+ */
+static void s_on_read_turn(struct socket_handler *socket_handler) {
+    struct socket_read_budget *read_budget = socket_handler->read_budget;
+    uint64_t now = 0;
+    if (!read_budget || aws_channel_current_clock_time(socket_handler->slot->channel, &now)) {
+        return;
+    }
+
+    uint64_t delay = now > socket_handler->yield_timestamp ? now - socket_handler->yield_timestamp : 0;
+    read_budget->read_delay_ns = read_budget->read_delay_ns - read_budget->read_delay_ns / 8 + delay / 8;
+
+    if (read_budget->read_delay_ns > READ_DELAY_TARGET_NS) {
+        read_budget->loop_budget = aws_max_size(LOOP_READ_BUDGET_MIN, read_budget->loop_budget / 2);
+    } else if (read_budget->read_delay_ns < READ_DELAY_TARGET_NS / 4) {
+        read_budget->loop_budget =
+            aws_min_size(LOOP_READ_BUDGET_MAX, read_budget->loop_budget + read_budget->loop_budget / 4);
+    }
+}
+
 /* Ok this next function is VERY important for how back pressure works. Here's what it's supposed to be doing:
  *
  * See how much data downstream is willing to accept.
- * See how much we're actually willing to read per event loop tick (usually 16 kb).
+ * See how much we're actually willing to read per event loop tick. That's this socket's share of the event loop's read
+ * budget, see s_read_budget_for_tick().
  * Take the minimum of those two.
- * Try and read as much as possible up to the calculated max read.
+ * Try and read as much as possible up to the calculated max read, scattering each read across as many pool messages
+ * as it takes.
  * If we didn't read up to the max_read, we go back to waiting on the event loop to tell us we can read more.
  * If we did read up to the max_read, we stop reading immediately and wait for either for a window update,
  * or schedule a task to enforce fairness for other sockets in the event loop if we read up to the max
@@ -123,8 +579,9 @@ static void s_on_readable_notification(struct aws_socket *socket, int error_code
 static void s_do_read(struct socket_handler *socket_handler) {
 
     size_t downstream_window = aws_channel_slot_downstream_read_window(socket_handler->slot);
-    size_t max_to_read =
-        downstream_window > socket_handler->max_rw_size ? socket_handler->max_rw_size : downstream_window;
+    size_t read_budget = s_read_budget_for_tick(socket_handler);
+    size_t max_to_read = downstream_window > read_budget ? read_budget : downstream_window;
+    socket_handler->stats.read_budget = read_budget;
 
     AWS_LOGF_TRACE(
         AWS_LS_IO_SOCKET_HANDLER,
@@ -134,35 +591,83 @@ static void s_do_read(struct socket_handler *socket_handler) {
         (unsigned long long)max_to_read);
 
     if (max_to_read == 0) {
+        s_set_read_budget_exhausted(socket_handler, false);
         return;
     }
 
+    /* everything read on this tick goes downstream as a single batch, once reading stops. */
+    struct aws_linked_list messages;
+    aws_linked_list_init(&messages);
+
     size_t total_read = 0;
-    size_t read = 0;
+    int last_error = AWS_ERROR_SUCCESS;
+    /* after a short read, the socket's most likely drained: only probe for more with a single message */
+    bool short_read = false;
     while (total_read < max_to_read && !socket_handler->shutdown_in_progress) {
-        size_t iter_max_read = max_to_read - total_read;
+        struct aws_io_message *batch[MAX_READ_MESSAGES];
+        struct aws_byte_buf buffers[MAX_READ_MESSAGES];
+        size_t batch_count = 0;
+        size_t batch_capacity = 0;
+        size_t max_batch_count = short_read ? 1 : MAX_READ_MESSAGES;
+
+        /* if the next handler lends us its own storage, fill that first and save it a copy */
+        struct aws_io_message *lent =
+            aws_channel_slot_borrow_read_buffer(socket_handler->slot, max_to_read - total_read);
+        if (lent) {
+            batch[0] = lent;
+            buffers[0] = lent->message_data;
+            buffers[0].capacity = aws_min_size(buffers[0].capacity, buffers[0].len + max_to_read - total_read);
+            batch_capacity = buffers[0].capacity - buffers[0].len;
+            batch_count = 1;
+        }
 
-        struct aws_io_message *message = aws_channel_acquire_message_from_pool(
-            socket_handler->slot->channel, AWS_IO_MESSAGE_APPLICATION_DATA, iter_max_read);
+        while (batch_count < max_batch_count && total_read + batch_capacity < max_to_read) {
+            struct aws_io_message *message = aws_channel_acquire_message_from_pool(
+                socket_handler->slot->channel,
+                AWS_IO_MESSAGE_APPLICATION_DATA,
+                max_to_read - total_read - batch_capacity);
+            if (!message) {
+                break;
+            }
 
-        if (!message) {
-            break;
+            batch[batch_count] = message;
+            buffers[batch_count] = message->message_data;
+            batch_capacity += message->message_data.capacity - message->message_data.len;
+            batch_count += 1;
         }
 
-        if (aws_socket_read(socket_handler->socket, &message->message_data, &read)) {
-            aws_mem_release(message->allocator, message);
+        if (batch_count == 0) {
+            last_error = aws_last_error();
             break;
         }
 
+        size_t read = 0;
+        int read_result = aws_socket_readv(socket_handler->socket, buffers, batch_count, &read);
+        if (read_result) {
+            last_error = aws_last_error();
+        }
+
+        for (size_t i = 0; i < batch_count; ++i) {
+            struct aws_io_message *message = batch[i];
+            bool filled = buffers[i].len > message->message_data.len;
+            message->message_data.len = buffers[i].len;
+            if (filled) {
+                aws_linked_list_push_back(&messages, &message->queueing_handle);
+            } else {
+                aws_mem_release(message->allocator, message);
+            }
+        }
+
         total_read += read;
+        short_read = read < batch_capacity;
         AWS_LOGF_TRACE(
             AWS_LS_IO_SOCKET_HANDLER,
-            "id=%p: read %llu from socket",
+            "id=%p: read %llu from socket into %llu messages",
             (void *)socket_handler->slot->handler,
-            (unsigned long long)read);
+            (unsigned long long)read,
+            (unsigned long long)batch_count);
 
-        if (aws_channel_slot_send_message(socket_handler->slot, message, AWS_CHANNEL_DIR_READ)) {
-            aws_mem_release(message->allocator, message);
+        if (read_result) {
             break;
         }
     }
@@ -175,9 +680,25 @@ static void s_do_read(struct socket_handler *socket_handler) {
 
     socket_handler->stats.bytes_read += total_read;
 
+    /* only a socket that used up its budget and still has more to read competes for the next tick */
+    s_set_read_budget_exhausted(socket_handler, !socket_handler->shutdown_in_progress && total_read == read_budget);
+
+    if (aws_channel_slot_send_messages(socket_handler->slot, &messages, AWS_CHANNEL_DIR_READ)) {
+        int send_error = aws_last_error();
+        while (!aws_linked_list_empty(&messages)) {
+            struct aws_io_message *message =
+                AWS_CONTAINER_OF(aws_linked_list_pop_front(&messages), struct aws_io_message, queueing_handle);
+            aws_mem_release(message->allocator, message);
+        }
+
+        if (!socket_handler->shutdown_in_progress) {
+            aws_channel_shutdown(socket_handler->slot->channel, send_error);
+        }
+        return;
+    }
+
     /* resubscribe as long as there's no error, just return if we're in a would block scenario. */
     if (total_read < max_to_read) {
-        int last_error = aws_last_error();
 
         if (last_error != AWS_IO_READ_WOULD_BLOCK && !socket_handler->shutdown_in_progress) {
             aws_channel_shutdown(socket_handler->slot->channel, last_error);
@@ -192,14 +713,20 @@ static void s_do_read(struct socket_handler *socket_handler) {
     }
     /* in this case, everything was fine, but there's still pending reads. We need to schedule a task to do the read
      * again. */
-    if (!socket_handler->shutdown_in_progress && total_read == socket_handler->max_rw_size &&
-        !socket_handler->read_task_storage.task_fn) {
+    if (!socket_handler->read_budget_exhausted) {
+        return;
+    }
 
+    socket_handler->stats.read_budget_exhausted_count += 1;
+    aws_channel_current_clock_time(socket_handler->slot->channel, &socket_handler->yield_timestamp);
+
+    if (!socket_handler->read_task_storage.task_fn) {
         AWS_LOGF_TRACE(
             AWS_LS_IO_SOCKET_HANDLER,
             "id=%p: more data is pending read, but we've exceeded "
-            "the max read on this tick. Scheduling a task to read on next tick.",
-            (void *)socket_handler->slot->handler);
+            "the read budget of %llu on this tick. Scheduling a task to read on next tick.",
+            (void *)socket_handler->slot->handler,
+            (unsigned long long)read_budget);
         aws_channel_task_init(
             &socket_handler->read_task_storage, s_read_task, socket_handler, "socket_handler_re_read");
         aws_channel_schedule_task_now(socket_handler->slot->channel, &socket_handler->read_task_storage);
@@ -232,6 +759,9 @@ static void s_read_task(struct aws_channel_task *task, void *arg, aws_task_statu
 
     if (status == AWS_TASK_STATUS_RUN_READY) {
         struct socket_handler *socket_handler = arg;
+        if (socket_handler->read_budget_exhausted) {
+            s_on_read_turn(socket_handler);
+        }
         s_do_read(socket_handler);
     }
 }
@@ -278,6 +808,49 @@ static void s_close_task(struct aws_channel_task *task, void *arg, aws_task_stat
         socket_handler->slot, AWS_CHANNEL_DIR_WRITE, socket_handler->shutdown_err_code, false);
 }
 
+/* Closes the socket and completes write shutdown on the next tick, in case a do_read task is currently pending. */
+static void s_finish_write_shutdown(struct socket_handler *socket_handler) {
+    socket_handler->close_when_writes_drain = false;
+
+    if (aws_socket_is_open(socket_handler->socket)) {
+        aws_socket_close(socket_handler->socket);
+    }
+
+    /* It's OK to delay the shutdown, even when free_scarce_resources_immediately is true,
+     * because the socket has been closed: mitigating the risk that the socket is still being abused by
+     * a hostile peer. */
+    aws_channel_task_init(
+        &socket_handler->shutdown_task_storage, s_close_task, socket_handler->slot->handler, "socket_handler_close");
+    aws_channel_schedule_task_now(socket_handler->slot->channel, &socket_handler->shutdown_task_storage);
+}
+
+static void s_on_socket_write_drained(struct socket_handler *socket_handler) {
+    AWS_ASSERT(socket_handler->pending_socket_writes > 0);
+    socket_handler->pending_socket_writes -= 1;
+
+    if (socket_handler->close_when_writes_drain && socket_handler->pending_socket_writes == 0) {
+        AWS_LOGF_TRACE(
+            AWS_LS_IO_SOCKET_HANDLER,
+            "id=%p: pending writes drained, closing socket",
+            (void *)socket_handler->slot->handler);
+        s_finish_write_shutdown(socket_handler);
+    }
+}
+
+static void s_drain_timeout_task(struct aws_channel_task *task, void *arg, aws_task_status status) {
+    (void)task;
+    struct socket_handler *socket_handler = arg;
+
+    if (status == AWS_TASK_STATUS_RUN_READY && socket_handler->close_when_writes_drain) {
+        AWS_LOGF_DEBUG(
+            AWS_LS_IO_SOCKET_HANDLER,
+            "id=%p: timed out waiting on %llu pending writes, closing socket",
+            (void *)socket_handler->slot->handler,
+            (unsigned long long)socket_handler->pending_socket_writes);
+        s_finish_write_shutdown(socket_handler);
+    }
+}
+
 static int s_socket_shutdown(
     struct aws_channel_handler *handler,
     struct aws_channel_slot *slot,
@@ -287,6 +860,7 @@ static int s_socket_shutdown(
     struct socket_handler *socket_handler = (struct socket_handler *)handler->impl;
 
     socket_handler->shutdown_in_progress = true;
+    s_set_read_budget_exhausted(socket_handler, false);
     if (dir == AWS_CHANNEL_DIR_READ) {
         AWS_LOGF_TRACE(
             AWS_LS_IO_SOCKET_HANDLER,
@@ -307,17 +881,41 @@ static int s_socket_shutdown(
         "id=%p: shutting down write direction with error_code %d",
         (void *)handler,
         error_code);
-    if (aws_socket_is_open(socket_handler->socket)) {
-        aws_socket_close(socket_handler->socket);
-    }
 
-    /* Schedule a task to complete the shutdown, in case a do_read task is currently pending.
-     * It's OK to delay the shutdown, even when free_scarce_resources_immediately is true,
-     * because the socket has been closed: mitigating the risk that the socket is still being abused by
-     * a hostile peer. */
-    aws_channel_task_init(&socket_handler->shutdown_task_storage, s_close_task, handler, "socket_handler_close");
+    /* give anything still corked a chance to go out, unless we're dropping the connection on the floor */
+    socket_handler->write_corked = false;
+    if (!free_scarce_resource_immediately) {
+        s_socket_flush_corked_writes(handler);
+    }
+    s_fail_pending_writes(&socket_handler->corked_writes, AWS_IO_SOCKET_CLOSED);
     socket_handler->shutdown_err_code = error_code;
-    aws_channel_schedule_task_now(slot->channel, &socket_handler->shutdown_task_storage);
+
+    /*
+     * Closing the socket fails whatever it hasn't sent yet, including the flush above. Unless the connection is being
+     * dropped, wait for those writes to complete first, but not forever: the peer may have stopped reading.
+     */
+    uint64_t now = 0;
+    if (!free_scarce_resource_immediately && socket_handler->pending_socket_writes > 0 &&
+        aws_socket_is_open(socket_handler->socket) && !aws_channel_current_clock_time(slot->channel, &now)) {
+        AWS_LOGF_TRACE(
+            AWS_LS_IO_SOCKET_HANDLER,
+            "id=%p: waiting on %llu pending writes before closing socket",
+            (void *)handler,
+            (unsigned long long)socket_handler->pending_socket_writes);
+        socket_handler->close_when_writes_drain = true;
+        aws_channel_task_init(
+            &socket_handler->drain_timeout_task_storage,
+            s_drain_timeout_task,
+            socket_handler,
+            "socket_handler_drain_timeout");
+        aws_channel_schedule_task_future(
+            slot->channel,
+            &socket_handler->drain_timeout_task_storage,
+            aws_add_u64_saturating(now, WRITE_DRAIN_TIMEOUT_NS));
+        return AWS_OP_SUCCESS;
+    }
+
+    s_finish_write_shutdown(socket_handler);
     return AWS_OP_SUCCESS;
 }
 
@@ -335,6 +933,8 @@ static void s_socket_destroy(struct aws_channel_handler *handler) {
     if (handler != NULL) {
         struct socket_handler *socket_handler = (struct socket_handler *)handler->impl;
         if (socket_handler != NULL) {
+            s_fail_pending_writes(&socket_handler->corked_writes, AWS_IO_SOCKET_CLOSED);
+            s_set_read_budget_exhausted(socket_handler, false);
             aws_crt_statistics_socket_cleanup(&socket_handler->stats);
         }
 
@@ -359,6 +959,8 @@ static struct aws_channel_handler_vtable s_vtable = {
     .process_read_message = s_socket_process_read_message,
     .destroy = s_socket_destroy,
     .process_write_message = s_socket_process_write_message,
+    .process_write_messages = s_socket_process_write_messages,
+    .set_write_cork = s_socket_set_write_cork,
     .initial_window_size = s_socket_initial_window_size,
     .increment_read_window = s_socket_increment_read_window,
     .shutdown = s_socket_shutdown,
@@ -386,12 +988,12 @@ struct aws_channel_handler *aws_socket_handler_new(
         return NULL;
     }
 
+    /* aws_mem_acquire_many() doesn't zero, and most of the state starts out empty */
+    AWS_ZERO_STRUCT(*impl);
     impl->socket = socket;
     impl->slot = slot;
     impl->max_rw_size = max_read_size;
-    AWS_ZERO_STRUCT(impl->read_task_storage);
-    AWS_ZERO_STRUCT(impl->shutdown_task_storage);
-    impl->shutdown_in_progress = false;
+    aws_linked_list_init(&impl->corked_writes);
     if (aws_crt_statistics_socket_init(&impl->stats)) {
         goto cleanup_handler;
     }
@@ -22,12 +22,15 @@ void aws_crt_statistics_socket_cleanup(struct aws_crt_statistics_socket *stats)
 void aws_crt_statistics_socket_reset(struct aws_crt_statistics_socket *stats) {
     stats->bytes_read = 0;
     stats->bytes_written = 0;
+    stats->read_budget_exhausted_count = 0;
+    stats->write_requests = 0;
 }
 
 int aws_crt_statistics_tls_init(struct aws_crt_statistics_tls *stats) {
     AWS_ZERO_STRUCT(*stats);
     stats->category = AWSCRT_STAT_CAT_TLS;
     stats->handshake_status = AWS_TLS_NEGOTIATION_STATUS_NONE;
+    stats->protocol_version = AWS_IO_TLS_VER_SYS_DEFAULTS;
 
     return AWS_OP_SUCCESS;
 }
@@ -37,8 +40,27 @@ void aws_crt_statistics_tls_cleanup(struct aws_crt_statistics_tls *stats) {
 }
 
 void aws_crt_statistics_tls_reset(struct aws_crt_statistics_tls *stats) {
-    /*
-     * We currently don't have any resettable tls statistics yet, but they may be added in the future.
-     */
+    stats->records_encrypted = 0;
+    stats->bytes_encrypted = 0;
+    stats->records_decrypted = 0;
+    stats->bytes_decrypted = 0;
+    stats->blocked_on_read_count = 0;
+    stats->blocked_on_write_count = 0;
+}
+
+int aws_crt_statistics_channel_init(struct aws_crt_statistics_channel *stats) {
+    AWS_ZERO_STRUCT(*stats);
+    stats->category = AWSCRT_STAT_CAT_CHANNEL;
+    stats->read_window_size = SIZE_MAX;
+
+    return AWS_OP_SUCCESS;
+}
+
+void aws_crt_statistics_channel_cleanup(struct aws_crt_statistics_channel *stats) {
     (void)stats;
 }
+
+void aws_crt_statistics_channel_reset(struct aws_crt_statistics_channel *stats) {
+    stats->read_window_grow_count = 0;
+    stats->read_window_shrink_count = 0;
+}
@@ -279,6 +279,45 @@ void aws_tls_ctx_options_set_minimum_tls_version(
     options->minimum_tls_version = minimum_tls_version;
 }
 
+void aws_tls_ctx_options_set_write_coalescing(
+    struct aws_tls_ctx_options *options,
+    size_t threshold,
+    uint32_t max_delay_ms) {
+    options->write_coalescing_threshold = threshold;
+    options->write_coalescing_max_delay_ms = max_delay_ms;
+}
+
+void aws_tls_ctx_options_set_record_size_policy(
+    struct aws_tls_ctx_options *options,
+    enum aws_tls_record_size_policy policy) {
+    options->record_size_policy = policy;
+}
+
+void aws_tls_ctx_options_set_dynamic_record_sizing(
+    struct aws_tls_ctx_options *options,
+    uint32_t resize_threshold,
+    uint16_t idle_timeout_secs) {
+    options->record_size_policy = AWS_IO_TLS_RECORD_SIZE_DYNAMIC;
+    options->dynamic_record_resize_threshold = resize_threshold;
+    options->dynamic_record_idle_timeout_secs = idle_timeout_secs;
+}
+
+void aws_tls_ctx_options_set_session_resumption(struct aws_tls_ctx_options *options, bool enabled) {
+    options->enable_session_resumption = enabled;
+}
+
+void aws_tls_ctx_options_set_handshake_offload(
+    struct aws_tls_ctx_options *options,
+    size_t worker_threads,
+    size_t max_queued) {
+    options->handshake_offload_threads = worker_threads;
+    options->handshake_offload_max_queued = max_queued;
+}
+
+void aws_tls_ctx_options_set_max_early_data_size(struct aws_tls_ctx_options *options, uint32_t max_early_data_size) {
+    options->max_early_data_size = max_early_data_size;
+}
+
 int aws_tls_ctx_options_override_default_trust_store_from_path(
     struct aws_tls_ctx_options *options,
     const char *ca_path,
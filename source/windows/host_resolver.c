@@ -45,6 +45,7 @@ int aws_default_dns_resolve(
 
     for (ADDRINFOA *iter = result; iter != NULL; iter = iter->ai_next) {
         struct aws_host_address host_address;
+        AWS_ZERO_STRUCT(host_address);
         AWS_ZERO_ARRAY(address_buffer);
         host_address.allocator = allocator;
 
@@ -515,6 +515,36 @@ int aws_socket_read(struct aws_socket *socket, struct aws_byte_buf *buffer, size
     return socket_impl->vtable->read(socket, buffer, amount_read);
 }
 
+int aws_socket_readv(
+    struct aws_socket *socket,
+    struct aws_byte_buf *buffers,
+    size_t buffer_count,
+    size_t *amount_read) {
+    if (!aws_event_loop_thread_is_callers_thread(socket->event_loop)) {
+        return aws_raise_error(AWS_ERROR_IO_EVENT_LOOP_THREAD_ONLY);
+    }
+
+    AWS_ASSERT(buffer_count > 0);
+    *amount_read = 0;
+
+    /* there's no vectored read to hand these to, so fill them one at a time until the data runs out */
+    for (size_t i = 0; i < buffer_count; ++i) {
+        size_t space = buffers[i].capacity - buffers[i].len;
+        size_t read = 0;
+        if (aws_socket_read(socket, &buffers[i], &read)) {
+            /* report what was read so far, the error will come up again on the next read */
+            return *amount_read > 0 ? AWS_OP_SUCCESS : AWS_OP_ERR;
+        }
+
+        *amount_read += read;
+        if (read < space) {
+            break;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
 int aws_socket_subscribe_to_readable_events(
     struct aws_socket *socket,
     aws_socket_on_readable_fn *on_readable,
@@ -3179,6 +3209,72 @@ int aws_socket_write(
     return AWS_OP_SUCCESS;
 }
 
+/*
+ * WriteFile() takes a single buffer and has to work for named pipes as well, so vectored writes are gathered into one
+ * buffer that lives until the write completes.
+ */
+struct gathered_write {
+    struct aws_allocator *allocator;
+    struct aws_byte_buf buffer;
+    aws_socket_on_write_completed_fn *written_fn;
+    void *user_data;
+};
+
+static void s_gathered_write_completed(
+    struct aws_socket *socket,
+    int error_code,
+    size_t bytes_written,
+    void *user_data) {
+
+    struct gathered_write *gathered_write = user_data;
+    gathered_write->written_fn(socket, error_code, bytes_written, gathered_write->user_data);
+    aws_byte_buf_clean_up(&gathered_write->buffer);
+    aws_mem_release(gathered_write->allocator, gathered_write);
+}
+
+int aws_socket_writev(
+    struct aws_socket *socket,
+    const struct aws_byte_cursor *cursors,
+    size_t cursor_count,
+    aws_socket_on_write_completed_fn *written_fn,
+    void *user_data) {
+
+    if (cursor_count == 1) {
+        return aws_socket_write(socket, &cursors[0], written_fn, user_data);
+    }
+
+    size_t total_len = 0;
+    for (size_t i = 0; i < cursor_count; ++i) {
+        total_len += cursors[i].len;
+    }
+
+    struct gathered_write *gathered_write = aws_mem_calloc(socket->allocator, 1, sizeof(struct gathered_write));
+    if (!gathered_write) {
+        return AWS_OP_ERR;
+    }
+
+    gathered_write->allocator = socket->allocator;
+    gathered_write->written_fn = written_fn;
+    gathered_write->user_data = user_data;
+    if (aws_byte_buf_init(&gathered_write->buffer, socket->allocator, total_len)) {
+        aws_mem_release(socket->allocator, gathered_write);
+        return AWS_OP_ERR;
+    }
+
+    for (size_t i = 0; i < cursor_count; ++i) {
+        aws_byte_buf_write_from_whole_cursor(&gathered_write->buffer, cursors[i]);
+    }
+
+    struct aws_byte_cursor gathered = aws_byte_cursor_from_buf(&gathered_write->buffer);
+    if (aws_socket_write(socket, &gathered, s_gathered_write_completed, gathered_write)) {
+        aws_byte_buf_clean_up(&gathered_write->buffer);
+        aws_mem_release(socket->allocator, gathered_write);
+        return AWS_OP_ERR;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
 int aws_socket_get_error(struct aws_socket *socket) {
     if (socket->options.domain != AWS_SOCKET_LOCAL) {
         int connect_result;
@@ -1252,6 +1252,11 @@ static int s_process_write_message(
     AWS_ASSERT(sc_handler->negotiation_finished);
     SECURITY_STATUS status = SEC_E_OK;
 
+    if (message && message->slices) {
+        /* the payload isn't in message_data, which is all this handler knows how to encrypt */
+        return aws_raise_error(AWS_IO_CHANNEL_UNKNOWN_MESSAGE_TYPE);
+    }
+
     if (message) {
         AWS_LOGF_TRACE(
             AWS_LS_IO_TLS, "id=%p: processing ougoing message of size %zu", (void *)handler, message->message_data.len);
@@ -1601,6 +1606,22 @@ struct aws_byte_buf aws_tls_handler_server_name(struct aws_channel_handler *hand
     return sc_handler->server_name;
 }
 
+int aws_tls_handler_flush(struct aws_channel_handler *handler) {
+    /* writes are not coalesced by this implementation, so there is never anything buffered to flush. */
+    (void)handler;
+    return AWS_OP_SUCCESS;
+}
+
+void aws_tls_reload_credential_cache(void) {
+    /* credentials are not cached by this implementation, every ctx already loads them fresh. */
+}
+
+enum aws_tls_early_data_status aws_tls_handler_early_data_status(struct aws_channel_handler *handler) {
+    /* this implementation doesn't support TLS 1.3 early data. */
+    (void)handler;
+    return AWS_IO_TLS_EARLY_DATA_NOT_REQUESTED;
+}
+
 static struct aws_channel_handler_vtable s_handler_vtable = {
     .destroy = s_handler_destroy,
     .process_read_message = s_process_read_message,
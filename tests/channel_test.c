@@ -7,10 +7,12 @@
 #include <aws/common/clock.h>
 #include <aws/common/condition_variable.h>
 #include <aws/common/string.h>
+#include <aws/common/thread.h>
 
 #include <aws/io/channel.h>
 #include <aws/io/channel_bootstrap.h>
 #include <aws/io/event_loop.h>
+#include <aws/io/message_pool.h>
 #include <aws/io/socket.h>
 #include <aws/testing/aws_test_harness.h>
 
@@ -447,6 +449,1172 @@ static int s_test_channel_tasks_run(struct aws_allocator *allocator, void *ctx)
 
 AWS_TEST_CASE(channel_tasks_run, s_test_channel_tasks_run);
 
+#define CROSS_THREAD_PRODUCER_COUNT 4
+#define CROSS_THREAD_TASKS_PER_PRODUCER 1000
+
+struct cross_thread_task {
+    struct aws_channel_task task;
+    struct cross_thread_tasks_test_args *test_args;
+    size_t producer;
+    size_t sequence;
+};
+
+struct cross_thread_tasks_test_args {
+    struct aws_mutex mutex;
+    struct aws_condition_variable condvar;
+    struct aws_channel *channel;
+    struct cross_thread_task *tasks;
+    size_t next_sequence[CROSS_THREAD_PRODUCER_COUNT]; /* only touched from the channel's thread */
+    size_t tasks_run;                                   /* protected by mutex */
+    bool out_of_order;                                  /* protected by mutex */
+    bool canceled;                                      /* protected by mutex */
+};
+
+struct cross_thread_producer {
+    struct cross_thread_tasks_test_args *test_args;
+    size_t producer;
+};
+
+static void s_cross_thread_task_fn(struct aws_channel_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    struct cross_thread_task *cross_thread_task = arg;
+    struct cross_thread_tasks_test_args *test_args = cross_thread_task->test_args;
+
+    /* each producer's tasks must run in the order that producer scheduled them */
+    bool in_order = test_args->next_sequence[cross_thread_task->producer] == cross_thread_task->sequence;
+    test_args->next_sequence[cross_thread_task->producer] += 1;
+
+    aws_mutex_lock(&test_args->mutex);
+    test_args->tasks_run += 1;
+    test_args->out_of_order |= !in_order;
+    test_args->canceled |= status == AWS_TASK_STATUS_CANCELED;
+    aws_mutex_unlock(&test_args->mutex);
+    aws_condition_variable_notify_one(&test_args->condvar);
+}
+
+static void s_cross_thread_producer_fn(void *arg) {
+    struct cross_thread_producer *producer = arg;
+    struct cross_thread_tasks_test_args *test_args = producer->test_args;
+
+    for (size_t i = 0; i < CROSS_THREAD_TASKS_PER_PRODUCER; ++i) {
+        struct cross_thread_task *task = &test_args->tasks[producer->producer * CROSS_THREAD_TASKS_PER_PRODUCER + i];
+        aws_channel_schedule_task_now(test_args->channel, &task->task);
+    }
+}
+
+static bool s_cross_thread_tasks_done_pred(void *arg) {
+    struct cross_thread_tasks_test_args *test_args = arg;
+    return test_args->tasks_run == CROSS_THREAD_PRODUCER_COUNT * CROSS_THREAD_TASKS_PER_PRODUCER;
+}
+
+static int s_test_channel_cross_thread_tasks_in_order(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    struct aws_event_loop *event_loop = aws_event_loop_new_default(allocator, aws_high_res_clock_get_ticks);
+
+    ASSERT_NOT_NULL(event_loop);
+    ASSERT_SUCCESS(aws_event_loop_run(event_loop));
+
+    struct aws_channel *channel = NULL;
+
+    struct channel_setup_test_args setup_args = {
+        .error_code = 0,
+        .mutex = AWS_MUTEX_INIT,
+        .condition_variable = AWS_CONDITION_VARIABLE_INIT,
+        .setup_completed = false,
+        .shutdown_completed = false,
+    };
+
+    struct aws_channel_options args = {
+        .on_setup_completed = s_channel_setup_test_on_setup_completed,
+        .setup_user_data = &setup_args,
+        .event_loop = event_loop,
+    };
+
+    ASSERT_SUCCESS(s_channel_setup_create_and_wait(allocator, &args, &setup_args, &channel));
+
+    struct cross_thread_tasks_test_args test_args = {
+        .mutex = AWS_MUTEX_INIT,
+        .condvar = AWS_CONDITION_VARIABLE_INIT,
+        .channel = channel,
+    };
+
+    const size_t task_count = CROSS_THREAD_PRODUCER_COUNT * CROSS_THREAD_TASKS_PER_PRODUCER;
+    test_args.tasks = aws_mem_calloc(allocator, task_count, sizeof(struct cross_thread_task));
+    ASSERT_NOT_NULL(test_args.tasks);
+    for (size_t i = 0; i < task_count; ++i) {
+        struct cross_thread_task *task = &test_args.tasks[i];
+        task->test_args = &test_args;
+        task->producer = i / CROSS_THREAD_TASKS_PER_PRODUCER;
+        task->sequence = i % CROSS_THREAD_TASKS_PER_PRODUCER;
+        aws_channel_task_init(&task->task, s_cross_thread_task_fn, task, "cross_thread_task");
+    }
+
+    /* several threads hammer the channel at once */
+    struct aws_thread threads[CROSS_THREAD_PRODUCER_COUNT];
+    struct cross_thread_producer producers[CROSS_THREAD_PRODUCER_COUNT];
+    for (size_t i = 0; i < CROSS_THREAD_PRODUCER_COUNT; ++i) {
+        producers[i].test_args = &test_args;
+        producers[i].producer = i;
+        ASSERT_SUCCESS(aws_thread_init(&threads[i], allocator));
+        ASSERT_SUCCESS(aws_thread_launch(&threads[i], s_cross_thread_producer_fn, &producers[i], NULL));
+    }
+
+    for (size_t i = 0; i < CROSS_THREAD_PRODUCER_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_join(&threads[i]));
+        aws_thread_clean_up(&threads[i]);
+    }
+
+    ASSERT_SUCCESS(aws_mutex_lock(&test_args.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &test_args.condvar, &test_args.mutex, s_cross_thread_tasks_done_pred, &test_args));
+    ASSERT_FALSE(test_args.out_of_order);
+    ASSERT_FALSE(test_args.canceled);
+    ASSERT_SUCCESS(aws_mutex_unlock(&test_args.mutex));
+
+    aws_channel_destroy(channel);
+    aws_event_loop_destroy(event_loop);
+    aws_mem_release(allocator, test_args.tasks);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(channel_cross_thread_tasks_in_order, s_test_channel_cross_thread_tasks_in_order)
+
+struct max_fragment_size_test_args {
+    struct aws_mutex mutex;
+    struct aws_condition_variable condvar;
+    struct aws_channel_slot *slot;
+    struct aws_channel_task task;
+    size_t max_message_capacity; /* protected by mutex */
+    bool task_ran;               /* protected by mutex */
+};
+
+static void s_acquire_max_message_task(struct aws_channel_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    (void)status;
+    struct max_fragment_size_test_args *test_args = arg;
+
+    struct aws_io_message *message = aws_channel_slot_acquire_max_message_for_write(test_args->slot);
+
+    aws_mutex_lock(&test_args->mutex);
+    test_args->max_message_capacity = message ? message->message_data.capacity : 0;
+    test_args->task_ran = true;
+    aws_mutex_unlock(&test_args->mutex);
+    aws_condition_variable_notify_one(&test_args->condvar);
+
+    if (message) {
+        aws_mem_release(message->allocator, message);
+    }
+}
+
+static bool s_max_fragment_size_task_ran_pred(void *arg) {
+    struct max_fragment_size_test_args *test_args = arg;
+    return test_args->task_ran;
+}
+
+static int s_channel_max_message_capacity(
+    struct aws_allocator *allocator,
+    struct aws_event_loop *event_loop,
+    size_t max_fragment_size,
+    size_t *max_message_capacity) {
+
+    struct aws_channel *channel = NULL;
+
+    struct channel_setup_test_args setup_args = {
+        .error_code = 0,
+        .mutex = AWS_MUTEX_INIT,
+        .condition_variable = AWS_CONDITION_VARIABLE_INIT,
+        .setup_completed = false,
+        .shutdown_completed = false,
+    };
+
+    struct aws_channel_options args = {
+        .on_setup_completed = s_channel_setup_test_on_setup_completed,
+        .setup_user_data = &setup_args,
+        .event_loop = event_loop,
+        .max_fragment_size = max_fragment_size,
+    };
+
+    ASSERT_SUCCESS(s_channel_setup_create_and_wait(allocator, &args, &setup_args, &channel));
+    ASSERT_UINT_EQUALS(
+        max_fragment_size ? max_fragment_size : g_aws_channel_max_fragment_size,
+        aws_channel_max_fragment_size(channel));
+
+    struct max_fragment_size_test_args test_args = {
+        .mutex = AWS_MUTEX_INIT,
+        .condvar = AWS_CONDITION_VARIABLE_INIT,
+    };
+    test_args.slot = aws_channel_slot_new(channel);
+    ASSERT_NOT_NULL(test_args.slot);
+
+    aws_channel_task_init(&test_args.task, s_acquire_max_message_task, &test_args, "acquire_max_message");
+    aws_channel_schedule_task_now(channel, &test_args.task);
+
+    ASSERT_SUCCESS(aws_mutex_lock(&test_args.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &test_args.condvar, &test_args.mutex, s_max_fragment_size_task_ran_pred, &test_args));
+    *max_message_capacity = test_args.max_message_capacity;
+    ASSERT_SUCCESS(aws_mutex_unlock(&test_args.mutex));
+
+    aws_channel_destroy(channel);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_channel_max_fragment_size(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    struct aws_event_loop *event_loop = aws_event_loop_new_default(allocator, aws_high_res_clock_get_ticks);
+
+    ASSERT_NOT_NULL(event_loop);
+    ASSERT_SUCCESS(aws_event_loop_run(event_loop));
+
+    /* channels with different fragment sizes share the loop's message pool, each gets messages of its own size */
+    size_t capacity = 0;
+    ASSERT_SUCCESS(s_channel_max_message_capacity(allocator, event_loop, 0, &capacity));
+    ASSERT_UINT_EQUALS(g_aws_channel_max_fragment_size, capacity);
+
+    ASSERT_SUCCESS(s_channel_max_message_capacity(allocator, event_loop, 2 * 1024, &capacity));
+    ASSERT_UINT_EQUALS(2 * 1024, capacity);
+
+    ASSERT_SUCCESS(s_channel_max_message_capacity(allocator, event_loop, 256 * 1024, &capacity));
+    ASSERT_UINT_EQUALS(256 * 1024, capacity);
+
+    /* sizes between the pool's size classes come from the next class up */
+    ASSERT_SUCCESS(s_channel_max_message_capacity(allocator, event_loop, 5000, &capacity));
+    ASSERT_UINT_EQUALS(5000, capacity);
+
+    aws_event_loop_destroy(event_loop);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(channel_max_fragment_size, s_test_channel_max_fragment_size)
+
+struct batch_counting_handler {
+    struct aws_channel_handler handler;
+    size_t process_message_calls;
+    size_t process_messages_calls;
+    size_t messages_received;
+};
+
+static int s_batch_counting_process_read_message(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    struct aws_io_message *message) {
+    (void)slot;
+
+    struct batch_counting_handler *counting_handler = handler->impl;
+    counting_handler->process_message_calls += 1;
+    counting_handler->messages_received += 1;
+    aws_mem_release(message->allocator, message);
+    return AWS_OP_SUCCESS;
+}
+
+static int s_batch_counting_process_read_messages(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    struct aws_linked_list *messages) {
+    (void)slot;
+
+    struct batch_counting_handler *counting_handler = handler->impl;
+    counting_handler->process_messages_calls += 1;
+    while (!aws_linked_list_empty(messages)) {
+        struct aws_io_message *message =
+            AWS_CONTAINER_OF(aws_linked_list_pop_front(messages), struct aws_io_message, queueing_handle);
+        counting_handler->messages_received += 1;
+        aws_mem_release(message->allocator, message);
+    }
+    return AWS_OP_SUCCESS;
+}
+
+static int s_batch_counting_shutdown(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    enum aws_channel_direction dir,
+    int error_code,
+    bool free_scarce_resources_immediately) {
+    (void)handler;
+    return aws_channel_slot_on_handler_shutdown_complete(slot, dir, error_code, free_scarce_resources_immediately);
+}
+
+static size_t s_batch_counting_initial_window_size(struct aws_channel_handler *handler) {
+    (void)handler;
+    return 1000;
+}
+
+static size_t s_batch_counting_message_overhead(struct aws_channel_handler *handler) {
+    (void)handler;
+    return 0;
+}
+
+static void s_batch_counting_destroy(struct aws_channel_handler *handler) {
+    (void)handler;
+}
+
+static struct aws_channel_handler_vtable s_single_message_vtable = {
+    .process_read_message = s_batch_counting_process_read_message,
+    .shutdown = s_batch_counting_shutdown,
+    .initial_window_size = s_batch_counting_initial_window_size,
+    .message_overhead = s_batch_counting_message_overhead,
+    .destroy = s_batch_counting_destroy,
+};
+
+static struct aws_channel_handler_vtable s_batched_vtable = {
+    .process_read_message = s_batch_counting_process_read_message,
+    .process_read_messages = s_batch_counting_process_read_messages,
+    .shutdown = s_batch_counting_shutdown,
+    .initial_window_size = s_batch_counting_initial_window_size,
+    .message_overhead = s_batch_counting_message_overhead,
+    .destroy = s_batch_counting_destroy,
+};
+
+struct batched_send_test_args {
+    struct aws_mutex mutex;
+    struct aws_condition_variable condvar;
+    struct aws_channel_slot *slot;
+    struct aws_channel_task task;
+    int send_result;     /* protected by mutex */
+    size_t window_after; /* protected by mutex */
+    bool task_ran;       /* protected by mutex */
+};
+
+static void s_send_batch_task(struct aws_channel_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    (void)status;
+    struct batched_send_test_args *test_args = arg;
+
+    struct aws_linked_list messages;
+    aws_linked_list_init(&messages);
+    for (size_t i = 0; i < 3; ++i) {
+        struct aws_io_message *message =
+            aws_channel_acquire_message_from_pool(test_args->slot->channel, AWS_IO_MESSAGE_APPLICATION_DATA, 10);
+        struct aws_byte_cursor data = aws_byte_cursor_from_c_str("0123456789");
+        aws_byte_buf_append(&message->message_data, &data);
+        aws_linked_list_push_back(&messages, &message->queueing_handle);
+    }
+
+    int send_result = aws_channel_slot_send_messages(test_args->slot, &messages, AWS_CHANNEL_DIR_READ);
+
+    aws_mutex_lock(&test_args->mutex);
+    test_args->send_result = send_result;
+    test_args->window_after = test_args->slot->adj_right->window_size;
+    test_args->task_ran = true;
+    aws_mutex_unlock(&test_args->mutex);
+    aws_condition_variable_notify_one(&test_args->condvar);
+}
+
+static bool s_send_batch_task_ran_pred(void *arg) {
+    struct batched_send_test_args *test_args = arg;
+    return test_args->task_ran;
+}
+
+static int s_channel_send_batch(
+    struct aws_allocator *allocator,
+    struct aws_event_loop *event_loop,
+    struct batch_counting_handler *counting_handler) {
+
+    struct aws_channel *channel = NULL;
+
+    struct channel_setup_test_args setup_args = {
+        .error_code = 0,
+        .mutex = AWS_MUTEX_INIT,
+        .condition_variable = AWS_CONDITION_VARIABLE_INIT,
+        .setup_completed = false,
+        .shutdown_completed = false,
+    };
+
+    struct aws_channel_options args = {
+        .on_setup_completed = s_channel_setup_test_on_setup_completed,
+        .setup_user_data = &setup_args,
+        .event_loop = event_loop,
+        .enable_read_back_pressure = true,
+    };
+
+    ASSERT_SUCCESS(s_channel_setup_create_and_wait(allocator, &args, &setup_args, &channel));
+
+    struct batched_send_test_args test_args = {
+        .mutex = AWS_MUTEX_INIT,
+        .condvar = AWS_CONDITION_VARIABLE_INIT,
+    };
+
+    test_args.slot = aws_channel_slot_new(channel);
+    ASSERT_NOT_NULL(test_args.slot);
+    struct aws_channel_handler *sender = rw_handler_new(allocator, NULL, NULL, false, 10000, NULL);
+    ASSERT_NOT_NULL(sender);
+    ASSERT_SUCCESS(aws_channel_slot_set_handler(test_args.slot, sender));
+
+    struct aws_channel_slot *receiver_slot = aws_channel_slot_new(channel);
+    ASSERT_NOT_NULL(receiver_slot);
+    ASSERT_SUCCESS(aws_channel_slot_insert_right(test_args.slot, receiver_slot));
+    ASSERT_SUCCESS(aws_channel_slot_set_handler(receiver_slot, &counting_handler->handler));
+
+    aws_channel_task_init(&test_args.task, s_send_batch_task, &test_args, "send_batch");
+    aws_channel_schedule_task_now(channel, &test_args.task);
+
+    ASSERT_SUCCESS(aws_mutex_lock(&test_args.mutex));
+    ASSERT_SUCCESS(
+        aws_condition_variable_wait_pred(&test_args.condvar, &test_args.mutex, s_send_batch_task_ran_pred, &test_args));
+    ASSERT_SUCCESS(test_args.send_result);
+    /* the window is charged for the whole batch */
+    ASSERT_UINT_EQUALS(1000 - 30, test_args.window_after);
+    ASSERT_SUCCESS(aws_mutex_unlock(&test_args.mutex));
+
+    aws_channel_destroy(channel);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_channel_batched_read_messages(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    struct aws_event_loop *event_loop = aws_event_loop_new_default(allocator, aws_high_res_clock_get_ticks);
+
+    ASSERT_NOT_NULL(event_loop);
+    ASSERT_SUCCESS(aws_event_loop_run(event_loop));
+
+    /* a handler without process_read_messages gets the batch one message at a time */
+    struct batch_counting_handler single = {
+        .handler = {.vtable = &s_single_message_vtable, .alloc = allocator, .impl = &single},
+    };
+    ASSERT_SUCCESS(s_channel_send_batch(allocator, event_loop, &single));
+    ASSERT_UINT_EQUALS(3, single.process_message_calls);
+    ASSERT_UINT_EQUALS(0, single.process_messages_calls);
+    ASSERT_UINT_EQUALS(3, single.messages_received);
+
+    /* a handler with it gets the whole batch in one call */
+    struct batch_counting_handler batched = {
+        .handler = {.vtable = &s_batched_vtable, .alloc = allocator, .impl = &batched},
+    };
+    ASSERT_SUCCESS(s_channel_send_batch(allocator, event_loop, &batched));
+    ASSERT_UINT_EQUALS(0, batched.process_message_calls);
+    ASSERT_UINT_EQUALS(1, batched.process_messages_calls);
+    ASSERT_UINT_EQUALS(3, batched.messages_received);
+
+    aws_event_loop_destroy(event_loop);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(channel_batched_read_messages, s_test_channel_batched_read_messages)
+
+struct writability_test_handler {
+    struct aws_channel_handler handler;
+    size_t notifications;
+    bool writable;
+};
+
+static void s_writability_test_on_writability_changed(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    bool writable) {
+    (void)slot;
+
+    struct writability_test_handler *test_handler = handler->impl;
+    test_handler->notifications += 1;
+    test_handler->writable = writable;
+}
+
+static struct aws_channel_handler_vtable s_writability_test_vtable = {
+    .process_read_message = s_batch_counting_process_read_message,
+    .shutdown = s_batch_counting_shutdown,
+    .initial_window_size = s_batch_counting_initial_window_size,
+    .message_overhead = s_batch_counting_message_overhead,
+    .destroy = s_batch_counting_destroy,
+    .on_writability_changed = s_writability_test_on_writability_changed,
+};
+
+struct write_water_mark_test_args {
+    struct aws_mutex mutex;
+    struct aws_condition_variable condvar;
+    struct aws_channel *channel;
+    struct writability_test_handler *test_handler;
+    struct aws_channel_task task;
+    int result;    /* protected by mutex */
+    bool task_ran; /* protected by mutex */
+};
+
+static int s_run_write_water_marks(struct write_water_mark_test_args *test_args) {
+    struct aws_channel *channel = test_args->channel;
+    struct writability_test_handler *test_handler = test_args->test_handler;
+
+    aws_channel_increment_pending_write_bytes(channel, 60);
+    ASSERT_TRUE(aws_channel_is_writable(channel));
+    ASSERT_UINT_EQUALS(0, test_handler->notifications);
+
+    /* crossing the high water mark */
+    aws_channel_increment_pending_write_bytes(channel, 50);
+    ASSERT_FALSE(aws_channel_is_writable(channel));
+    ASSERT_UINT_EQUALS(110, aws_channel_pending_write_bytes(channel));
+    ASSERT_UINT_EQUALS(1, test_handler->notifications);
+    ASSERT_FALSE(test_handler->writable);
+
+    /* more writes while full don't notify again */
+    aws_channel_increment_pending_write_bytes(channel, 10);
+    ASSERT_UINT_EQUALS(1, test_handler->notifications);
+
+    /* draining below the high water mark isn't enough, it has to reach the low one */
+    aws_channel_decrement_pending_write_bytes(channel, 60);
+    ASSERT_FALSE(aws_channel_is_writable(channel));
+    ASSERT_UINT_EQUALS(1, test_handler->notifications);
+
+    aws_channel_decrement_pending_write_bytes(channel, 20);
+    ASSERT_TRUE(aws_channel_is_writable(channel));
+    ASSERT_UINT_EQUALS(40, aws_channel_pending_write_bytes(channel));
+    ASSERT_UINT_EQUALS(2, test_handler->notifications);
+    ASSERT_TRUE(test_handler->writable);
+
+    aws_channel_decrement_pending_write_bytes(channel, 40);
+    ASSERT_UINT_EQUALS(0, aws_channel_pending_write_bytes(channel));
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_write_water_marks_task(struct aws_channel_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    (void)status;
+    struct write_water_mark_test_args *test_args = arg;
+
+    int result = s_run_write_water_marks(test_args);
+
+    aws_mutex_lock(&test_args->mutex);
+    test_args->result = result;
+    test_args->task_ran = true;
+    aws_mutex_unlock(&test_args->mutex);
+    aws_condition_variable_notify_one(&test_args->condvar);
+}
+
+static bool s_write_water_marks_task_ran_pred(void *arg) {
+    struct write_water_mark_test_args *test_args = arg;
+    return test_args->task_ran;
+}
+
+static int s_test_channel_write_water_marks(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    struct aws_event_loop *event_loop = aws_event_loop_new_default(allocator, aws_high_res_clock_get_ticks);
+
+    ASSERT_NOT_NULL(event_loop);
+    ASSERT_SUCCESS(aws_event_loop_run(event_loop));
+
+    struct channel_setup_test_args setup_args = {
+        .error_code = 0,
+        .mutex = AWS_MUTEX_INIT,
+        .condition_variable = AWS_CONDITION_VARIABLE_INIT,
+        .setup_completed = false,
+        .shutdown_completed = false,
+    };
+
+    struct aws_channel_options args = {
+        .on_setup_completed = s_channel_setup_test_on_setup_completed,
+        .setup_user_data = &setup_args,
+        .event_loop = event_loop,
+        .write_high_water_mark = 100,
+        .write_low_water_mark = 100,
+    };
+
+    /* the low water mark has to be below the high one */
+    ASSERT_NULL(aws_channel_new(allocator, &args));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    args.write_low_water_mark = 40;
+    struct aws_channel *channel = NULL;
+    ASSERT_SUCCESS(s_channel_setup_create_and_wait(allocator, &args, &setup_args, &channel));
+    ASSERT_TRUE(aws_channel_is_writable(channel));
+
+    struct writability_test_handler test_handler = {
+        .handler = {.vtable = &s_writability_test_vtable, .alloc = allocator, .impl = &test_handler},
+        .writable = true,
+    };
+
+    struct aws_channel_slot *slot = aws_channel_slot_new(channel);
+    ASSERT_NOT_NULL(slot);
+    ASSERT_SUCCESS(aws_channel_slot_set_handler(slot, &test_handler.handler));
+
+    struct write_water_mark_test_args test_args = {
+        .mutex = AWS_MUTEX_INIT,
+        .condvar = AWS_CONDITION_VARIABLE_INIT,
+        .channel = channel,
+        .test_handler = &test_handler,
+    };
+
+    aws_channel_task_init(&test_args.task, s_write_water_marks_task, &test_args, "write_water_marks");
+    aws_channel_schedule_task_now(channel, &test_args.task);
+
+    ASSERT_SUCCESS(aws_mutex_lock(&test_args.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &test_args.condvar, &test_args.mutex, s_write_water_marks_task_ran_pred, &test_args));
+    ASSERT_SUCCESS(test_args.result);
+    ASSERT_SUCCESS(aws_mutex_unlock(&test_args.mutex));
+
+    aws_channel_destroy(channel);
+    aws_event_loop_destroy(event_loop);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(channel_write_water_marks, s_test_channel_write_water_marks)
+
+struct read_window_tuning_test_args {
+    struct aws_mutex mutex;
+    struct aws_condition_variable condvar;
+    struct aws_channel_slot *sender_slot;
+    struct aws_channel_slot *consumer_slot;
+    struct aws_channel_task task;
+    int phase;
+    int result;    /* protected by mutex */
+    bool task_ran; /* protected by mutex */
+};
+
+/* sends size bytes to the consumer in 500 byte messages, which it releases without handing the window back */
+static int s_read_window_tuning_consume(struct read_window_tuning_test_args *test_args, size_t size) {
+    struct aws_channel *channel = test_args->sender_slot->channel;
+
+    for (size_t sent = 0; sent < size; sent += 500) {
+        struct aws_io_message *message =
+            aws_channel_acquire_message_from_pool(channel, AWS_IO_MESSAGE_APPLICATION_DATA, 500);
+        ASSERT_NOT_NULL(message);
+        message->message_data.len = 500;
+        ASSERT_SUCCESS(aws_channel_slot_send_message(test_args->sender_slot, message, AWS_CHANNEL_DIR_READ));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_run_read_window_tuning_phase(struct read_window_tuning_test_args *test_args) {
+    struct aws_channel_slot *consumer_slot = test_args->consumer_slot;
+    struct aws_channel *channel = consumer_slot->channel;
+
+    switch (test_args->phase) {
+        case 0:
+            /* the consumer drains its initial window and hands it back, so it gets twice as much */
+            ASSERT_UINT_EQUALS(1000, aws_channel_read_window_size(channel));
+            ASSERT_UINT_EQUALS(1000, consumer_slot->window_size);
+            ASSERT_SUCCESS(s_read_window_tuning_consume(test_args, 1000));
+            ASSERT_SUCCESS(aws_channel_slot_increment_read_window(consumer_slot, 1000));
+            ASSERT_UINT_EQUALS(2000, aws_channel_read_window_size(channel));
+            ASSERT_UINT_EQUALS(2000, consumer_slot->current_window_update_batch_size);
+            break;
+
+        case 1:
+            /* and again, but the window stops at the max */
+            ASSERT_UINT_EQUALS(2000, consumer_slot->window_size);
+            ASSERT_SUCCESS(s_read_window_tuning_consume(test_args, 2000));
+            ASSERT_SUCCESS(aws_channel_slot_increment_read_window(consumer_slot, 2000));
+            ASSERT_UINT_EQUALS(3000, aws_channel_read_window_size(channel));
+            ASSERT_UINT_EQUALS(3000, consumer_slot->current_window_update_batch_size);
+            break;
+
+        case 2: {
+            /* a consumer that never runs dry doesn't change anything */
+            ASSERT_UINT_EQUALS(3000, consumer_slot->window_size);
+            ASSERT_SUCCESS(s_read_window_tuning_consume(test_args, 500));
+            ASSERT_SUCCESS(aws_channel_slot_increment_read_window(consumer_slot, 500));
+            ASSERT_UINT_EQUALS(3000, aws_channel_read_window_size(channel));
+            ASSERT_UINT_EQUALS(500, consumer_slot->current_window_update_batch_size);
+
+            /* holding more of the largest messages than the pool may keep in slabs makes it go to the allocator */
+            struct aws_message_pool_statistics before;
+            ASSERT_SUCCESS(aws_channel_get_message_pool_statistics(channel, &before));
+            struct aws_io_message *messages[32];
+            for (size_t i = 0; i < AWS_ARRAY_SIZE(messages); ++i) {
+                messages[i] =
+                    aws_channel_acquire_message_from_pool(channel, AWS_IO_MESSAGE_APPLICATION_DATA, 256 * 1024);
+                ASSERT_NOT_NULL(messages[i]);
+            }
+            struct aws_message_pool_statistics after;
+            ASSERT_SUCCESS(aws_channel_get_message_pool_statistics(channel, &after));
+            ASSERT_TRUE(after.fallbacks > before.fallbacks);
+            for (size_t i = 0; i < AWS_ARRAY_SIZE(messages); ++i) {
+                aws_mem_release(messages[i]->allocator, messages[i]);
+            }
+
+            /* so the window halves, and the difference is held back from what the consumer hands back */
+            ASSERT_SUCCESS(s_read_window_tuning_consume(test_args, 500));
+            ASSERT_SUCCESS(aws_channel_slot_increment_read_window(consumer_slot, 500));
+            ASSERT_UINT_EQUALS(1500, aws_channel_read_window_size(channel));
+            ASSERT_UINT_EQUALS(500, consumer_slot->current_window_update_batch_size);
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_read_window_tuning_task(struct aws_channel_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    (void)status;
+    struct read_window_tuning_test_args *test_args = arg;
+
+    int result = s_run_read_window_tuning_phase(test_args);
+
+    aws_mutex_lock(&test_args->mutex);
+    test_args->result = result;
+    test_args->task_ran = true;
+    aws_mutex_unlock(&test_args->mutex);
+    aws_condition_variable_notify_one(&test_args->condvar);
+}
+
+static bool s_read_window_tuning_task_ran_pred(void *arg) {
+    struct read_window_tuning_test_args *test_args = arg;
+    return test_args->task_ran;
+}
+
+static int s_test_channel_read_window_auto_tuning(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    struct aws_event_loop *event_loop = aws_event_loop_new_default(allocator, aws_high_res_clock_get_ticks);
+
+    ASSERT_NOT_NULL(event_loop);
+    ASSERT_SUCCESS(aws_event_loop_run(event_loop));
+
+    struct channel_setup_test_args setup_args = {
+        .error_code = 0,
+        .mutex = AWS_MUTEX_INIT,
+        .condition_variable = AWS_CONDITION_VARIABLE_INIT,
+        .setup_completed = false,
+        .shutdown_completed = false,
+    };
+
+    struct aws_channel_options args = {
+        .on_setup_completed = s_channel_setup_test_on_setup_completed,
+        .setup_user_data = &setup_args,
+        .event_loop = event_loop,
+        .max_fragment_size = 500,
+        .enable_read_window_auto_tuning = true,
+        .max_read_window_size = 3000,
+    };
+
+    /* auto-tuning only makes sense with read back pressure on */
+    ASSERT_NULL(aws_channel_new(allocator, &args));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    args.enable_read_back_pressure = true;
+    struct aws_channel *channel = NULL;
+    ASSERT_SUCCESS(s_channel_setup_create_and_wait(allocator, &args, &setup_args, &channel));
+
+    struct read_window_tuning_test_args test_args = {
+        .mutex = AWS_MUTEX_INIT,
+        .condvar = AWS_CONDITION_VARIABLE_INIT,
+    };
+
+    test_args.sender_slot = aws_channel_slot_new(channel);
+    ASSERT_NOT_NULL(test_args.sender_slot);
+    struct aws_channel_handler *sender = rw_handler_new(allocator, NULL, NULL, false, 10000, NULL);
+    ASSERT_NOT_NULL(sender);
+    ASSERT_SUCCESS(aws_channel_slot_set_handler(test_args.sender_slot, sender));
+
+    struct batch_counting_handler consumer = {
+        .handler = {.vtable = &s_single_message_vtable, .alloc = allocator, .impl = &consumer},
+    };
+    test_args.consumer_slot = aws_channel_slot_new(channel);
+    ASSERT_NOT_NULL(test_args.consumer_slot);
+    ASSERT_SUCCESS(aws_channel_slot_insert_right(test_args.sender_slot, test_args.consumer_slot));
+    ASSERT_SUCCESS(aws_channel_slot_set_handler(test_args.consumer_slot, &consumer.handler));
+
+    /* each phase runs after the window updates scheduled by the one before it */
+    for (test_args.phase = 0; test_args.phase < 3; ++test_args.phase) {
+        test_args.task_ran = false;
+        aws_channel_task_init(&test_args.task, s_read_window_tuning_task, &test_args, "read_window_tuning");
+        aws_channel_schedule_task_now(channel, &test_args.task);
+
+        ASSERT_SUCCESS(aws_mutex_lock(&test_args.mutex));
+        ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+            &test_args.condvar, &test_args.mutex, s_read_window_tuning_task_ran_pred, &test_args));
+        ASSERT_SUCCESS(test_args.result);
+        ASSERT_SUCCESS(aws_mutex_unlock(&test_args.mutex));
+    }
+
+    ASSERT_UINT_EQUALS(8, consumer.messages_received);
+
+    aws_channel_destroy(channel);
+    aws_event_loop_destroy(event_loop);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(channel_read_window_auto_tuning, s_test_channel_read_window_auto_tuning)
+
+static int s_test_channel_arena(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    struct aws_event_loop *event_loop = aws_event_loop_new_default(allocator, aws_high_res_clock_get_ticks);
+
+    ASSERT_NOT_NULL(event_loop);
+    ASSERT_SUCCESS(aws_event_loop_run(event_loop));
+
+    struct channel_setup_test_args setup_args = {
+        .error_code = 0,
+        .mutex = AWS_MUTEX_INIT,
+        .condition_variable = AWS_CONDITION_VARIABLE_INIT,
+        .setup_completed = false,
+        .shutdown_completed = false,
+    };
+
+    struct aws_channel_options args = {
+        .on_setup_completed = s_channel_setup_test_on_setup_completed,
+        .setup_user_data = &setup_args,
+        .event_loop = event_loop,
+        .arena_size = aws_channel_arena_size_hint(2, 1024),
+    };
+
+    struct aws_channel *channel = NULL;
+    ASSERT_SUCCESS(s_channel_setup_create_and_wait(allocator, &args, &setup_args, &channel));
+
+    struct aws_allocator *arena = aws_channel_get_allocator(channel);
+    ASSERT_NOT_NULL(arena);
+    ASSERT_FALSE(arena == allocator);
+
+    /* slots and handlers come out of the arena, and go away with the channel without being released one by one */
+    struct aws_channel_slot *first_slot = aws_channel_slot_new(channel);
+    ASSERT_NOT_NULL(first_slot);
+    ASSERT_TRUE(first_slot->alloc == arena);
+    struct aws_channel_handler *first_handler = rw_handler_new(arena, NULL, NULL, false, 10000, NULL);
+    ASSERT_NOT_NULL(first_handler);
+    ASSERT_SUCCESS(aws_channel_slot_set_handler(first_slot, first_handler));
+
+    struct aws_channel_slot *second_slot = aws_channel_slot_new(channel);
+    ASSERT_NOT_NULL(second_slot);
+    ASSERT_SUCCESS(aws_channel_slot_insert_right(first_slot, second_slot));
+    struct aws_channel_handler *second_handler = rw_handler_new(arena, NULL, NULL, false, 10000, NULL);
+    ASSERT_NOT_NULL(second_handler);
+    ASSERT_SUCCESS(aws_channel_slot_set_handler(second_slot, second_handler));
+
+    /* releasing the most recent allocation hands its memory straight back */
+    void *transient = aws_mem_acquire(arena, 64);
+    ASSERT_NOT_NULL(transient);
+    aws_mem_release(arena, transient);
+    void *reused = aws_mem_acquire(arena, 64);
+    ASSERT_PTR_EQUALS(transient, reused);
+    aws_mem_release(arena, reused);
+
+    /* anything that doesn't fit comes from the channel's allocator instead */
+    void *oversized = aws_mem_acquire(arena, args.arena_size + 1);
+    ASSERT_NOT_NULL(oversized);
+    aws_mem_release(arena, oversized);
+
+    aws_channel_destroy(channel);
+    aws_event_loop_destroy(event_loop);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(channel_arena, s_test_channel_arena)
+
+struct event_loop_flush_args {
+    struct aws_mutex mutex;
+    struct aws_condition_variable condvar;
+    bool ran;
+    struct aws_task task;
+};
+
+static void s_event_loop_flush_task(struct aws_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    (void)status;
+    struct event_loop_flush_args *flush_args = arg;
+
+    aws_mutex_lock(&flush_args->mutex);
+    flush_args->ran = true;
+    aws_mutex_unlock(&flush_args->mutex);
+    aws_condition_variable_notify_one(&flush_args->condvar);
+}
+
+static bool s_event_loop_flush_pred(void *arg) {
+    struct event_loop_flush_args *flush_args = arg;
+    return flush_args->ran;
+}
+
+/* waits until the tasks already scheduled on event_loop from this thread have run */
+static int s_flush_event_loop(struct aws_event_loop *event_loop) {
+    struct event_loop_flush_args flush_args = {
+        .mutex = AWS_MUTEX_INIT,
+        .condvar = AWS_CONDITION_VARIABLE_INIT,
+    };
+    aws_task_init(&flush_args.task, s_event_loop_flush_task, &flush_args, "event_loop_flush");
+    aws_event_loop_schedule_task_now(event_loop, &flush_args.task);
+
+    ASSERT_SUCCESS(aws_mutex_lock(&flush_args.mutex));
+    ASSERT_SUCCESS(
+        aws_condition_variable_wait_pred(&flush_args.condvar, &flush_args.mutex, s_event_loop_flush_pred, &flush_args));
+    ASSERT_SUCCESS(aws_mutex_unlock(&flush_args.mutex));
+    return AWS_OP_SUCCESS;
+}
+
+static int s_wait_for_recycled_count(
+    struct aws_event_loop *event_loop,
+    struct aws_channel_recycler *recycler,
+    size_t expected) {
+    /*
+     * channels are deleted by a task on their event loop, after aws_channel_destroy() returns. Every destroyed
+     * channel has to be deleted before going on, a late one would land in the recycler behind the test's back.
+     */
+    ASSERT_SUCCESS(s_flush_event_loop(event_loop));
+    for (size_t i = 0; i < 1000 && aws_channel_recycler_get_cached_count(recycler) != expected; ++i) {
+        aws_thread_current_sleep(aws_timestamp_convert(1, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL));
+    }
+
+    ASSERT_UINT_EQUALS(expected, aws_channel_recycler_get_cached_count(recycler));
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_channel_recycler(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    struct aws_event_loop *event_loop = aws_event_loop_new_default(allocator, aws_high_res_clock_get_ticks);
+
+    ASSERT_NOT_NULL(event_loop);
+    ASSERT_SUCCESS(aws_event_loop_run(event_loop));
+
+    struct aws_channel_recycler *recycler = aws_channel_recycler_new(allocator, 1);
+    ASSERT_NOT_NULL(recycler);
+
+    struct channel_setup_test_args setup_args = {
+        .error_code = 0,
+        .mutex = AWS_MUTEX_INIT,
+        .condition_variable = AWS_CONDITION_VARIABLE_INIT,
+        .setup_completed = false,
+        .shutdown_completed = false,
+    };
+
+    struct aws_channel_options args = {
+        .on_setup_completed = s_channel_setup_test_on_setup_completed,
+        .setup_user_data = &setup_args,
+        .event_loop = event_loop,
+        .arena_size = aws_channel_arena_size_hint(1, 0),
+        .recycler = recycler,
+    };
+
+    struct aws_channel *first = NULL;
+    ASSERT_SUCCESS(s_channel_setup_create_and_wait(allocator, &args, &setup_args, &first));
+    ASSERT_PTR_EQUALS(recycler, aws_channel_get_recycler(first));
+    ASSERT_NOT_NULL(aws_channel_slot_new(first));
+    struct aws_channel *second = NULL;
+    setup_args.setup_completed = false;
+    ASSERT_SUCCESS(s_channel_setup_create_and_wait(allocator, &args, &setup_args, &second));
+
+    /* the recycler only keeps one, the other is freed as usual */
+    aws_channel_destroy(first);
+    aws_channel_destroy(second);
+    ASSERT_SUCCESS(s_wait_for_recycled_count(event_loop, recycler, 1));
+
+    /* a channel of another size can't use it */
+    struct aws_channel *other_size = NULL;
+    args.arena_size = 0;
+    setup_args.setup_completed = false;
+    ASSERT_SUCCESS(s_channel_setup_create_and_wait(allocator, &args, &setup_args, &other_size));
+    ASSERT_FALSE(other_size == first);
+    ASSERT_UINT_EQUALS(1, aws_channel_recycler_get_cached_count(recycler));
+    aws_channel_destroy(other_size);
+    ASSERT_SUCCESS(s_wait_for_recycled_count(event_loop, recycler, 1));
+
+    /* but one of the same size does, and starts out with an empty arena */
+    struct aws_channel *reused = NULL;
+    args.arena_size = aws_channel_arena_size_hint(1, 0);
+    setup_args.setup_completed = false;
+    ASSERT_SUCCESS(s_channel_setup_create_and_wait(allocator, &args, &setup_args, &reused));
+    ASSERT_TRUE(reused == first || reused == second);
+    ASSERT_UINT_EQUALS(0, aws_channel_recycler_get_cached_count(recycler));
+    ASSERT_NOT_NULL(aws_channel_slot_new(reused));
+
+    /* the channel's reference keeps the recycler around until it's deleted */
+    aws_channel_recycler_release(recycler);
+    aws_channel_destroy(reused);
+
+    aws_event_loop_destroy(event_loop);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(channel_recycler, s_test_channel_recycler)
+
+/* a handler that has data read straight into its ring buffer */
+struct ring_lending_handler {
+    struct aws_channel_handler handler;
+    struct aws_channel_read_buffer_loan loan;
+    uint8_t ring[64];
+    size_t write_offset;
+    size_t lent_messages_received;
+    size_t other_messages_received;
+};
+
+static struct aws_io_message *s_ring_lending_lend_read_buffer(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    size_t size_hint) {
+    (void)slot;
+
+    struct ring_lending_handler *ring_handler = handler->impl;
+    size_t free_space = sizeof(ring_handler->ring) - ring_handler->write_offset;
+    struct aws_byte_buf region = aws_byte_buf_from_empty_array(
+        ring_handler->ring + ring_handler->write_offset, aws_min_size(free_space, size_hint));
+    return aws_channel_read_buffer_loan_lend(&ring_handler->loan, region);
+}
+
+static void s_ring_lending_on_returned(
+    struct aws_channel_read_buffer_loan *loan,
+    struct aws_byte_buf *data,
+    void *user_data) {
+    (void)loan;
+
+    struct ring_lending_handler *ring_handler = user_data;
+    ring_handler->write_offset += data->len;
+}
+
+static int s_ring_lending_process_read_message(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    struct aws_io_message *message) {
+    (void)slot;
+
+    struct ring_lending_handler *ring_handler = handler->impl;
+    if (message == &ring_handler->loan.message) {
+        ring_handler->lent_messages_received += 1;
+    } else {
+        ring_handler->other_messages_received += 1;
+    }
+
+    aws_mem_release(message->allocator, message);
+    return AWS_OP_SUCCESS;
+}
+
+static struct aws_channel_handler_vtable s_ring_lending_vtable = {
+    .process_read_message = s_ring_lending_process_read_message,
+    .shutdown = s_batch_counting_shutdown,
+    .initial_window_size = s_batch_counting_initial_window_size,
+    .message_overhead = s_batch_counting_message_overhead,
+    .destroy = s_batch_counting_destroy,
+    .lend_read_buffer = s_ring_lending_lend_read_buffer,
+};
+
+struct read_buffer_lending_test_args {
+    struct aws_mutex mutex;
+    struct aws_condition_variable condvar;
+    struct aws_channel_slot *slot;
+    struct ring_lending_handler *ring_handler;
+    struct aws_channel_task task;
+    int result;    /* protected by mutex */
+    bool task_ran; /* protected by mutex */
+};
+
+static int s_run_read_buffer_lending(struct read_buffer_lending_test_args *test_args) {
+    struct aws_channel_slot *slot = test_args->slot;
+    struct ring_lending_handler *ring_handler = test_args->ring_handler;
+
+    /* the last handler has no one to borrow from */
+    ASSERT_NULL(aws_channel_slot_borrow_read_buffer(slot->adj_right, 10));
+
+    struct aws_byte_cursor data = aws_byte_cursor_from_c_str("0123456789");
+    for (size_t i = 0; i < 2; ++i) {
+        struct aws_io_message *message = aws_channel_slot_borrow_read_buffer(slot, 10);
+        ASSERT_PTR_EQUALS(&ring_handler->loan.message, message);
+        ASSERT_PTR_EQUALS(slot->channel, message->owning_channel);
+        ASSERT_UINT_EQUALS(10, message->message_data.capacity);
+
+        /* only one region is out at a time */
+        ASSERT_NULL(aws_channel_slot_borrow_read_buffer(slot, 10));
+        ASSERT_INT_EQUALS(AWS_ERROR_INVALID_STATE, aws_last_error());
+
+        ASSERT_TRUE(aws_byte_buf_write_from_whole_cursor(&message->message_data, data));
+        ASSERT_SUCCESS(aws_channel_slot_send_message(slot, message, AWS_CHANNEL_DIR_READ));
+    }
+
+    /* the data went straight into the ring, and the regions came back once released */
+    ASSERT_UINT_EQUALS(2, ring_handler->lent_messages_received);
+    ASSERT_UINT_EQUALS(0, ring_handler->other_messages_received);
+    ASSERT_UINT_EQUALS(2 * data.len, ring_handler->write_offset);
+    ASSERT_BIN_ARRAYS_EQUALS("01234567890123456789", 2 * data.len, ring_handler->ring, ring_handler->write_offset);
+
+    /* a borrowed buffer that's never filled can just be released */
+    struct aws_io_message *unused = aws_channel_slot_borrow_read_buffer(slot, 10);
+    ASSERT_NOT_NULL(unused);
+    aws_mem_release(unused->allocator, unused);
+    ASSERT_FALSE(ring_handler->loan.outstanding);
+    ASSERT_UINT_EQUALS(2 * data.len, ring_handler->write_offset);
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_read_buffer_lending_task(struct aws_channel_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    (void)status;
+    struct read_buffer_lending_test_args *test_args = arg;
+
+    int result = s_run_read_buffer_lending(test_args);
+
+    aws_mutex_lock(&test_args->mutex);
+    test_args->result = result;
+    test_args->task_ran = true;
+    aws_mutex_unlock(&test_args->mutex);
+    aws_condition_variable_notify_one(&test_args->condvar);
+}
+
+static bool s_read_buffer_lending_task_ran_pred(void *arg) {
+    struct read_buffer_lending_test_args *test_args = arg;
+    return test_args->task_ran;
+}
+
+static int s_test_channel_read_buffer_lending(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    struct aws_event_loop *event_loop = aws_event_loop_new_default(allocator, aws_high_res_clock_get_ticks);
+
+    ASSERT_NOT_NULL(event_loop);
+    ASSERT_SUCCESS(aws_event_loop_run(event_loop));
+
+    struct channel_setup_test_args setup_args = {
+        .error_code = 0,
+        .mutex = AWS_MUTEX_INIT,
+        .condition_variable = AWS_CONDITION_VARIABLE_INIT,
+        .setup_completed = false,
+        .shutdown_completed = false,
+    };
+
+    struct aws_channel_options args = {
+        .on_setup_completed = s_channel_setup_test_on_setup_completed,
+        .setup_user_data = &setup_args,
+        .event_loop = event_loop,
+    };
+
+    struct aws_channel *channel = NULL;
+    ASSERT_SUCCESS(s_channel_setup_create_and_wait(allocator, &args, &setup_args, &channel));
+
+    struct ring_lending_handler ring_handler;
+    AWS_ZERO_STRUCT(ring_handler);
+    ring_handler.handler.vtable = &s_ring_lending_vtable;
+    ring_handler.handler.alloc = allocator;
+    ring_handler.handler.impl = &ring_handler;
+    aws_channel_read_buffer_loan_init(&ring_handler.loan, s_ring_lending_on_returned, &ring_handler);
+
+    struct read_buffer_lending_test_args test_args = {
+        .mutex = AWS_MUTEX_INIT,
+        .condvar = AWS_CONDITION_VARIABLE_INIT,
+        .ring_handler = &ring_handler,
+    };
+
+    test_args.slot = aws_channel_slot_new(channel);
+    ASSERT_NOT_NULL(test_args.slot);
+    struct aws_channel_handler *reader = rw_handler_new(allocator, NULL, NULL, false, 10000, NULL);
+    ASSERT_NOT_NULL(reader);
+    ASSERT_SUCCESS(aws_channel_slot_set_handler(test_args.slot, reader));
+
+    struct aws_channel_slot *lender_slot = aws_channel_slot_new(channel);
+    ASSERT_NOT_NULL(lender_slot);
+    ASSERT_SUCCESS(aws_channel_slot_insert_right(test_args.slot, lender_slot));
+    ASSERT_SUCCESS(aws_channel_slot_set_handler(lender_slot, &ring_handler.handler));
+
+    aws_channel_task_init(&test_args.task, s_read_buffer_lending_task, &test_args, "read_buffer_lending");
+    aws_channel_schedule_task_now(channel, &test_args.task);
+
+    ASSERT_SUCCESS(aws_mutex_lock(&test_args.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &test_args.condvar, &test_args.mutex, s_read_buffer_lending_task_ran_pred, &test_args));
+    ASSERT_SUCCESS(test_args.result);
+    ASSERT_SUCCESS(aws_mutex_unlock(&test_args.mutex));
+
+    aws_channel_destroy(channel);
+    aws_event_loop_destroy(event_loop);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(channel_read_buffer_lending, s_test_channel_read_buffer_lending)
+
 static int s_test_channel_rejects_post_shutdown_tasks(struct aws_allocator *allocator, void *ctx) {
     (void)ctx;
     struct aws_event_loop *event_loop = aws_event_loop_new_default(allocator, aws_high_res_clock_get_ticks);
@@ -1702,9 +1702,7 @@ static int s_test_resolver_add_multiple_listeners_fn(struct aws_allocator *alloc
 AWS_TEST_CASE(test_resolver_add_multiple_listeners_fn, s_test_resolver_add_multiple_listeners_fn)
 
 /* Test to make sure that a host listener still works even when a host entry is removed and re-added. */
-static int s_test_resolver_listener_host_re_add_fn(struct aws_allocator *allocator, void *ctx) {
-    (void)ctx;
-
+static int s_test_resolver_listener_host_re_add(struct aws_allocator *allocator, size_t thread_pool_size) {
     aws_io_library_init(allocator);
 
     const uint32_t num_ipv4 = 1;
@@ -1718,6 +1716,7 @@ static int s_test_resolver_listener_host_re_add_fn(struct aws_allocator *allocat
     struct aws_host_resolver_default_options resolver_options = {
         .el_group = el_group,
         .max_entries = 10,
+        .resolver_thread_pool_size = thread_pool_size,
     };
     struct aws_host_resolver *resolver = aws_host_resolver_new_default(allocator, &resolver_options);
     struct aws_host_listener *listener = NULL;
@@ -1837,11 +1836,27 @@ static int s_test_resolver_listener_host_re_add_fn(struct aws_allocator *allocat
     return 0;
 }
 
+static int s_test_resolver_listener_host_re_add_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    ASSERT_SUCCESS(s_test_resolver_listener_host_re_add(allocator, 0));
+
+    return AWS_OP_SUCCESS;
+}
+
 AWS_TEST_CASE(test_resolver_listener_host_re_add_fn, s_test_resolver_listener_host_re_add_fn)
 
-static int s_test_resolver_listener_multiple_results_fn(struct aws_allocator *allocator, void *ctx) {
+static int s_test_resolver_listener_host_re_add_pooled_fn(struct aws_allocator *allocator, void *ctx) {
     (void)ctx;
 
+    ASSERT_SUCCESS(s_test_resolver_listener_host_re_add(allocator, 2));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(test_resolver_listener_host_re_add_pooled, s_test_resolver_listener_host_re_add_pooled_fn)
+
+static int s_test_resolver_listener_multiple_results(struct aws_allocator *allocator, size_t thread_pool_size) {
     aws_io_library_init(allocator);
 
     const uint32_t num_ipv4 = 4;
@@ -1855,6 +1870,7 @@ static int s_test_resolver_listener_multiple_results_fn(struct aws_allocator *al
     struct aws_host_resolver_default_options resolver_options = {
         .el_group = el_group,
         .max_entries = 10,
+        .resolver_thread_pool_size = thread_pool_size,
     };
     struct aws_host_resolver *resolver = aws_host_resolver_new_default(allocator, &resolver_options);
     struct aws_host_listener *listener = NULL;
@@ -1928,8 +1944,26 @@ static int s_test_resolver_listener_multiple_results_fn(struct aws_allocator *al
     return 0;
 }
 
+static int s_test_resolver_listener_multiple_results_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    ASSERT_SUCCESS(s_test_resolver_listener_multiple_results(allocator, 0));
+
+    return AWS_OP_SUCCESS;
+}
+
 AWS_TEST_CASE(test_resolver_listener_multiple_results, s_test_resolver_listener_multiple_results_fn)
 
+static int s_test_resolver_listener_multiple_results_pooled_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    ASSERT_SUCCESS(s_test_resolver_listener_multiple_results(allocator, 2));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(test_resolver_listener_multiple_results_pooled, s_test_resolver_listener_multiple_results_pooled_fn)
+
 static uint64_t s_mocked_time = 0;
 static struct aws_mutex s_mocked_time_lock = AWS_MUTEX_INIT;
 
@@ -2540,3 +2574,967 @@ static int s_test_resolver_address_promote_demote_listener_callbacks_fn(struct a
 AWS_TEST_CASE(
     test_resolver_address_promote_demote_listener_callbacks,
     s_test_resolver_address_promote_demote_listener_callbacks_fn)
+
+#define RESOLVER_BENCHMARK_HOST_COUNT 128
+
+struct resolver_benchmark_host {
+    struct aws_string *host_name;
+    struct mock_dns_resolver mock_resolver;
+    struct aws_host_resolution_config config;
+};
+
+struct resolver_benchmark {
+    struct aws_mutex mutex;
+    struct aws_condition_variable signal;
+    aws_thread_id_t caller_thread_id;
+    size_t resolved_count;
+    size_t resolved_on_caller_count;
+    size_t failed_count;
+};
+
+static bool s_resolver_benchmark_done_pred(void *arg) {
+    struct resolver_benchmark *benchmark = arg;
+    return benchmark->resolved_count + benchmark->failed_count == RESOLVER_BENCHMARK_HOST_COUNT;
+}
+
+static void s_resolver_benchmark_callback(
+    struct aws_host_resolver *resolver,
+    const struct aws_string *host_name,
+    int err_code,
+    const struct aws_array_list *host_addresses,
+    void *user_data) {
+
+    (void)resolver;
+    struct resolver_benchmark *benchmark = user_data;
+
+    struct aws_host_address *address = NULL;
+    if (!err_code && host_addresses != NULL && aws_array_list_length(host_addresses) == 1) {
+        aws_array_list_get_at_ptr(host_addresses, (void **)&address, 0);
+    }
+
+    aws_mutex_lock(&benchmark->mutex);
+    if (address != NULL && aws_string_eq(address->host, host_name)) {
+        benchmark->resolved_count += 1;
+        if (aws_thread_thread_id_equal(benchmark->caller_thread_id, aws_thread_current_thread_id())) {
+            benchmark->resolved_on_caller_count += 1;
+        }
+    } else {
+        benchmark->failed_count += 1;
+    }
+    aws_mutex_unlock(&benchmark->mutex);
+    aws_condition_variable_notify_one(&benchmark->signal);
+}
+
+static int s_resolver_benchmark_resolve_all(
+    struct aws_host_resolver *resolver,
+    struct resolver_benchmark_host *hosts,
+    struct resolver_benchmark *benchmark,
+    uint64_t *elapsed_ns) {
+
+    benchmark->resolved_count = 0;
+    benchmark->resolved_on_caller_count = 0;
+    benchmark->failed_count = 0;
+    benchmark->caller_thread_id = aws_thread_current_thread_id();
+
+    uint64_t start = 0;
+    ASSERT_SUCCESS(aws_high_res_clock_get_ticks(&start));
+
+    for (size_t i = 0; i < RESOLVER_BENCHMARK_HOST_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_host_resolver_resolve_host(
+            resolver, hosts[i].host_name, s_resolver_benchmark_callback, &hosts[i].config, benchmark));
+    }
+
+    ASSERT_SUCCESS(aws_mutex_lock(&benchmark->mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &benchmark->signal, &benchmark->mutex, s_resolver_benchmark_done_pred, benchmark));
+    ASSERT_SUCCESS(aws_mutex_unlock(&benchmark->mutex));
+
+    uint64_t end = 0;
+    ASSERT_SUCCESS(aws_high_res_clock_get_ticks(&end));
+    *elapsed_ns = end - start;
+
+    ASSERT_UINT_EQUALS(0, benchmark->failed_count);
+
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * Resolves the same set of mocked hosts twice: cold, where every entry needs a resolve, then warm, where every answer
+ * should come straight out of the cache on the calling thread. Logs how long each pass took.
+ */
+static int s_run_resolver_benchmark(struct aws_allocator *allocator, size_t thread_pool_size) {
+    aws_io_library_init(allocator);
+
+    struct aws_event_loop_group *el_group = aws_event_loop_group_new_default(allocator, 1, NULL);
+
+    struct aws_host_resolver_default_options resolver_options = {
+        .el_group = el_group,
+        .max_entries = RESOLVER_BENCHMARK_HOST_COUNT,
+        .resolver_thread_pool_size = thread_pool_size,
+    };
+    struct aws_host_resolver *resolver = aws_host_resolver_new_default(allocator, &resolver_options);
+    ASSERT_NOT_NULL(resolver);
+
+    struct resolver_benchmark_host *hosts =
+        aws_mem_calloc(allocator, RESOLVER_BENCHMARK_HOST_COUNT, sizeof(struct resolver_benchmark_host));
+    ASSERT_NOT_NULL(hosts);
+
+    for (size_t i = 0; i < RESOLVER_BENCHMARK_HOST_COUNT; ++i) {
+        char name[64];
+        snprintf(name, sizeof(name), "host%d.benchmark", (int)i);
+        char address[32];
+        snprintf(address, sizeof(address), "10.0.%d.%d", (int)(i / 256), (int)(i % 256));
+
+        struct resolver_benchmark_host *host = &hosts[i];
+        host->host_name = aws_string_new_from_c_str(allocator, name);
+        ASSERT_NOT_NULL(host->host_name);
+        ASSERT_SUCCESS(mock_dns_resolver_init(&host->mock_resolver, 100, allocator));
+
+        struct aws_host_address host_address = {
+            .address = aws_string_new_from_c_str(allocator, address),
+            .allocator = allocator,
+            .host = aws_string_new_from_c_str(allocator, name),
+            .record_type = AWS_ADDRESS_RECORD_TYPE_A,
+        };
+
+        struct aws_array_list address_list;
+        ASSERT_SUCCESS(aws_array_list_init_dynamic(&address_list, allocator, 1, sizeof(struct aws_host_address)));
+        ASSERT_SUCCESS(aws_array_list_push_back(&address_list, &host_address));
+        ASSERT_SUCCESS(mock_dns_resolver_append_address_list(&host->mock_resolver, &address_list));
+
+        host->config.max_ttl = 30;
+        host->config.impl = mock_dns_resolve;
+        host->config.impl_data = &host->mock_resolver;
+    }
+
+    struct resolver_benchmark benchmark = {
+        .mutex = AWS_MUTEX_INIT,
+        .signal = AWS_CONDITION_VARIABLE_INIT,
+    };
+
+    uint64_t cold_ns = 0;
+    ASSERT_SUCCESS(s_resolver_benchmark_resolve_all(resolver, hosts, &benchmark, &cold_ns));
+
+    uint64_t warm_ns = 0;
+    ASSERT_SUCCESS(s_resolver_benchmark_resolve_all(resolver, hosts, &benchmark, &warm_ns));
+    ASSERT_UINT_EQUALS(RESOLVER_BENCHMARK_HOST_COUNT, benchmark.resolved_on_caller_count);
+
+    AWS_LOGF_INFO(
+        AWS_LS_IO_DNS,
+        "resolver benchmark with a thread pool of %d: %d hosts took %llu ns cold and %llu ns warm.",
+        (int)thread_pool_size,
+        RESOLVER_BENCHMARK_HOST_COUNT,
+        (unsigned long long)cold_ns,
+        (unsigned long long)warm_ns);
+
+    aws_host_resolver_release(resolver);
+    aws_event_loop_group_release(el_group);
+    ASSERT_SUCCESS(aws_global_thread_creator_shutdown_wait_for(10));
+
+    for (size_t i = 0; i < RESOLVER_BENCHMARK_HOST_COUNT; ++i) {
+        aws_string_destroy(hosts[i].host_name);
+        mock_dns_resolver_clean_up(&hosts[i].mock_resolver);
+    }
+    aws_mem_release(allocator, hosts);
+
+    aws_io_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_resolver_thread_pool_benchmark_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    /* a thread per host entry, then a pool of 4 */
+    ASSERT_SUCCESS(s_run_resolver_benchmark(allocator, 0));
+    ASSERT_SUCCESS(s_run_resolver_benchmark(allocator, 4));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(test_resolver_thread_pool_benchmark, s_test_resolver_thread_pool_benchmark_fn)
+
+#define RESOLVER_HIT_THREAD_COUNT 4
+
+struct resolver_hit_worker {
+    struct aws_host_resolver *resolver;
+    const struct aws_string *host_name;
+    const struct aws_string *first_address;
+    struct aws_host_resolution_config *config;
+    uint64_t end_ns;
+    struct aws_thread thread;
+
+    /* cache hits are answered on the calling thread, so only the worker itself touches these */
+    size_t attempt_count;
+    size_t answered_count;
+    size_t first_address_count;
+    size_t failed_count;
+};
+
+static void s_resolver_hit_callback(
+    struct aws_host_resolver *resolver,
+    const struct aws_string *host_name,
+    int err_code,
+    const struct aws_array_list *host_addresses,
+    void *user_data) {
+
+    (void)resolver;
+    (void)host_name;
+    struct resolver_hit_worker *worker = user_data;
+
+    struct aws_host_address *address = NULL;
+    if (err_code || host_addresses == NULL || aws_array_list_length(host_addresses) != 1) {
+        worker->failed_count += 1;
+        return;
+    }
+
+    aws_array_list_get_at_ptr(host_addresses, (void **)&address, 0);
+    worker->answered_count += 1;
+    if (aws_string_eq(address->address, worker->first_address)) {
+        worker->first_address_count += 1;
+    }
+}
+
+static void s_resolver_hit_worker_fn(void *arg) {
+    struct resolver_hit_worker *worker = arg;
+
+    uint64_t now = 0;
+    while (!aws_high_res_clock_get_ticks(&now) && now < worker->end_ns) {
+        worker->attempt_count += 1;
+        if (aws_host_resolver_resolve_host(
+                worker->resolver, worker->host_name, s_resolver_hit_callback, worker->config, worker)) {
+            worker->failed_count += 1;
+        }
+    }
+}
+
+/*
+ * Hammers one cached host from several threads while its entry keeps re-resolving, so cache hits race with snapshot
+ * publication. Every hit must be answered right away, and hits must keep rotating through the host's addresses.
+ */
+static int s_test_resolver_concurrent_cache_hits_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_io_library_init(allocator);
+
+    struct aws_event_loop_group *el_group = aws_event_loop_group_new_default(allocator, 1, NULL);
+
+    struct aws_host_resolver_default_options resolver_options = {
+        .el_group = el_group,
+        .max_entries = 10,
+    };
+    struct aws_host_resolver *resolver = aws_host_resolver_new_default(allocator, &resolver_options);
+    ASSERT_NOT_NULL(resolver);
+
+    const struct aws_string *host_name = aws_string_new_from_c_str(allocator, "host_address");
+    const struct aws_string *addr1_ipv4 = aws_string_new_from_c_str(allocator, "address1ipv4");
+    const struct aws_string *addr2_ipv4 = aws_string_new_from_c_str(allocator, "address2ipv4");
+
+    struct mock_dns_resolver mock_resolver;
+    ASSERT_SUCCESS(mock_dns_resolver_init(&mock_resolver, 100, allocator));
+
+    struct aws_host_address host_address_1_ipv4 = {
+        .address = aws_string_new_from_string(allocator, addr1_ipv4),
+        .allocator = allocator,
+        .host = aws_string_new_from_c_str(allocator, "host_address"),
+        .record_type = AWS_ADDRESS_RECORD_TYPE_A,
+    };
+
+    struct aws_host_address host_address_2_ipv4 = {
+        .address = aws_string_new_from_string(allocator, addr2_ipv4),
+        .allocator = allocator,
+        .host = aws_string_new_from_c_str(allocator, "host_address"),
+        .record_type = AWS_ADDRESS_RECORD_TYPE_A,
+    };
+
+    struct aws_array_list address_list;
+    ASSERT_SUCCESS(aws_array_list_init_dynamic(&address_list, allocator, 2, sizeof(struct aws_host_address)));
+    ASSERT_SUCCESS(aws_array_list_push_back(&address_list, &host_address_1_ipv4));
+    ASSERT_SUCCESS(aws_array_list_push_back(&address_list, &host_address_2_ipv4));
+    ASSERT_SUCCESS(mock_dns_resolver_append_address_list(&mock_resolver, &address_list));
+
+    /* re-resolves every second, caching both addresses */
+    struct aws_host_resolution_config config = {
+        .max_ttl = 2,
+        .impl = mock_dns_resolve,
+        .impl_data = &mock_resolver,
+    };
+
+    struct aws_mutex mutex = AWS_MUTEX_INIT;
+    struct default_host_callback_data callback_data = {
+        .condition_variable = AWS_CONDITION_VARIABLE_INIT,
+        .mutex = &mutex,
+    };
+
+    ASSERT_SUCCESS(aws_host_resolver_resolve_host(
+        resolver, host_name, s_default_host_resolved_test_callback, &config, &callback_data));
+
+    ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+    aws_condition_variable_wait_pred(
+        &callback_data.condition_variable, &mutex, s_default_host_resolved_predicate, &callback_data);
+    ASSERT_TRUE(callback_data.has_a_address);
+    aws_host_address_clean_up(&callback_data.a_address);
+    ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+
+    uint64_t start_ns = 0;
+    ASSERT_SUCCESS(aws_high_res_clock_get_ticks(&start_ns));
+
+    struct resolver_hit_worker workers[RESOLVER_HIT_THREAD_COUNT];
+    AWS_ZERO_ARRAY(workers);
+    for (size_t i = 0; i < RESOLVER_HIT_THREAD_COUNT; ++i) {
+        struct resolver_hit_worker *worker = &workers[i];
+        worker->resolver = resolver;
+        worker->host_name = host_name;
+        worker->first_address = addr1_ipv4;
+        worker->config = &config;
+        worker->end_ns = start_ns + FORCE_RESOLVE_SLEEP_TIME;
+        ASSERT_SUCCESS(aws_thread_init(&worker->thread, allocator));
+        ASSERT_SUCCESS(aws_thread_launch(&worker->thread, s_resolver_hit_worker_fn, worker, NULL));
+    }
+
+    size_t hit_count = 0;
+    size_t first_address_count = 0;
+    for (size_t i = 0; i < RESOLVER_HIT_THREAD_COUNT; ++i) {
+        struct resolver_hit_worker *worker = &workers[i];
+        ASSERT_SUCCESS(aws_thread_join(&worker->thread));
+        aws_thread_clean_up(&worker->thread);
+
+        ASSERT_UINT_EQUALS(0, worker->failed_count);
+        /* every thread got its share of the cache, rather than being shut out by the others */
+        ASSERT_TRUE(worker->answered_count > 0);
+        ASSERT_UINT_EQUALS(worker->attempt_count, worker->answered_count);
+        hit_count += worker->answered_count;
+        first_address_count += worker->first_address_count;
+    }
+
+    /* each hit rotates the addresses, so there have to be enough of them for both addresses to come up */
+    ASSERT_TRUE(hit_count >= 2 * RESOLVER_HIT_THREAD_COUNT);
+    ASSERT_TRUE(first_address_count > 0);
+    ASSERT_TRUE(first_address_count < hit_count);
+
+    mock_dns_resolver_clean_up(&mock_resolver);
+    aws_host_resolver_release(resolver);
+    aws_string_destroy((void *)host_name);
+    aws_string_destroy((void *)addr1_ipv4);
+    aws_string_destroy((void *)addr2_ipv4);
+    aws_event_loop_group_release(el_group);
+    ASSERT_SUCCESS(aws_global_thread_creator_shutdown_wait_for(10));
+
+    aws_io_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(test_resolver_concurrent_cache_hits, s_test_resolver_concurrent_cache_hits_fn)
+
+/*
+ * The host resolves once, then every resolve fails. Its entry retires for lack of queries, and the next query must
+ * still be answered, straight away, with the address it had.
+ */
+static int s_test_resolver_serves_stale_addresses(struct aws_allocator *allocator, size_t thread_pool_size) {
+    aws_io_library_init(allocator);
+
+    struct aws_event_loop_group *el_group = aws_event_loop_group_new_default(allocator, 1, NULL);
+
+    struct aws_host_resolver_default_options resolver_options = {
+        .el_group = el_group,
+        .max_entries = 10,
+        .max_stale_secs = 30,
+        .resolver_thread_pool_size = thread_pool_size,
+    };
+    struct aws_host_resolver *resolver = aws_host_resolver_new_default(allocator, &resolver_options);
+    ASSERT_NOT_NULL(resolver);
+
+    const struct aws_string *host_name = aws_string_new_from_c_str(allocator, "host_address");
+    const struct aws_string *addr1_ipv4 = aws_string_new_from_c_str(allocator, "address1ipv4");
+
+    struct mock_dns_resolver mock_resolver;
+    ASSERT_SUCCESS(mock_dns_resolver_init(&mock_resolver, 1, allocator));
+
+    struct aws_host_address host_address_1_ipv4 = {
+        .address = aws_string_new_from_string(allocator, addr1_ipv4),
+        .allocator = allocator,
+        .host = aws_string_new_from_c_str(allocator, "host_address"),
+        .record_type = AWS_ADDRESS_RECORD_TYPE_A,
+    };
+
+    struct aws_array_list address_list;
+    ASSERT_SUCCESS(aws_array_list_init_dynamic(&address_list, allocator, 1, sizeof(struct aws_host_address)));
+    ASSERT_SUCCESS(aws_array_list_push_back(&address_list, &host_address_1_ipv4));
+    ASSERT_SUCCESS(mock_dns_resolver_append_address_list(&mock_resolver, &address_list));
+
+    struct aws_host_resolution_config config = {
+        .max_ttl = 1,
+        .impl = mock_dns_resolve,
+        .impl_data = &mock_resolver,
+    };
+
+    struct aws_mutex mutex = AWS_MUTEX_INIT;
+    struct default_host_callback_data callback_data = {
+        .condition_variable = AWS_CONDITION_VARIABLE_INIT,
+        .mutex = &mutex,
+    };
+
+    ASSERT_SUCCESS(aws_host_resolver_resolve_host(
+        resolver, host_name, s_default_host_resolved_test_callback, &config, &callback_data));
+
+    ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+    aws_condition_variable_wait_pred(
+        &callback_data.condition_variable, &mutex, s_default_host_resolved_predicate, &callback_data);
+    ASSERT_TRUE(callback_data.has_a_address);
+    aws_host_address_clean_up(&callback_data.a_address);
+    callback_data.invoked = false;
+    callback_data.has_a_address = false;
+    ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+
+    /* long enough for the entry to outlive max_ttl, fail its re-resolves, and retire */
+    aws_thread_current_sleep(aws_timestamp_convert(3, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL));
+
+    ASSERT_SUCCESS(aws_host_resolver_resolve_host(
+        resolver, host_name, s_default_host_resolved_test_callback, &config, &callback_data));
+
+    /* answered from the retired entry's addresses before the call returned */
+    ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+    ASSERT_TRUE(callback_data.invoked);
+    ASSERT_TRUE(callback_data.has_a_address);
+    ASSERT_BIN_ARRAYS_EQUALS(
+        aws_string_bytes(addr1_ipv4),
+        addr1_ipv4->len,
+        aws_string_bytes(callback_data.a_address.address),
+        callback_data.a_address.address->len);
+    aws_host_address_clean_up(&callback_data.a_address);
+    ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+
+    mock_dns_resolver_clean_up(&mock_resolver);
+    aws_host_resolver_release(resolver);
+    aws_string_destroy((void *)host_name);
+    aws_string_destroy((void *)addr1_ipv4);
+    aws_event_loop_group_release(el_group);
+    ASSERT_SUCCESS(aws_global_thread_creator_shutdown_wait_for(10));
+
+    aws_io_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_resolver_serves_stale_addresses_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    ASSERT_SUCCESS(s_test_resolver_serves_stale_addresses(allocator, 0));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(test_resolver_serves_stale_addresses, s_test_resolver_serves_stale_addresses_fn)
+
+static int s_test_resolver_serves_stale_addresses_pooled_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    ASSERT_SUCCESS(s_test_resolver_serves_stale_addresses(allocator, 2));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(test_resolver_serves_stale_addresses_pooled, s_test_resolver_serves_stale_addresses_pooled_fn)
+
+/*
+ * A record whose own TTL is shorter than max_ttl must expire when its record does, even though re-resolves keep
+ * succeeding, while the other address, which has no TTL of its own, keeps its max_ttl expiry.
+ */
+static int s_test_resolver_record_ttl_expires_address_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_io_library_init(allocator);
+
+    s_set_mock_system_clock(0);
+
+    struct aws_byte_cursor host_name = AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("test_host");
+    struct aws_string *host_name_str = aws_string_new_from_c_str(allocator, (const char *)host_name.ptr);
+    struct aws_event_loop_group *el_group = aws_event_loop_group_new_default(allocator, 1, NULL);
+
+    struct aws_host_resolver_default_options resolver_options = {
+        .el_group = el_group,
+        .max_entries = 10,
+        .system_clock_override_fn = s_get_mock_system_clock,
+    };
+    struct aws_host_resolver *resolver = aws_host_resolver_new_default(allocator, &resolver_options);
+    ASSERT_NOT_NULL(resolver);
+
+    struct aws_byte_cursor short_ttl_address = AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("address1ipv4");
+    uint64_t record_expiry = aws_timestamp_convert(5, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL);
+
+    struct mock_dns_resolver mock_resolver;
+    ASSERT_SUCCESS(mock_dns_resolver_init(&mock_resolver, 1000, allocator));
+
+    struct aws_host_address host_address_1_ipv4 = {
+        .address = aws_string_new_from_cursor(allocator, &short_ttl_address),
+        .allocator = allocator,
+        .expiry = record_expiry,
+        .host = aws_string_new_from_string(allocator, host_name_str),
+        .record_type = AWS_ADDRESS_RECORD_TYPE_A,
+    };
+    struct aws_host_address host_address_2_ipv4 = {
+        .address = aws_string_new_from_c_str(allocator, "address2ipv4"),
+        .allocator = allocator,
+        .host = aws_string_new_from_string(allocator, host_name_str),
+        .record_type = AWS_ADDRESS_RECORD_TYPE_A,
+    };
+
+    struct aws_array_list address_list;
+    ASSERT_SUCCESS(aws_array_list_init_dynamic(&address_list, allocator, 2, sizeof(struct aws_host_address)));
+    ASSERT_SUCCESS(aws_array_list_push_back(&address_list, &host_address_1_ipv4));
+    ASSERT_SUCCESS(aws_array_list_push_back(&address_list, &host_address_2_ipv4));
+    ASSERT_SUCCESS(mock_dns_resolver_append_address_list(&mock_resolver, &address_list));
+
+    struct aws_mutex mutex = AWS_MUTEX_INIT;
+    struct listener_test_callback_data callback_data;
+    s_listener_test_callback_data_init(allocator, &mutex, 2, 1, &callback_data);
+
+    struct aws_host_listener_options listener_options = {
+        .host_name = host_name,
+        .resolved_address_callback = s_listener_new_address_callback,
+        .expired_address_callback = s_listener_expired_address_callback,
+        .shutdown_callback = s_listener_shutdown_callback,
+        .user_data = &callback_data,
+    };
+    struct aws_host_listener *listener = aws_host_resolver_add_host_listener(resolver, &listener_options);
+    ASSERT_NOT_NULL(listener);
+
+    struct aws_host_resolution_config config = {
+        .max_ttl = 30,
+        .impl = mock_dns_resolve,
+        .impl_data = &mock_resolver,
+    };
+    ASSERT_SUCCESS(aws_host_resolver_resolve_host(
+        resolver, host_name_str, s_listener_test_initial_resolved_callback_empty, &config, NULL));
+
+    ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+    aws_condition_variable_wait_pred(
+        &callback_data.condition_variable, &mutex, s_listener_new_address_complete_set_predicate, &callback_data);
+    ASSERT_INT_EQUALS(0, aws_array_list_length(&callback_data.expired_address_callback_data.address_list));
+    ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+
+    /* past the record's own expiry, but well within max_ttl */
+    s_set_mock_system_clock(record_expiry + 1);
+
+    /*
+     * Every re-resolve brings the short-lived address back with the same expiry and it expires again, so only wait for
+     * the first expiration, and make sure the long-lived address was never among them.
+     */
+    ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+    aws_condition_variable_wait_pred(
+        &callback_data.condition_variable, &mutex, s_listener_expired_address_invoked_predicate, &callback_data);
+    struct aws_array_list *expired_list = &callback_data.expired_address_callback_data.address_list;
+    ASSERT_TRUE(aws_array_list_length(expired_list) > 0);
+    for (size_t i = 0; i < aws_array_list_length(expired_list); ++i) {
+        struct aws_host_address *expired_address = NULL;
+        ASSERT_SUCCESS(aws_array_list_get_at(expired_list, &expired_address, i));
+        ASSERT_BIN_ARRAYS_EQUALS(
+            short_ttl_address.ptr,
+            short_ttl_address.len,
+            aws_string_bytes(expired_address->address),
+            expired_address->address->len);
+    }
+    ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+
+    aws_host_resolver_remove_host_listener(resolver, listener);
+    s_wait_on_listener_shutdown(&callback_data);
+    s_listener_test_callback_data_clean_up(&callback_data);
+
+    mock_dns_resolver_clean_up(&mock_resolver);
+    aws_host_resolver_release(resolver);
+
+    aws_mutex_clean_up(&mutex);
+    aws_string_destroy(host_name_str);
+
+    aws_event_loop_group_release(el_group);
+    ASSERT_SUCCESS(aws_global_thread_creator_shutdown_wait_for(10));
+
+    aws_io_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(test_resolver_record_ttl_expires_address, s_test_resolver_record_ttl_expires_address_fn)
+
+/*
+ * The host resolves once, then every resolve fails. Its entry stays active, and its addresses must keep being served
+ * past their expiry until max_stale_secs have gone by, and only then be purged.
+ */
+static int s_test_resolver_serves_expired_addresses_through_outage_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_io_library_init(allocator);
+
+    s_set_mock_system_clock(0);
+
+    const uint32_t num_ipv4 = 2;
+    const uint64_t max_ttl_ns = aws_timestamp_convert(30, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL);
+    const uint64_t max_stale_ns = aws_timestamp_convert(30, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL);
+
+    struct aws_byte_cursor host_name = AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("test_host");
+    struct aws_string *host_name_str = aws_string_new_from_c_str(allocator, (const char *)host_name.ptr);
+    struct aws_event_loop_group *el_group = aws_event_loop_group_new_default(allocator, 1, NULL);
+
+    struct aws_host_resolver_default_options resolver_options = {
+        .el_group = el_group,
+        .max_entries = 10,
+        .system_clock_override_fn = s_get_mock_system_clock,
+        .max_stale_secs = 30,
+    };
+    struct aws_host_resolver *resolver = aws_host_resolver_new_default(allocator, &resolver_options);
+    ASSERT_NOT_NULL(resolver);
+
+    /* only the first resolve succeeds */
+    struct mock_dns_resolver mock_resolver;
+    ASSERT_SUCCESS(s_setup_mock_host(allocator, resolver, &mock_resolver, host_name_str, num_ipv4, 0, 1));
+
+    /*
+     * Internal default resolver detail: we don't expire the last remaining address, so only one of the two is
+     * expected to go.
+     */
+    struct aws_mutex mutex = AWS_MUTEX_INIT;
+    struct listener_test_callback_data callback_data;
+    s_listener_test_callback_data_init(allocator, &mutex, num_ipv4, num_ipv4 - 1, &callback_data);
+
+    struct aws_host_listener_options listener_options = {
+        .host_name = host_name,
+        .resolved_address_callback = s_listener_new_address_callback,
+        .expired_address_callback = s_listener_expired_address_callback,
+        .shutdown_callback = s_listener_shutdown_callback,
+        .user_data = &callback_data,
+    };
+    struct aws_host_listener *listener = aws_host_resolver_add_host_listener(resolver, &listener_options);
+    ASSERT_NOT_NULL(listener);
+
+    struct aws_host_resolution_config config = {
+        .max_ttl = 30,
+        .impl = mock_dns_resolve,
+        .impl_data = &mock_resolver,
+    };
+    ASSERT_SUCCESS(aws_host_resolver_resolve_host(
+        resolver, host_name_str, s_listener_test_initial_resolved_callback_empty, &config, NULL));
+
+    ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+    aws_condition_variable_wait_pred(
+        &callback_data.condition_variable, &mutex, s_listener_new_address_complete_set_predicate, &callback_data);
+    ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+
+    /* every address is past its expiry, but within max_stale_secs of it */
+    s_set_mock_system_clock(max_ttl_ns + 1);
+
+    /* long enough for a couple of failed re-resolves */
+    aws_thread_current_sleep(aws_timestamp_convert(3, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL));
+
+    ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+    ASSERT_FALSE(callback_data.expired_address_callback_data.callback_invoked);
+    ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+
+    struct default_host_callback_data resolve_callback_data = {
+        .condition_variable = AWS_CONDITION_VARIABLE_INIT,
+        .mutex = &mutex,
+    };
+    ASSERT_SUCCESS(aws_host_resolver_resolve_host(
+        resolver, host_name_str, s_default_host_resolved_test_callback, &config, &resolve_callback_data));
+
+    /* answered from the entry's expired addresses before the call returned */
+    ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+    ASSERT_TRUE(resolve_callback_data.invoked);
+    ASSERT_TRUE(resolve_callback_data.has_a_address);
+    aws_host_address_clean_up(&resolve_callback_data.a_address);
+    ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+
+    /* and once they're more than max_stale_secs past it, they're purged */
+    s_set_mock_system_clock(max_ttl_ns + max_stale_ns + 1);
+
+    ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+    aws_condition_variable_wait_pred(
+        &callback_data.condition_variable, &mutex, s_listener_expired_address_complete_set_predicate, &callback_data);
+    ASSERT_SUCCESS(
+        s_verify_mock_address_list(&callback_data.expired_address_callback_data.address_list, num_ipv4 - 1, 0));
+    ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+
+    aws_host_resolver_remove_host_listener(resolver, listener);
+    s_wait_on_listener_shutdown(&callback_data);
+    s_listener_test_callback_data_clean_up(&callback_data);
+
+    mock_dns_resolver_clean_up(&mock_resolver);
+    aws_host_resolver_release(resolver);
+
+    aws_mutex_clean_up(&mutex);
+    aws_string_destroy(host_name_str);
+
+    aws_event_loop_group_release(el_group);
+    ASSERT_SUCCESS(aws_global_thread_creator_shutdown_wait_for(10));
+
+    aws_io_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(
+    test_resolver_serves_expired_addresses_through_outage,
+    s_test_resolver_serves_expired_addresses_through_outage_fn)
+
+/*
+ * Purging the cache shuts the host's entry down and forgets its addresses, so the next query for the host starts a
+ * new entry that resolves it all over again.
+ */
+static int s_test_resolver_purge_cache(struct aws_allocator *allocator, size_t thread_pool_size) {
+    aws_io_library_init(allocator);
+
+    struct aws_event_loop_group *el_group = aws_event_loop_group_new_default(allocator, 1, NULL);
+
+    struct aws_host_resolver_default_options resolver_options = {
+        .el_group = el_group,
+        .max_entries = 10,
+        .resolver_thread_pool_size = thread_pool_size,
+    };
+    struct aws_host_resolver *resolver = aws_host_resolver_new_default(allocator, &resolver_options);
+    ASSERT_NOT_NULL(resolver);
+
+    struct aws_string *host_name = aws_string_new_from_c_str(allocator, "test_host");
+
+    struct mock_dns_resolver mock_resolver;
+    ASSERT_SUCCESS(s_setup_mock_host(allocator, resolver, &mock_resolver, host_name, 1, 1, 100));
+
+    struct aws_host_resolution_config config = {
+        .max_ttl = 30,
+        .impl = mock_dns_resolve,
+        .impl_data = &mock_resolver,
+    };
+
+    struct aws_mutex mutex = AWS_MUTEX_INIT;
+    struct default_host_callback_data callback_data = {
+        .condition_variable = AWS_CONDITION_VARIABLE_INIT,
+        .mutex = &mutex,
+    };
+
+    for (size_t i = 0; i < 2; ++i) {
+        ASSERT_SUCCESS(aws_host_resolver_resolve_host(
+            resolver, host_name, s_default_host_resolved_test_callback, &config, &callback_data));
+
+        ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+        aws_condition_variable_wait_pred(
+            &callback_data.condition_variable, &mutex, s_default_host_resolved_predicate, &callback_data);
+        ASSERT_TRUE(callback_data.has_a_address);
+        ASSERT_TRUE(callback_data.has_aaaa_address);
+        aws_host_address_clean_up(&callback_data.a_address);
+        aws_host_address_clean_up(&callback_data.aaaa_address);
+        callback_data.invoked = false;
+        callback_data.has_a_address = false;
+        callback_data.has_aaaa_address = false;
+        ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+
+        ASSERT_UINT_EQUALS(
+            2,
+            aws_host_resolver_get_host_address_count(
+                resolver,
+                host_name,
+                AWS_GET_HOST_ADDRESS_COUNT_RECORD_TYPE_A | AWS_GET_HOST_ADDRESS_COUNT_RECORD_TYPE_AAAA));
+
+        ASSERT_SUCCESS(aws_host_resolver_purge_cache(resolver));
+        ASSERT_UINT_EQUALS(
+            0,
+            aws_host_resolver_get_host_address_count(
+                resolver,
+                host_name,
+                AWS_GET_HOST_ADDRESS_COUNT_RECORD_TYPE_A | AWS_GET_HOST_ADDRESS_COUNT_RECORD_TYPE_AAAA));
+
+        /* the purged entry retires on its next pass, let it go before the host gets a new one */
+        aws_thread_current_sleep(aws_timestamp_convert(2, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL));
+    }
+
+    aws_host_resolver_release(resolver);
+    mock_dns_resolver_clean_up(&mock_resolver);
+    aws_string_destroy(host_name);
+    aws_event_loop_group_release(el_group);
+    ASSERT_SUCCESS(aws_global_thread_creator_shutdown_wait_for(10));
+
+    aws_io_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_resolver_purge_cache_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    ASSERT_SUCCESS(s_test_resolver_purge_cache(allocator, 0));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(test_resolver_purge_cache, s_test_resolver_purge_cache_fn)
+
+static int s_test_resolver_purge_cache_pooled_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    ASSERT_SUCCESS(s_test_resolver_purge_cache(allocator, 2));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(test_resolver_purge_cache_pooled, s_test_resolver_purge_cache_pooled_fn)
+
+static const char *s_test_cache_file_name = "host_resolver_cache.bin";
+static const char *s_test_cache_tmp_file_name = "host_resolver_cache.bin.tmp";
+
+/*
+ * Saves a resolved host to a cache file and loads it into a resolver whose DNS is down. The host's first query must be
+ * answered straight away with the saved addresses. Saving replaces an existing file without leaving its temporary file
+ * behind. A truncated file must be rejected.
+ */
+static int s_test_resolver_cache_file_round_trip_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_io_library_init(allocator);
+
+    struct aws_event_loop_group *el_group = aws_event_loop_group_new_default(allocator, 1, NULL);
+
+    struct aws_host_resolver_default_options resolver_options = {
+        .el_group = el_group,
+        .max_entries = 10,
+    };
+
+    const struct aws_string *host_name = aws_string_new_from_c_str(allocator, "host_address");
+    const struct aws_string *addr1_ipv4 = aws_string_new_from_c_str(allocator, "address1ipv4");
+    const struct aws_string *addr1_ipv6 = aws_string_new_from_c_str(allocator, "address1ipv6");
+
+    struct mock_dns_resolver mock_resolver;
+    ASSERT_SUCCESS(mock_dns_resolver_init(&mock_resolver, 1, allocator));
+
+    struct mock_dns_resolver failing_resolver;
+    ASSERT_SUCCESS(mock_dns_resolver_init(&failing_resolver, 0, allocator));
+
+    struct aws_host_address host_address_1_ipv4 = {
+        .address = aws_string_new_from_string(allocator, addr1_ipv4),
+        .allocator = allocator,
+        .host = aws_string_new_from_c_str(allocator, "host_address"),
+        .record_type = AWS_ADDRESS_RECORD_TYPE_A,
+    };
+
+    struct aws_host_address host_address_1_ipv6 = {
+        .address = aws_string_new_from_string(allocator, addr1_ipv6),
+        .allocator = allocator,
+        .host = aws_string_new_from_c_str(allocator, "host_address"),
+        .record_type = AWS_ADDRESS_RECORD_TYPE_AAAA,
+    };
+
+    struct aws_array_list address_list;
+    ASSERT_SUCCESS(aws_array_list_init_dynamic(&address_list, allocator, 2, sizeof(struct aws_host_address)));
+    ASSERT_SUCCESS(aws_array_list_push_back(&address_list, &host_address_1_ipv6));
+    ASSERT_SUCCESS(aws_array_list_push_back(&address_list, &host_address_1_ipv4));
+    ASSERT_SUCCESS(mock_dns_resolver_append_address_list(&mock_resolver, &address_list));
+
+    struct aws_host_resolution_config config = {
+        .max_ttl = 30,
+        .impl = mock_dns_resolve,
+        .impl_data = &mock_resolver,
+    };
+
+    struct aws_mutex mutex = AWS_MUTEX_INIT;
+    struct default_host_callback_data callback_data = {
+        .condition_variable = AWS_CONDITION_VARIABLE_INIT,
+        .mutex = &mutex,
+    };
+
+    /* resolve once and save */
+    {
+        struct aws_host_resolver *resolver = aws_host_resolver_new_default(allocator, &resolver_options);
+        ASSERT_NOT_NULL(resolver);
+
+        ASSERT_SUCCESS(aws_host_resolver_resolve_host(
+            resolver, host_name, s_default_host_resolved_test_callback, &config, &callback_data));
+
+        ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+        aws_condition_variable_wait_pred(
+            &callback_data.condition_variable, &mutex, s_default_host_resolved_predicate, &callback_data);
+        ASSERT_TRUE(callback_data.has_aaaa_address);
+        ASSERT_TRUE(callback_data.has_a_address);
+        aws_host_address_clean_up(&callback_data.aaaa_address);
+        aws_host_address_clean_up(&callback_data.a_address);
+        callback_data.invoked = false;
+        callback_data.has_aaaa_address = false;
+        callback_data.has_a_address = false;
+        ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+
+        /* an older cache is already in place */
+        FILE *old_cache_file = fopen(s_test_cache_file_name, "wb");
+        ASSERT_NOT_NULL(old_cache_file);
+        ASSERT_UINT_EQUALS(4, fwrite("DNSC", 1, 4, old_cache_file));
+        fclose(old_cache_file);
+
+        ASSERT_SUCCESS(aws_host_resolver_save_cache(resolver, s_test_cache_file_name));
+
+        FILE *tmp_cache_file = fopen(s_test_cache_tmp_file_name, "rb");
+        if (tmp_cache_file != NULL) {
+            fclose(tmp_cache_file);
+        }
+        ASSERT_NULL(tmp_cache_file);
+
+        aws_host_resolver_release(resolver);
+    }
+
+    /* load into a resolver that can't resolve anything */
+    {
+        config.impl_data = &failing_resolver;
+
+        struct aws_host_resolver *resolver = aws_host_resolver_new_default(allocator, &resolver_options);
+        ASSERT_NOT_NULL(resolver);
+        ASSERT_SUCCESS(aws_host_resolver_load_cache(resolver, s_test_cache_file_name));
+
+        ASSERT_SUCCESS(aws_host_resolver_resolve_host(
+            resolver, host_name, s_default_host_resolved_test_callback, &config, &callback_data));
+
+        /* answered from the file before the call returned */
+        ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+        ASSERT_TRUE(callback_data.invoked);
+        ASSERT_TRUE(callback_data.has_aaaa_address);
+        ASSERT_TRUE(callback_data.has_a_address);
+        ASSERT_BIN_ARRAYS_EQUALS(
+            aws_string_bytes(addr1_ipv6),
+            addr1_ipv6->len,
+            aws_string_bytes(callback_data.aaaa_address.address),
+            callback_data.aaaa_address.address->len);
+        ASSERT_BIN_ARRAYS_EQUALS(
+            aws_string_bytes(addr1_ipv4),
+            addr1_ipv4->len,
+            aws_string_bytes(callback_data.a_address.address),
+            callback_data.a_address.address->len);
+        aws_host_address_clean_up(&callback_data.aaaa_address);
+        aws_host_address_clean_up(&callback_data.a_address);
+        ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+
+        aws_host_resolver_release(resolver);
+    }
+
+    /* a truncated file loads nothing */
+    {
+        remove(s_test_cache_file_name);
+        FILE *cache_file = fopen(s_test_cache_file_name, "wb");
+        ASSERT_NOT_NULL(cache_file);
+        ASSERT_UINT_EQUALS(4, fwrite("DNSC", 1, 4, cache_file));
+        fclose(cache_file);
+
+        struct aws_host_resolver *resolver = aws_host_resolver_new_default(allocator, &resolver_options);
+        ASSERT_NOT_NULL(resolver);
+        ASSERT_ERROR(AWS_IO_FILE_VALIDATION_FAILURE, aws_host_resolver_load_cache(resolver, s_test_cache_file_name));
+        aws_host_resolver_release(resolver);
+    }
+
+    remove(s_test_cache_file_name);
+
+    mock_dns_resolver_clean_up(&mock_resolver);
+    mock_dns_resolver_clean_up(&failing_resolver);
+    aws_string_destroy((void *)host_name);
+    aws_string_destroy((void *)addr1_ipv4);
+    aws_string_destroy((void *)addr1_ipv6);
+    aws_event_loop_group_release(el_group);
+    ASSERT_SUCCESS(aws_global_thread_creator_shutdown_wait_for(10));
+
+    aws_io_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(test_resolver_cache_file_round_trip, s_test_resolver_cache_file_round_trip_fn)
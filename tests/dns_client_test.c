@@ -0,0 +1,651 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+/* the dns client, and the stub server these tests talk to, are POSIX only */
+#ifndef _WIN32
+
+#    include <aws/io/dns_client.h>
+
+#    include <aws/common/atomics.h>
+#    include <aws/common/clock.h>
+#    include <aws/common/condition_variable.h>
+#    include <aws/common/string.h>
+#    include <aws/common/thread.h>
+
+#    include <aws/io/event_loop.h>
+#    include <aws/io/host_resolver.h>
+
+#    include <aws/testing/aws_test_harness.h>
+
+#    include <arpa/inet.h>
+#    include <netinet/in.h>
+#    include <poll.h>
+#    include <stdio.h>
+#    include <sys/socket.h>
+#    include <unistd.h>
+
+static const char *s_stub_host_name = "stub.test";
+static const char *s_stub_alias_name = "alias.stub.test";
+static const char *s_stub_mismatch_name = "mismatch.test";
+static const char *s_test_hosts_path = "dns_client_test_hosts";
+
+/*
+ * A tiny nameserver on 127.0.0.1 that knows a single name: stub.test has A 10.1.2.3 (ttl 30) and AAAA fd00::1
+ * (ttl 60). alias.stub.test is a CNAME for it, answered along with a stray record for an unrelated name, and
+ * mismatch.test is answered as if the other record type had been asked for. Everything else is NXDOMAIN. It answers
+ * over UDP and TCP on the same port.
+ */
+struct stub_dns_server {
+    int udp_fd;
+    int tcp_fd;
+    uint16_t port;
+    /* answer UDP queries with just the TC bit, so clients have to come back over TCP */
+    bool truncate_udp;
+    struct aws_thread thread;
+    struct aws_atomic_var stop;
+    struct aws_atomic_var udp_queries;
+    struct aws_atomic_var tcp_queries;
+};
+
+/* Builds the answer to query into response, returns its length or 0 if the query is garbage. */
+static size_t s_stub_dns_build_response(
+    const uint8_t *query,
+    size_t query_len,
+    uint8_t *response,
+    size_t response_capacity,
+    bool truncate) {
+
+    if (query_len < 12 + 5 || response_capacity < 512) {
+        return 0;
+    }
+
+    /* decode the question's name as dotted text */
+    char name[256];
+    size_t name_len = 0;
+    size_t offset = 12;
+    while (offset < query_len && query[offset] != 0) {
+        size_t label_len = query[offset++];
+        if (offset + label_len > query_len || name_len + label_len + 1 >= sizeof(name)) {
+            return 0;
+        }
+        if (name_len > 0) {
+            name[name_len++] = '.';
+        }
+        memcpy(name + name_len, query + offset, label_len);
+        name_len += label_len;
+        offset += label_len;
+    }
+    name[name_len] = '\0';
+
+    /* root label, type, class */
+    size_t question_end = offset + 5;
+    if (question_end > query_len) {
+        return 0;
+    }
+    uint16_t type = (uint16_t)((query[offset + 1] << 8) | query[offset + 2]);
+
+    bool alias = strcmp(name, s_stub_alias_name) == 0;
+    bool mismatch = strcmp(name, s_stub_mismatch_name) == 0;
+    bool known = strcmp(name, s_stub_host_name) == 0 || alias || mismatch;
+    uint16_t flags = 0x8180;
+    if (!known) {
+        flags |= 3;
+    } else if (truncate) {
+        flags |= 0x0200;
+    }
+
+    bool answer = known && !truncate && (type == 1 || type == 28);
+
+    memcpy(response, query, question_end);
+    response[2] = (uint8_t)(flags >> 8);
+    response[3] = (uint8_t)flags;
+    /* one question, maybe some answers, nothing else */
+    memset(response + 4, 0, 8);
+    response[5] = 1;
+    if (mismatch) {
+        response[offset + 2] = type == 1 ? 28 : 1;
+    }
+
+    size_t len = question_end;
+    if (answer) {
+        const uint8_t a_data[] = {10, 1, 2, 3};
+        const uint8_t aaaa_data[] = {0xfd, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+        const uint8_t *data = type == 1 ? a_data : aaaa_data;
+        uint8_t data_len = type == 1 ? sizeof(a_data) : sizeof(aaaa_data);
+        uint8_t ttl = type == 1 ? 30 : 60;
+
+        /* the address record's owner is the question's name, or for the alias, the "stub.test" inside it */
+        uint8_t owner_offset = 0x0C;
+        if (alias) {
+            owner_offset = 0x0C + 6;
+
+            /* the CNAME, and a record for another name that mustn't be taken as an answer */
+            const uint8_t cname[] = {0xC0, 0x0C, 0, 5, 0, 1, 0, 0, 0, ttl, 0, 2, 0xC0, owner_offset};
+            memcpy(response + len, cname, sizeof(cname));
+            len += sizeof(cname);
+
+            const uint8_t stray[] = {
+                5, 'o', 't', 'h', 'e', 'r', 4, 't', 'e', 's', 't', 0, /* other.test */
+                0, (uint8_t)type, 0, 1, 0, 0, 0, ttl, 0, data_len};
+            memcpy(response + len, stray, sizeof(stray));
+            len += sizeof(stray);
+            memset(response + len, 6, data_len);
+            len += data_len;
+            response[7] += 2;
+        }
+
+        /* a pointer to the owner's name, type, class IN, ttl, then the address */
+        const uint8_t record[] = {0xC0, owner_offset, 0, (uint8_t)type, 0, 1, 0, 0, 0, ttl, 0, data_len};
+        memcpy(response + len, record, sizeof(record));
+        len += sizeof(record);
+        memcpy(response + len, data, data_len);
+        len += data_len;
+        response[7] += 1;
+    }
+
+    return len;
+}
+
+static void s_stub_dns_serve_tcp(struct stub_dns_server *server) {
+    int fd = accept(server->tcp_fd, NULL, NULL);
+    if (fd < 0) {
+        return;
+    }
+
+    uint8_t query[514];
+    size_t query_len = 0;
+    ssize_t amount_read = 0;
+    while ((amount_read = read(fd, query + query_len, sizeof(query) - query_len)) > 0) {
+        query_len += (size_t)amount_read;
+        if (query_len >= 2 && query_len >= 2 + (size_t)((query[0] << 8) | query[1])) {
+            break;
+        }
+    }
+
+    uint8_t response[514];
+    size_t response_len =
+        query_len > 2 ? s_stub_dns_build_response(query + 2, query_len - 2, response + 2, sizeof(response) - 2, false)
+                      : 0;
+    if (response_len > 0) {
+        aws_atomic_fetch_add(&server->tcp_queries, 1);
+        response[0] = (uint8_t)(response_len >> 8);
+        response[1] = (uint8_t)response_len;
+        ssize_t written = write(fd, response, response_len + 2);
+        (void)written;
+    }
+
+    close(fd);
+}
+
+static void s_stub_dns_serve_udp(struct stub_dns_server *server) {
+    uint8_t query[512];
+    struct sockaddr_storage from;
+    socklen_t from_len = sizeof(from);
+    ssize_t query_len = recvfrom(server->udp_fd, query, sizeof(query), 0, (struct sockaddr *)&from, &from_len);
+    if (query_len <= 0) {
+        return;
+    }
+
+    uint8_t response[512];
+    size_t response_len =
+        s_stub_dns_build_response(query, (size_t)query_len, response, sizeof(response), server->truncate_udp);
+    if (response_len > 0) {
+        aws_atomic_fetch_add(&server->udp_queries, 1);
+        sendto(server->udp_fd, response, response_len, 0, (struct sockaddr *)&from, from_len);
+    }
+}
+
+static void s_stub_dns_server_thread_fn(void *arg) {
+    struct stub_dns_server *server = arg;
+
+    while (!aws_atomic_load_int(&server->stop)) {
+        struct pollfd fds[2] = {
+            {.fd = server->udp_fd, .events = POLLIN},
+            {.fd = server->tcp_fd, .events = POLLIN},
+        };
+
+        if (poll(fds, 2, 50) <= 0) {
+            continue;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            s_stub_dns_serve_udp(server);
+        }
+
+        if (fds[1].revents & POLLIN) {
+            s_stub_dns_serve_tcp(server);
+        }
+    }
+}
+
+/* Binds a socket of the given type to 127.0.0.1, on port if it's not 0. */
+static int s_bind_loopback(int type, uint16_t port, uint16_t *bound_port) {
+    int fd = socket(AF_INET, type, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct sockaddr_in addr;
+    AWS_ZERO_STRUCT(addr);
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    socklen_t addr_len = sizeof(addr);
+    if (bind(fd, (struct sockaddr *)&addr, addr_len) || getsockname(fd, (struct sockaddr *)&addr, &addr_len)) {
+        close(fd);
+        return -1;
+    }
+
+    *bound_port = ntohs(addr.sin_port);
+    return fd;
+}
+
+static int s_stub_dns_server_start(struct aws_allocator *allocator, struct stub_dns_server *server, bool truncate) {
+    AWS_ZERO_STRUCT(*server);
+    server->truncate_udp = truncate;
+    aws_atomic_init_int(&server->stop, 0);
+    aws_atomic_init_int(&server->udp_queries, 0);
+    aws_atomic_init_int(&server->tcp_queries, 0);
+
+    server->udp_fd = s_bind_loopback(SOCK_DGRAM, 0, &server->port);
+    ASSERT_TRUE(server->udp_fd >= 0);
+
+    uint16_t tcp_port = 0;
+    server->tcp_fd = s_bind_loopback(SOCK_STREAM, server->port, &tcp_port);
+    ASSERT_TRUE(server->tcp_fd >= 0);
+    ASSERT_SUCCESS(listen(server->tcp_fd, 8));
+
+    ASSERT_SUCCESS(aws_thread_init(&server->thread, allocator));
+    ASSERT_SUCCESS(aws_thread_launch(&server->thread, s_stub_dns_server_thread_fn, server, NULL));
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_stub_dns_server_stop(struct stub_dns_server *server) {
+    aws_atomic_store_int(&server->stop, 1);
+    aws_thread_join(&server->thread);
+    aws_thread_clean_up(&server->thread);
+    close(server->udp_fd);
+    close(server->tcp_fd);
+}
+
+#    define MAX_TEST_ADDRESSES 4
+
+struct dns_client_test_result {
+    struct aws_mutex mutex;
+    struct aws_condition_variable signal;
+    bool completed;
+    int error_code;
+    struct aws_host_address addresses[MAX_TEST_ADDRESSES];
+    size_t address_count;
+};
+
+static void s_copy_addresses(struct dns_client_test_result *result, const struct aws_array_list *addresses) {
+    for (size_t i = 0; addresses && i < aws_array_list_length(addresses) && i < MAX_TEST_ADDRESSES; ++i) {
+        struct aws_host_address *address = NULL;
+        aws_array_list_get_at_ptr(addresses, (void **)&address, i);
+        aws_host_address_copy(address, &result->addresses[result->address_count++]);
+    }
+}
+
+static void s_on_dns_client_resolved(
+    struct aws_dns_client *client,
+    const struct aws_string *host_name,
+    int error_code,
+    const struct aws_array_list *addresses,
+    void *user_data) {
+
+    (void)client;
+    (void)host_name;
+    struct dns_client_test_result *result = user_data;
+
+    aws_mutex_lock(&result->mutex);
+    result->error_code = error_code;
+    s_copy_addresses(result, addresses);
+    result->completed = true;
+    aws_condition_variable_notify_one(&result->signal);
+    aws_mutex_unlock(&result->mutex);
+}
+
+static void s_on_host_resolver_resolved(
+    struct aws_host_resolver *resolver,
+    const struct aws_string *host_name,
+    int err_code,
+    const struct aws_array_list *host_addresses,
+    void *user_data) {
+
+    (void)resolver;
+    s_on_dns_client_resolved(NULL, host_name, err_code, host_addresses, user_data);
+}
+
+static bool s_dns_client_test_completed(void *arg) {
+    struct dns_client_test_result *result = arg;
+    return result->completed;
+}
+
+static void s_dns_client_test_result_init(struct dns_client_test_result *result) {
+    AWS_ZERO_STRUCT(*result);
+    aws_mutex_init(&result->mutex);
+    aws_condition_variable_init(&result->signal);
+}
+
+static void s_dns_client_test_result_clean_up(struct dns_client_test_result *result) {
+    for (size_t i = 0; i < result->address_count; ++i) {
+        aws_host_address_clean_up(&result->addresses[i]);
+    }
+    aws_condition_variable_clean_up(&result->signal);
+    aws_mutex_clean_up(&result->mutex);
+}
+
+/* Resolves host_name with the client and waits for the outcome. */
+static int s_dns_client_resolve_and_wait(
+    struct aws_allocator *allocator,
+    struct aws_dns_client *client,
+    const char *host_name,
+    struct dns_client_test_result *result) {
+
+    s_dns_client_test_result_init(result);
+
+    struct aws_string *name = aws_string_new_from_c_str(allocator, host_name);
+    ASSERT_NOT_NULL(name);
+
+    ASSERT_SUCCESS(aws_mutex_lock(&result->mutex));
+    ASSERT_SUCCESS(aws_dns_client_resolve(client, name, s_on_dns_client_resolved, result));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(&result->signal, &result->mutex, s_dns_client_test_completed, result));
+    ASSERT_SUCCESS(aws_mutex_unlock(&result->mutex));
+
+    aws_string_destroy(name);
+    return AWS_OP_SUCCESS;
+}
+
+static struct aws_host_address *s_find_address(
+    struct dns_client_test_result *result,
+    enum aws_address_record_type record_type) {
+
+    for (size_t i = 0; i < result->address_count; ++i) {
+        if (result->addresses[i].record_type == record_type) {
+            return &result->addresses[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Checks that the address was answered with the given ttl, give or take the time the test took. */
+static int s_assert_address(
+    struct dns_client_test_result *result,
+    enum aws_address_record_type record_type,
+    const char *expected,
+    uint64_t ttl_secs,
+    uint64_t start_ns) {
+
+    struct aws_host_address *address = s_find_address(result, record_type);
+    ASSERT_NOT_NULL(address);
+    ASSERT_STR_EQUALS(expected, aws_string_c_str(address->address));
+    ASSERT_STR_EQUALS(s_stub_host_name, aws_string_c_str(address->host));
+
+    uint64_t end_ns = 0;
+    ASSERT_SUCCESS(aws_sys_clock_get_ticks(&end_ns));
+    uint64_t ttl_ns = aws_timestamp_convert(ttl_secs, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL);
+    ASSERT_TRUE(address->expiry >= start_ns + ttl_ns);
+    ASSERT_TRUE(address->expiry <= end_ns + ttl_ns);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_dns_client_resolve_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_io_library_init(allocator);
+
+    struct stub_dns_server server;
+    ASSERT_SUCCESS(s_stub_dns_server_start(allocator, &server, false));
+
+    remove(s_test_hosts_path);
+    FILE *hosts_file = fopen(s_test_hosts_path, "w");
+    ASSERT_NOT_NULL(hosts_file);
+    fprintf(hosts_file, "# static entries\n10.9.8.7\tstatic.test  alias.test # trailing comment\n");
+    fclose(hosts_file);
+
+    struct aws_event_loop_group *el_group = aws_event_loop_group_new_default(allocator, 1, NULL);
+
+    struct aws_socket_endpoint nameserver = {.address = "127.0.0.1", .port = server.port};
+    struct aws_dns_client_options options = {
+        .el_group = el_group,
+        .resolv_conf_path = "dns_client_test_resolv_conf_does_not_exist",
+        .hosts_path = s_test_hosts_path,
+        .nameservers = &nameserver,
+        .nameserver_count = 1,
+    };
+    struct aws_dns_client *client = aws_dns_client_new(allocator, &options);
+    ASSERT_NOT_NULL(client);
+
+    /* A and AAAA together, each with its record's ttl */
+    uint64_t start_ns = 0;
+    ASSERT_SUCCESS(aws_sys_clock_get_ticks(&start_ns));
+    struct dns_client_test_result result;
+    ASSERT_SUCCESS(s_dns_client_resolve_and_wait(allocator, client, s_stub_host_name, &result));
+    ASSERT_SUCCESS(result.error_code);
+    ASSERT_UINT_EQUALS(2, result.address_count);
+    ASSERT_SUCCESS(s_assert_address(&result, AWS_ADDRESS_RECORD_TYPE_A, "10.1.2.3", 30, start_ns));
+    ASSERT_SUCCESS(s_assert_address(&result, AWS_ADDRESS_RECORD_TYPE_AAAA, "fd00::1", 60, start_ns));
+    ASSERT_INT_EQUALS(2, aws_atomic_load_int(&server.udp_queries));
+    s_dns_client_test_result_clean_up(&result);
+
+    /* hosts file entries and address literals never reach the nameserver */
+    ASSERT_SUCCESS(s_dns_client_resolve_and_wait(allocator, client, "ALIAS.test.", &result));
+    ASSERT_SUCCESS(result.error_code);
+    ASSERT_UINT_EQUALS(1, result.address_count);
+    ASSERT_STR_EQUALS("10.9.8.7", aws_string_c_str(result.addresses[0].address));
+    s_dns_client_test_result_clean_up(&result);
+
+    ASSERT_SUCCESS(s_dns_client_resolve_and_wait(allocator, client, "::1", &result));
+    ASSERT_SUCCESS(result.error_code);
+    ASSERT_UINT_EQUALS(1, result.address_count);
+    ASSERT_INT_EQUALS(AWS_ADDRESS_RECORD_TYPE_AAAA, result.addresses[0].record_type);
+    s_dns_client_test_result_clean_up(&result);
+    ASSERT_INT_EQUALS(2, aws_atomic_load_int(&server.udp_queries));
+
+    /* and the default host resolver can use the client in place of getaddrinfo() */
+    struct aws_host_resolver_default_options resolver_options = {
+        .el_group = el_group,
+        .max_entries = 10,
+    };
+    struct aws_host_resolver *resolver = aws_host_resolver_new_default(allocator, &resolver_options);
+    ASSERT_NOT_NULL(resolver);
+
+    struct aws_host_resolution_config config = {
+        .max_ttl = 10,
+        .impl = aws_dns_client_resolve_host,
+        .impl_data = client,
+    };
+
+    struct aws_string *host_name = aws_string_new_from_c_str(allocator, s_stub_host_name);
+    s_dns_client_test_result_init(&result);
+    ASSERT_SUCCESS(aws_mutex_lock(&result.mutex));
+    ASSERT_SUCCESS(aws_host_resolver_resolve_host(resolver, host_name, s_on_host_resolver_resolved, &config, &result));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(&result.signal, &result.mutex, s_dns_client_test_completed, &result));
+    ASSERT_SUCCESS(aws_mutex_unlock(&result.mutex));
+    ASSERT_SUCCESS(result.error_code);
+    ASSERT_NOT_NULL(s_find_address(&result, AWS_ADDRESS_RECORD_TYPE_A));
+    ASSERT_NOT_NULL(s_find_address(&result, AWS_ADDRESS_RECORD_TYPE_AAAA));
+    s_dns_client_test_result_clean_up(&result);
+
+    aws_host_resolver_release(resolver);
+    aws_string_destroy(host_name);
+    aws_dns_client_release(client);
+    aws_event_loop_group_release(el_group);
+    ASSERT_SUCCESS(aws_global_thread_creator_shutdown_wait_for(10));
+
+    s_stub_dns_server_stop(&server);
+    remove(s_test_hosts_path);
+    aws_io_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(dns_client_resolve, s_test_dns_client_resolve_fn)
+
+static int s_test_dns_client_retry_and_tcp_fallback_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_io_library_init(allocator);
+
+    struct stub_dns_server server;
+    ASSERT_SUCCESS(s_stub_dns_server_start(allocator, &server, true /* truncate_udp */));
+
+    /* the first nameserver takes queries but never answers */
+    uint16_t silent_port = 0;
+    int silent_fd = s_bind_loopback(SOCK_DGRAM, 0, &silent_port);
+    ASSERT_TRUE(silent_fd >= 0);
+
+    struct aws_event_loop_group *el_group = aws_event_loop_group_new_default(allocator, 1, NULL);
+
+    struct aws_socket_endpoint nameservers[] = {
+        {.address = "127.0.0.1", .port = silent_port},
+        {.address = "127.0.0.1", .port = server.port},
+    };
+    struct aws_dns_client_options options = {
+        .el_group = el_group,
+        .resolv_conf_path = "dns_client_test_resolv_conf_does_not_exist",
+        .hosts_path = "dns_client_test_hosts_does_not_exist",
+        .nameservers = nameservers,
+        .nameserver_count = AWS_ARRAY_SIZE(nameservers),
+        .timeout_ms = 200,
+        .attempts = 1,
+    };
+    struct aws_dns_client *client = aws_dns_client_new(allocator, &options);
+    ASSERT_NOT_NULL(client);
+
+    /* times out on the first nameserver, gets truncated answers from the second, and asks it again over TCP */
+    uint64_t start_ns = 0;
+    ASSERT_SUCCESS(aws_sys_clock_get_ticks(&start_ns));
+    struct dns_client_test_result result;
+    ASSERT_SUCCESS(s_dns_client_resolve_and_wait(allocator, client, s_stub_host_name, &result));
+    ASSERT_SUCCESS(result.error_code);
+    ASSERT_UINT_EQUALS(2, result.address_count);
+    ASSERT_SUCCESS(s_assert_address(&result, AWS_ADDRESS_RECORD_TYPE_A, "10.1.2.3", 30, start_ns));
+    ASSERT_SUCCESS(s_assert_address(&result, AWS_ADDRESS_RECORD_TYPE_AAAA, "fd00::1", 60, start_ns));
+    ASSERT_INT_EQUALS(2, aws_atomic_load_int(&server.udp_queries));
+    ASSERT_INT_EQUALS(2, aws_atomic_load_int(&server.tcp_queries));
+    s_dns_client_test_result_clean_up(&result);
+
+    aws_dns_client_release(client);
+    aws_event_loop_group_release(el_group);
+    ASSERT_SUCCESS(aws_global_thread_creator_shutdown_wait_for(10));
+
+    close(silent_fd);
+    s_stub_dns_server_stop(&server);
+    aws_io_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(dns_client_retry_and_tcp_fallback, s_test_dns_client_retry_and_tcp_fallback_fn)
+
+static int s_test_dns_client_nxdomain_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_io_library_init(allocator);
+
+    struct stub_dns_server server;
+    ASSERT_SUCCESS(s_stub_dns_server_start(allocator, &server, false));
+
+    struct aws_event_loop_group *el_group = aws_event_loop_group_new_default(allocator, 1, NULL);
+
+    struct aws_socket_endpoint nameserver = {.address = "127.0.0.1", .port = server.port};
+    struct aws_dns_client_options options = {
+        .el_group = el_group,
+        .resolv_conf_path = "dns_client_test_resolv_conf_does_not_exist",
+        .hosts_path = "dns_client_test_hosts_does_not_exist",
+        .nameservers = &nameserver,
+        .nameserver_count = 1,
+    };
+    struct aws_dns_client *client = aws_dns_client_new(allocator, &options);
+    ASSERT_NOT_NULL(client);
+
+    struct dns_client_test_result result;
+    ASSERT_SUCCESS(s_dns_client_resolve_and_wait(allocator, client, "missing.test", &result));
+    ASSERT_INT_EQUALS(AWS_IO_DNS_INVALID_NAME, result.error_code);
+    ASSERT_UINT_EQUALS(0, result.address_count);
+    s_dns_client_test_result_clean_up(&result);
+
+    /* names that can't be encoded fail without a query */
+    ASSERT_SUCCESS(s_dns_client_resolve_and_wait(allocator, client, "empty..label", &result));
+    ASSERT_INT_EQUALS(AWS_IO_DNS_INVALID_NAME, result.error_code);
+    s_dns_client_test_result_clean_up(&result);
+    ASSERT_INT_EQUALS(2, aws_atomic_load_int(&server.udp_queries));
+
+    aws_dns_client_release(client);
+    aws_event_loop_group_release(el_group);
+    ASSERT_SUCCESS(aws_global_thread_creator_shutdown_wait_for(10));
+
+    s_stub_dns_server_stop(&server);
+    aws_io_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(dns_client_nxdomain, s_test_dns_client_nxdomain_fn)
+
+static int s_test_dns_client_answer_validation_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_io_library_init(allocator);
+
+    struct stub_dns_server server;
+    ASSERT_SUCCESS(s_stub_dns_server_start(allocator, &server, false));
+
+    struct aws_event_loop_group *el_group = aws_event_loop_group_new_default(allocator, 1, NULL);
+
+    struct aws_socket_endpoint nameserver = {.address = "127.0.0.1", .port = server.port};
+    struct aws_dns_client_options options = {
+        .el_group = el_group,
+        .resolv_conf_path = "dns_client_test_resolv_conf_does_not_exist",
+        .hosts_path = "dns_client_test_hosts_does_not_exist",
+        .nameservers = &nameserver,
+        .nameserver_count = 1,
+        .timeout_ms = 200,
+        .attempts = 1,
+    };
+    struct aws_dns_client *client = aws_dns_client_new(allocator, &options);
+    ASSERT_NOT_NULL(client);
+
+    /* the records at the end of the CNAME chain are taken, the one for an unrelated name isn't */
+    uint64_t start_ns = 0;
+    ASSERT_SUCCESS(aws_sys_clock_get_ticks(&start_ns));
+    struct dns_client_test_result result;
+    ASSERT_SUCCESS(s_dns_client_resolve_and_wait(allocator, client, s_stub_alias_name, &result));
+    ASSERT_SUCCESS(result.error_code);
+    ASSERT_UINT_EQUALS(2, result.address_count);
+    struct aws_host_address *address = s_find_address(&result, AWS_ADDRESS_RECORD_TYPE_A);
+    ASSERT_NOT_NULL(address);
+    ASSERT_STR_EQUALS("10.1.2.3", aws_string_c_str(address->address));
+    address = s_find_address(&result, AWS_ADDRESS_RECORD_TYPE_AAAA);
+    ASSERT_NOT_NULL(address);
+    ASSERT_STR_EQUALS("fd00::1", aws_string_c_str(address->address));
+    s_dns_client_test_result_clean_up(&result);
+
+    /* answers to a question that wasn't asked are ignored, so the queries time out */
+    ASSERT_SUCCESS(s_dns_client_resolve_and_wait(allocator, client, s_stub_mismatch_name, &result));
+    ASSERT_INT_EQUALS(AWS_IO_DNS_QUERY_FAILED, result.error_code);
+    ASSERT_UINT_EQUALS(0, result.address_count);
+    s_dns_client_test_result_clean_up(&result);
+    ASSERT_INT_EQUALS(4, aws_atomic_load_int(&server.udp_queries));
+
+    aws_dns_client_release(client);
+    aws_event_loop_group_release(el_group);
+    ASSERT_SUCCESS(aws_global_thread_creator_shutdown_wait_for(10));
+
+    s_stub_dns_server_stop(&server);
+    aws_io_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(dns_client_answer_validation, s_test_dns_client_answer_validation_fn)
+
+#endif /* _WIN32 */
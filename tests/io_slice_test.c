@@ -0,0 +1,142 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/io/io_slice.h>
+
+#include <aws/testing/aws_test_harness.h>
+
+static struct aws_io_buffer *s_buffer_from_c_str(struct aws_allocator *allocator, const char *str) {
+    struct aws_byte_cursor cursor = aws_byte_cursor_from_c_str(str);
+    struct aws_io_buffer *buffer = aws_io_buffer_new(allocator, cursor.len);
+    if (buffer) {
+        aws_byte_buf_write_from_whole_cursor(&buffer->data, cursor);
+    }
+    return buffer;
+}
+
+static int s_chain_equals(struct aws_io_slice_chain *chain, const char *expected) {
+    struct aws_byte_cursor expected_cur = aws_byte_cursor_from_c_str(expected);
+    ASSERT_UINT_EQUALS(expected_cur.len, chain->len);
+
+    size_t slice_count = 0;
+    for (struct aws_linked_list_node *node = aws_linked_list_begin(&chain->slices);
+         node != aws_linked_list_end(&chain->slices);
+         node = aws_linked_list_next(node)) {
+        struct aws_io_slice *slice = AWS_CONTAINER_OF(node, struct aws_io_slice, node);
+        struct aws_byte_cursor expected_part = aws_byte_cursor_advance(&expected_cur, slice->cursor.len);
+        ASSERT_BIN_ARRAYS_EQUALS(expected_part.ptr, expected_part.len, slice->cursor.ptr, slice->cursor.len);
+        ++slice_count;
+    }
+
+    ASSERT_UINT_EQUALS(0, expected_cur.len);
+    ASSERT_UINT_EQUALS(slice_count, chain->slice_count);
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_io_slice_chain_append_prepend(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_io_buffer *header = s_buffer_from_c_str(allocator, "HDR:");
+    struct aws_io_buffer *payload = s_buffer_from_c_str(allocator, "payload");
+    ASSERT_NOT_NULL(header);
+    ASSERT_NOT_NULL(payload);
+
+    struct aws_io_slice_chain chain;
+    aws_io_slice_chain_init(&chain, allocator);
+
+    ASSERT_SUCCESS(aws_io_slice_chain_append(&chain, payload, aws_byte_cursor_from_buf(&payload->data)));
+    ASSERT_SUCCESS(aws_io_slice_chain_prepend(&chain, header, aws_byte_cursor_from_buf(&header->data)));
+    ASSERT_SUCCESS(s_chain_equals(&chain, "HDR:payload"));
+
+    /* a range outside the buffer is rejected */
+    struct aws_byte_cursor bad_range = aws_byte_cursor_from_buf(&payload->data);
+    bad_range.len += 1;
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_io_slice_chain_append(&chain, payload, bad_range));
+    ASSERT_UINT_EQUALS(2, chain.slice_count);
+
+    /* the chain holds its own references, so the buffers outlive ours */
+    ASSERT_INT_EQUALS(2, aws_atomic_load_int(&payload->ref_count));
+    aws_io_buffer_release(header);
+    aws_io_buffer_release(payload);
+    ASSERT_SUCCESS(s_chain_equals(&chain, "HDR:payload"));
+
+    aws_io_slice_chain_clean_up(&chain);
+    ASSERT_UINT_EQUALS(0, chain.len);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(io_slice_chain_append_prepend, s_test_io_slice_chain_append_prepend)
+
+static int s_test_io_slice_chain_split(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_io_buffer *first = s_buffer_from_c_str(allocator, "abcdef");
+    struct aws_io_buffer *second = s_buffer_from_c_str(allocator, "ghij");
+    ASSERT_NOT_NULL(first);
+    ASSERT_NOT_NULL(second);
+
+    struct aws_io_slice_chain chain;
+    aws_io_slice_chain_init(&chain, allocator);
+    ASSERT_SUCCESS(aws_io_slice_chain_append(&chain, first, aws_byte_cursor_from_buf(&first->data)));
+    ASSERT_SUCCESS(aws_io_slice_chain_append(&chain, second, aws_byte_cursor_from_buf(&second->data)));
+    aws_io_buffer_release(second);
+
+    struct aws_io_slice_chain tail;
+    aws_io_slice_chain_init(&tail, allocator);
+
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_io_slice_chain_split(&chain, 11, &tail));
+
+    /* splitting inside the first slice leaves both halves sharing its buffer */
+    ASSERT_SUCCESS(aws_io_slice_chain_split(&chain, 4, &tail));
+    ASSERT_SUCCESS(s_chain_equals(&chain, "abcd"));
+    ASSERT_SUCCESS(s_chain_equals(&tail, "efghij"));
+    ASSERT_INT_EQUALS(3, aws_atomic_load_int(&first->ref_count));
+
+    /* splitting on a slice boundary just moves slices */
+    struct aws_io_slice_chain rest;
+    aws_io_slice_chain_init(&rest, allocator);
+    ASSERT_SUCCESS(aws_io_slice_chain_split(&tail, 2, &rest));
+    ASSERT_SUCCESS(s_chain_equals(&tail, "ef"));
+    ASSERT_SUCCESS(s_chain_equals(&rest, "ghij"));
+
+    /* and moving glues them back together */
+    aws_io_slice_chain_move(&chain, &tail);
+    aws_io_slice_chain_move(&chain, &rest);
+    ASSERT_SUCCESS(s_chain_equals(&chain, "abcdefghij"));
+    ASSERT_UINT_EQUALS(0, tail.len);
+    ASSERT_UINT_EQUALS(0, rest.slice_count);
+
+    aws_io_slice_chain_clean_up(&chain);
+    ASSERT_INT_EQUALS(1, aws_atomic_load_int(&first->ref_count));
+    aws_io_buffer_release(first);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(io_slice_chain_split, s_test_io_slice_chain_split)
+
+static int s_test_io_message_sliced_release(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_io_buffer *buffer = s_buffer_from_c_str(allocator, "sliced message payload");
+    ASSERT_NOT_NULL(buffer);
+
+    struct aws_io_message *message = aws_io_message_new_sliced(allocator);
+    ASSERT_NOT_NULL(message);
+    ASSERT_NOT_NULL(message->slices);
+    ASSERT_UINT_EQUALS(0, message->message_data.len);
+
+    ASSERT_SUCCESS(aws_io_slice_chain_append(message->slices, buffer, aws_byte_cursor_from_buf(&buffer->data)));
+    ASSERT_INT_EQUALS(2, aws_atomic_load_int(&buffer->ref_count));
+
+    /* releasing the message the usual way drops its slices too */
+    aws_mem_release(message->allocator, message);
+    ASSERT_INT_EQUALS(1, aws_atomic_load_int(&buffer->ref_count));
+    aws_io_buffer_release(buffer);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(io_message_sliced_release, s_test_io_message_sliced_release)
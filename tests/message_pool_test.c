@@ -0,0 +1,152 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/io/message_pool.h>
+
+#include <aws/testing/aws_test_harness.h>
+
+#define SEGMENT_COUNT 100
+
+static int s_test_memory_pool_grows_and_trims(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    /* 48 byte segments take up 64 bytes with their header, so 4 of them fit in each slab */
+    struct aws_memory_pool_options options = {
+        .alloc = allocator,
+        .segment_size = 48,
+        .min_segment_count = 2,
+        .slab_size = 256,
+    };
+
+    struct aws_memory_pool pool;
+    ASSERT_SUCCESS(aws_memory_pool_init_from_options(&pool, &options));
+    ASSERT_UINT_EQUALS(4, pool.slab_segment_count);
+
+    void *segments[SEGMENT_COUNT];
+    for (size_t i = 0; i < SEGMENT_COUNT; ++i) {
+        segments[i] = aws_memory_pool_acquire(&pool);
+        ASSERT_NOT_NULL(segments[i]);
+        memset(segments[i], 0xAB, options.segment_size);
+    }
+
+    /* one miss per slab the pool had to add */
+    ASSERT_UINT_EQUALS(SEGMENT_COUNT, pool.outstanding);
+    ASSERT_UINT_EQUALS(SEGMENT_COUNT, pool.slab_segment_count);
+    ASSERT_UINT_EQUALS(SEGMENT_COUNT / 4 - 1, pool.misses);
+    ASSERT_UINT_EQUALS(SEGMENT_COUNT - pool.misses, pool.hits);
+    /* every segment was out while slabs were added, room for all of them to come back must already be reserved */
+    ASSERT_TRUE(aws_array_list_capacity(&pool.stack) >= pool.slab_segment_count);
+
+    for (size_t i = 0; i < SEGMENT_COUNT; ++i) {
+        aws_memory_pool_release(&pool, segments[i]);
+    }
+    ASSERT_UINT_EQUALS(0, pool.outstanding);
+    ASSERT_UINT_EQUALS(SEGMENT_COUNT, aws_array_list_length(&pool.stack));
+
+    /* demand drops to a single segment at a time, so the slabs get handed back over the next couple of trims */
+    for (size_t i = 0; i < 2048; ++i) {
+        void *segment = aws_memory_pool_acquire(&pool);
+        ASSERT_NOT_NULL(segment);
+        aws_memory_pool_release(&pool, segment);
+    }
+
+    ASSERT_TRUE(pool.slab_segment_count >= options.min_segment_count);
+    ASSERT_TRUE(pool.slab_segment_count <= 8);
+
+    aws_memory_pool_clean_up(&pool);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(memory_pool_grows_and_trims, s_test_memory_pool_grows_and_trims)
+
+static int s_test_memory_pool_high_water_mark(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_memory_pool_options options = {
+        .alloc = allocator,
+        .segment_size = 128,
+        .max_segment_count = 4,
+    };
+
+    struct aws_memory_pool pool;
+    ASSERT_SUCCESS(aws_memory_pool_init_from_options(&pool, &options));
+    ASSERT_UINT_EQUALS(0, pool.slab_segment_count);
+
+    void *segments[6];
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(segments); ++i) {
+        segments[i] = aws_memory_pool_acquire(&pool);
+        ASSERT_NOT_NULL(segments[i]);
+    }
+
+    /* the first acquire adds the only slab the pool may have, the last two are allocated individually */
+    ASSERT_UINT_EQUALS(4, pool.slab_segment_count);
+    ASSERT_UINT_EQUALS(3, pool.hits);
+    ASSERT_UINT_EQUALS(3, pool.misses);
+    ASSERT_UINT_EQUALS(2, pool.fallbacks);
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(segments); ++i) {
+        aws_memory_pool_release(&pool, segments[i]);
+    }
+
+    ASSERT_UINT_EQUALS(0, pool.outstanding);
+    ASSERT_UINT_EQUALS(4, aws_array_list_length(&pool.stack));
+
+    aws_memory_pool_clean_up(&pool);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(memory_pool_high_water_mark, s_test_memory_pool_high_water_mark)
+
+static int s_test_message_pool_statistics(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_message_pool_creation_args args = {
+        .application_data_msg_data_size = 16 * 1024,
+        .application_data_msg_count = 2,
+        .small_block_msg_data_size = 128,
+        .small_block_msg_count = 2,
+        .additional_msg_data_sizes = {2 * 1024},
+    };
+
+    struct aws_message_pool msg_pool;
+    ASSERT_SUCCESS(aws_message_pool_init(&msg_pool, allocator, &args));
+    ASSERT_UINT_EQUALS(3, msg_pool.size_class_count);
+    /* the additional 2KB class reserves nothing until it's first used */
+    ASSERT_UINT_EQUALS(0, msg_pool.size_classes[1].slab_segment_count);
+
+    struct aws_io_message *small = aws_message_pool_acquire(&msg_pool, AWS_IO_MESSAGE_APPLICATION_DATA, 100);
+    struct aws_io_message *medium = aws_message_pool_acquire(&msg_pool, AWS_IO_MESSAGE_APPLICATION_DATA, 1500);
+    struct aws_io_message *large = aws_message_pool_acquire(&msg_pool, AWS_IO_MESSAGE_APPLICATION_DATA, 64 * 1024);
+    ASSERT_NOT_NULL(small);
+    ASSERT_NOT_NULL(medium);
+    ASSERT_NOT_NULL(large);
+    ASSERT_UINT_EQUALS(100, small->message_data.capacity);
+    ASSERT_UINT_EQUALS(1500, medium->message_data.capacity);
+    /* nothing is large enough, so the largest class is used */
+    ASSERT_UINT_EQUALS(16 * 1024, large->message_data.capacity);
+
+    struct aws_message_pool_statistics stats;
+    aws_message_pool_get_statistics(&msg_pool, &stats);
+    ASSERT_UINT_EQUALS(2, stats.hits);
+    /* the first 2KB message grows its class by a slab */
+    ASSERT_UINT_EQUALS(1, stats.misses);
+    ASSERT_TRUE(msg_pool.size_classes[1].slab_segment_count > 0);
+    ASSERT_UINT_EQUALS(3, stats.outstanding);
+    ASSERT_TRUE(stats.bytes_reserved > 0);
+
+    aws_mem_release(small->allocator, small);
+    aws_mem_release(medium->allocator, medium);
+    aws_mem_release(large->allocator, large);
+
+    aws_message_pool_get_statistics(&msg_pool, &stats);
+    ASSERT_UINT_EQUALS(0, stats.outstanding);
+
+    aws_message_pool_clean_up(&msg_pool);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(message_pool_statistics, s_test_message_pool_statistics)
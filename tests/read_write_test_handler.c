@@ -23,6 +23,7 @@ struct rw_test_handler_impl {
     struct aws_condition_variable *destroy_condition_variable;
     rw_handler_driver_fn *on_read;
     rw_handler_driver_fn *on_write;
+    rw_handler_writability_fn *on_writability_changed;
     bool event_loop_driven;
     size_t window;
     struct aws_condition_variable condition_variable;
@@ -102,6 +103,17 @@ static int s_rw_handler_shutdown(
     return aws_channel_slot_on_handler_shutdown_complete(slot, dir, error_code, abort_immediately);
 }
 
+static void s_rw_handler_on_writability_changed(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    bool writable) {
+
+    struct rw_test_handler_impl *handler_impl = handler->impl;
+    if (handler_impl->on_writability_changed) {
+        handler_impl->on_writability_changed(handler, slot, writable, handler_impl->ctx);
+    }
+}
+
 static size_t s_rw_handler_message_overhead(struct aws_channel_handler *handler) {
     (void)handler;
     return 0;
@@ -132,6 +144,7 @@ struct aws_channel_handler_vtable s_rw_test_vtable = {
     .process_write_message = s_rw_handler_process_write_message,
     .destroy = s_rw_handler_destroy,
     .message_overhead = s_rw_handler_message_overhead,
+    .on_writability_changed = s_rw_handler_on_writability_changed,
 };
 
 struct aws_channel_handler *rw_handler_new(
@@ -171,6 +184,14 @@ void rw_handler_enable_wait_on_destroy(
     handler_impl->destroy_condition_variable = condition_variable;
 }
 
+void rw_handler_set_on_writability_changed(
+    struct aws_channel_handler *handler,
+    rw_handler_writability_fn *on_writability_changed) {
+
+    struct rw_test_handler_impl *handler_impl = handler->impl;
+    handler_impl->on_writability_changed = on_writability_changed;
+}
+
 void rw_handler_trigger_read(struct aws_channel_handler *handler, struct aws_channel_slot *slot) {
     struct rw_test_handler_impl *handler_impl = handler->impl;
 
@@ -21,6 +21,12 @@ typedef struct aws_byte_buf(rw_handler_driver_fn)(
     struct aws_byte_buf *data_read,
     void *ctx);
 
+typedef void(rw_handler_writability_fn)(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    bool writable,
+    void *ctx);
+
 struct aws_channel_handler *rw_handler_new(
     struct aws_allocator *allocator,
     rw_handler_driver_fn *on_read,
@@ -34,6 +40,11 @@ void rw_handler_enable_wait_on_destroy(
     struct aws_atomic_var *destroy_called,
     struct aws_condition_variable *condition_variable);
 
+/* on_writability_changed is called, with the handler's ctx, whenever the channel's writability changes */
+void rw_handler_set_on_writability_changed(
+    struct aws_channel_handler *handler,
+    rw_handler_writability_fn *on_writability_changed);
+
 void rw_handler_write(struct aws_channel_handler *handler, struct aws_channel_slot *slot, struct aws_byte_buf *buffer);
 
 void rw_handler_trigger_read(struct aws_channel_handler *handler, struct aws_channel_slot *slot);
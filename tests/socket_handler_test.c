@@ -190,8 +190,36 @@ struct socket_test_rw_args {
     size_t expected_read;
     bool invocation_happened;
     bool shutdown_finished;
+    size_t not_writable_count;
+    size_t writable_count;
 };
 
+static void s_socket_test_on_writability_changed(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    bool writable,
+    void *user_data) {
+
+    (void)handler;
+    (void)slot;
+
+    struct socket_test_rw_args *rw_args = (struct socket_test_rw_args *)user_data;
+
+    aws_mutex_lock(rw_args->mutex);
+    if (writable) {
+        rw_args->writable_count++;
+    } else {
+        rw_args->not_writable_count++;
+    }
+    aws_condition_variable_notify_one(rw_args->condition_variable);
+    aws_mutex_unlock(rw_args->mutex);
+}
+
+static bool s_socket_test_writable_again_predicate(void *user_data) {
+    struct socket_test_rw_args *rw_args = (struct socket_test_rw_args *)user_data;
+    return rw_args->writable_count > 0;
+}
+
 static bool s_socket_test_read_predicate(void *user_data) {
     struct socket_test_rw_args *rw_args = (struct socket_test_rw_args *)user_data;
     return rw_args->invocation_happened;
@@ -550,6 +578,522 @@ static int s_socket_close_test(struct aws_allocator *allocator, void *ctx) {
 
 AWS_TEST_CASE(socket_handler_close, s_socket_close_test)
 
+struct corked_write_task_args {
+    struct aws_channel_handler *rw_handler;
+    struct aws_channel_slot *rw_slot;
+    struct aws_byte_buf *parts;
+    size_t part_count;
+    /* shut the channel down while still corked, instead of uncorking */
+    bool shutdown_corked;
+    /* writes the socket handler made while the task ran */
+    uint32_t write_requests;
+    /* whether the channel was writable with every part queued, just before uncorking */
+    bool writable_while_corked;
+    struct aws_channel_task task;
+};
+
+/* must be called on the channel's thread */
+static uint32_t s_socket_handler_write_requests(struct aws_channel *channel) {
+    struct aws_channel_handler *socket_handler = aws_channel_get_first_slot(channel)->handler;
+
+    struct aws_array_list stats_list;
+    void *stats_storage[1];
+    aws_array_list_init_static(&stats_list, stats_storage, 1, sizeof(void *));
+    socket_handler->vtable->gather_statistics(socket_handler, &stats_list);
+
+    struct aws_crt_statistics_socket *socket_stats = NULL;
+    aws_array_list_get_at(&stats_list, &socket_stats, 0);
+    return socket_stats->write_requests;
+}
+
+/* writes every part while corked, so they all reach the socket in the same vectored write on uncork */
+static void s_corked_write_task(struct aws_channel_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    (void)status;
+    struct corked_write_task_args *task_args = arg;
+    struct aws_channel *channel = task_args->rw_slot->channel;
+    uint32_t write_requests_before = s_socket_handler_write_requests(channel);
+
+    aws_channel_slot_cork_writes(task_args->rw_slot);
+    for (size_t i = 0; i < task_args->part_count; ++i) {
+        rw_handler_write(task_args->rw_handler, task_args->rw_slot, &task_args->parts[i]);
+    }
+
+    if (task_args->shutdown_corked) {
+        aws_channel_shutdown(channel, AWS_OP_SUCCESS);
+        return;
+    }
+
+    task_args->writable_while_corked = aws_channel_is_writable(channel);
+    aws_channel_slot_uncork_writes(task_args->rw_slot);
+    task_args->write_requests = s_socket_handler_write_requests(channel) - write_requests_before;
+}
+
+static int s_socket_corked_writes_test(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    s_socket_common_tester_init(allocator, &c_tester);
+
+    struct aws_byte_buf parts[] = {
+        aws_byte_buf_from_c_str("I'm a little teapot, "),
+        aws_byte_buf_from_c_str("short and stout. "),
+        aws_byte_buf_from_c_str("Here is my handle, here is my spout."),
+    };
+    struct aws_byte_buf expected = aws_byte_buf_from_c_str(
+        "I'm a little teapot, short and stout. Here is my handle, here is my spout.");
+
+    uint8_t incoming_received_message[128] = {0};
+    uint8_t outgoing_received_message[128] = {0};
+
+    struct socket_test_rw_args incoming_rw_args;
+    ASSERT_SUCCESS(s_rw_args_init(
+        &incoming_rw_args,
+        &c_tester,
+        aws_byte_buf_from_empty_array(incoming_received_message, sizeof(incoming_received_message)),
+        (int)expected.len));
+
+    struct socket_test_rw_args outgoing_rw_args;
+    ASSERT_SUCCESS(s_rw_args_init(
+        &outgoing_rw_args,
+        &c_tester,
+        aws_byte_buf_from_empty_array(outgoing_received_message, sizeof(outgoing_received_message)),
+        0));
+
+    struct aws_channel_handler *outgoing_rw_handler = rw_handler_new(
+        allocator, s_socket_test_handle_read, s_socket_test_handle_write, true, 10000, &outgoing_rw_args);
+    ASSERT_NOT_NULL(outgoing_rw_handler);
+
+    struct aws_channel_handler *incoming_rw_handler = rw_handler_new(
+        allocator, s_socket_test_handle_read, s_socket_test_handle_write, true, 10000, &incoming_rw_args);
+    ASSERT_NOT_NULL(incoming_rw_handler);
+
+    struct socket_test_args incoming_args;
+    ASSERT_SUCCESS(s_socket_test_args_init(&incoming_args, &c_tester, incoming_rw_handler));
+
+    struct socket_test_args outgoing_args;
+    ASSERT_SUCCESS(s_socket_test_args_init(&outgoing_args, &c_tester, outgoing_rw_handler));
+
+    struct local_server_tester local_server_tester;
+    ASSERT_SUCCESS(s_local_server_tester_init(allocator, &local_server_tester, &incoming_args, &c_tester, false));
+
+    struct aws_client_bootstrap_options bootstrap_options = {
+        .event_loop_group = c_tester.el_group,
+        .host_resolver = NULL,
+    };
+    struct aws_client_bootstrap *client_bootstrap = aws_client_bootstrap_new(allocator, &bootstrap_options);
+    ASSERT_NOT_NULL(client_bootstrap);
+
+    struct aws_socket_channel_bootstrap_options channel_options;
+    AWS_ZERO_STRUCT(channel_options);
+    channel_options.bootstrap = client_bootstrap;
+    channel_options.host_name = local_server_tester.endpoint.address;
+    channel_options.port = 0;
+    channel_options.socket_options = &local_server_tester.socket_options;
+    channel_options.setup_callback = s_socket_handler_test_client_setup_callback;
+    channel_options.shutdown_callback = s_socket_handler_test_client_shutdown_callback;
+    channel_options.user_data = &outgoing_args;
+
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_client_bootstrap_new_socket_channel(&channel_options));
+
+    /* wait for both ends to setup */
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_setup_predicate, &incoming_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_setup_predicate, &outgoing_args));
+
+    struct corked_write_task_args task_args = {
+        .rw_handler = outgoing_args.rw_handler,
+        .rw_slot = aws_atomic_load_ptr(&outgoing_args.rw_slot),
+        .parts = parts,
+        .part_count = AWS_ARRAY_SIZE(parts),
+    };
+    aws_channel_task_init(&task_args.task, s_corked_write_task, &task_args, "corked_write");
+    aws_channel_schedule_task_now(outgoing_args.channel, &task_args.task);
+
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_socket_test_full_read_predicate, &incoming_rw_args));
+
+    ASSERT_BIN_ARRAYS_EQUALS(
+        expected.buffer, expected.len, incoming_rw_args.received_message.buffer, incoming_rw_args.received_message.len);
+    /* all three parts went out in a single write */
+    ASSERT_UINT_EQUALS(1, task_args.write_requests);
+
+    ASSERT_SUCCESS(aws_channel_shutdown(incoming_args.channel, AWS_OP_SUCCESS));
+    ASSERT_SUCCESS(aws_channel_shutdown(outgoing_args.channel, AWS_OP_SUCCESS));
+
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_shutdown_predicate, &incoming_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_shutdown_predicate, &outgoing_args));
+    aws_server_bootstrap_destroy_socket_listener(local_server_tester.server_bootstrap, local_server_tester.listener);
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_listener_destroy_predicate, &incoming_args));
+
+    aws_mutex_unlock(&c_tester.mutex);
+
+    /* clean up */
+    ASSERT_SUCCESS(s_local_server_tester_clean_up(&local_server_tester));
+
+    aws_client_bootstrap_release(client_bootstrap);
+    ASSERT_SUCCESS(s_socket_common_tester_clean_up(&c_tester));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(socket_handler_corked_writes, s_socket_corked_writes_test)
+
+/* parts fit in a pooled message, but add up to far more than a local socket buffers, so the flush at shutdown
+ * can't go out in one go */
+#define SHUTDOWN_FLUSH_PART_SIZE (8 * 1024)
+#define SHUTDOWN_FLUSH_PART_COUNT 128
+
+static int s_socket_shutdown_flushes_corked_writes_test(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    s_socket_common_tester_init(allocator, &c_tester);
+
+    struct aws_byte_buf payload;
+    ASSERT_SUCCESS(aws_byte_buf_init(&payload, allocator, SHUTDOWN_FLUSH_PART_SIZE * SHUTDOWN_FLUSH_PART_COUNT));
+    for (size_t i = 0; i < payload.capacity; ++i) {
+        payload.buffer[i] = (uint8_t)(i % 251);
+    }
+    payload.len = payload.capacity;
+
+    struct aws_byte_buf parts[SHUTDOWN_FLUSH_PART_COUNT];
+    for (size_t i = 0; i < SHUTDOWN_FLUSH_PART_COUNT; ++i) {
+        parts[i] = aws_byte_buf_from_array(payload.buffer + i * SHUTDOWN_FLUSH_PART_SIZE, SHUTDOWN_FLUSH_PART_SIZE);
+    }
+
+    struct aws_byte_buf incoming_received_message;
+    ASSERT_SUCCESS(aws_byte_buf_init(&incoming_received_message, allocator, payload.len));
+    uint8_t outgoing_received_message[128] = {0};
+
+    struct socket_test_rw_args incoming_rw_args;
+    ASSERT_SUCCESS(s_rw_args_init(&incoming_rw_args, &c_tester, incoming_received_message, (int)payload.len));
+
+    struct socket_test_rw_args outgoing_rw_args;
+    ASSERT_SUCCESS(s_rw_args_init(
+        &outgoing_rw_args,
+        &c_tester,
+        aws_byte_buf_from_empty_array(outgoing_received_message, sizeof(outgoing_received_message)),
+        0));
+
+    struct aws_channel_handler *outgoing_rw_handler = rw_handler_new(
+        allocator, s_socket_test_handle_read, s_socket_test_handle_write, true, SIZE_MAX, &outgoing_rw_args);
+    ASSERT_NOT_NULL(outgoing_rw_handler);
+
+    struct aws_channel_handler *incoming_rw_handler = rw_handler_new(
+        allocator, s_socket_test_handle_read, s_socket_test_handle_write, true, SIZE_MAX, &incoming_rw_args);
+    ASSERT_NOT_NULL(incoming_rw_handler);
+
+    struct socket_test_args incoming_args;
+    ASSERT_SUCCESS(s_socket_test_args_init(&incoming_args, &c_tester, incoming_rw_handler));
+
+    struct socket_test_args outgoing_args;
+    ASSERT_SUCCESS(s_socket_test_args_init(&outgoing_args, &c_tester, outgoing_rw_handler));
+
+    struct local_server_tester local_server_tester;
+    ASSERT_SUCCESS(s_local_server_tester_init(allocator, &local_server_tester, &incoming_args, &c_tester, false));
+
+    struct aws_client_bootstrap_options bootstrap_options = {
+        .event_loop_group = c_tester.el_group,
+        .host_resolver = NULL,
+    };
+    struct aws_client_bootstrap *client_bootstrap = aws_client_bootstrap_new(allocator, &bootstrap_options);
+    ASSERT_NOT_NULL(client_bootstrap);
+
+    struct aws_socket_channel_bootstrap_options channel_options;
+    AWS_ZERO_STRUCT(channel_options);
+    channel_options.bootstrap = client_bootstrap;
+    channel_options.host_name = local_server_tester.endpoint.address;
+    channel_options.port = 0;
+    channel_options.socket_options = &local_server_tester.socket_options;
+    channel_options.setup_callback = s_socket_handler_test_client_setup_callback;
+    channel_options.shutdown_callback = s_socket_handler_test_client_shutdown_callback;
+    channel_options.user_data = &outgoing_args;
+
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_client_bootstrap_new_socket_channel(&channel_options));
+
+    /* wait for both ends to setup */
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_setup_predicate, &incoming_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_setup_predicate, &outgoing_args));
+
+    /* the writes are still corked when the channel shuts down, the socket must not close until they've gone out */
+    struct corked_write_task_args task_args = {
+        .rw_handler = outgoing_args.rw_handler,
+        .rw_slot = aws_atomic_load_ptr(&outgoing_args.rw_slot),
+        .parts = parts,
+        .part_count = AWS_ARRAY_SIZE(parts),
+        .shutdown_corked = true,
+    };
+    aws_channel_task_init(&task_args.task, s_corked_write_task, &task_args, "corked_write_then_shutdown");
+    aws_channel_schedule_task_now(outgoing_args.channel, &task_args.task);
+
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_socket_test_full_read_predicate, &incoming_rw_args));
+
+    ASSERT_BIN_ARRAYS_EQUALS(
+        payload.buffer, payload.len, incoming_rw_args.received_message.buffer, incoming_rw_args.received_message.len);
+
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_shutdown_predicate, &outgoing_args));
+    ASSERT_SUCCESS(aws_channel_shutdown(incoming_args.channel, AWS_OP_SUCCESS));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_shutdown_predicate, &incoming_args));
+    aws_server_bootstrap_destroy_socket_listener(local_server_tester.server_bootstrap, local_server_tester.listener);
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_listener_destroy_predicate, &incoming_args));
+
+    aws_mutex_unlock(&c_tester.mutex);
+
+    /* clean up */
+    ASSERT_SUCCESS(s_local_server_tester_clean_up(&local_server_tester));
+
+    aws_client_bootstrap_release(client_bootstrap);
+    ASSERT_SUCCESS(s_socket_common_tester_clean_up(&c_tester));
+    aws_byte_buf_clean_up(&incoming_received_message);
+    aws_byte_buf_clean_up(&payload);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(socket_handler_shutdown_flushes_corked_writes, s_socket_shutdown_flushes_corked_writes_test)
+
+#define WATER_MARK_PART_SIZE (8 * 1024)
+#define WATER_MARK_PART_COUNT 32
+#define WATER_MARK_HIGH (64 * 1024)
+#define WATER_MARK_LOW (16 * 1024)
+
+static int s_socket_write_water_marks_test(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    s_socket_common_tester_init(allocator, &c_tester);
+
+    struct aws_byte_buf payload;
+    ASSERT_SUCCESS(aws_byte_buf_init(&payload, allocator, WATER_MARK_PART_SIZE * WATER_MARK_PART_COUNT));
+    for (size_t i = 0; i < payload.capacity; ++i) {
+        payload.buffer[i] = (uint8_t)(i % 251);
+    }
+    payload.len = payload.capacity;
+
+    struct aws_byte_buf parts[WATER_MARK_PART_COUNT];
+    for (size_t i = 0; i < WATER_MARK_PART_COUNT; ++i) {
+        parts[i] = aws_byte_buf_from_array(payload.buffer + i * WATER_MARK_PART_SIZE, WATER_MARK_PART_SIZE);
+    }
+
+    struct aws_byte_buf incoming_received_message;
+    ASSERT_SUCCESS(aws_byte_buf_init(&incoming_received_message, allocator, payload.len));
+    uint8_t outgoing_received_message[128] = {0};
+
+    struct socket_test_rw_args incoming_rw_args;
+    ASSERT_SUCCESS(s_rw_args_init(&incoming_rw_args, &c_tester, incoming_received_message, (int)payload.len));
+
+    struct socket_test_rw_args outgoing_rw_args;
+    ASSERT_SUCCESS(s_rw_args_init(
+        &outgoing_rw_args,
+        &c_tester,
+        aws_byte_buf_from_empty_array(outgoing_received_message, sizeof(outgoing_received_message)),
+        0));
+
+    struct aws_channel_handler *outgoing_rw_handler = rw_handler_new(
+        allocator, s_socket_test_handle_read, s_socket_test_handle_write, true, SIZE_MAX, &outgoing_rw_args);
+    ASSERT_NOT_NULL(outgoing_rw_handler);
+    rw_handler_set_on_writability_changed(outgoing_rw_handler, s_socket_test_on_writability_changed);
+
+    struct aws_channel_handler *incoming_rw_handler = rw_handler_new(
+        allocator, s_socket_test_handle_read, s_socket_test_handle_write, true, SIZE_MAX, &incoming_rw_args);
+    ASSERT_NOT_NULL(incoming_rw_handler);
+
+    struct socket_test_args incoming_args;
+    ASSERT_SUCCESS(s_socket_test_args_init(&incoming_args, &c_tester, incoming_rw_handler));
+
+    struct socket_test_args outgoing_args;
+    ASSERT_SUCCESS(s_socket_test_args_init(&outgoing_args, &c_tester, outgoing_rw_handler));
+
+    struct local_server_tester local_server_tester;
+    ASSERT_SUCCESS(s_local_server_tester_init(allocator, &local_server_tester, &incoming_args, &c_tester, false));
+
+    struct aws_client_bootstrap_options bootstrap_options = {
+        .event_loop_group = c_tester.el_group,
+        .host_resolver = NULL,
+    };
+    struct aws_client_bootstrap *client_bootstrap = aws_client_bootstrap_new(allocator, &bootstrap_options);
+    ASSERT_NOT_NULL(client_bootstrap);
+
+    struct aws_socket_channel_bootstrap_options channel_options;
+    AWS_ZERO_STRUCT(channel_options);
+    channel_options.bootstrap = client_bootstrap;
+    channel_options.host_name = local_server_tester.endpoint.address;
+    channel_options.port = 0;
+    channel_options.socket_options = &local_server_tester.socket_options;
+    channel_options.setup_callback = s_socket_handler_test_client_setup_callback;
+    channel_options.shutdown_callback = s_socket_handler_test_client_shutdown_callback;
+    channel_options.user_data = &outgoing_args;
+    channel_options.write_high_water_mark = WATER_MARK_HIGH;
+    channel_options.write_low_water_mark = WATER_MARK_LOW;
+
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_client_bootstrap_new_socket_channel(&channel_options));
+
+    /* wait for both ends to setup */
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_setup_predicate, &incoming_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_setup_predicate, &outgoing_args));
+
+    /* corked, every part sits in the socket handler's queue, well past the high water mark */
+    struct corked_write_task_args task_args = {
+        .rw_handler = outgoing_args.rw_handler,
+        .rw_slot = aws_atomic_load_ptr(&outgoing_args.rw_slot),
+        .parts = parts,
+        .part_count = AWS_ARRAY_SIZE(parts),
+    };
+    aws_channel_task_init(&task_args.task, s_corked_write_task, &task_args, "corked_write_past_high_water_mark");
+    aws_channel_schedule_task_now(outgoing_args.channel, &task_args.task);
+
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_socket_test_full_read_predicate, &incoming_rw_args));
+    ASSERT_BIN_ARRAYS_EQUALS(
+        payload.buffer, payload.len, incoming_rw_args.received_message.buffer, incoming_rw_args.received_message.len);
+
+    /* once the socket has written it all, the queue is below the low water mark */
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_socket_test_writable_again_predicate, &outgoing_rw_args));
+    ASSERT_FALSE(task_args.writable_while_corked);
+    ASSERT_UINT_EQUALS(1, outgoing_rw_args.not_writable_count);
+    ASSERT_UINT_EQUALS(1, outgoing_rw_args.writable_count);
+
+    ASSERT_SUCCESS(aws_channel_shutdown(incoming_args.channel, AWS_OP_SUCCESS));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_shutdown_predicate, &incoming_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_shutdown_predicate, &outgoing_args));
+    aws_server_bootstrap_destroy_socket_listener(local_server_tester.server_bootstrap, local_server_tester.listener);
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_listener_destroy_predicate, &incoming_args));
+
+    aws_mutex_unlock(&c_tester.mutex);
+
+    /* clean up */
+    ASSERT_SUCCESS(s_local_server_tester_clean_up(&local_server_tester));
+
+    aws_client_bootstrap_release(client_bootstrap);
+    ASSERT_SUCCESS(s_socket_common_tester_clean_up(&c_tester));
+    aws_byte_buf_clean_up(&incoming_received_message);
+    aws_byte_buf_clean_up(&payload);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(socket_handler_write_water_marks, s_socket_write_water_marks_test)
+
+static int s_socket_shutdown_without_pending_writes_test(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    s_socket_common_tester_init(allocator, &c_tester);
+
+    uint8_t payload[] = "sent before shutdown";
+    struct aws_byte_buf write_buf = aws_byte_buf_from_array(payload, sizeof(payload));
+
+    uint8_t incoming_received_message[128] = {0};
+    uint8_t outgoing_received_message[128] = {0};
+
+    struct socket_test_rw_args incoming_rw_args;
+    ASSERT_SUCCESS(s_rw_args_init(
+        &incoming_rw_args,
+        &c_tester,
+        aws_byte_buf_from_empty_array(incoming_received_message, sizeof(incoming_received_message)),
+        (int)sizeof(payload)));
+
+    struct socket_test_rw_args outgoing_rw_args;
+    ASSERT_SUCCESS(s_rw_args_init(
+        &outgoing_rw_args,
+        &c_tester,
+        aws_byte_buf_from_empty_array(outgoing_received_message, sizeof(outgoing_received_message)),
+        0));
+
+    struct aws_channel_handler *outgoing_rw_handler = rw_handler_new(
+        allocator, s_socket_test_handle_read, s_socket_test_handle_write, true, SIZE_MAX, &outgoing_rw_args);
+    ASSERT_NOT_NULL(outgoing_rw_handler);
+
+    struct aws_channel_handler *incoming_rw_handler = rw_handler_new(
+        allocator, s_socket_test_handle_read, s_socket_test_handle_write, true, SIZE_MAX, &incoming_rw_args);
+    ASSERT_NOT_NULL(incoming_rw_handler);
+
+    struct socket_test_args incoming_args;
+    ASSERT_SUCCESS(s_socket_test_args_init(&incoming_args, &c_tester, incoming_rw_handler));
+
+    struct socket_test_args outgoing_args;
+    ASSERT_SUCCESS(s_socket_test_args_init(&outgoing_args, &c_tester, outgoing_rw_handler));
+
+    struct local_server_tester local_server_tester;
+    ASSERT_SUCCESS(s_local_server_tester_init(allocator, &local_server_tester, &incoming_args, &c_tester, false));
+
+    struct aws_client_bootstrap_options bootstrap_options = {
+        .event_loop_group = c_tester.el_group,
+        .host_resolver = NULL,
+    };
+    struct aws_client_bootstrap *client_bootstrap = aws_client_bootstrap_new(allocator, &bootstrap_options);
+    ASSERT_NOT_NULL(client_bootstrap);
+
+    struct aws_socket_channel_bootstrap_options channel_options;
+    AWS_ZERO_STRUCT(channel_options);
+    channel_options.bootstrap = client_bootstrap;
+    channel_options.host_name = local_server_tester.endpoint.address;
+    channel_options.port = 0;
+    channel_options.socket_options = &local_server_tester.socket_options;
+    channel_options.setup_callback = s_socket_handler_test_client_setup_callback;
+    channel_options.shutdown_callback = s_socket_handler_test_client_shutdown_callback;
+    channel_options.user_data = &outgoing_args;
+
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_client_bootstrap_new_socket_channel(&channel_options));
+
+    /* wait for both ends to setup */
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_setup_predicate, &incoming_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_setup_predicate, &outgoing_args));
+
+    /* a write that has long completed by the time the channel shuts down */
+    rw_handler_write(outgoing_args.rw_handler, aws_atomic_load_ptr(&outgoing_args.rw_slot), &write_buf);
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_socket_test_full_read_predicate, &incoming_rw_args));
+
+    /* with nothing left to drain, the socket closes straight away instead of waiting out the drain timeout */
+    uint64_t start_ns = 0;
+    ASSERT_SUCCESS(aws_high_res_clock_get_ticks(&start_ns));
+    ASSERT_SUCCESS(aws_channel_shutdown(outgoing_args.channel, AWS_OP_SUCCESS));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_shutdown_predicate, &outgoing_args));
+    uint64_t end_ns = 0;
+    ASSERT_SUCCESS(aws_high_res_clock_get_ticks(&end_ns));
+    ASSERT_TRUE(end_ns - start_ns < aws_timestamp_convert(1, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL));
+
+    ASSERT_SUCCESS(aws_channel_shutdown(incoming_args.channel, AWS_OP_SUCCESS));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_shutdown_predicate, &incoming_args));
+    aws_server_bootstrap_destroy_socket_listener(local_server_tester.server_bootstrap, local_server_tester.listener);
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_listener_destroy_predicate, &incoming_args));
+
+    aws_mutex_unlock(&c_tester.mutex);
+
+    /* clean up */
+    ASSERT_SUCCESS(s_local_server_tester_clean_up(&local_server_tester));
+
+    aws_client_bootstrap_release(client_bootstrap);
+    ASSERT_SUCCESS(s_socket_common_tester_clean_up(&c_tester));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(socket_handler_shutdown_without_pending_writes, s_socket_shutdown_without_pending_writes_test)
+
 static void s_creation_callback_test_channel_creation_callback(
     struct aws_client_bootstrap *bootstrap,
     int error_code,
@@ -731,3 +1275,168 @@ static int s_open_channel_statistics_test(struct aws_allocator *allocator, void
 }
 
 AWS_TEST_CASE(open_channel_statistics_test, s_open_channel_statistics_test)
+
+#define READ_BUDGET_TEST_CHUNK_SIZE (16 * 1024)
+#define READ_BUDGET_TEST_CHUNK_COUNT 64
+/* the loop budget starts at 64KB */
+#define READ_BUDGET_TEST_INITIAL_BUDGET (64 * 1024)
+/* well past the handler's 1ms target for the delay between a socket yielding and reading again */
+#define READ_BUDGET_TEST_SLOW_TICK_NS (10 * 1000 * 1000)
+
+/*
+ * Stands in for a task that blocks the event loop: every tick it runs on, it moves the test clock forward, so a socket
+ * that yields sees a long wait for its next turn.
+ */
+struct slow_tick_task {
+    struct aws_task task;
+    struct aws_event_loop *event_loop;
+    struct aws_atomic_var stop;
+};
+
+static void s_slow_tick_task_fn(struct aws_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    struct slow_tick_task *slow_tick = arg;
+
+    if (status != AWS_TASK_STATUS_RUN_READY || aws_atomic_load_int(&slow_tick->stop)) {
+        return;
+    }
+
+    aws_atomic_fetch_add(&c_tester.current_time_ns, READ_BUDGET_TEST_SLOW_TICK_NS);
+    aws_event_loop_schedule_task_now(slow_tick->event_loop, &slow_tick->task);
+}
+
+static bool s_stats_all_read_predicate(void *user_data) {
+    struct aws_crt_statistics_handler *stats_handler = user_data;
+    struct aws_statistics_handler_test_impl *stats_impl = stats_handler->impl;
+
+    return stats_impl->total_bytes_read == READ_BUDGET_TEST_CHUNK_SIZE * READ_BUDGET_TEST_CHUNK_COUNT;
+}
+
+static int s_socket_handler_read_budget_test(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    s_socket_common_tester_statistics_init(allocator, &c_tester);
+
+    uint8_t chunk_storage[READ_BUDGET_TEST_CHUNK_SIZE];
+    memset(chunk_storage, 'a', sizeof(chunk_storage));
+    struct aws_byte_buf chunk = aws_byte_buf_from_array(chunk_storage, sizeof(chunk_storage));
+
+    struct aws_byte_buf outgoing_received_message;
+    ASSERT_SUCCESS(aws_byte_buf_init(&outgoing_received_message, allocator, chunk.len * READ_BUDGET_TEST_CHUNK_COUNT));
+    uint8_t incoming_received_message[128];
+
+    struct socket_test_rw_args incoming_rw_args;
+    ASSERT_SUCCESS(s_rw_args_init(
+        &incoming_rw_args,
+        &c_tester,
+        aws_byte_buf_from_empty_array(incoming_received_message, sizeof(incoming_received_message)),
+        0));
+
+    struct socket_test_rw_args outgoing_rw_args;
+    ASSERT_SUCCESS(s_rw_args_init(
+        &outgoing_rw_args,
+        &c_tester,
+        outgoing_received_message,
+        (int)outgoing_received_message.capacity));
+
+    struct aws_channel_handler *outgoing_rw_handler = rw_handler_new(
+        allocator, s_socket_test_handle_read, s_socket_test_handle_write, true, SIZE_MAX, &outgoing_rw_args);
+    ASSERT_NOT_NULL(outgoing_rw_handler);
+
+    struct aws_channel_handler *incoming_rw_handler = rw_handler_new(
+        allocator, s_socket_test_handle_read, s_socket_test_handle_write, true, SIZE_MAX, &incoming_rw_args);
+    ASSERT_NOT_NULL(incoming_rw_handler);
+
+    struct socket_test_args incoming_args;
+    ASSERT_SUCCESS(s_socket_test_args_init(&incoming_args, &c_tester, incoming_rw_handler));
+
+    struct socket_test_args outgoing_args;
+    ASSERT_SUCCESS(s_socket_test_args_init(&outgoing_args, &c_tester, outgoing_rw_handler));
+
+    struct local_server_tester local_server_tester;
+    ASSERT_SUCCESS(s_local_server_tester_init(allocator, &local_server_tester, &incoming_args, &c_tester, false));
+
+    struct aws_client_bootstrap_options bootstrap_options = {
+        .event_loop_group = c_tester.el_group,
+        .host_resolver = NULL,
+    };
+    struct aws_client_bootstrap *client_bootstrap = aws_client_bootstrap_new(allocator, &bootstrap_options);
+    ASSERT_NOT_NULL(client_bootstrap);
+
+    struct aws_socket_channel_bootstrap_options channel_options;
+    AWS_ZERO_STRUCT(channel_options);
+    channel_options.bootstrap = client_bootstrap;
+    channel_options.host_name = local_server_tester.endpoint.address;
+    channel_options.port = 0;
+    channel_options.socket_options = &local_server_tester.socket_options;
+    channel_options.creation_callback = s_creation_callback_test_channel_creation_callback;
+    channel_options.setup_callback = s_socket_handler_test_client_setup_callback;
+    channel_options.shutdown_callback = s_socket_handler_test_client_shutdown_callback;
+    channel_options.user_data = &outgoing_args;
+
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_client_bootstrap_new_socket_channel(&channel_options));
+
+    /* wait for both ends to setup */
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_setup_predicate, &incoming_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_setup_predicate, &outgoing_args));
+
+    struct slow_tick_task slow_tick;
+    aws_task_init(&slow_tick.task, s_slow_tick_task_fn, &slow_tick, "slow_tick_task");
+    slow_tick.event_loop = aws_event_loop_group_get_next_loop(c_tester.el_group);
+    aws_atomic_init_int(&slow_tick.stop, 0);
+    aws_event_loop_schedule_task_now(slow_tick.event_loop, &slow_tick.task);
+
+    /* send far more than a single tick's worth, so the reading side has to yield */
+    struct aws_channel_slot *incoming_slot = aws_atomic_load_ptr(&incoming_args.rw_slot);
+    for (size_t i = 0; i < READ_BUDGET_TEST_CHUNK_COUNT; ++i) {
+        rw_handler_write(incoming_args.rw_handler, incoming_slot, &chunk);
+    }
+
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_socket_test_full_read_predicate, &outgoing_rw_args));
+
+    /* let the last statistics report come due */
+    aws_atomic_store_int(&slow_tick.stop, 1);
+    aws_atomic_fetch_add(
+        &c_tester.current_time_ns, (size_t)aws_timestamp_convert(1, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL));
+
+    struct aws_crt_statistics_handler *stats_handler = aws_atomic_load_ptr(&c_tester.stats_handler);
+    struct aws_statistics_handler_test_impl *stats_impl = stats_handler->impl;
+
+    aws_mutex_lock(&stats_impl->lock);
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &stats_impl->signal, &stats_impl->lock, s_stats_all_read_predicate, stats_handler));
+
+    /* every yield waited out a slow tick, so the budget backed off */
+    ASSERT_TRUE(stats_impl->total_read_budget_exhausted_count > 0);
+    ASSERT_TRUE(stats_impl->read_budget < READ_BUDGET_TEST_INITIAL_BUDGET);
+
+    aws_mutex_unlock(&stats_impl->lock);
+
+    aws_channel_shutdown(incoming_args.channel, AWS_OP_SUCCESS);
+
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_shutdown_predicate, &incoming_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_channel_shutdown_predicate, &outgoing_args));
+
+    aws_server_bootstrap_destroy_socket_listener(local_server_tester.server_bootstrap, local_server_tester.listener);
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_listener_destroy_predicate, &incoming_args));
+
+    aws_mutex_unlock(&c_tester.mutex);
+
+    /* clean up */
+    ASSERT_SUCCESS(s_local_server_tester_clean_up(&local_server_tester));
+
+    aws_client_bootstrap_release(client_bootstrap);
+    ASSERT_SUCCESS(s_socket_common_tester_clean_up(&c_tester));
+    aws_byte_buf_clean_up(&outgoing_received_message);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(socket_handler_read_budget, s_socket_handler_read_budget_test)
@@ -154,6 +154,44 @@ static void s_read_task(struct aws_task *task, void *args, enum aws_task_status
     aws_condition_variable_notify_one(&io_args->condition_variable);
 }
 
+/* like s_read_task, but scatters the data across the two halves of read_data */
+static void s_readv_task(struct aws_task *task, void *args, enum aws_task_status status) {
+    (void)task;
+    (void)status;
+
+    struct socket_io_args *io_args = args;
+    aws_mutex_lock(io_args->mutex);
+
+    size_t half = io_args->read_data->capacity / 2;
+    struct aws_byte_buf buffers[2] = {
+        aws_byte_buf_from_empty_array(io_args->read_data->buffer, half),
+        aws_byte_buf_from_empty_array(io_args->read_data->buffer + half, io_args->read_data->capacity - half),
+    };
+
+    size_t read = 0;
+    while (read < io_args->to_read->len) {
+        size_t data_len = 0;
+        if (aws_socket_readv(io_args->socket, buffers, AWS_ARRAY_SIZE(buffers), &data_len)) {
+            if (AWS_IO_READ_WOULD_BLOCK == aws_last_error()) {
+                continue;
+            }
+            break;
+        }
+        read += data_len;
+    }
+
+    /* the second half only gets data once the first is full */
+    if (buffers[1].len > 0 && buffers[0].len != buffers[0].capacity) {
+        io_args->error_code = AWS_ERROR_UNKNOWN;
+    }
+
+    io_args->read_data->len = buffers[0].len + buffers[1].len;
+    io_args->amount_read = read;
+
+    aws_mutex_unlock(io_args->mutex);
+    aws_condition_variable_notify_one(&io_args->condition_variable);
+}
+
 static bool s_read_task_predicate(void *arg) {
     struct socket_io_args *io_args = arg;
 
@@ -347,6 +385,32 @@ static int s_test_socket_ex(
         ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
         ASSERT_INT_EQUALS(AWS_OP_SUCCESS, io_args.error_code);
         ASSERT_BIN_ARRAYS_EQUALS(read_buffer.buffer, read_buffer.len, write_buffer.buffer, write_buffer.len);
+
+        /* once more, with a vectored read */
+        memset((void *)write_data, 0, sizeof(write_data));
+        write_buffer.len = 0;
+
+        io_args.error_code = 0;
+        io_args.amount_read = 0;
+        io_args.amount_written = 0;
+        io_args.socket = &outgoing;
+        aws_event_loop_schedule_task_now(event_loop, &write_task);
+        ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+        aws_condition_variable_wait_pred(&io_args.condition_variable, &mutex, s_write_completed_predicate, &io_args);
+        ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+        ASSERT_INT_EQUALS(AWS_OP_SUCCESS, io_args.error_code);
+
+        io_args.socket = server_sock;
+        struct aws_task readv_task = {
+            .fn = s_readv_task,
+            .arg = &io_args,
+        };
+        aws_event_loop_schedule_task_now(event_loop, &readv_task);
+        ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+        aws_condition_variable_wait_pred(&io_args.condition_variable, &mutex, s_read_task_predicate, &io_args);
+        ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+        ASSERT_INT_EQUALS(AWS_OP_SUCCESS, io_args.error_code);
+        ASSERT_BIN_ARRAYS_EQUALS(read_buffer.buffer, read_buffer.len, write_buffer.buffer, write_buffer.len);
     }
 
     struct aws_task close_task = {
@@ -932,6 +996,7 @@ static int s_test_wrong_thread_read_write_fails(struct aws_allocator *allocator,
     aws_socket_subscribe_to_readable_events(&socket, s_on_null_readable_notification, NULL);
     size_t amount_read = 0;
     ASSERT_ERROR(AWS_ERROR_IO_EVENT_LOOP_THREAD_ONLY, aws_socket_read(&socket, NULL, &amount_read));
+    ASSERT_ERROR(AWS_ERROR_IO_EVENT_LOOP_THREAD_ONLY, aws_socket_readv(&socket, NULL, 0, &amount_read));
     ASSERT_ERROR(AWS_ERROR_IO_EVENT_LOOP_THREAD_ONLY, aws_socket_write(&socket, NULL, NULL, NULL));
 
     struct aws_mutex mutex = AWS_MUTEX_INIT;
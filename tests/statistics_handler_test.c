@@ -41,12 +41,23 @@ static void s_process_statistics(
                 struct aws_crt_statistics_socket *socket_stats = (struct aws_crt_statistics_socket *)stats_base;
                 impl->total_bytes_read += socket_stats->bytes_read;
                 impl->total_bytes_written += socket_stats->bytes_written;
+                impl->read_budget = socket_stats->read_budget;
+                impl->total_read_budget_exhausted_count += socket_stats->read_budget_exhausted_count;
                 break;
             }
 
             case AWSCRT_STAT_CAT_TLS: {
                 struct aws_crt_statistics_tls *tls_stats = (struct aws_crt_statistics_tls *)stats_base;
                 impl->tls_status = tls_stats->handshake_status;
+                impl->tls_handshake_read_waits = tls_stats->handshake_read_waits;
+                impl->tls_handshake_bytes_sent = tls_stats->handshake_bytes_sent;
+                impl->tls_handshake_bytes_received = tls_stats->handshake_bytes_received;
+                impl->tls_cipher_suite = tls_stats->cipher_suite;
+                impl->tls_protocol_version = tls_stats->protocol_version;
+                impl->total_tls_records_encrypted += tls_stats->records_encrypted;
+                impl->total_tls_bytes_encrypted += tls_stats->bytes_encrypted;
+                impl->total_tls_records_decrypted += tls_stats->records_decrypted;
+                impl->total_tls_bytes_decrypted += tls_stats->bytes_decrypted;
                 break;
             }
 
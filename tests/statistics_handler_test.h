@@ -15,8 +15,19 @@ struct aws_statistics_handler_test_impl {
 
     uint64_t total_bytes_read;
     uint64_t total_bytes_written;
+    uint64_t read_budget;
+    uint64_t total_read_budget_exhausted_count;
 
     enum aws_tls_negotiation_status tls_status;
+    uint32_t tls_handshake_read_waits;
+    uint64_t tls_handshake_bytes_sent;
+    uint64_t tls_handshake_bytes_received;
+    uint16_t tls_cipher_suite;
+    enum aws_tls_versions tls_protocol_version;
+    uint64_t total_tls_records_encrypted;
+    uint64_t total_tls_bytes_encrypted;
+    uint64_t total_tls_records_decrypted;
+    uint64_t total_tls_bytes_decrypted;
 
     struct aws_mutex lock;
     struct aws_condition_variable signal;
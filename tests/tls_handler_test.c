@@ -8,6 +8,7 @@
 #include <aws/io/file_utils.h>
 #include <aws/io/host_resolver.h>
 #include <aws/io/logging.h>
+#include <aws/io/private/tls_channel_handler_shared.h>
 #include <aws/io/socket.h>
 #include <aws/io/tls_channel_handler.h>
 
@@ -62,7 +63,12 @@ struct tls_opt_tester {
     struct aws_tls_connection_options opt;
 };
 
-static int s_tls_server_opt_tester_init(struct aws_allocator *allocator, struct tls_opt_tester *tester) {
+typedef void(tls_ctx_options_configure_fn)(struct aws_tls_ctx_options *options);
+
+static int s_tls_server_opt_tester_init(
+    struct aws_allocator *allocator,
+    struct tls_opt_tester *tester,
+    tls_ctx_options_configure_fn *configure_fn) {
 
 #ifdef __APPLE__
     struct aws_byte_cursor pwd_cur = aws_byte_cursor_from_c_str("1234");
@@ -73,6 +79,9 @@ static int s_tls_server_opt_tester_init(struct aws_allocator *allocator, struct
         &tester->ctx_options, allocator, "unittests.crt", "unittests.key"));
 #endif /* __APPLE__ */
     aws_tls_ctx_options_set_alpn_list(&tester->ctx_options, "h2;http/1.1");
+    if (configure_fn) {
+        configure_fn(&tester->ctx_options);
+    }
     tester->ctx = aws_tls_server_ctx_new(allocator, &tester->ctx_options);
     ASSERT_NOT_NULL(tester->ctx);
 
@@ -367,15 +376,19 @@ static void s_tls_on_negotiated(
     aws_condition_variable_notify_one(setup_test_args->condition_variable);
 }
 
-static int s_tls_local_server_tester_init(
+/*
+ * Sets up everything but the listener, so that the server's connection options can still be changed. The listener
+ * copies them when s_tls_local_server_tester_listen() creates it.
+ */
+static int s_tls_local_server_tester_prepare(
     struct aws_allocator *allocator,
     struct tls_local_server_tester *tester,
     struct tls_test_args *args,
     struct tls_common_tester *tls_c_tester,
-    bool enable_back_pressure,
-    int server_index) {
+    int server_index,
+    tls_ctx_options_configure_fn *configure_fn) {
     AWS_ZERO_STRUCT(*tester);
-    ASSERT_SUCCESS(s_tls_server_opt_tester_init(allocator, &tester->server_tls_opt_tester));
+    ASSERT_SUCCESS(s_tls_server_opt_tester_init(allocator, &tester->server_tls_opt_tester, configure_fn));
     aws_tls_connection_options_set_callbacks(&tester->server_tls_opt_tester.opt, s_tls_on_negotiated, NULL, NULL, args);
     tester->socket_options.connect_timeout_ms = 3000;
     tester->socket_options.type = AWS_SOCKET_STREAM;
@@ -385,6 +398,13 @@ static int s_tls_local_server_tester_init(
     tester->server_bootstrap = aws_server_bootstrap_new(allocator, tls_c_tester->el_group);
     ASSERT_NOT_NULL(tester->server_bootstrap);
 
+    return AWS_OP_SUCCESS;
+}
+
+static int s_tls_local_server_tester_listen(
+    struct tls_local_server_tester *tester,
+    struct tls_test_args *args,
+    bool enable_back_pressure) {
     struct aws_server_socket_channel_bootstrap_options bootstrap_options = {
         .bootstrap = tester->server_bootstrap,
         .enable_read_back_pressure = enable_back_pressure,
@@ -403,12 +423,99 @@ static int s_tls_local_server_tester_init(
     return AWS_OP_SUCCESS;
 }
 
+static int s_tls_local_server_tester_init_configured(
+    struct aws_allocator *allocator,
+    struct tls_local_server_tester *tester,
+    struct tls_test_args *args,
+    struct tls_common_tester *tls_c_tester,
+    bool enable_back_pressure,
+    int server_index,
+    tls_ctx_options_configure_fn *configure_fn) {
+    ASSERT_SUCCESS(
+        s_tls_local_server_tester_prepare(allocator, tester, args, tls_c_tester, server_index, configure_fn));
+    return s_tls_local_server_tester_listen(tester, args, enable_back_pressure);
+}
+
+static int s_tls_local_server_tester_init(
+    struct aws_allocator *allocator,
+    struct tls_local_server_tester *tester,
+    struct tls_test_args *args,
+    struct tls_common_tester *tls_c_tester,
+    bool enable_back_pressure,
+    int server_index) {
+    return s_tls_local_server_tester_init_configured(
+        allocator, tester, args, tls_c_tester, enable_back_pressure, server_index, NULL);
+}
+
 static int s_tls_local_server_tester_clean_up(struct tls_local_server_tester *tester) {
     ASSERT_SUCCESS(s_tls_opt_tester_clean_up(&tester->server_tls_opt_tester));
     aws_server_bootstrap_release(tester->server_bootstrap);
     return AWS_OP_SUCCESS;
 }
 
+/* common structure for a tls client of a tls local server */
+struct tls_local_client_tester {
+    struct tls_opt_tester client_tls_opt_tester;
+    struct aws_client_bootstrap *client_bootstrap;
+    struct aws_socket_channel_bootstrap_options channel_options;
+};
+
+/*
+ * Sets up a client ctx that trusts the test certificate, with configure_fn (if any) applied, and the options for
+ * channels from it to server_tester. on_negotiated is called with negotiated_user_data, and everything else with args.
+ */
+static int s_tls_local_client_tester_init(
+    struct aws_allocator *allocator,
+    struct tls_local_client_tester *tester,
+    struct tls_local_server_tester *server_tester,
+    struct tls_test_args *args,
+    struct tls_common_tester *tls_c_tester,
+    tls_ctx_options_configure_fn *configure_fn,
+    aws_tls_on_negotiation_result_fn *on_negotiated,
+    void *negotiated_user_data) {
+    AWS_ZERO_STRUCT(*tester);
+
+    struct tls_opt_tester *client_tls_opt_tester = &tester->client_tls_opt_tester;
+    aws_tls_ctx_options_init_default_client(&client_tls_opt_tester->ctx_options, allocator);
+    ASSERT_SUCCESS(aws_tls_ctx_options_override_default_trust_store_from_path(
+        &client_tls_opt_tester->ctx_options, NULL, "unittests.crt"));
+    if (configure_fn) {
+        configure_fn(&client_tls_opt_tester->ctx_options);
+    }
+    client_tls_opt_tester->ctx = aws_tls_client_ctx_new(allocator, &client_tls_opt_tester->ctx_options);
+    ASSERT_NOT_NULL(client_tls_opt_tester->ctx);
+    aws_tls_connection_options_init_from_ctx(&client_tls_opt_tester->opt, client_tls_opt_tester->ctx);
+    struct aws_byte_cursor server_name = aws_byte_cursor_from_c_str("localhost");
+    ASSERT_SUCCESS(aws_tls_connection_options_set_server_name(&client_tls_opt_tester->opt, allocator, &server_name));
+    aws_tls_connection_options_set_callbacks(
+        &client_tls_opt_tester->opt, on_negotiated, NULL, NULL, negotiated_user_data);
+
+    struct aws_client_bootstrap_options bootstrap_options = {
+        .event_loop_group = tls_c_tester->el_group,
+        .host_resolver = tls_c_tester->resolver,
+    };
+    tester->client_bootstrap = aws_client_bootstrap_new(allocator, &bootstrap_options);
+    ASSERT_NOT_NULL(tester->client_bootstrap);
+
+    struct aws_socket_channel_bootstrap_options *channel_options = &tester->channel_options;
+    channel_options->bootstrap = tester->client_bootstrap;
+    channel_options->host_name = server_tester->endpoint.address;
+    channel_options->port = 0;
+    channel_options->socket_options = &server_tester->socket_options;
+    channel_options->tls_options = &client_tls_opt_tester->opt;
+    channel_options->setup_callback = s_tls_handler_test_client_setup_callback;
+    channel_options->shutdown_callback = s_tls_handler_test_client_shutdown_callback;
+    channel_options->user_data = args;
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_tls_local_client_tester_clean_up(struct tls_local_client_tester *tester) {
+    ASSERT_SUCCESS(s_tls_opt_tester_clean_up(&tester->client_tls_opt_tester));
+    aws_client_bootstrap_release(tester->client_bootstrap);
+    return AWS_OP_SUCCESS;
+}
+
 struct tls_test_rw_args {
     struct aws_mutex *mutex;
     struct aws_condition_variable *condition_variable;
@@ -780,6 +887,410 @@ static int s_tls_channel_echo_and_backpressure_test_fn(struct aws_allocator *all
 
 AWS_TEST_CASE(tls_channel_echo_and_backpressure_test, s_tls_channel_echo_and_backpressure_test_fn)
 
+struct tls_write_burst_tester {
+    struct aws_channel_task write_task;
+    struct aws_channel_task stats_task;
+    struct aws_channel_slot *slot;
+    struct aws_mutex *mutex;
+    struct aws_condition_variable *condition_variable;
+    struct aws_byte_buf expected;
+    size_t write_count;
+    bool flush_after_writes;
+    struct tls_test_rw_args *incoming_rw_args;
+    size_t completions;
+    int last_completion_error;
+    uint64_t writes_issued_ns;
+    uint64_t last_completion_ns;
+    struct aws_crt_statistics_tls client_stats;
+    bool stats_gathered;
+};
+
+static void s_tls_write_burst_completed(
+    struct aws_channel *channel,
+    struct aws_io_message *message,
+    int err_code,
+    void *user_data) {
+    (void)channel;
+    (void)message;
+
+    struct tls_write_burst_tester *tester = user_data;
+    aws_mutex_lock(tester->mutex);
+    tester->completions += 1;
+    aws_high_res_clock_get_ticks(&tester->last_completion_ns);
+    if (err_code) {
+        tester->last_completion_error = err_code;
+    }
+    aws_mutex_unlock(tester->mutex);
+    aws_condition_variable_notify_one(tester->condition_variable);
+}
+
+/* issues all of the writes from the channel thread so that they land in the same event-loop tick */
+static void s_tls_write_burst_task(struct aws_channel_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    if (status != AWS_TASK_STATUS_RUN_READY) {
+        return;
+    }
+
+    struct tls_write_burst_tester *tester = arg;
+    struct aws_byte_cursor to_write = aws_byte_cursor_from_buf(&tester->expected);
+    size_t chunk_size = tester->expected.len / tester->write_count;
+
+    aws_mutex_lock(tester->mutex);
+    aws_high_res_clock_get_ticks(&tester->writes_issued_ns);
+    aws_mutex_unlock(tester->mutex);
+
+    for (size_t i = 0; i < tester->write_count; ++i) {
+        struct aws_byte_cursor chunk = aws_byte_cursor_advance(&to_write, chunk_size);
+        struct aws_io_message *message =
+            aws_channel_acquire_message_from_pool(tester->slot->channel, AWS_IO_MESSAGE_APPLICATION_DATA, chunk.len);
+        AWS_FATAL_ASSERT(message);
+        AWS_FATAL_ASSERT(aws_byte_buf_append(&message->message_data, &chunk) == AWS_OP_SUCCESS);
+        message->on_completion = s_tls_write_burst_completed;
+        message->user_data = tester;
+
+        if (aws_channel_slot_send_message(tester->slot, message, AWS_CHANNEL_DIR_WRITE)) {
+            aws_mem_release(message->allocator, message);
+        }
+    }
+
+    if (tester->flush_after_writes) {
+        AWS_FATAL_ASSERT(aws_tls_handler_flush(tester->slot->adj_left->handler) == AWS_OP_SUCCESS);
+    }
+}
+
+/* copies the client tls handler's statistics, which may only be read from the channel thread */
+static void s_tls_write_burst_stats_task(struct aws_channel_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+
+    struct tls_write_burst_tester *tester = arg;
+    aws_mutex_lock(tester->mutex);
+    if (status == AWS_TASK_STATUS_RUN_READY) {
+        struct aws_channel_handler *tls_handler = tester->slot->adj_left->handler;
+
+        struct aws_array_list stats_list;
+        void *stats_storage[1];
+        aws_array_list_init_static(&stats_list, stats_storage, 1, sizeof(void *));
+        tls_handler->vtable->gather_statistics(tls_handler, &stats_list);
+
+        struct aws_crt_statistics_tls *tls_stats = NULL;
+        aws_array_list_get_at(&stats_list, &tls_stats, 0);
+        tester->client_stats = *tls_stats;
+    }
+    tester->stats_gathered = true;
+    aws_mutex_unlock(tester->mutex);
+    aws_condition_variable_notify_one(tester->condition_variable);
+}
+
+static bool s_tls_write_burst_predicate(void *user_data) {
+    struct tls_write_burst_tester *tester = user_data;
+    return tester->completions == tester->write_count &&
+           tester->incoming_rw_args->received_message.len == tester->expected.len;
+}
+
+static bool s_tls_write_burst_stats_predicate(void *user_data) {
+    struct tls_write_burst_tester *tester = user_data;
+    return tester->stats_gathered;
+}
+
+/*
+ * Writes write_count messages of write_size bytes from client to server with the client ctx configured by
+ * configure_fn, then calls aws_tls_handler_flush() if flush_after_writes is set. Verifies every write completes and
+ * the server sees all of the bytes in order. The client tls handler's statistics from after the writes are copied to
+ * client_stats, and how long the writes took to complete to completion_ns, if they aren't NULL.
+ */
+static int s_tls_channel_write_burst_test(
+    struct aws_allocator *allocator,
+    tls_ctx_options_configure_fn *configure_fn,
+    size_t write_count,
+    size_t write_size,
+    bool flush_after_writes,
+    struct aws_crt_statistics_tls *client_stats,
+    uint64_t *completion_ns) {
+    aws_io_library_init(allocator);
+    ASSERT_SUCCESS(s_tls_common_tester_init(allocator, &c_tester));
+
+    struct aws_byte_buf write_tag;
+    ASSERT_SUCCESS(aws_byte_buf_init(&write_tag, allocator, write_count * write_size));
+    for (size_t i = 0; i < write_tag.capacity; ++i) {
+        aws_byte_buf_write_u8(&write_tag, (uint8_t)('a' + i % 26));
+    }
+
+    struct aws_byte_buf incoming_received_message;
+    ASSERT_SUCCESS(aws_byte_buf_init(&incoming_received_message, allocator, write_tag.len));
+    struct tls_test_rw_args incoming_rw_args;
+    ASSERT_SUCCESS(s_tls_rw_args_init(&incoming_rw_args, &c_tester, incoming_received_message));
+
+    uint8_t outgoing_received_message[128] = {0};
+    struct tls_test_rw_args outgoing_rw_args;
+    ASSERT_SUCCESS(s_tls_rw_args_init(
+        &outgoing_rw_args,
+        &c_tester,
+        aws_byte_buf_from_empty_array(outgoing_received_message, sizeof(outgoing_received_message))));
+
+    struct tls_test_args outgoing_args;
+    ASSERT_SUCCESS(s_tls_test_arg_init(allocator, &outgoing_args, false, &c_tester));
+
+    struct tls_test_args incoming_args;
+    ASSERT_SUCCESS(s_tls_test_arg_init(allocator, &incoming_args, true, &c_tester));
+
+    struct tls_local_server_tester local_server_tester;
+    ASSERT_SUCCESS(
+        s_tls_local_server_tester_init(allocator, &local_server_tester, &incoming_args, &c_tester, false, 1));
+
+    struct aws_channel_handler *outgoing_rw_handler = rw_handler_new(
+        allocator, s_tls_test_handle_read, s_tls_test_handle_write, true, SIZE_MAX, &outgoing_rw_args);
+    ASSERT_NOT_NULL(outgoing_rw_handler);
+
+    struct aws_channel_handler *incoming_rw_handler = rw_handler_new(
+        allocator, s_tls_test_handle_read, s_tls_test_handle_write, true, SIZE_MAX, &incoming_rw_args);
+    ASSERT_NOT_NULL(incoming_rw_handler);
+
+    incoming_args.rw_handler = incoming_rw_handler;
+    outgoing_args.rw_handler = outgoing_rw_handler;
+
+    struct tls_local_client_tester local_client_tester;
+    ASSERT_SUCCESS(s_tls_local_client_tester_init(
+        allocator,
+        &local_client_tester,
+        &local_server_tester,
+        &outgoing_args,
+        &c_tester,
+        configure_fn,
+        s_tls_on_negotiated,
+        &outgoing_args));
+
+    ASSERT_SUCCESS(aws_client_bootstrap_new_socket_channel(&local_client_tester.channel_options));
+
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_channel_setup_predicate, &incoming_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_channel_setup_predicate, &outgoing_args));
+    ASSERT_SUCCESS(aws_mutex_unlock(&c_tester.mutex));
+    ASSERT_FALSE(incoming_args.error_invoked);
+    ASSERT_FALSE(outgoing_args.error_invoked);
+
+    struct tls_write_burst_tester write_tester = {
+        .slot = outgoing_args.rw_slot,
+        .mutex = &c_tester.mutex,
+        .condition_variable = &c_tester.condition_variable,
+        .expected = write_tag,
+        .write_count = write_count,
+        .flush_after_writes = flush_after_writes,
+        .incoming_rw_args = &incoming_rw_args,
+    };
+    aws_channel_task_init(&write_tester.write_task, s_tls_write_burst_task, &write_tester, "tls_write_burst_task");
+    aws_channel_schedule_task_now(outgoing_args.channel, &write_tester.write_task);
+
+    /* every write must complete, and the peer must see the bytes in order */
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_write_burst_predicate, &write_tester));
+    if (completion_ns != NULL) {
+        *completion_ns = write_tester.last_completion_ns - write_tester.writes_issued_ns;
+    }
+    ASSERT_SUCCESS(aws_mutex_unlock(&c_tester.mutex));
+
+    ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, write_tester.last_completion_error);
+    ASSERT_BIN_ARRAYS_EQUALS(
+        write_tag.buffer,
+        write_tag.len,
+        incoming_rw_args.received_message.buffer,
+        incoming_rw_args.received_message.len);
+
+    if (client_stats != NULL) {
+        aws_channel_task_init(
+            &write_tester.stats_task, s_tls_write_burst_stats_task, &write_tester, "tls_write_burst_stats_task");
+        aws_channel_schedule_task_now(outgoing_args.channel, &write_tester.stats_task);
+
+        ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+        ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+            &c_tester.condition_variable, &c_tester.mutex, s_tls_write_burst_stats_predicate, &write_tester));
+        *client_stats = write_tester.client_stats;
+        ASSERT_SUCCESS(aws_mutex_unlock(&c_tester.mutex));
+    }
+
+    aws_channel_shutdown(incoming_args.channel, AWS_OP_SUCCESS);
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_channel_shutdown_predicate, &incoming_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_channel_shutdown_predicate, &outgoing_args));
+    aws_server_bootstrap_destroy_socket_listener(local_server_tester.server_bootstrap, local_server_tester.listener);
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_listener_destroy_predicate, &incoming_args));
+    aws_mutex_unlock(&c_tester.mutex);
+
+    ASSERT_SUCCESS(s_tls_local_client_tester_clean_up(&local_client_tester));
+    ASSERT_SUCCESS(s_tls_local_server_tester_clean_up(&local_server_tester));
+    ASSERT_SUCCESS(s_tls_common_tester_clean_up(&c_tester));
+    aws_byte_buf_clean_up(&incoming_rw_args.received_message);
+    aws_byte_buf_clean_up(&write_tag);
+    aws_io_library_clean_up();
+    return AWS_OP_SUCCESS;
+}
+
+#define WRITE_COALESCING_WRITE_COUNT 10
+#define WRITE_COALESCING_WRITE_SIZE 10
+
+/* long enough that a flush well before it can't have come from the timer */
+#define WRITE_COALESCING_LONG_DELAY_MS 10000
+#define WRITE_COALESCING_SHORT_DELAY_MS 200
+
+/* the threshold is well above the total amount written, so only a flush sends anything */
+static void s_configure_write_coalescing(struct aws_tls_ctx_options *options) {
+    /* buffer everything for the full tick */
+    aws_tls_ctx_options_set_write_coalescing(options, 16 * 1024, 0);
+}
+
+static void s_configure_write_coalescing_long_delay(struct aws_tls_ctx_options *options) {
+    aws_tls_ctx_options_set_write_coalescing(options, 16 * 1024, WRITE_COALESCING_LONG_DELAY_MS);
+}
+
+static void s_configure_write_coalescing_short_delay(struct aws_tls_ctx_options *options) {
+    aws_tls_ctx_options_set_write_coalescing(options, 16 * 1024, WRITE_COALESCING_SHORT_DELAY_MS);
+}
+
+static int s_tls_channel_write_coalescing_burst(
+    struct aws_allocator *allocator,
+    tls_ctx_options_configure_fn *configure_fn,
+    bool flush_after_writes,
+    uint64_t *completion_ns) {
+
+    struct aws_crt_statistics_tls client_stats;
+    AWS_ZERO_STRUCT(client_stats);
+    ASSERT_SUCCESS(s_tls_channel_write_burst_test(
+        allocator,
+        configure_fn,
+        WRITE_COALESCING_WRITE_COUNT,
+        WRITE_COALESCING_WRITE_SIZE,
+        flush_after_writes,
+        &client_stats,
+        completion_ns));
+
+    /* the writes went out together, in fewer records than there were writes */
+    ASSERT_TRUE(client_stats.records_encrypted < WRITE_COALESCING_WRITE_COUNT);
+#if !defined(_WIN32) && !defined(__APPLE__)
+    /* only the s2n handler counts records */
+    ASSERT_TRUE(client_stats.records_encrypted > 0);
+#endif
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_tls_channel_write_coalescing_test_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    return s_tls_channel_write_coalescing_burst(allocator, s_configure_write_coalescing, false, NULL);
+}
+
+AWS_TEST_CASE(tls_channel_write_coalescing_test, s_tls_channel_write_coalescing_test_fn)
+
+static int s_tls_channel_write_coalescing_flush_test_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    /* aws_tls_handler_flush() sends the buffered writes long before the timer would have */
+    uint64_t completion_ns = 0;
+    ASSERT_SUCCESS(s_tls_channel_write_coalescing_burst(
+        allocator, s_configure_write_coalescing_long_delay, true, &completion_ns));
+    ASSERT_TRUE(
+        completion_ns <
+        aws_timestamp_convert(WRITE_COALESCING_LONG_DELAY_MS, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(tls_channel_write_coalescing_flush_test, s_tls_channel_write_coalescing_flush_test_fn)
+
+static int s_tls_channel_write_coalescing_max_delay_test_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    /* nothing flushes the buffered writes, so they sit there until the timer goes off */
+    uint64_t completion_ns = 0;
+    ASSERT_SUCCESS(s_tls_channel_write_coalescing_burst(
+        allocator, s_configure_write_coalescing_short_delay, false, &completion_ns));
+#if !defined(_WIN32) && !defined(__APPLE__)
+    /* only the s2n handler coalesces writes */
+    ASSERT_TRUE(
+        completion_ns >=
+        aws_timestamp_convert(WRITE_COALESCING_SHORT_DELAY_MS, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL));
+#else
+    (void)completion_ns;
+#endif
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(tls_channel_write_coalescing_max_delay_test, s_tls_channel_write_coalescing_max_delay_test_fn)
+
+/* 64KB in writes that are each much bigger than a packet, so that the record size policy decides the record sizes */
+#define RECORD_SIZING_WRITE_COUNT 8
+#define RECORD_SIZING_WRITE_SIZE (8 * 1024)
+
+/* records that fit in one packet, vs. the average record size seen once records are allowed to be big */
+#define RECORD_SIZING_SMALL_RECORD_MAX 1500
+#define RECORD_SIZING_LARGE_RECORD_MIN 4096
+
+static void s_configure_low_latency_records(struct aws_tls_ctx_options *options) {
+    aws_tls_ctx_options_set_record_size_policy(options, AWS_IO_TLS_RECORD_SIZE_LOW_LATENCY);
+}
+
+static void s_configure_throughput_records(struct aws_tls_ctx_options *options) {
+    aws_tls_ctx_options_set_record_size_policy(options, AWS_IO_TLS_RECORD_SIZE_THROUGHPUT);
+}
+
+static void s_configure_dynamic_record_sizing(struct aws_tls_ctx_options *options) {
+    /* tiny threshold so the connection ramps up to full-size records after its first record */
+    aws_tls_ctx_options_set_dynamic_record_sizing(options, 32, 1);
+}
+
+static int s_tls_channel_record_sizing_burst(
+    struct aws_allocator *allocator,
+    tls_ctx_options_configure_fn *configure_fn,
+    uint64_t *average_record_size) {
+
+    struct aws_crt_statistics_tls client_stats;
+    AWS_ZERO_STRUCT(client_stats);
+    ASSERT_SUCCESS(s_tls_channel_write_burst_test(
+        allocator, configure_fn, RECORD_SIZING_WRITE_COUNT, RECORD_SIZING_WRITE_SIZE, false, &client_stats, NULL));
+
+    ASSERT_UINT_EQUALS(RECORD_SIZING_WRITE_COUNT * RECORD_SIZING_WRITE_SIZE, client_stats.bytes_encrypted);
+    ASSERT_TRUE(client_stats.records_encrypted > 0);
+    *average_record_size = client_stats.bytes_encrypted / client_stats.records_encrypted;
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_tls_channel_dynamic_record_sizing_test_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    uint64_t low_latency_record_size = 0;
+    ASSERT_SUCCESS(
+        s_tls_channel_record_sizing_burst(allocator, s_configure_low_latency_records, &low_latency_record_size));
+
+    uint64_t throughput_record_size = 0;
+    ASSERT_SUCCESS(
+        s_tls_channel_record_sizing_burst(allocator, s_configure_throughput_records, &throughput_record_size));
+
+    uint64_t dynamic_record_size = 0;
+    ASSERT_SUCCESS(
+        s_tls_channel_record_sizing_burst(allocator, s_configure_dynamic_record_sizing, &dynamic_record_size));
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+    /* only the s2n handler counts records */
+    ASSERT_TRUE(low_latency_record_size <= RECORD_SIZING_SMALL_RECORD_MAX);
+    ASSERT_TRUE(throughput_record_size >= RECORD_SIZING_LARGE_RECORD_MIN);
+    ASSERT_TRUE(dynamic_record_size >= RECORD_SIZING_LARGE_RECORD_MIN);
+#else
+    (void)low_latency_record_size;
+    (void)throughput_record_size;
+    (void)dynamic_record_size;
+#endif
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(tls_channel_dynamic_record_sizing_test, s_tls_channel_dynamic_record_sizing_test_fn)
+
 struct default_host_callback_data {
     struct aws_host_address aaaa_address;
     struct aws_host_address a_address;
@@ -1280,24 +1791,743 @@ static int s_tls_server_multiple_connections_fn(struct aws_allocator *allocator,
 }
 AWS_TEST_CASE(tls_server_multiple_connections, s_tls_server_multiple_connections_fn)
 
-struct shutdown_listener_tester {
-    struct aws_socket *listener;
-    struct aws_server_bootstrap *server_bootstrap;
-    struct tls_test_args *outgoing_args; /* client args */
-    struct aws_socket client_socket;
+struct tls_session_resumption_tester {
+    struct tls_test_args *args;
+    bool session_resumed;
+    enum aws_tls_early_data_status early_data_status;
 };
 
-static bool s_client_socket_closed_predicate(void *user_data) {
-    struct tls_test_args *args = user_data;
-    return args->shutdown_finished;
-}
-
-static void s_close_client_socket_task(struct aws_task *task, void *arg, enum aws_task_status status) {
-    (void)status;
-    struct shutdown_listener_tester *tester = arg;
+static void s_tls_on_negotiated_record_resumption(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    int err_code,
+    void *user_data) {
 
-    /* Free task memory */
-    aws_mem_release(tester->outgoing_args->allocator, task);
+    struct tls_session_resumption_tester *tester = user_data;
+
+    if (!err_code) {
+        struct aws_array_list stats_list;
+        void *stats_storage[1];
+        aws_array_list_init_static(&stats_list, stats_storage, 1, sizeof(void *));
+        handler->vtable->gather_statistics(handler, &stats_list);
+
+        struct aws_crt_statistics_tls *tls_stats = NULL;
+        aws_array_list_get_at(&stats_list, &tls_stats, 0);
+
+        aws_mutex_lock(tester->args->mutex);
+        tester->session_resumed = tls_stats->session_resumed;
+        tester->early_data_status = aws_tls_handler_early_data_status(handler);
+        aws_mutex_unlock(tester->args->mutex);
+    }
+
+    s_tls_on_negotiated(handler, slot, err_code, tester->args);
+}
+
+static int s_tls_connect_and_shutdown(
+    struct aws_socket_channel_bootstrap_options *channel_options,
+    struct tls_test_args *outgoing_args,
+    struct tls_test_args *incoming_args) {
+
+    s_reset_arg_state(outgoing_args);
+    s_reset_arg_state(incoming_args);
+
+    ASSERT_SUCCESS(aws_client_bootstrap_new_socket_channel(channel_options));
+
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_channel_setup_predicate, incoming_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_channel_setup_predicate, outgoing_args));
+    ASSERT_SUCCESS(aws_mutex_unlock(&c_tester.mutex));
+    ASSERT_FALSE(incoming_args->error_invoked);
+    ASSERT_FALSE(outgoing_args->error_invoked);
+
+    aws_channel_shutdown(outgoing_args->channel, AWS_OP_SUCCESS);
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_channel_shutdown_predicate, outgoing_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_channel_shutdown_predicate, incoming_args));
+    ASSERT_SUCCESS(aws_mutex_unlock(&c_tester.mutex));
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_configure_session_resumption(struct aws_tls_ctx_options *options) {
+    aws_tls_ctx_options_set_session_resumption(options, true);
+}
+
+static int s_tls_client_session_resumption_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_io_library_init(allocator);
+
+    ASSERT_SUCCESS(s_tls_common_tester_init(allocator, &c_tester));
+
+    struct tls_test_args outgoing_args;
+    ASSERT_SUCCESS(s_tls_test_arg_init(allocator, &outgoing_args, false, &c_tester));
+
+    struct tls_test_args incoming_args;
+    ASSERT_SUCCESS(s_tls_test_arg_init(allocator, &incoming_args, true, &c_tester));
+
+    /* only this test's server issues tickets */
+    struct tls_local_server_tester local_server_tester;
+    ASSERT_SUCCESS(s_tls_local_server_tester_init_configured(
+        allocator, &local_server_tester, &incoming_args, &c_tester, false, 1, s_configure_session_resumption));
+
+    struct tls_session_resumption_tester resumption_tester = {.args = &outgoing_args};
+
+    struct tls_local_client_tester local_client_tester;
+    ASSERT_SUCCESS(s_tls_local_client_tester_init(
+        allocator,
+        &local_client_tester,
+        &local_server_tester,
+        &outgoing_args,
+        &c_tester,
+        s_configure_session_resumption,
+        s_tls_on_negotiated_record_resumption,
+        &resumption_tester));
+
+    /* the first connection has nothing cached and must do a full handshake */
+    ASSERT_SUCCESS(
+        s_tls_connect_and_shutdown(&local_client_tester.channel_options, &outgoing_args, &incoming_args));
+    ASSERT_FALSE(resumption_tester.session_resumed);
+
+    /* the second one offers the ticket from the first, and the server should accept it */
+    ASSERT_SUCCESS(
+        s_tls_connect_and_shutdown(&local_client_tester.channel_options, &outgoing_args, &incoming_args));
+#if !defined(_WIN32) && !defined(__APPLE__)
+    ASSERT_TRUE(resumption_tester.session_resumed);
+#endif
+
+    aws_server_bootstrap_destroy_socket_listener(local_server_tester.server_bootstrap, local_server_tester.listener);
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_listener_destroy_predicate, &incoming_args));
+    aws_mutex_unlock(&c_tester.mutex);
+
+    ASSERT_SUCCESS(s_tls_local_client_tester_clean_up(&local_client_tester));
+    ASSERT_SUCCESS(s_tls_local_server_tester_clean_up(&local_server_tester));
+    ASSERT_SUCCESS(s_tls_common_tester_clean_up(&c_tester));
+    aws_io_library_clean_up();
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(tls_client_session_resumption, s_tls_client_session_resumption_fn)
+
+struct tls_server_stats_tester {
+    struct tls_test_args *args;
+    struct aws_crt_statistics_tls stats;
+};
+
+/* copies the server tls handler's statistics as its handshake completes */
+static void s_tls_on_negotiated_record_stats(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    int err_code,
+    void *user_data) {
+
+    struct tls_server_stats_tester *tester = user_data;
+
+    if (!err_code) {
+        struct aws_array_list stats_list;
+        void *stats_storage[1];
+        aws_array_list_init_static(&stats_list, stats_storage, 1, sizeof(void *));
+        handler->vtable->gather_statistics(handler, &stats_list);
+
+        struct aws_crt_statistics_tls *tls_stats = NULL;
+        aws_array_list_get_at(&stats_list, &tls_stats, 0);
+
+        aws_mutex_lock(tester->args->mutex);
+        tester->stats = *tls_stats;
+        aws_mutex_unlock(tester->args->mutex);
+    }
+
+    s_tls_on_negotiated(handler, slot, err_code, tester->args);
+}
+
+static void s_configure_handshake_offload(struct aws_tls_ctx_options *options) {
+    /*
+     * The connections below run one after another, so each signature goes through a worker and the queue never fills.
+     * The queue-full fallback signs inline, just like a ctx without offload does in every other test.
+     */
+    aws_tls_ctx_options_set_handshake_offload(options, 2, 1);
+}
+
+static int s_tls_server_handshake_offload_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_io_library_init(allocator);
+
+    ASSERT_SUCCESS(s_tls_common_tester_init(allocator, &c_tester));
+
+    struct tls_test_args outgoing_args;
+    ASSERT_SUCCESS(s_tls_test_arg_init(allocator, &outgoing_args, false, &c_tester));
+
+    struct tls_test_args incoming_args;
+    ASSERT_SUCCESS(s_tls_test_arg_init(allocator, &incoming_args, true, &c_tester));
+
+    struct tls_server_stats_tester server_tester = {.args = &incoming_args};
+    struct tls_local_server_tester local_server_tester;
+    ASSERT_SUCCESS(s_tls_local_server_tester_prepare(
+        allocator, &local_server_tester, &incoming_args, &c_tester, 1, s_configure_handshake_offload));
+    aws_tls_connection_options_set_callbacks(
+        &local_server_tester.server_tls_opt_tester.opt, s_tls_on_negotiated_record_stats, NULL, NULL, &server_tester);
+    ASSERT_SUCCESS(s_tls_local_server_tester_listen(&local_server_tester, &incoming_args, false));
+
+    struct tls_local_client_tester local_client_tester;
+    ASSERT_SUCCESS(s_tls_local_client_tester_init(
+        allocator,
+        &local_client_tester,
+        &local_server_tester,
+        &outgoing_args,
+        &c_tester,
+        NULL,
+        s_tls_on_negotiated,
+        &outgoing_args));
+
+    /* every one of these is a full handshake with a server side signature, made by a worker */
+    for (size_t i = 0; i < 3; ++i) {
+        AWS_ZERO_STRUCT(server_tester.stats);
+        ASSERT_SUCCESS(
+            s_tls_connect_and_shutdown(&local_client_tester.channel_options, &outgoing_args, &incoming_args));
+        ASSERT_UINT_EQUALS(1, outgoing_args.tls_levels_negotiated);
+        ASSERT_UINT_EQUALS(1, incoming_args.tls_levels_negotiated);
+#if !defined(_WIN32) && !defined(__APPLE__)
+        /* the handler only times private key operations when offload is enabled */
+        ASSERT_TRUE(server_tester.stats.private_key_op_ns > 0);
+#endif
+    }
+
+    aws_server_bootstrap_destroy_socket_listener(local_server_tester.server_bootstrap, local_server_tester.listener);
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_listener_destroy_predicate, &incoming_args));
+    aws_mutex_unlock(&c_tester.mutex);
+
+    ASSERT_SUCCESS(s_tls_local_client_tester_clean_up(&local_client_tester));
+    ASSERT_SUCCESS(s_tls_local_server_tester_clean_up(&local_server_tester));
+    ASSERT_SUCCESS(s_tls_common_tester_clean_up(&c_tester));
+    aws_io_library_clean_up();
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(tls_server_handshake_offload, s_tls_server_handshake_offload_fn)
+
+static int s_tls_server_shared_credentials_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_io_library_init(allocator);
+
+    ASSERT_SUCCESS(s_tls_common_tester_init(allocator, &c_tester));
+
+    /* holds the parsed certificate in the credential cache so that the server below shares it */
+    struct tls_opt_tester cached_tls_opt_tester;
+    ASSERT_SUCCESS(s_tls_server_opt_tester_init(allocator, &cached_tls_opt_tester, NULL));
+
+    struct tls_test_args outgoing_args;
+    ASSERT_SUCCESS(s_tls_test_arg_init(allocator, &outgoing_args, false, &c_tester));
+
+    struct tls_test_args incoming_args;
+    ASSERT_SUCCESS(s_tls_test_arg_init(allocator, &incoming_args, true, &c_tester));
+
+    struct tls_local_server_tester local_server_tester;
+    ASSERT_SUCCESS(
+        s_tls_local_server_tester_init(allocator, &local_server_tester, &incoming_args, &c_tester, false, 1));
+
+    struct tls_local_client_tester local_client_tester;
+    ASSERT_SUCCESS(s_tls_local_client_tester_init(
+        allocator,
+        &local_client_tester,
+        &local_server_tester,
+        &outgoing_args,
+        &c_tester,
+        NULL,
+        s_tls_on_negotiated,
+        &outgoing_args));
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+    /* both server contexts were created from the same files, so they must be sharing a single entry */
+    ASSERT_UINT_EQUALS(1, aws_tls_credential_cache_entry_count());
+#endif
+
+    ASSERT_SUCCESS(
+        s_tls_connect_and_shutdown(&local_client_tester.channel_options, &outgoing_args, &incoming_args));
+
+    /* contexts created after a reload parse fresh, while the ones above keep working off the evicted entry */
+    aws_tls_reload_credential_cache();
+#if !defined(_WIN32) && !defined(__APPLE__)
+    ASSERT_UINT_EQUALS(0, aws_tls_credential_cache_entry_count());
+#endif
+    struct tls_opt_tester reloaded_tls_opt_tester;
+    ASSERT_SUCCESS(s_tls_server_opt_tester_init(allocator, &reloaded_tls_opt_tester, NULL));
+#if !defined(_WIN32) && !defined(__APPLE__)
+    ASSERT_UINT_EQUALS(1, aws_tls_credential_cache_entry_count());
+#endif
+    ASSERT_SUCCESS(
+        s_tls_connect_and_shutdown(&local_client_tester.channel_options, &outgoing_args, &incoming_args));
+
+    aws_server_bootstrap_destroy_socket_listener(local_server_tester.server_bootstrap, local_server_tester.listener);
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_listener_destroy_predicate, &incoming_args));
+    aws_mutex_unlock(&c_tester.mutex);
+
+    ASSERT_SUCCESS(s_tls_opt_tester_clean_up(&cached_tls_opt_tester));
+    ASSERT_SUCCESS(s_tls_opt_tester_clean_up(&reloaded_tls_opt_tester));
+    ASSERT_SUCCESS(s_tls_local_client_tester_clean_up(&local_client_tester));
+    ASSERT_SUCCESS(s_tls_local_server_tester_clean_up(&local_server_tester));
+    ASSERT_SUCCESS(s_tls_common_tester_clean_up(&c_tester));
+    aws_io_library_clean_up();
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(tls_server_shared_credentials, s_tls_server_shared_credentials_fn)
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+
+static void s_configure_early_data(struct aws_tls_ctx_options *options) {
+    options->minimum_tls_version = AWS_IO_TLSv1_3;
+    aws_tls_ctx_options_set_session_resumption(options, true);
+    aws_tls_ctx_options_set_max_early_data_size(options, 16 * 1024);
+}
+
+static int s_tls_client_early_data_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_io_library_init(allocator);
+
+    ASSERT_SUCCESS(s_tls_common_tester_init(allocator, &c_tester));
+
+    /* early data without TLS 1.3 is a configuration error */
+    struct aws_tls_ctx_options invalid_ctx_options;
+    aws_tls_ctx_options_init_default_client(&invalid_ctx_options, allocator);
+    aws_tls_ctx_options_set_session_resumption(&invalid_ctx_options, true);
+    aws_tls_ctx_options_set_max_early_data_size(&invalid_ctx_options, 16 * 1024);
+    ASSERT_NULL(aws_tls_client_ctx_new(allocator, &invalid_ctx_options));
+    aws_tls_ctx_options_clean_up(&invalid_ctx_options);
+
+    struct tls_test_args outgoing_args;
+    ASSERT_SUCCESS(s_tls_test_arg_init(allocator, &outgoing_args, false, &c_tester));
+
+    struct tls_test_args incoming_args;
+    ASSERT_SUCCESS(s_tls_test_arg_init(allocator, &incoming_args, true, &c_tester));
+
+    /* the server allows early data in its tickets but its connections don't opt in, so it rejects whatever arrives */
+    struct tls_local_server_tester local_server_tester;
+    ASSERT_SUCCESS(s_tls_local_server_tester_init_configured(
+        allocator, &local_server_tester, &incoming_args, &c_tester, false, 1, s_configure_early_data));
+
+    struct tls_session_resumption_tester resumption_tester = {.args = &outgoing_args};
+
+    struct tls_local_client_tester local_client_tester;
+    ASSERT_SUCCESS(s_tls_local_client_tester_init(
+        allocator,
+        &local_client_tester,
+        &local_server_tester,
+        &outgoing_args,
+        &c_tester,
+        s_configure_early_data,
+        s_tls_on_negotiated_record_resumption,
+        &resumption_tester));
+    local_client_tester.client_tls_opt_tester.opt.early_data_replay_safe = true;
+
+    /* nothing is cached yet, so there is no session to carry early data */
+    ASSERT_SUCCESS(
+        s_tls_connect_and_shutdown(&local_client_tester.channel_options, &outgoing_args, &incoming_args));
+    ASSERT_FALSE(resumption_tester.session_resumed);
+    ASSERT_INT_EQUALS(AWS_IO_TLS_EARLY_DATA_NOT_REQUESTED, resumption_tester.early_data_status);
+
+    /* the resumed connection asks for early data, is turned down, and still negotiates */
+    ASSERT_SUCCESS(
+        s_tls_connect_and_shutdown(&local_client_tester.channel_options, &outgoing_args, &incoming_args));
+    ASSERT_TRUE(resumption_tester.session_resumed);
+    ASSERT_INT_EQUALS(AWS_IO_TLS_EARLY_DATA_REJECTED, resumption_tester.early_data_status);
+
+    aws_server_bootstrap_destroy_socket_listener(local_server_tester.server_bootstrap, local_server_tester.listener);
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_listener_destroy_predicate, &incoming_args));
+    aws_mutex_unlock(&c_tester.mutex);
+
+    ASSERT_SUCCESS(s_tls_local_client_tester_clean_up(&local_client_tester));
+    ASSERT_SUCCESS(s_tls_local_server_tester_clean_up(&local_server_tester));
+    ASSERT_SUCCESS(s_tls_common_tester_clean_up(&c_tester));
+    aws_io_library_clean_up();
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(tls_client_early_data, s_tls_client_early_data_fn)
+
+/* more writes than the s2n handler hands to a single s2n_sendv() call */
+#define EARLY_DATA_BURST_WRITE_COUNT 80
+
+struct tls_early_data_burst_tester {
+    struct tls_test_args *args;
+    struct aws_tls_connection_options *tls_options;
+    struct aws_channel_handler *rw_handler;
+};
+
+static void s_tls_early_data_burst_write(struct aws_channel_handler *rw_handler, struct aws_channel_slot *slot) {
+    for (int i = 0; i < EARLY_DATA_BURST_WRITE_COUNT; ++i) {
+        char write_str[32];
+        snprintf(write_str, sizeof(write_str), "early data write %02d;", i);
+        struct aws_byte_buf write_buf = aws_byte_buf_from_c_str(write_str);
+        rw_handler_write(rw_handler, slot, &write_buf);
+    }
+}
+
+/* TLS is set up by hand, so that the writes are made while the resumed handshake is still in flight. */
+static void s_tls_early_data_burst_setup_callback(
+    struct aws_client_bootstrap *bootstrap,
+    int error_code,
+    struct aws_channel *channel,
+    void *user_data) {
+
+    (void)bootstrap;
+    struct tls_early_data_burst_tester *tester = user_data;
+
+    if (!error_code) {
+        struct aws_channel_slot *socket_slot = aws_channel_get_first_slot(channel);
+        if (aws_channel_setup_client_tls(socket_slot, tester->tls_options)) {
+            error_code = aws_last_error();
+        } else {
+            struct aws_channel_slot *rw_slot = aws_channel_slot_new(channel);
+            aws_channel_slot_insert_right(socket_slot->adj_right, rw_slot);
+            aws_channel_slot_set_handler(rw_slot, tester->rw_handler);
+            s_tls_early_data_burst_write(tester->rw_handler, rw_slot);
+        }
+    }
+
+    /* not s_tls_handler_test_client_setup_callback(), negotiation hasn't finished so it would stack another handler */
+    struct tls_test_args *setup_test_args = tester->args;
+    aws_mutex_lock(setup_test_args->mutex);
+    setup_test_args->setup_callback_invoked = true;
+    if (!error_code) {
+        setup_test_args->channel = channel;
+    } else {
+        setup_test_args->error_invoked = true;
+        setup_test_args->last_error_code = error_code;
+    }
+    aws_mutex_unlock(setup_test_args->mutex);
+    aws_condition_variable_notify_one(setup_test_args->condition_variable);
+}
+
+static void s_tls_early_data_burst_shutdown_callback(
+    struct aws_client_bootstrap *bootstrap,
+    int error_code,
+    struct aws_channel *channel,
+    void *user_data) {
+
+    struct tls_early_data_burst_tester *tester = user_data;
+    s_tls_handler_test_client_shutdown_callback(bootstrap, error_code, channel, tester->args);
+}
+
+static bool s_tls_early_data_burst_received_predicate(void *user_data) {
+    struct tls_test_rw_args *rw_args = user_data;
+    return rw_args->received_message.len == rw_args->received_message.capacity;
+}
+
+static int s_tls_client_early_data_write_burst_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_io_library_init(allocator);
+
+    ASSERT_SUCCESS(s_tls_common_tester_init(allocator, &c_tester));
+
+    struct aws_byte_buf expected_message;
+    ASSERT_SUCCESS(aws_byte_buf_init(&expected_message, allocator, 1024));
+    for (int i = 0; i < EARLY_DATA_BURST_WRITE_COUNT; ++i) {
+        char write_str[32];
+        snprintf(write_str, sizeof(write_str), "early data write %02d;", i);
+        struct aws_byte_cursor write_cur = aws_byte_cursor_from_c_str(write_str);
+        ASSERT_SUCCESS(aws_byte_buf_append_dynamic(&expected_message, &write_cur));
+    }
+
+    struct aws_byte_buf incoming_received_message;
+    ASSERT_SUCCESS(aws_byte_buf_init(&incoming_received_message, allocator, expected_message.len));
+    struct tls_test_rw_args incoming_rw_args;
+    ASSERT_SUCCESS(s_tls_rw_args_init(&incoming_rw_args, &c_tester, incoming_received_message));
+
+    uint8_t outgoing_received_message[128] = {0};
+    struct tls_test_rw_args outgoing_rw_args;
+    ASSERT_SUCCESS(s_tls_rw_args_init(
+        &outgoing_rw_args,
+        &c_tester,
+        aws_byte_buf_from_empty_array(outgoing_received_message, sizeof(outgoing_received_message))));
+
+    struct tls_test_args outgoing_args;
+    ASSERT_SUCCESS(s_tls_test_arg_init(allocator, &outgoing_args, false, &c_tester));
+
+    struct tls_test_args incoming_args;
+    ASSERT_SUCCESS(s_tls_test_arg_init(allocator, &incoming_args, true, &c_tester));
+
+    /* the server's connections don't opt in, so every early data write is rejected and has to be resent */
+    struct tls_local_server_tester local_server_tester;
+    ASSERT_SUCCESS(s_tls_local_server_tester_init_configured(
+        allocator, &local_server_tester, &incoming_args, &c_tester, false, 1, s_configure_early_data));
+
+    struct tls_session_resumption_tester resumption_tester = {.args = &outgoing_args};
+
+    struct tls_local_client_tester local_client_tester;
+    ASSERT_SUCCESS(s_tls_local_client_tester_init(
+        allocator,
+        &local_client_tester,
+        &local_server_tester,
+        &outgoing_args,
+        &c_tester,
+        s_configure_early_data,
+        s_tls_on_negotiated_record_resumption,
+        &resumption_tester));
+    local_client_tester.client_tls_opt_tester.opt.early_data_replay_safe = true;
+
+    /* caches a session to resume */
+    ASSERT_SUCCESS(
+        s_tls_connect_and_shutdown(&local_client_tester.channel_options, &outgoing_args, &incoming_args));
+
+    s_reset_arg_state(&outgoing_args);
+    s_reset_arg_state(&incoming_args);
+    incoming_args.rw_handler = rw_handler_new(
+        allocator, s_tls_test_handle_read, s_tls_test_handle_write, true, SIZE_MAX, &incoming_rw_args);
+    ASSERT_NOT_NULL(incoming_args.rw_handler);
+
+    struct tls_early_data_burst_tester burst_tester = {
+        .args = &outgoing_args,
+        .tls_options = &local_client_tester.client_tls_opt_tester.opt,
+        .rw_handler = rw_handler_new(
+            allocator, s_tls_test_handle_read, s_tls_test_handle_write, true, SIZE_MAX, &outgoing_rw_args),
+    };
+    ASSERT_NOT_NULL(burst_tester.rw_handler);
+
+    struct aws_socket_channel_bootstrap_options channel_options = local_client_tester.channel_options;
+    channel_options.tls_options = NULL;
+    channel_options.setup_callback = s_tls_early_data_burst_setup_callback;
+    channel_options.shutdown_callback = s_tls_early_data_burst_shutdown_callback;
+    channel_options.user_data = &burst_tester;
+    ASSERT_SUCCESS(aws_client_bootstrap_new_socket_channel(&channel_options));
+
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_channel_setup_predicate, &outgoing_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_early_data_burst_received_predicate, &incoming_rw_args));
+    ASSERT_SUCCESS(aws_mutex_unlock(&c_tester.mutex));
+    ASSERT_FALSE(outgoing_args.error_invoked);
+    ASSERT_TRUE(resumption_tester.session_resumed);
+    ASSERT_INT_EQUALS(AWS_IO_TLS_EARLY_DATA_REJECTED, resumption_tester.early_data_status);
+
+    /* every write arrives exactly once and in order, across more than one s2n_sendv() batch */
+    ASSERT_BIN_ARRAYS_EQUALS(
+        expected_message.buffer,
+        expected_message.len,
+        incoming_rw_args.received_message.buffer,
+        incoming_rw_args.received_message.len);
+
+    aws_channel_shutdown(outgoing_args.channel, AWS_OP_SUCCESS);
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_channel_shutdown_predicate, &outgoing_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_channel_shutdown_predicate, &incoming_args));
+    ASSERT_SUCCESS(aws_mutex_unlock(&c_tester.mutex));
+
+    aws_server_bootstrap_destroy_socket_listener(local_server_tester.server_bootstrap, local_server_tester.listener);
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_listener_destroy_predicate, &incoming_args));
+    aws_mutex_unlock(&c_tester.mutex);
+
+    aws_byte_buf_clean_up(&incoming_received_message);
+    aws_byte_buf_clean_up(&expected_message);
+    ASSERT_SUCCESS(s_tls_local_client_tester_clean_up(&local_client_tester));
+    ASSERT_SUCCESS(s_tls_local_server_tester_clean_up(&local_server_tester));
+    ASSERT_SUCCESS(s_tls_common_tester_clean_up(&c_tester));
+    aws_io_library_clean_up();
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(tls_client_early_data_write_burst, s_tls_client_early_data_write_burst_fn)
+
+struct tls_early_data_server_tester {
+    struct tls_test_args *args;
+    uint64_t bytes_decrypted;
+    enum aws_tls_early_data_status early_data_status;
+};
+
+static void s_tls_on_negotiated_record_early_data(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    int err_code,
+    void *user_data) {
+
+    struct tls_early_data_server_tester *tester = user_data;
+
+    if (!err_code) {
+        struct aws_array_list stats_list;
+        void *stats_storage[1];
+        aws_array_list_init_static(&stats_list, stats_storage, 1, sizeof(void *));
+        handler->vtable->gather_statistics(handler, &stats_list);
+
+        struct aws_crt_statistics_tls *tls_stats = NULL;
+        aws_array_list_get_at(&stats_list, &tls_stats, 0);
+
+        aws_mutex_lock(tester->args->mutex);
+        tester->bytes_decrypted = tls_stats->bytes_decrypted;
+        tester->early_data_status = aws_tls_handler_early_data_status(handler);
+        aws_mutex_unlock(tester->args->mutex);
+    }
+
+    s_tls_on_negotiated(handler, slot, err_code, tester->args);
+}
+
+static int s_tls_server_accepts_early_data_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_io_library_init(allocator);
+
+    ASSERT_SUCCESS(s_tls_common_tester_init(allocator, &c_tester));
+
+    struct aws_byte_buf expected_message;
+    ASSERT_SUCCESS(aws_byte_buf_init(&expected_message, allocator, 1024));
+    for (int i = 0; i < EARLY_DATA_BURST_WRITE_COUNT; ++i) {
+        char write_str[32];
+        snprintf(write_str, sizeof(write_str), "early data write %02d;", i);
+        struct aws_byte_cursor write_cur = aws_byte_cursor_from_c_str(write_str);
+        ASSERT_SUCCESS(aws_byte_buf_append_dynamic(&expected_message, &write_cur));
+    }
+
+    struct aws_byte_buf incoming_received_message;
+    ASSERT_SUCCESS(aws_byte_buf_init(&incoming_received_message, allocator, expected_message.len));
+    struct tls_test_rw_args incoming_rw_args;
+    ASSERT_SUCCESS(s_tls_rw_args_init(&incoming_rw_args, &c_tester, incoming_received_message));
+
+    uint8_t outgoing_received_message[128] = {0};
+    struct tls_test_rw_args outgoing_rw_args;
+    ASSERT_SUCCESS(s_tls_rw_args_init(
+        &outgoing_rw_args,
+        &c_tester,
+        aws_byte_buf_from_empty_array(outgoing_received_message, sizeof(outgoing_received_message))));
+
+    struct tls_test_args outgoing_args;
+    ASSERT_SUCCESS(s_tls_test_arg_init(allocator, &outgoing_args, false, &c_tester));
+
+    struct tls_test_args incoming_args;
+    ASSERT_SUCCESS(s_tls_test_arg_init(allocator, &incoming_args, true, &c_tester));
+
+    /* this time the server's connections opt in too, so the early data is accepted */
+    struct tls_early_data_server_tester server_tester = {.args = &incoming_args};
+    struct tls_local_server_tester local_server_tester;
+    ASSERT_SUCCESS(s_tls_local_server_tester_prepare(
+        allocator, &local_server_tester, &incoming_args, &c_tester, 1, s_configure_early_data));
+    local_server_tester.server_tls_opt_tester.opt.early_data_replay_safe = true;
+    aws_tls_connection_options_set_callbacks(
+        &local_server_tester.server_tls_opt_tester.opt,
+        s_tls_on_negotiated_record_early_data,
+        NULL,
+        NULL,
+        &server_tester);
+    ASSERT_SUCCESS(s_tls_local_server_tester_listen(&local_server_tester, &incoming_args, false));
+
+    struct tls_session_resumption_tester resumption_tester = {.args = &outgoing_args};
+
+    struct tls_local_client_tester local_client_tester;
+    ASSERT_SUCCESS(s_tls_local_client_tester_init(
+        allocator,
+        &local_client_tester,
+        &local_server_tester,
+        &outgoing_args,
+        &c_tester,
+        s_configure_early_data,
+        s_tls_on_negotiated_record_resumption,
+        &resumption_tester));
+    local_client_tester.client_tls_opt_tester.opt.early_data_replay_safe = true;
+
+    /* caches a session to resume */
+    ASSERT_SUCCESS(
+        s_tls_connect_and_shutdown(&local_client_tester.channel_options, &outgoing_args, &incoming_args));
+    ASSERT_INT_EQUALS(AWS_IO_TLS_EARLY_DATA_NOT_REQUESTED, server_tester.early_data_status);
+
+    s_reset_arg_state(&outgoing_args);
+    s_reset_arg_state(&incoming_args);
+    incoming_args.rw_handler = rw_handler_new(
+        allocator, s_tls_test_handle_read, s_tls_test_handle_write, true, SIZE_MAX, &incoming_rw_args);
+    ASSERT_NOT_NULL(incoming_args.rw_handler);
+
+    struct tls_early_data_burst_tester burst_tester = {
+        .args = &outgoing_args,
+        .tls_options = &local_client_tester.client_tls_opt_tester.opt,
+        .rw_handler = rw_handler_new(
+            allocator, s_tls_test_handle_read, s_tls_test_handle_write, true, SIZE_MAX, &outgoing_rw_args),
+    };
+    ASSERT_NOT_NULL(burst_tester.rw_handler);
+
+    struct aws_socket_channel_bootstrap_options channel_options = local_client_tester.channel_options;
+    channel_options.tls_options = NULL;
+    channel_options.setup_callback = s_tls_early_data_burst_setup_callback;
+    channel_options.shutdown_callback = s_tls_early_data_burst_shutdown_callback;
+    channel_options.user_data = &burst_tester;
+    ASSERT_SUCCESS(aws_client_bootstrap_new_socket_channel(&channel_options));
+
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_channel_setup_predicate, &outgoing_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_early_data_burst_received_predicate, &incoming_rw_args));
+    ASSERT_SUCCESS(aws_mutex_unlock(&c_tester.mutex));
+    ASSERT_FALSE(outgoing_args.error_invoked);
+    ASSERT_TRUE(resumption_tester.session_resumed);
+    ASSERT_INT_EQUALS(AWS_IO_TLS_EARLY_DATA_ACCEPTED, resumption_tester.early_data_status);
+    ASSERT_INT_EQUALS(AWS_IO_TLS_EARLY_DATA_ACCEPTED, server_tester.early_data_status);
+
+    /* the server had decrypted all of it by the time its handshake completed */
+    ASSERT_UINT_EQUALS(expected_message.len, server_tester.bytes_decrypted);
+
+    /* and handed it on afterwards, exactly once and in order */
+    ASSERT_BIN_ARRAYS_EQUALS(
+        expected_message.buffer,
+        expected_message.len,
+        incoming_rw_args.received_message.buffer,
+        incoming_rw_args.received_message.len);
+
+    aws_channel_shutdown(outgoing_args.channel, AWS_OP_SUCCESS);
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_channel_shutdown_predicate, &outgoing_args));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_channel_shutdown_predicate, &incoming_args));
+    ASSERT_SUCCESS(aws_mutex_unlock(&c_tester.mutex));
+
+    aws_server_bootstrap_destroy_socket_listener(local_server_tester.server_bootstrap, local_server_tester.listener);
+    ASSERT_SUCCESS(aws_mutex_lock(&c_tester.mutex));
+    ASSERT_SUCCESS(aws_condition_variable_wait_pred(
+        &c_tester.condition_variable, &c_tester.mutex, s_tls_listener_destroy_predicate, &incoming_args));
+    aws_mutex_unlock(&c_tester.mutex);
+
+    aws_byte_buf_clean_up(&incoming_received_message);
+    aws_byte_buf_clean_up(&expected_message);
+    ASSERT_SUCCESS(s_tls_local_client_tester_clean_up(&local_client_tester));
+    ASSERT_SUCCESS(s_tls_local_server_tester_clean_up(&local_server_tester));
+    ASSERT_SUCCESS(s_tls_common_tester_clean_up(&c_tester));
+    aws_io_library_clean_up();
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(tls_server_accepts_early_data, s_tls_server_accepts_early_data_fn)
+
+#endif /* !defined(_WIN32) && !defined(__APPLE__) */
+
+struct shutdown_listener_tester {
+    struct aws_socket *listener;
+    struct aws_server_bootstrap *server_bootstrap;
+    struct tls_test_args *outgoing_args; /* client args */
+    struct aws_socket client_socket;
+};
+
+static bool s_client_socket_closed_predicate(void *user_data) {
+    struct tls_test_args *args = user_data;
+    return args->shutdown_finished;
+}
+
+static void s_close_client_socket_task(struct aws_task *task, void *arg, enum aws_task_status status) {
+    (void)status;
+    struct shutdown_listener_tester *tester = arg;
+
+    /* Free task memory */
+    aws_mem_release(tester->outgoing_args->allocator, task);
 
     /* Close socket and notify  */
     AWS_FATAL_ASSERT(aws_socket_close(&tester->client_socket) == AWS_OP_SUCCESS);
@@ -1564,6 +2794,18 @@ static int s_tls_channel_statistics_test(struct aws_allocator *allocator, void *
     ASSERT_TRUE(stats_impl->total_bytes_read >= read_tag.len);
     ASSERT_TRUE(stats_impl->total_bytes_written >= write_tag.len);
     ASSERT_TRUE(stats_impl->tls_status == AWS_TLS_NEGOTIATION_STATUS_SUCCESS);
+#if !defined(_WIN32) && !defined(__APPLE__)
+    /* the stats handler is on the client, which wrote write_tag and read read_tag */
+    ASSERT_TRUE(stats_impl->tls_handshake_read_waits > 0);
+    ASSERT_TRUE(stats_impl->tls_handshake_bytes_sent > 0);
+    ASSERT_TRUE(stats_impl->tls_handshake_bytes_received > 0);
+    ASSERT_TRUE(stats_impl->tls_cipher_suite != 0);
+    ASSERT_TRUE(stats_impl->tls_protocol_version != AWS_IO_TLS_VER_SYS_DEFAULTS);
+    ASSERT_TRUE(stats_impl->total_tls_records_encrypted > 0);
+    ASSERT_UINT_EQUALS(write_tag.len, stats_impl->total_tls_bytes_encrypted);
+    ASSERT_TRUE(stats_impl->total_tls_records_decrypted > 0);
+    ASSERT_UINT_EQUALS(read_tag.len, stats_impl->total_tls_bytes_decrypted);
+#endif
 
     aws_mutex_unlock(&stats_impl->lock);
 